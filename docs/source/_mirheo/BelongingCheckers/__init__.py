@@ -76,6 +76,50 @@ class Mesh(BelongingChecker):
         """
         pass
 
+class MeshGrid(BelongingChecker):
+    r"""
+        This checker will use the triangular mesh associated with objects to detect *inside*-*outside* status.
+        The generalized winding number of each object is evaluated on a coarse regular grid covering the object;
+        particles are classified from the grid, except close to the surface where the exact winding number is computed.
+        This is much faster than :any:`Mesh` for meshes with many triangles, and supports deformable objects.
+
+        .. note:
+            The grid spacing must be smaller than the thinnest parts of the objects.
+    
+    """
+    def __init__():
+        r"""__init__(name: str, grid_size: int = 16) -> None
+
+
+            Args:
+                name: name of the checker
+                grid_size: number of grid nodes along each direction of an object
+        
+
+        """
+        pass
+
+class MeshWindingNumber(BelongingChecker):
+    r"""
+        This checker will use the triangular mesh associated with objects to detect *inside*-*outside* status.
+        The generalized winding number of the mesh is computed for each particle, using a hierarchy of the triangles
+        in which groups of triangles far from the particle are approximated by their dipole.
+        Unlike :any:`Mesh`, the result is robust to meshes with small holes or self intersections, e.g. after large deformations.
+    
+    """
+    def __init__():
+        r"""__init__(name: str, far_field_ratio: float = 2.0, leaf_size: int = 8) -> None
+
+
+            Args:
+                name: name of the checker
+                far_field_ratio: groups of triangles are approximated when their distance to the particle is larger than this ratio times their radius
+                leaf_size: maximum number of triangles in the leaves of the hierarchy
+        
+
+        """
+        pass
+
 class Rod(BelongingChecker):
     r"""
         This checker will detect *inside*-*outside* status with respect to every segment of the rod, enlarged by a given radius.
@@ -227,6 +227,37 @@ class UniformSphere(InitialConditions):
         """
         pass
 
+class MembraneWithParameterScales(Membrane):
+    r"""
+        Same as :class:`~InitialConditions.Membrane` with an additional field attached to each membrane that scales its forces.
+        The membrane forces of :class:`~Interactions.MembraneForces` are multiplied by the corresponding scales of each membrane.
+        This allows to simulate many independent membranes with different properties in a single membrane vector, e.g. an ensemble of replicas in a parameter study.
+    
+    """
+    def __init__():
+        r"""__init__(com_q: List[ComQ], scales: List[real4], global_scale: float = 1.0) -> None
+
+
+            Args:
+                com_q:
+                    List describing location and rotation of the created objects.
+                    One entry in the list corresponds to one object created.
+                    Each entry consist of 7 reals: *<com_x> <com_y> <com_z>  <q_x> <q_y> <q_z> <q_w>*, where
+                    *com* is the center of mass of the object, *q* is the quaternion of its rotation,
+                    not necessarily normalized
+                scales:
+                    List of force scales, one entry per membrane.
+                    Each entry consists of 4 reals: *<shear> <bending> <constraints> <viscosity>*, which multiply
+                    respectively the shear (and local area) forces, the bending forces, the total area and volume constraint forces and the viscous forces.
+                    The fluctuation forces are multiplied by the square root of the viscosity scale.
+                global_scale:
+                    All the membranes will be scaled by that value. Useful to implement membranes growth so that they
+                    can fill the space with high volume fraction
+        
+
+        """
+        pass
+
 class MembraneWithTypeId(Membrane):
     r"""
         Same as :class:`~InitialConditions.Membrane` with an additional `type id` field which distinguish membranes with different properties.
@@ -255,3 +286,42 @@ class MembraneWithTypeId(Membrane):
         pass
 
 
+
+class RodWithParameterScales(Rod):
+    r"""
+        Same as :class:`~InitialConditions.Rod` with an additional field attached to each rod that scales its forces.
+        The forces of :class:`~Interactions.RodForces` are multiplied by the corresponding scales of each rod.
+        This allows to have rods with different elastic properties in a single rod vector.
+    
+    """
+    def __init__():
+        r"""__init__(com_q: List[ComQ], scales: List[real3], center_line: Callable[[float], real3], torsion: Callable[[float], float], a: float, initial_frame: real3 = real3(inf, inf, inf)) -> None
+
+
+            Args:
+                com_q:
+                    List describing location and rotation of the created objects.
+                    One entry in the list corresponds to one object created.
+                    Each entry consist of 7 reals: *<com_x> <com_y> <com_z>  <q_x> <q_y> <q_z> <q_w>*, where
+                    *com* is the center of mass of the object, *q* is the quaternion of its rotation,
+                    not necessarily normalized
+                scales:
+                    List of force scales, one entry per rod.
+                    Each entry consists of 3 reals: *<bounds> <bending> <twist>*, which multiply
+                    respectively the bound spring constants, the bending tensor and the twist coefficient.
+                    The curvature smoothing forces of the polymorphic states are multiplied by the bending scale.
+                center_line:
+                    explicit mapping :math:`\mathbf{r} : [0,1] \rightarrow R^3`.
+                    Assume :math:`|r'(s)|` is constant for all :math:`s \in [0,1]`.
+                torsion:
+                    explicit mapping :math:`\tau : [0,1] \rightarrow R`.
+                a:
+                    width of the rod
+                initial_frame:
+                    Orientation of the initial frame (optional)
+                    By default, will come up with any orthogonal frame to the rod at origin
+        
+
+        """
+        pass
+
@@ -50,6 +50,28 @@ class Oscillate(Integrator):
         """
         pass
 
+class RigidMotion(Integrator):
+    r"""
+        Move particles rigidly regardless of the forces acting on them, with the motion of a :any:`MovingSDF` wall:
+        a translation and a rotation around a center moving with the translation, constant or oscillating in time.
+        The positions follow the exact transform of the wall, so that its frozen particles stay attached to it.
+    
+    """
+    def __init__():
+        r"""__init__(name: str, velocity: real3 = (0.0, 0.0, 0.0), omega: real3 = (0.0, 0.0, 0.0), center: real3 = (0.0, 0.0, 0.0), period: float = 0.0) -> None
+
+
+                Args:
+                    name: name of the integrator
+                    velocity: translation velocity (amplitude if **period** is positive)
+                    omega: angular velocity (amplitude if **period** is positive)
+                    center: center of rotation at time 0
+                    period: oscillation period of the motion; the motion is constant if not positive
+            
+
+        """
+        pass
+
 class RigidVelocityVerlet(Integrator):
     r"""
         Integrate the position and rotation (in terms of quaternions) of the rigid bodies as per Velocity-Verlet scheme.
@@ -57,11 +79,14 @@ class RigidVelocityVerlet(Integrator):
     
     """
     def __init__():
-        r"""__init__(name: str) -> None
+        r"""__init__(name: str, reset_forces: bool = False) -> None
 
 
                 Args:
                     name: name of the integrator
+                    reset_forces: if True, the forces are set to zero while integrating instead of in a separate step
+                                  before the next force computation. Only for particle vectors that are not object vectors;
+                                  the forces are then not available after integration, e.g. to plugins.
             
 
         """
@@ -85,6 +110,37 @@ class Rotate(Integrator):
         """
         pass
 
+class RodConstraints(Integrator):
+    r"""
+            Advance rods with the velocity-Verlet scheme and enforce the lengths between the particles of each segment
+            (center line and material frame) with SHAKE iterations.
+            This replaces the stiff bound forces of :any:`RodForces`, which usually restrict the time step.
+            The velocities are set to the constrained displacements divided by the time step.
+
+            Optionally, the time step can be split into sub steps, similarly to :any:`SubStep`:
+            the fast forces (e.g. the bending and twist forces of the rod) are updated at every sub step
+            while the other forces are kept constant.
+        
+    """
+    def __init__():
+        r"""__init__(name: str, rod_forces: Interactions.RodForces, nIterations: int = 10, substeps: int = 1, fastForces: List[Interactions.Interaction] = []) -> None
+
+
+                Args:
+                    name: name of the integrator
+                    rod_forces: the :any:`RodForces` of the rods; its equilibrium lengths ``a0`` and ``l0`` define the constraints
+                    nIterations: number of SHAKE iterations per (sub) time step
+                    substeps: number of sub steps
+                    fastForces: a list of fast interactions. Only accepts :any:`RodForces`
+
+                .. warning::
+                    The fast interactions must not be registered to the simulation.
+                    The bound stiffnesses ``k_s_center`` and ``k_s_frame`` of the rod interactions should be set to zero.
+            
+
+        """
+        pass
+
 class SubStep(Integrator):
     r"""
             Takes advantage of separation of time scales between "fast" internal forces and other "slow" forces on an object vector.
@@ -142,11 +198,14 @@ class VelocityVerlet(Integrator):
         
     """
     def __init__():
-        r"""__init__(name: str) -> None
+        r"""__init__(name: str, reset_forces: bool = False) -> None
 
 
                 Args:
                     name: name of the integrator
+                    reset_forces: if True, the forces are set to zero while integrating instead of in a separate step
+                                  before the next force computation. Only for particle vectors that are not object vectors;
+                                  the forces are then not available after integration, e.g. to plugins.
             
 
         """
@@ -162,13 +221,16 @@ class VelocityVerlet_withConstForce(Integrator):
         
     """
     def __init__():
-        r"""__init__(name: str, force: real3) -> None
+        r"""__init__(name: str, force: real3, reset_forces: bool = False) -> None
 
 
 
                 Args:
                     name: name of the integrator
                     force: :math:`\mathbf{F}_{extra}`
+                    reset_forces: if True, the forces are set to zero while integrating instead of in a separate step
+                                  before the next force computation. Only for particle vectors that are not object vectors;
+                                  the forces are then not available after integration, e.g. to plugins.
             
 
         """
@@ -183,7 +245,7 @@ class VelocityVerlet_withPeriodicForce(Integrator):
         
     """
     def __init__():
-        r"""__init__(name: str, force: float, direction: str) -> None
+        r"""__init__(name: str, force: float, direction: str, reset_forces: bool = False) -> None
 
 
                 Args:
@@ -193,6 +255,9 @@ class VelocityVerlet_withPeriodicForce(Integrator):
                                if direction is \"x\", the sign changes along \"y\".
                                if direction is \"y\", the sign changes along \"z\".
                                if direction is \"z\", the sign changes along \"x\".
+                    reset_forces: if True, the forces are set to zero while integrating instead of in a separate step
+                                  before the next force computation. Only for particle vectors that are not object vectors;
+                                  the forces are then not available after integration, e.g. to plugins.
             
 
         """
@@ -394,6 +394,41 @@ class Pairwise(Interaction):
         """
         pass
 
+class RigidContact(Interaction):
+    r"""
+        Short range contact and lubrication forces between rigid objects with analytical shapes
+        (see :any:`RigidCapsuleVector`, :any:`RigidCylinderVector` and :any:`RigidEllipsoidVector`).
+
+        The forces are computed from the positions, orientations and velocities of the objects and their analytical shapes,
+        without using the frozen particles.
+        This prevents overlaps in dense suspensions of objects that are represented by few particles.
+
+        For each pair of objects, the closest points of the surfaces define the gap :math:`h` and the normal :math:`\mathbf{n}`.
+        The force acting on the objects along :math:`\mathbf{n}` is the sum of
+
+        * a contact force :math:`k_c (h_c - h)`, active when :math:`h < h_c`;
+        * a lubrication force :math:`6 \pi \mu R^2 \left( \frac{1}{\max(h, h_{min})} - \frac{1}{h_l} \right) v_n`, active when :math:`h < h_l`,
+          where :math:`v_n` is the normal relative velocity at the contact point and :math:`R` is the reduced radius at the contact point.
+
+        The forces and torques are added to the rigid motions of the objects.
+    
+    """
+    def __init__():
+        r"""__init__(name: str, k_contact: float, contact_distance: float, viscosity: float = 0.0, lubrication_distance: float = 0.0, min_gap: float = 0.001) -> None
+
+
+            Args:
+                name: name of the interaction
+                k_contact: stiffness of the contact force :math:`k_c`
+                contact_distance: gap :math:`h_c` below which the contact force is active
+                viscosity: viscosity of the solvent :math:`\mu` for the lubrication force
+                lubrication_distance: gap :math:`h_l` below which the lubrication force is active
+                min_gap: regularization gap :math:`h_{min}` of the lubrication force
+    
+
+        """
+        pass
+
 class RodForces(Interaction):
     r"""
         Forces acting on an elastic rod.
@@ -98,7 +98,7 @@ def createBerendsenThermostat():
     pass
 
 def createDensityControl():
-    r"""createDensityControl(state: MirState, name: str, file_name: str, pvs: List[ParticleVectors.ParticleVector], target_density: float, region: Callable[[real3], float], resolution: real3, level_lo: float, level_hi: float, level_space: float, Kp: float, Ki: float, Kd: float, tune_every: int, dump_every: int, sample_every: int) -> Tuple[Plugins.SimulationPlugin, Plugins.PostprocessPlugin]
+    r"""createDensityControl(state: MirState, name: str, file_name: str, pvs: List[ParticleVectors.ParticleVector], target_density: float, region: function, resolution: real3, level_lo: float, level_hi: float, level_space: float, Kp: float, Ki: float, Kd: float, tune_every: int, dump_every: int, sample_every: int, vectorized: bool = False) -> Tuple[Plugins.SimulationPlugin, Plugins.PostprocessPlugin]
 
 
         This plugin applies forces to a set of particle vectors in order to get a constant density.
@@ -118,13 +118,15 @@ def createDensityControl():
             tune_every: update the forces every this amount of time steps
             dump_every: dump densities and forces in file ``filename``
             sample_every: sample to average densities every this amount of time steps
+            vectorized: if True, ``region`` is called with an array of positions of shape (N, 3) and must return N values
+                        (e.g. a function written with NumPy); this is much faster than calling it once per grid node.
     
 
     """
     pass
 
 def createDensityOutlet():
-    r"""createDensityOutlet(state: MirState, name: str, pvs: List[ParticleVectors.ParticleVector], number_density: float, region: Callable[[real3], float], resolution: real3) -> Tuple[Plugins.SimulationPlugin, Plugins.PostprocessPlugin]
+    r"""createDensityOutlet(state: MirState, name: str, pvs: List[ParticleVectors.ParticleVector], number_density: float, region: function, resolution: real3, vectorized: bool = False) -> Tuple[Plugins.SimulationPlugin, Plugins.PostprocessPlugin]
 
 
         This plugin removes particles from a set of :any:`ParticleVector` in a given region if the number density is larger than a given target.
@@ -135,6 +137,8 @@ def createDensityOutlet():
             number_density: maximum number_density in the region
             region: a function that is negative in the concerned region and positive outside
             resolution: grid resolution to represent the region field
+            vectorized: if True, ``region`` is called with an array of positions of shape (N, 3) and must return N values
+                        (e.g. a function written with NumPy); this is much faster than calling it once per grid node.
 
     
 
@@ -549,7 +553,7 @@ def createPlaneOutlet():
     pass
 
 def createRateOutlet():
-    r"""createRateOutlet(state: MirState, name: str, pvs: List[ParticleVectors.ParticleVector], mass_rate: float, region: Callable[[real3], float], resolution: real3) -> Tuple[Plugins.SimulationPlugin, Plugins.PostprocessPlugin]
+    r"""createRateOutlet(state: MirState, name: str, pvs: List[ParticleVectors.ParticleVector], mass_rate: float, region: function, resolution: real3, vectorized: bool = False) -> Tuple[Plugins.SimulationPlugin, Plugins.PostprocessPlugin]
 
 
         This plugin removes particles from a set of :any:`ParticleVector` in a given region at a given mass rate.
@@ -560,6 +564,8 @@ def createRateOutlet():
             mass_rate: total outlet mass rate in the region
             region: a function that is negative in the concerned region and positive outside
             resolution: grid resolution to represent the region field
+            vectorized: if True, ``region`` is called with an array of positions of shape (N, 3) and must return N values
+                        (e.g. a function written with NumPy); this is much faster than calling it once per grid node.
 
     
 
@@ -646,7 +652,7 @@ def createVelocityControl():
     pass
 
 def createVelocityInlet():
-    r"""createVelocityInlet(state: MirState, name: str, pv: ParticleVectors.ParticleVector, implicit_surface_func: Callable[[real3], float], velocity_field: Callable[[real3], real3], resolution: real3, number_density: float, kBT: float) -> Tuple[Plugins.SimulationPlugin, Plugins.PostprocessPlugin]
+    r"""createVelocityInlet(state: MirState, name: str, pv: ParticleVectors.ParticleVector, implicit_surface_func: function, velocity_field: Callable[[real3], real3], resolution: real3, number_density: float, kBT: float, vectorized: bool = False) -> Tuple[Plugins.SimulationPlugin, Plugins.PostprocessPlugin]
 
 
         This plugin inserts particles in a given :any:`ParticleVector`.
@@ -661,13 +667,15 @@ def createVelocityInlet():
             resolution: grid size used to discretize the surface
             number_density: number density of the inserted solvent
             kBT: temperature of the inserted solvent
+            vectorized: if True, ``implicit_surface_func`` is called with an array of positions of shape (N, 3) and must return N values
+                        (e.g. a function written with NumPy); it is then called once per plane of grid nodes.
     
 
     """
     pass
 
 def createVirialPressurePlugin():
-    r"""createVirialPressurePlugin(state: MirState, name: str, pv: ParticleVectors.ParticleVector, regionFunc: Callable[[real3], float], h: real3, dump_every: int, path: str) -> Tuple[Plugins.SimulationPlugin, Plugins.PostprocessPlugin]
+    r"""createVirialPressurePlugin(state: MirState, name: str, pv: ParticleVectors.ParticleVector, regionFunc: function, h: real3, dump_every: int, path: str, vectorized: bool = False) -> Tuple[Plugins.SimulationPlugin, Plugins.PostprocessPlugin]
 
 
         This plugin computes the virial pressure from a given :any:`ParticleVector`.
@@ -682,6 +690,8 @@ def createVirialPressurePlugin():
             h: grid size for representing the predicate onto a grid
             dump_every: report total pressure every this many time-steps
             path: the folder name in which the file will be dumped
+            vectorized: if True, ``regionFunc`` is called with an array of positions of shape (N, 3) and must return N values
+                        (e.g. a function written with NumPy); this is much faster than calling it once per grid node.
     
 
     """
@@ -16,6 +16,21 @@ class Wall:
         As a result, its particles will not be removed from the inside of the wall.
     
 
+        """
+        pass
+
+    def useSdfCacheInBounce():
+        r"""useSdfCacheInBounce(enabled: bool) -> None
+
+
+        Allow the bounce to skip the particles that were far from the wall before integration,
+        from the SDF values cached by the other users of the wall before integration (e.g. :any:`createWallRepulsion`).
+        Enabled by default. The results do not depend on it; disabling it is only useful to check it.
+
+        Args:
+            enabled: if ``False``, the SDF is evaluated for all the particles of the boundary cells during the bounce
+    
+
         """
         pass
 
@@ -47,6 +62,72 @@ class Box(Wall):
         As a result, its particles will not be removed from the inside of the wall.
     
 
+        """
+        pass
+
+    def useSdfCacheInBounce():
+        r"""useSdfCacheInBounce(enabled: bool) -> None
+
+
+        Allow the bounce to skip the particles that were far from the wall before integration,
+        from the SDF values cached by the other users of the wall before integration (e.g. :any:`createWallRepulsion`).
+        Enabled by default. The results do not depend on it; disabling it is only useful to check it.
+
+        Args:
+            enabled: if ``False``, the SDF is evaluated for all the particles of the boundary cells during the bounce
+    
+
+        """
+        pass
+
+class Composite(Wall):
+    r"""
+        Combination of stationary walls by union, intersection and difference of their inside (where their SDF is positive).
+        The whole expression is evaluated at once: the particles are bounced once instead of once per wall,
+        and the walls are skipped away from their bounding box when possible (inside of spheres and cylinders).
+
+        The SDF of a union is the maximum of the SDFs of the operands, the one of an intersection is their minimum
+        and the one of a difference :math:`A \setminus B` is :math:`\min(\phi_A, -\phi_B)`.
+        The walls used in the expression must not be registered to the simulation.
+    
+    """
+    def __init__():
+        r"""__init__(name: str, expression: object) -> None
+
+
+            Args:
+                name: name of the wall
+                expression: a wall (:any:`Box`, :any:`Sphere`, :any:`Plane`, :any:`Cylinder` or :any:`SDF`),
+                   or a tuple whose first element is ``"union"``, ``"intersection"`` or ``"difference"``
+                   and the others are (at least two) expressions, e.g. ``("difference", block, ("union", channel, chamber))``
+        
+
+        """
+        pass
+
+    def attachFrozenParticles():
+        r"""attachFrozenParticles(arg0: ParticleVectors.ParticleVector) -> None
+
+
+        Let the wall know that the following :any:`ParticleVector` should be treated as frozen.
+        As a result, its particles will not be removed from the inside of the wall.
+    
+
+        """
+        pass
+
+    def useSdfCacheInBounce():
+        r"""useSdfCacheInBounce(enabled: bool) -> None
+
+
+        Allow the bounce to skip the particles that were far from the wall before integration,
+        from the SDF values cached by the other users of the wall before integration (e.g. :any:`createWallRepulsion`).
+        Enabled by default. The results do not depend on it; disabling it is only useful to check it.
+
+        Args:
+            enabled: if ``False``, the SDF is evaluated for all the particles of the boundary cells during the bounce
+    
+
         """
         pass
 
@@ -78,6 +159,21 @@ class Cylinder(Wall):
         As a result, its particles will not be removed from the inside of the wall.
     
 
+        """
+        pass
+
+    def useSdfCacheInBounce():
+        r"""useSdfCacheInBounce(enabled: bool) -> None
+
+
+        Allow the bounce to skip the particles that were far from the wall before integration,
+        from the SDF values cached by the other users of the wall before integration (e.g. :any:`createWallRepulsion`).
+        Enabled by default. The results do not depend on it; disabling it is only useful to check it.
+
+        Args:
+            enabled: if ``False``, the SDF is evaluated for all the particles of the boundary cells during the bounce
+    
+
         """
         pass
 
@@ -110,6 +206,86 @@ class MovingPlane(Wall):
         As a result, its particles will not be removed from the inside of the wall.
     
 
+        """
+        pass
+
+    def useSdfCacheInBounce():
+        r"""useSdfCacheInBounce(enabled: bool) -> None
+
+
+        Allow the bounce to skip the particles that were far from the wall before integration,
+        from the SDF values cached by the other users of the wall before integration (e.g. :any:`createWallRepulsion`).
+        Enabled by default. The results do not depend on it; disabling it is only useful to check it.
+
+        Args:
+            enabled: if ``False``, the SDF is evaluated for all the particles of the boundary cells during the bounce
+    
+
+        """
+        pass
+
+class MovingSDF(Wall):
+    r"""
+        Wall based on a Signed Distance Function read from a ``.sdf`` file (see :any:`SDF`), moving rigidly in time.
+        The motion is made of a translation and a rotation around a center moving with the translation:
+
+        .. math::
+            \mathbf{u}(\mathbf{r}, t) = s(t) \left( \mathbf{v} + \mathbf{\omega} \times (\mathbf{r} - \mathbf{c}(t)) \right),
+
+        where :math:`s(t) = cos(2 \pi t / T)` if the period :math:`T` is positive, and :math:`s(t) = 1` otherwise.
+
+        The SDF is sampled only once; the moved shape is evaluated by transforming the positions back to the
+        initial frame of the shape, so that moving walls cost about the same as stationary ones.
+        The file describes the shape at time 0. Every rank stores the SDF on the whole domain.
+        Distances to the center of rotation follow the minimum image convention:
+        a rotating shape should be kept away from the domain boundaries.
+
+        .. note::
+            The frozen particles of the wall must be moved with a :any:`RigidMotion` integrator with the same motion parameters.
+    
+    """
+    def __init__():
+        r"""__init__(name: str, sdfFilename: str, h: real3 = real3(0.25, 0.25, 0.25), velocity: real3 = real3(0.0, 0.0, 0.0), omega: real3 = real3(0.0, 0.0, 0.0), center: real3 = real3(0.0, 0.0, 0.0), period: float = 0.0, narrow_band_width: float = 0.0, interpolation: str = 'linear') -> None
+
+
+            Args:
+                name: name of the wall
+                sdfFilename: name of the ``.sdf`` file, describing the shape at time 0
+                h: resolution of the resampled SDF (see :any:`SDF`)
+                velocity: translation velocity (amplitude if **period** is positive)
+                omega: angular velocity (amplitude if **period** is positive)
+                center: center of rotation at time 0
+                period: oscillation period of the motion; the motion is constant if not positive
+                narrow_band_width: see :any:`SDF`
+                interpolation: see :any:`SDF`
+        
+
+        """
+        pass
+
+    def attachFrozenParticles():
+        r"""attachFrozenParticles(arg0: ParticleVectors.ParticleVector) -> None
+
+
+        Let the wall know that the following :any:`ParticleVector` should be treated as frozen.
+        As a result, its particles will not be removed from the inside of the wall.
+    
+
+        """
+        pass
+
+    def useSdfCacheInBounce():
+        r"""useSdfCacheInBounce(enabled: bool) -> None
+
+
+        Allow the bounce to skip the particles that were far from the wall before integration,
+        from the SDF values cached by the other users of the wall before integration (e.g. :any:`createWallRepulsion`).
+        Enabled by default. The results do not depend on it; disabling it is only useful to check it.
+
+        Args:
+            enabled: if ``False``, the SDF is evaluated for all the particles of the boundary cells during the bounce
+    
+
         """
         pass
 
@@ -144,6 +320,21 @@ class OscillatingPlane(Wall):
         As a result, its particles will not be removed from the inside of the wall.
     
 
+        """
+        pass
+
+    def useSdfCacheInBounce():
+        r"""useSdfCacheInBounce(enabled: bool) -> None
+
+
+        Allow the bounce to skip the particles that were far from the wall before integration,
+        from the SDF values cached by the other users of the wall before integration (e.g. :any:`createWallRepulsion`).
+        Enabled by default. The results do not depend on it; disabling it is only useful to check it.
+
+        Args:
+            enabled: if ``False``, the SDF is evaluated for all the particles of the boundary cells during the bounce
+    
+
         """
         pass
 
@@ -174,6 +365,21 @@ class Plane(Wall):
         As a result, its particles will not be removed from the inside of the wall.
     
 
+        """
+        pass
+
+    def useSdfCacheInBounce():
+        r"""useSdfCacheInBounce(enabled: bool) -> None
+
+
+        Allow the bounce to skip the particles that were far from the wall before integration,
+        from the SDF values cached by the other users of the wall before integration (e.g. :any:`createWallRepulsion`).
+        Enabled by default. The results do not depend on it; disabling it is only useful to check it.
+
+        Args:
+            enabled: if ``False``, the SDF is evaluated for all the particles of the boundary cells during the bounce
+    
+
         """
         pass
 
@@ -206,6 +412,21 @@ class RotatingCylinder(Wall):
         As a result, its particles will not be removed from the inside of the wall.
     
 
+        """
+        pass
+
+    def useSdfCacheInBounce():
+        r"""useSdfCacheInBounce(enabled: bool) -> None
+
+
+        Allow the bounce to skip the particles that were far from the wall before integration,
+        from the SDF values cached by the other users of the wall before integration (e.g. :any:`createWallRepulsion`).
+        Enabled by default. The results do not depend on it; disabling it is only useful to check it.
+
+        Args:
+            enabled: if ``False``, the SDF is evaluated for all the particles of the boundary cells during the bounce
+    
+
         """
         pass
 
@@ -223,7 +444,7 @@ class SDF(Wall):
     
     """
     def __init__():
-        r"""__init__(name: str, sdfFilename: str, h: real3 = real3(0.25, 0.25, 0.25)) -> None
+        r"""__init__(name: str, sdfFilename: str, h: real3 = real3(0.25, 0.25, 0.25), narrow_band_width: float = 0.0, interpolation: str = 'linear') -> None
 
 
             Args:
@@ -232,6 +453,12 @@ class SDF(Wall):
                 h: resolution of the resampled SDF.
                    In order to have a more accurate SDF representation, the initial function is resampled on a finer grid.
                    The lower this value is, the more accurate the wall will be represented, however, the  more memory it will consume and the slower the execution will be.
+                narrow_band_width: if positive, the resampled SDF is only stored in bricks of :math:`8^3` grid cells
+                   where its magnitude is smaller than this value; elsewhere it is clamped to plus or minus this value.
+                   This reduces the memory footprint of fine SDFs in large domains.
+                   Must be larger than the wall thickness and the cutoff radius of the interactions with the frozen particles.
+                interpolation: interpolation of the resampled SDF, ``"linear"`` (trilinear) or ``"cubic"`` (tricubic Catmull-Rom).
+                   The cubic interpolation is smoother and gives analytic gradients, which allows a coarser ``h`` for the same accuracy.
         
 
         """
@@ -245,6 +472,21 @@ class SDF(Wall):
         As a result, its particles will not be removed from the inside of the wall.
     
 
+        """
+        pass
+
+    def useSdfCacheInBounce():
+        r"""useSdfCacheInBounce(enabled: bool) -> None
+
+
+        Allow the bounce to skip the particles that were far from the wall before integration,
+        from the SDF values cached by the other users of the wall before integration (e.g. :any:`createWallRepulsion`).
+        Enabled by default. The results do not depend on it; disabling it is only useful to check it.
+
+        Args:
+            enabled: if ``False``, the SDF is evaluated for all the particles of the boundary cells during the bounce
+    
+
         """
         pass
 
@@ -279,4 +521,19 @@ class Sphere(Wall):
         """
         pass
 
+    def useSdfCacheInBounce():
+        r"""useSdfCacheInBounce(enabled: bool) -> None
+
+
+        Allow the bounce to skip the particles that were far from the wall before integration,
+        from the SDF values cached by the other users of the wall before integration (e.g. :any:`createWallRepulsion`).
+        Enabled by default. The results do not depend on it; disabling it is only useful to check it.
+
+        Args:
+            enabled: if ``False``, the SDF is evaluated for all the particles of the boundary cells during the bounce
+    
+
+        """
+        pass
+
 
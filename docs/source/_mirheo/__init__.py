@@ -157,15 +157,17 @@ Args:
         pass
 
     def computeVolumeInsideWalls():
-        r"""computeVolumeInsideWalls(walls: List[mirheo::Wall], nSamplesPerRank: int = 100000) -> float
+        r"""computeVolumeInsideWalls(walls: List[mirheo::Wall], nSamplesPerRank: int = 100000, h: float = 0.0) -> float
 
 
                 Compute the volume inside the given walls in the whole domain (negative values are the 'inside' of the simulation).
-                The computation is made via simple Monte-Carlo.
+                The computation is made via simple Monte-Carlo, or by integrating the SDF on a grid if **h** is positive.
+                The grid integration is much more accurate for a given cost.
 
                 Args:
                     walls: sdf based walls
                     nSamplesPerRank: number of Monte-Carlo samples used per rank
+                    h: if positive, spacing of the grid used to integrate the SDF; Monte-Carlo sampling is used otherwise
         
 
         """
@@ -249,14 +251,14 @@ Returns ``True`` if the current rank is the root
         pass
 
     def makeFrozenWallParticles():
-        r"""makeFrozenWallParticles(pvName: str, walls: List[mirheo::Wall], interactions: List[mirheo::Interaction], integrator: mirheo::Integrator, number_density: float, mass: float = 1.0, nsteps: int = 1000) -> mirheo::ParticleVector
+        r"""makeFrozenWallParticles(pvName: str, walls: List[mirheo::Wall], interactions: List[mirheo::Interaction], integrator: mirheo::Integrator, number_density: float, mass: float = 1.0, nsteps: int = 1000, cache_folder: str = '') -> mirheo::ParticleVector
 
 
                 Create particles frozen inside the walls.
 
                 .. note::
                     A separate simulation will be run for every call to this function, which may take certain amount of time.
-                    If you want to save time, consider using restarting mechanism instead
+                    If you want to save time, consider using restarting mechanism instead, or a **cache_folder**
 
                 Args:
                     pvName: name of the created particle vector
@@ -266,9 +268,15 @@ Returns ``True`` if the current rank is the root
                     number_density: target particle number density
                     mass: the mass of a single frozen particle
                     nsteps: run this many steps to achieve equilibrium
+                    cache_folder: if not empty, the frozen particles are saved in this folder and reused by the next calls with the same
+                        wall geometry, domain decomposition, density, mass, number of steps, time step, integrator name
+                        and interaction names and cutoffs. Other interaction parameters are not part of the key:
+                        the folder must be cleared when they change.
 
                 Returns:
                     New :any:`ParticleVector` that will contain particles that are close to the wall boundary, but still inside the wall.
+                    The particles are static: their cell-lists and halo are built once per run,
+                    unless an integrator is set to them.
 
         
 
@@ -431,6 +439,29 @@ Register Plugins
         """
         pass
 
+    def setAdaptiveTimeStep():
+        r"""setAdaptiveTimeStep(dt_min: float, dt_max: float, max_displacement: float, max_growth: float = 1.1, every: int = 1) -> None
+
+
+                Let the time step follow the velocities and forces of the integrated particles.
+                The time step is set to the largest value such that no particle moves by more than ``max_displacement``
+                over one step, estimated from the maximum velocity :math:`v` and acceleration :math:`a`:
+                :math:`v \Delta t + a \Delta t^2 \leq \Delta x_{max}`.
+                It decreases immediately when needed, but increases by at most a factor ``max_growth`` per update.
+                Quantities depending on the time step, such as the DPD random force amplitudes, follow automatically.
+
+                Args:
+                    dt_min: lower bound of the time step
+                    dt_max: upper bound of the time step
+                    max_displacement: target maximum displacement of any particle over one time step;
+                        should not exceed the ``maximum_part_travel`` of the walls
+                    max_growth: the time step can increase at most by this factor per update
+                    every: the time step is updated every this number of time steps
+         
+
+        """
+        pass
+
     def setBouncer():
         r"""setBouncer(bouncer: mirheo::Bouncer, ov: mirheo::ObjectVector, pv: mirheo::ParticleVector) -> None
 
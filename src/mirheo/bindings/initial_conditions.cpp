@@ -5,10 +5,12 @@
 #include <mirheo/core/initial_conditions/from_array.h>
 #include <mirheo/core/initial_conditions/interface.h>
 #include <mirheo/core/initial_conditions/membrane.h>
+#include <mirheo/core/initial_conditions/membrane_with_parameter_scales.h>
 #include <mirheo/core/initial_conditions/membrane_with_type_ids.h>
 #include <mirheo/core/initial_conditions/restart.h>
 #include <mirheo/core/initial_conditions/rigid.h>
 #include <mirheo/core/initial_conditions/rod.h>
+#include <mirheo/core/initial_conditions/rod_with_parameter_scales.h>
 #include <mirheo/core/initial_conditions/uniform.h>
 #include <mirheo/core/initial_conditions/uniform_filtered.h>
 #include <mirheo/core/initial_conditions/uniform_sphere.h>
@@ -77,6 +79,30 @@ void exportInitialConditions(py::module& m)
                     can fill the space with high volume fraction
         )");
 
+    py::handlers_class<MembraneWithParameterScalesIC>(m, "MembraneWithParameterScales", pyMembraneIC, R"(
+        Same as :class:`~libmirheo.InitialConditions.Membrane` with an additional field attached to each membrane that scales its forces.
+        The membrane forces of :class:`~libmirheo.Interactions.MembraneForces` are multiplied by the corresponding scales of each membrane.
+        This allows to simulate many independent membranes with different properties in a single membrane vector, e.g. an ensemble of replicas in a parameter study.
+    )")
+        .def(py::init<const std::vector<ComQ>&, const std::vector<real4>&, real>(),
+             "com_q"_a, "scales"_a, "global_scale"_a=1.0, R"(
+            Args:
+                com_q:
+                    List describing location and rotation of the created objects.
+                    One entry in the list corresponds to one object created.
+                    Each entry consist of 7 reals: *<com_x> <com_y> <com_z>  <q_x> <q_y> <q_z> <q_w>*, where
+                    *com* is the center of mass of the object, *q* is the quaternion of its rotation,
+                    not necessarily normalized
+                scales:
+                    List of force scales, one entry per membrane.
+                    Each entry consists of 4 reals: *<shear> <bending> <constraints> <viscosity>*, which multiply
+                    respectively the shear (and local area) forces, the bending forces, the total area and volume constraint forces and the viscous forces.
+                    The fluctuation forces are multiplied by the square root of the viscosity scale.
+                global_scale:
+                    All the membranes will be scaled by that value. Useful to implement membranes growth so that they
+                    can fill the space with high volume fraction
+        )");
+
     py::handlers_class<RestartIC>(m, "Restart", pyic, R"(
         Read the state of the particle vector from restart files.
     )")
@@ -142,14 +168,41 @@ void exportInitialConditions(py::module& m)
         )");
 
 
-    py::handlers_class<RodIC>(m, "Rod", pyic, R"(
+    py::handlers_class<RodIC> pyRodIC(m, "Rod", pyic, R"(
         Can only be used with Rod Vector. These IC will initialize the particles of each rod
         according to the the given explicit center-line position aand torsion mapping and then
         the objects will be translated/rotated according to the provided initial conditions.
 
+    )");
+
+    pyRodIC.def(py::init<const std::vector<ComQ>&, std::function<real3(real)>, std::function<real(real)>, real, real3>(),
+                "com_q"_a, "center_line"_a, "torsion"_a, "a"_a, "initial_frame"_a=RodIC::DefaultFrame, R"(
+            Args:
+                com_q:
+                    List describing location and rotation of the created objects.
+                    One entry in the list corresponds to one object created.
+                    Each entry consist of 7 reals: *<com_x> <com_y> <com_z>  <q_x> <q_y> <q_z> <q_w>*, where
+                    *com* is the center of mass of the object, *q* is the quaternion of its rotation,
+                    not necessarily normalized
+                center_line:
+                    explicit mapping :math:`\mathbf{r} : [0,1] \rightarrow R^3`.
+                    Assume :math:`|r'(s)|` is constant for all :math:`s \in [0,1]`.
+                torsion:
+                    explicit mapping :math:`\tau : [0,1] \rightarrow R`.
+                a:
+                    width of the rod
+                initial_frame:
+                    Orientation of the initial frame (optional)
+                    By default, will come up with any orthogonal frame to the rod at origin
+        )");
+
+    py::handlers_class<RodWithParameterScalesIC>(m, "RodWithParameterScales", pyRodIC, R"(
+        Same as :class:`~libmirheo.InitialConditions.Rod` with an additional field attached to each rod that scales its forces.
+        The forces of :class:`~libmirheo.Interactions.RodForces` are multiplied by the corresponding scales of each rod.
+        This allows to have rods with different elastic properties in a single rod vector.
     )")
-        .def(py::init<const std::vector<ComQ>&, std::function<real3(real)>, std::function<real(real)>, real, real3>(),
-             "com_q"_a, "center_line"_a, "torsion"_a, "a"_a, "initial_frame"_a=RodIC::DefaultFrame, R"(
+        .def(py::init<const std::vector<ComQ>&, const std::vector<real3>&, std::function<real3(real)>, std::function<real(real)>, real, real3>(),
+             "com_q"_a, "scales"_a, "center_line"_a, "torsion"_a, "a"_a, "initial_frame"_a=RodIC::DefaultFrame, R"(
             Args:
                 com_q:
                     List describing location and rotation of the created objects.
@@ -157,6 +210,11 @@ void exportInitialConditions(py::module& m)
                     Each entry consist of 7 reals: *<com_x> <com_y> <com_z>  <q_x> <q_y> <q_z> <q_w>*, where
                     *com* is the center of mass of the object, *q* is the quaternion of its rotation,
                     not necessarily normalized
+                scales:
+                    List of force scales, one entry per rod.
+                    Each entry consists of 3 reals: *<bounds> <bending> <twist>*, which multiply
+                    respectively the bound spring constants, the bending tensor and the twist coefficient.
+                    The curvature smoothing forces of the polymorphic states are multiplied by the bending scale.
                 center_line:
                     explicit mapping :math:`\mathbf{r} : [0,1] \rightarrow R^3`.
                     Assume :math:`|r'(s)|` is constant for all :math:`s \in [0,1]`.
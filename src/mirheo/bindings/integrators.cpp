@@ -1,6 +1,7 @@
 // Copyright 2020 ETH Zurich. All Rights Reserved.
 #include <mirheo/core/integrators/factory.h>
 #include <mirheo/core/interactions/interface.h>
+#include <mirheo/core/interactions/rod/base_rod.h>
 
 #include "bindings.h"
 #include "class_wrapper.h"
@@ -57,6 +58,22 @@ void exportIntegrators(py::module& m)
                     period: oscillation period :math:`T`
             )");
 
+    py::handlers_class<IntegratorRigidMotion>(m, "RigidMotion", pyint, R"(
+        Move particles rigidly regardless of the forces acting on them, with the motion of a :any:`MovingSDF` wall:
+        a translation and a rotation around a center moving with the translation, constant or oscillating in time.
+        The positions follow the exact transform of the wall, so that its frozen particles stay attached to it.
+    )")
+        .def(py::init(&integrator_factory::createRigidMotion),
+             "state"_a, "name"_a, "velocity"_a = real3{0, 0, 0}, "omega"_a = real3{0, 0, 0},
+             "center"_a = real3{0, 0, 0}, "period"_a = 0.0, R"(
+                Args:
+                    name: name of the integrator
+                    velocity: translation velocity (amplitude if **period** is positive)
+                    omega: angular velocity (amplitude if **period** is positive)
+                    center: center of rotation at time 0
+                    period: oscillation period of the motion; the motion is constant if not positive
+            )");
+
     py::handlers_class<IntegratorVVRigid>(m, "RigidVelocityVerlet", pyint, R"(
         Integrate the position and rotation (in terms of quaternions) of the rigid bodies as per Velocity-Verlet scheme.
         Can only applied to :any:`RigidObjectVector` or :any:`RigidEllipsoidVector`.
@@ -91,9 +108,12 @@ void exportIntegrators(py::module& m)
             where bold symbol means a vector, :math:`m` is a particle mass, and superscripts denote the time: :math:`\mathbf{x}^{k} = \mathbf{x}(k \, \Delta t)`
         )")
         .def(py::init(&integrator_factory::createVV),
-             "state"_a, "name"_a, R"(
+             "state"_a, "name"_a, "reset_forces"_a=false, R"(
                 Args:
                     name: name of the integrator
+                    reset_forces: if True, the forces are set to zero while integrating instead of in a separate step
+                                  before the next force computation. Only for particle vectors that are not object vectors;
+                                  the forces are then not available after integration, e.g. to plugins.
             )");
 
     py::handlers_class<IntegratorVV<ForcingTermConstDP>>
@@ -105,11 +125,14 @@ void exportIntegrators(py::module& m)
                 \mathbf{a}^{n} &= \frac{1}{m} \left( \mathbf{F}(\mathbf{x}^{n}, \mathbf{v}^{n-1/2}) + \mathbf{F}_{extra} \right) \\
         )")
         .def(py::init(&integrator_factory::createVV_constDP),
-             "state"_a, "name"_a, "force"_a, R"(
+             "state"_a, "name"_a, "force"_a, "reset_forces"_a=false, R"(
 
                 Args:
                     name: name of the integrator
                     force: :math:`\mathbf{F}_{extra}`
+                    reset_forces: if True, the forces are set to zero while integrating instead of in a separate step
+                                  before the next force computation. Only for particle vectors that are not object vectors;
+                                  the forces are then not available after integration, e.g. to plugins.
             )");
 
     py::handlers_class<IntegratorVV<ForcingTermPeriodicPoiseuille>>
@@ -120,7 +143,7 @@ void exportIntegrators(py::module& m)
             with force :math:`-F_{Poiseuille}`
         )")
         .def(py::init(&integrator_factory::createVV_PeriodicPoiseuille),
-             "state"_a, "name"_a, "force"_a, "direction"_a, R"(
+             "state"_a, "name"_a, "force"_a, "direction"_a, "reset_forces"_a=false, R"(
                 Args:
                     name: name of the integrator
                     force: force magnitude, :math:`F_{Poiseuille}`
@@ -128,6 +151,35 @@ void exportIntegrators(py::module& m)
                                if direction is \"x\", the sign changes along \"y\".
                                if direction is \"y\", the sign changes along \"z\".
                                if direction is \"z\", the sign changes along \"x\".
+                    reset_forces: if True, the forces are set to zero while integrating instead of in a separate step
+                                  before the next force computation. Only for particle vectors that are not object vectors;
+                                  the forces are then not available after integration, e.g. to plugins.
+            )");
+
+    py::handlers_class<IntegratorRodConstraints>
+        (m, "RodConstraints", pyint, R"(
+            Advance rods with the velocity-Verlet scheme and enforce the lengths between the particles of each segment
+            (center line and material frame) with SHAKE iterations.
+            This replaces the stiff bound forces of :any:`RodForces`, which usually restrict the time step.
+            The velocities are set to the constrained displacements divided by the time step.
+
+            Optionally, the time step can be split into sub steps, similarly to :any:`SubStep`:
+            the fast forces (e.g. the bending and twist forces of the rod) are updated at every sub step
+            while the other forces are kept constant.
+        )")
+        .def(py::init(&integrator_factory::createRodConstraints),
+             "state"_a, "name"_a, "rod_forces"_a, "nIterations"_a=10, "substeps"_a=1,
+             "fastForces"_a=std::vector<Interaction*>(), R"(
+                Args:
+                    name: name of the integrator
+                    rod_forces: the :any:`RodForces` of the rods; its equilibrium lengths ``a0`` and ``l0`` define the constraints
+                    nIterations: number of SHAKE iterations per (sub) time step
+                    substeps: number of sub steps
+                    fastForces: a list of fast interactions. Only accepts :any:`RodForces`
+
+                .. warning::
+                    The fast interactions must not be registered to the simulation.
+                    The bound stiffnesses ``k_s_center`` and ``k_s_frame`` of the rod interactions should be set to zero.
             )");
 
     py::handlers_class<IntegratorSubStep>
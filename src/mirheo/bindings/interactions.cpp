@@ -6,6 +6,7 @@
 #include <mirheo/core/interactions/interface.h>
 #include <mirheo/core/interactions/membrane/base_membrane.h>
 #include <mirheo/core/interactions/obj_rod_binding.h>
+#include <mirheo/core/interactions/rigid_contact.h>
 #include <mirheo/core/interactions/rod/base_rod.h>
 
 #include "bindings.h"
@@ -425,6 +426,9 @@ void exportInteractions(py::module& m)
                  The interaction will be applied membranes with a given **type_id** (see :class:`~libmirheo.InitialConditions.MembraneWithTypeId`)
 
                  * **type_id**: the type id that the interaction applies to
+
+             If the membranes were initialized with per-membrane scales (see :class:`~libmirheo.InitialConditions.MembraneWithParameterScales`),
+             the forces of each membrane are multiplied by its own scales.
     )");
 
 
@@ -443,6 +447,36 @@ void exportInteractions(py::module& m)
     )");
 
 
+    py::handlers_class<RigidContactInteraction> pyRigidContact(m, "RigidContact", pyInt, R"(
+        Short range contact and lubrication forces between rigid objects with analytical shapes
+        (see :any:`RigidCapsuleVector`, :any:`RigidCylinderVector` and :any:`RigidEllipsoidVector`).
+
+        The forces are computed from the positions, orientations and velocities of the objects and their analytical shapes,
+        without using the frozen particles.
+        This prevents overlaps in dense suspensions of objects that are represented by few particles.
+
+        For each pair of objects, the closest points of the surfaces define the gap :math:`h` and the normal :math:`\mathbf{n}`.
+        The force acting on the objects along :math:`\mathbf{n}` is the sum of
+
+        * a contact force :math:`k_c (h_c - h)`, active when :math:`h < h_c`;
+        * a lubrication force :math:`6 \pi \mu R^2 \left( \frac{1}{\max(h, h_{min})} - \frac{1}{h_l} \right) v_n`, active when :math:`h < h_l`,
+          where :math:`v_n` is the normal relative velocity at the contact point and :math:`R` is the reduced radius at the contact point.
+
+        The forces and torques are added to the rigid motions of the objects.
+    )");
+
+    pyRigidContact.def(py::init(&interaction_factory::createInteractionRigidContact),
+                       "state"_a, "name"_a, "k_contact"_a, "contact_distance"_a,
+                       "viscosity"_a=0.0_r, "lubrication_distance"_a=0.0_r, "min_gap"_a=1e-3_r, R"(
+            Args:
+                name: name of the interaction
+                k_contact: stiffness of the contact force :math:`k_c`
+                contact_distance: gap :math:`h_c` below which the contact force is active
+                viscosity: viscosity of the solvent :math:`\mu` for the lubrication force
+                lubrication_distance: gap :math:`h_l` below which the lubrication force is active
+                min_gap: regularization gap :math:`h_{min}` of the lubrication force
+    )");
+
     py::handlers_class<BaseRodInteraction> pyRodForces(m, "RodForces", pyInt, R"(
         Forces acting on an elastic rod.
 
@@ -510,6 +544,9 @@ void exportInteractions(py::module& m)
              The interaction can support multiple polymorphic states if **kappa0**, **tau0** and **E0** are lists of equal size.
              In this case, the **E0** parameter is required.
              Only lists of 1, 2 and 11 states are supported.
+
+             If the rods were initialized with per-rod scales (see :class:`~libmirheo.InitialConditions.RodWithParameterScales`),
+             the forces of each rod are multiplied by its own scales.
     )");
 }
 
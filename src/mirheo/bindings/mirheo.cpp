@@ -292,6 +292,23 @@ Args:
                     maximum_part_travel: maximum distance that one particle travels in one time step.
                         this should be as small as possible for performance reasons but large enough for correctness
          )")
+        .def("setAdaptiveTimeStep", &Mirheo::setAdaptiveTimeStep,
+             "dt_min"_a, "dt_max"_a, "max_displacement"_a, "max_growth"_a=1.1_r, "every"_a=1, R"(
+                Let the time step follow the velocities and forces of the integrated particles.
+                The time step is set to the largest value such that no particle moves by more than ``max_displacement``
+                over one step, estimated from the maximum velocity :math:`v` and acceleration :math:`a`:
+                :math:`v \Delta t + a \Delta t^2 \leq \Delta x_{max}`.
+                It decreases immediately when needed, but increases by at most a factor ``max_growth`` per update.
+                Quantities depending on the time step, such as the DPD random force amplitudes, follow automatically.
+
+                Args:
+                    dt_min: lower bound of the time step
+                    dt_max: upper bound of the time step
+                    max_displacement: target maximum displacement of any particle over one time step;
+                        should not exceed the ``maximum_part_travel`` of the walls
+                    max_growth: the time step can increase at most by this factor per update
+                    every: the time step is updated every this number of time steps
+         )")
         .def("getState",       &Mirheo::getMirState,    "Return mirheo state")
 
         .def("dumpWalls2XDMF",    &Mirheo::dumpWalls2XDMF,
@@ -305,13 +322,15 @@ Args:
         )")
 
         .def("computeVolumeInsideWalls", &Mirheo::computeVolumeInsideWalls,
-            "walls"_a, "nSamplesPerRank"_a=100000, R"(
+            "walls"_a, "nSamplesPerRank"_a=100000, "h"_a=0.0_r, R"(
                 Compute the volume inside the given walls in the whole domain (negative values are the 'inside' of the simulation).
-                The computation is made via simple Monte-Carlo.
+                The computation is made via simple Monte-Carlo, or by integrating the SDF on a grid if **h** is positive.
+                The grid integration is much more accurate for a given cost.
 
                 Args:
                     walls: sdf based walls
                     nSamplesPerRank: number of Monte-Carlo samples used per rank
+                    h: if positive, spacing of the grid used to integrate the SDF; Monte-Carlo sampling is used otherwise
         )")
 
         .def("applyObjectBelongingChecker",    &Mirheo::applyObjectBelongingChecker,
@@ -334,12 +353,13 @@ Args:
         )")
 
         .def("makeFrozenWallParticles", &Mirheo::makeFrozenWallParticles,
-             "pvName"_a, "walls"_a, "interactions"_a, "integrator"_a, "number_density"_a, "mass"_a=1.0_r, "nsteps"_a=1000, R"(
+             "pvName"_a, "walls"_a, "interactions"_a, "integrator"_a, "number_density"_a, "mass"_a=1.0_r, "nsteps"_a=1000,
+             "cache_folder"_a="", R"(
                 Create particles frozen inside the walls.
 
                 .. note::
                     A separate simulation will be run for every call to this function, which may take certain amount of time.
-                    If you want to save time, consider using restarting mechanism instead
+                    If you want to save time, consider using restarting mechanism instead, or a **cache_folder**
 
                 Args:
                     pvName: name of the created particle vector
@@ -349,9 +369,15 @@ Args:
                     number_density: target particle number density
                     mass: the mass of a single frozen particle
                     nsteps: run this many steps to achieve equilibrium
+                    cache_folder: if not empty, the frozen particles are saved in this folder and reused by the next calls with the same
+                        wall geometry, domain decomposition, density, mass, number of steps, time step, integrator name
+                        and interaction names and cutoffs. Other interaction parameters are not part of the key:
+                        the folder must be cleared when they change.
 
                 Returns:
                     New :any:`ParticleVector` that will contain particles that are close to the wall boundary, but still inside the wall.
+                    The particles are static: their cell-lists and halo are built once per run,
+                    unless an integrator is set to them.
 
         )")
 
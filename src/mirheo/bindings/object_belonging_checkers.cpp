@@ -32,6 +32,36 @@ void exportObjectBelongingCheckers(py::module& m)
                 name: name of the checker
         )");
 
+    py::handlers_class<MeshGridBelongingChecker>(m, "MeshGrid", pycheck, R"(
+        This checker will use the triangular mesh associated with objects to detect *inside*-*outside* status.
+        The generalized winding number of each object is evaluated on a coarse regular grid covering the object;
+        particles are classified from the grid, except close to the surface where the exact winding number is computed.
+        This is much faster than :any:`Mesh` for meshes with many triangles, and supports deformable objects.
+
+        .. note:
+            The grid spacing must be smaller than the thinnest parts of the objects.
+    )")
+        .def(py::init<const MirState*, std::string, int>(),
+             "state"_a, "name"_a, "grid_size"_a=16, R"(
+            Args:
+                name: name of the checker
+                grid_size: number of grid nodes along each direction of an object
+        )");
+
+    py::handlers_class<MeshWindingNumberBelongingChecker>(m, "MeshWindingNumber", pycheck, R"(
+        This checker will use the triangular mesh associated with objects to detect *inside*-*outside* status.
+        The generalized winding number of the mesh is computed for each particle, using a hierarchy of the triangles
+        in which groups of triangles far from the particle are approximated by their dipole.
+        Unlike :any:`Mesh`, the result is robust to meshes with small holes or self intersections, e.g. after large deformations.
+    )")
+        .def(py::init<const MirState*, std::string, real, int>(),
+             "state"_a, "name"_a, "far_field_ratio"_a=2.0, "leaf_size"_a=8, R"(
+            Args:
+                name: name of the checker
+                far_field_ratio: groups of triangles are approximated when their distance to the particle is larger than this ratio times their radius
+                leaf_size: maximum number of triangles in the leaves of the hierarchy
+        )");
+
     py::handlers_class<ShapeBelongingChecker<Capsule>>(m, "Capsule", pycheck, R"(
         This checker will use the analytical representation of the capsule to detect *inside*-*outside* status.
     )")
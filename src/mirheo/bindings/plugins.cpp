@@ -3,16 +3,48 @@
 #include <pybind11/numpy.h>
 #include <pybind11/functional.h>
 
+#include <mirheo/core/logger.h>
 #include <mirheo/plugins/factory.h>
 
 #include "bindings.h"
 #include "class_wrapper.h"
 
+#include <algorithm>
+
 namespace mirheo
 {
 
 using namespace pybind11::literals;
 
+/** Convert a python scalar field to a FieldBatchFunction.
+    If vectorized, the function takes an array of N positions with shape (N, 3) and returns N values;
+    otherwise it is called once per position.
+ */
+static FieldBatchFunction toFieldBatchFunction(const py::function& func, bool vectorized)
+{
+    if (!vectorized)
+        return makeSerialFieldBatchFunction(func.cast<FieldFunction>());
+
+    static_assert(sizeof(real3) == 3 * sizeof(real), "positions are passed to python as a contiguous array");
+    using ValuesArray = py::array_t<real, py::array::c_style | py::array::forcecast>;
+
+    auto batchFunc = func.cast<std::function<py::object(py::array_t<real>)>>();
+
+    return [batchFunc](int n, const real3 *positions, real *values)
+    {
+        py::gil_scoped_acquire gil;
+
+        const py::array_t<real> r({static_cast<py::ssize_t>(n), static_cast<py::ssize_t>(3)},
+                                  reinterpret_cast<const real*>(positions));
+        const auto v = ValuesArray::ensure(batchFunc(r));
+
+        if (!v || v.size() != n)
+            die("The vectorized field function must return an array of %d values", n);
+
+        std::copy(v.data(), v.data() + n, values);
+    };
+}
+
 void exportPlugins(py::module& m)
 {
     py::handlers_class<SimulationPlugin>  pysim(m, "SimulationPlugin", R"(
@@ -87,10 +119,20 @@ void exportPlugins(py::module& m)
         (*) Exactly one of ``kBT`` and ``T`` must be set.
     )");
 
-    m.def("__createDensityControl", &plugin_factory::createDensityControlPlugin,
+    m.def("__createDensityControl", [](bool computeTask, const MirState *state, std::string name, std::string fname,
+                                       std::vector<ParticleVector*> pvs, real targetDensity,
+                                       const py::function& region, real3 resolution,
+                                       real levelLo, real levelHi, real levelSpace, real Kp, real Ki, real Kd,
+                                       int tuneEvery, int dumpEvery, int sampleEvery, bool vectorized)
+    {
+        return plugin_factory::createDensityControlPlugin(computeTask, state, std::move(name), std::move(fname), std::move(pvs),
+                                                          targetDensity, toFieldBatchFunction(region, vectorized), resolution,
+                                                          levelLo, levelHi, levelSpace, Kp, Ki, Kd,
+                                                          tuneEvery, dumpEvery, sampleEvery);
+    },
           "compute_task"_a, "state"_a, "name"_a, "file_name"_a, "pvs"_a, "target_density"_a,
           "region"_a, "resolution"_a, "level_lo"_a, "level_hi"_a, "level_space"_a,
-          "Kp"_a, "Ki"_a, "Kd"_a, "tune_every"_a, "dump_every"_a, "sample_every"_a, R"(
+          "Kp"_a, "Ki"_a, "Kd"_a, "tune_every"_a, "dump_every"_a, "sample_every"_a, "vectorized"_a = false, R"(
         This plugin applies forces to a set of particle vectors in order to get a constant density.
 
         Args:
@@ -108,11 +150,19 @@ void exportPlugins(py::module& m)
             tune_every: update the forces every this amount of time steps
             dump_every: dump densities and forces in file ``filename``
             sample_every: sample to average densities every this amount of time steps
+            vectorized: if True, ``region`` is called with an array of positions of shape (N, 3) and must return N values
+                        (e.g. a function written with NumPy); this is much faster than calling it once per grid node.
     )");
 
-    m.def("__createDensityOutlet", &plugin_factory::createDensityOutletPlugin,
+    m.def("__createDensityOutlet", [](bool computeTask, const MirState *state, std::string name,
+                                      std::vector<ParticleVector*> pvs, real numberDensity,
+                                      const py::function& region, real3 resolution, bool vectorized)
+    {
+        return plugin_factory::createDensityOutletPlugin(computeTask, state, std::move(name), std::move(pvs), numberDensity,
+                                                         toFieldBatchFunction(region, vectorized), resolution);
+    },
           "compute_task"_a, "state"_a, "name"_a, "pvs"_a, "number_density"_a,
-          "region"_a, "resolution"_a, R"(
+          "region"_a, "resolution"_a, "vectorized"_a = false, R"(
         This plugin removes particles from a set of :any:`ParticleVector` in a given region if the number density is larger than a given target.
 
         Args:
@@ -121,6 +171,8 @@ void exportPlugins(py::module& m)
             number_density: maximum number_density in the region
             region: a function that is negative in the concerned region and positive outside
             resolution: grid resolution to represent the region field
+            vectorized: if True, ``region`` is called with an array of positions of shape (N, 3) and must return N values
+                        (e.g. a function written with NumPy); this is much faster than calling it once per grid node.
 
     )");
 
@@ -134,9 +186,15 @@ void exportPlugins(py::module& m)
             plane: Tuple (a, b, c, d). Particles are removed if `ax + by + cz + d >= 0`.
     )");
 
-    m.def("__createRateOutlet", &plugin_factory::createRateOutletPlugin,
+    m.def("__createRateOutlet", [](bool computeTask, const MirState *state, std::string name,
+                                   std::vector<ParticleVector*> pvs, real rate,
+                                   const py::function& region, real3 resolution, bool vectorized)
+    {
+        return plugin_factory::createRateOutletPlugin(computeTask, state, std::move(name), std::move(pvs), rate,
+                                                      toFieldBatchFunction(region, vectorized), resolution);
+    },
           "compute_task"_a, "state"_a, "name"_a, "pvs"_a, "mass_rate"_a,
-          "region"_a, "resolution"_a, R"(
+          "region"_a, "resolution"_a, "vectorized"_a = false, R"(
         This plugin removes particles from a set of :any:`ParticleVector` in a given region at a given mass rate.
 
         Args:
@@ -145,6 +203,8 @@ void exportPlugins(py::module& m)
             mass_rate: total outlet mass rate in the region
             region: a function that is negative in the concerned region and positive outside
             resolution: grid resolution to represent the region field
+            vectorized: if True, ``region`` is called with an array of positions of shape (N, 3) and must return N values
+                        (e.g. a function written with NumPy); this is much faster than calling it once per grid node.
 
     )");
 
@@ -519,9 +579,17 @@ void exportPlugins(py::module& m)
             Kp, Ki, Kd: PID controller coefficients
     )");
 
-    m.def("__createVelocityInlet", &plugin_factory::createVelocityInletPlugin,
+    m.def("__createVelocityInlet", [](bool computeTask, const MirState *state, std::string name, ParticleVector *pv,
+                                      const py::function& implicitSurface, std::function<real3(real3)> velocityField,
+                                      real3 resolution, real numberDensity, real kBT, bool vectorized)
+    {
+        return plugin_factory::createVelocityInletPlugin(computeTask, state, std::move(name), pv,
+                                                         toFieldBatchFunction(implicitSurface, vectorized), std::move(velocityField),
+                                                         resolution, numberDensity, kBT);
+    },
           "compute_task"_a, "state"_a, "name"_a, "pv"_a,
-          "implicit_surface_func"_a, "velocity_field"_a, "resolution"_a, "number_density"_a, "kBT"_a, R"(
+          "implicit_surface_func"_a, "velocity_field"_a, "resolution"_a, "number_density"_a, "kBT"_a,
+          "vectorized"_a = false, R"(
         This plugin inserts particles in a given :any:`ParticleVector`.
         The particles are inserted on a given surface with given velocity inlet.
         The rate of insertion is governed by the velocity and the given number density.
@@ -534,10 +602,19 @@ void exportPlugins(py::module& m)
             resolution: grid size used to discretize the surface
             number_density: number density of the inserted solvent
             kBT: temperature of the inserted solvent
-    )");
-
-    m.def("__createVirialPressurePlugin", &plugin_factory::createVirialPressurePlugin,
-          "compute_task"_a, "state"_a, "name"_a, "pv"_a, "regionFunc"_a, "h"_a, "dump_every"_a, "path"_a, R"(
+            vectorized: if True, ``implicit_surface_func`` is called with an array of positions of shape (N, 3) and must return N values
+                        (e.g. a function written with NumPy); it is then called once per plane of grid nodes.
+    )");
+
+    m.def("__createVirialPressurePlugin", [](bool computeTask, const MirState *state, std::string name, ParticleVector *pv,
+                                             const py::function& regionFunc, real3 h, int dumpEvery, std::string path,
+                                             bool vectorized)
+    {
+        return plugin_factory::createVirialPressurePlugin(computeTask, state, std::move(name), pv,
+                                                          toFieldBatchFunction(regionFunc, vectorized), h, dumpEvery, std::move(path));
+    },
+          "compute_task"_a, "state"_a, "name"_a, "pv"_a, "regionFunc"_a, "h"_a, "dump_every"_a, "path"_a,
+          "vectorized"_a = false, R"(
         This plugin computes the virial pressure from a given :any:`ParticleVector`.
         Note that the stress computation must be enabled with the corresponding stressName.
         This returns the total internal virial part only (no temperature term).
@@ -550,6 +627,8 @@ void exportPlugins(py::module& m)
             h: grid size for representing the predicate onto a grid
             dump_every: report total pressure every this many time-steps
             path: the folder name in which the file will be dumped
+            vectorized: if True, ``regionFunc`` is called with an array of positions of shape (N, 3) and must return N values
+                        (e.g. a function written with NumPy); this is much faster than calling it once per grid node.
     )");
 
     m.def("__createWallRepulsion", &plugin_factory::createWallRepulsionPlugin,
@@ -2,6 +2,7 @@
 #include "bindings.h"
 #include "class_wrapper.h"
 
+#include <mirheo/core/logger.h>
 #include <mirheo/core/walls/factory.h>
 
 namespace mirheo
@@ -9,6 +10,38 @@ namespace mirheo
 
 using namespace pybind11::literals;
 
+/// convert a wall or a tuple (operation, operand, operand, ...) to a composite wall expression
+static CompositeWallExpression toCompositeWallExpression(const py::handle& obj)
+{
+    using Operation = CompositeWallExpression::Operation;
+
+    if (py::isinstance<Wall>(obj))
+        return {Operation::Wall, obj.cast<std::shared_ptr<Wall>>(), {}};
+
+    if (!py::isinstance<py::tuple>(obj) && !py::isinstance<py::list>(obj))
+        die("Composite wall: expected a wall or a tuple (operation, operands...), got '%s'",
+            std::string(py::str(obj)).c_str());
+
+    const auto items = obj.cast<py::sequence>();
+    if (items.size() < 1)
+        die("Composite wall: got an empty expression");
+
+    const auto opName = items[0].cast<std::string>();
+    CompositeWallExpression expression;
+
+    if      (opName == "union")        expression.operation = Operation::Union;
+    else if (opName == "intersection") expression.operation = Operation::Intersection;
+    else if (opName == "difference")   expression.operation = Operation::Difference;
+    else
+        die("Composite wall: unknown operation '%s'; choose from 'union', 'intersection' or 'difference'",
+            opName.c_str());
+
+    for (size_t i = 1; i < items.size(); ++i)
+        expression.children.push_back(toCompositeWallExpression(items[i]));
+
+    return expression;
+}
+
 void exportWalls(py::module& m)
 {
     py::handlers_class<Wall> pywall(m, "Wall", R"(
@@ -20,6 +53,21 @@ void exportWalls(py::module& m)
         As a result, its particles will not be removed from the inside of the wall.
     )");
 
+    pywall.def("useSdfCacheInBounce", [](Wall& wall, bool enabled)
+    {
+        auto sdfWall = dynamic_cast<SDFBasedWall*>(&wall);
+        if (sdfWall == nullptr)
+            die("Wall '%s' does not cache SDF values", wall.getCName());
+        sdfWall->useSdfCacheInBounce(enabled);
+    }, "enabled"_a, R"(
+        Allow the bounce to skip the particles that were far from the wall before integration,
+        from the SDF values cached by the other users of the wall before integration (e.g. :any:`createWallRepulsion`).
+        Enabled by default. The results do not depend on it; disabling it is only useful to check it.
+
+        Args:
+            enabled: if ``False``, the SDF is evaluated for all the particles of the boundary cells during the bounce
+    )");
+
     py::handlers_class< SimpleStationaryWall<StationaryWallBox> >(m, "Box", pywall, R"(
         Rectangular cuboid wall with edges aligned with the coordinate axes.
 
@@ -83,13 +131,41 @@ void exportWalls(py::module& m)
         The boundary is defined by the zero-level isosurface.
     )")
         .def(py::init(&wall_factory::createSDFWall),
-            "state"_a, "name"_a, "sdfFilename"_a, "h"_a = real3{0.25, 0.25, 0.25}, R"(
+            "state"_a, "name"_a, "sdfFilename"_a, "h"_a = real3{0.25, 0.25, 0.25}, "narrow_band_width"_a = 0.0,
+            "interpolation"_a = "linear", R"(
             Args:
                 name: name of the wall
                 sdfFilename: name of the ``.sdf`` file
                 h: resolution of the resampled SDF.
                    In order to have a more accurate SDF representation, the initial function is resampled on a finer grid.
                    The lower this value is, the more accurate the wall will be represented, however, the  more memory it will consume and the slower the execution will be.
+                narrow_band_width: if positive, the resampled SDF is only stored in bricks of :math:`8^3` grid cells
+                   where its magnitude is smaller than this value; elsewhere it is clamped to plus or minus this value.
+                   This reduces the memory footprint of fine SDFs in large domains.
+                   Must be larger than the wall thickness and the cutoff radius of the interactions with the frozen particles.
+                interpolation: interpolation of the resampled SDF, ``"linear"`` (trilinear) or ``"cubic"`` (tricubic Catmull-Rom).
+                   The cubic interpolation is smoother and gives analytic gradients, which allows a coarser ``h`` for the same accuracy.
+        )");
+
+    py::handlers_class< SimpleStationaryWall<StationaryWallComposite> >(m, "Composite", pywall, R"(
+        Combination of stationary walls by union, intersection and difference of their inside (where their SDF is positive).
+        The whole expression is evaluated at once: the particles are bounced once instead of once per wall,
+        and the walls are skipped away from their bounding box when possible (inside of spheres and cylinders).
+
+        The SDF of a union is the maximum of the SDFs of the operands, the one of an intersection is their minimum
+        and the one of a difference :math:`A \setminus B` is :math:`\min(\phi_A, -\phi_B)`.
+        The walls used in the expression must not be registered to the simulation.
+    )")
+        .def(py::init([](const MirState *state, const std::string& name, py::object expression)
+        {
+            return wall_factory::createCompositeWall(state, name, toCompositeWallExpression(expression));
+        }),
+            "state"_a, "name"_a, "expression"_a, R"(
+            Args:
+                name: name of the wall
+                expression: a wall (:any:`Box`, :any:`Sphere`, :any:`Plane`, :any:`Cylinder` or :any:`SDF`),
+                   or a tuple whose first element is ``"union"``, ``"intersection"`` or ``"difference"``
+                   and the others are (at least two) expressions, e.g. ``("difference", block, ("union", channel, chamber))``
         )");
 
     py::handlers_class< WallWithVelocity<StationaryWallCylinder, VelocityFieldRotate> >(m, "RotatingCylinder", pywall, R"(
@@ -135,6 +211,40 @@ void exportWalls(py::module& m)
                 velocity: velocity amplitude, should be orthogonal to the normal
                 period: oscillation period dpd time units
         )");
+
+    py::handlers_class<MovingSDFWall>(m, "MovingSDF", pywall, R"(
+        Wall based on a Signed Distance Function read from a ``.sdf`` file (see :any:`SDF`), moving rigidly in time.
+        The motion is made of a translation and a rotation around a center moving with the translation:
+
+        .. math::
+            \mathbf{u}(\mathbf{r}, t) = s(t) \left( \mathbf{v} + \mathbf{\omega} \times (\mathbf{r} - \mathbf{c}(t)) \right),
+
+        where :math:`s(t) = cos(2 \pi t / T)` if the period :math:`T` is positive, and :math:`s(t) = 1` otherwise.
+
+        The SDF is sampled only once; the moved shape is evaluated by transforming the positions back to the
+        initial frame of the shape, so that moving walls cost about the same as stationary ones.
+        The file describes the shape at time 0. Every rank stores the SDF on the whole domain.
+        Distances to the center of rotation follow the minimum image convention:
+        a rotating shape should be kept away from the domain boundaries.
+
+        .. note::
+            The frozen particles of the wall must be moved with a :any:`RigidMotion` integrator with the same motion parameters.
+    )")
+        .def(py::init(&wall_factory::createMovingSDFWall),
+            "state"_a, "name"_a, "sdfFilename"_a, "h"_a = real3{0.25, 0.25, 0.25},
+            "velocity"_a = real3{0, 0, 0}, "omega"_a = real3{0, 0, 0}, "center"_a = real3{0, 0, 0}, "period"_a = 0.0,
+            "narrow_band_width"_a = 0.0, "interpolation"_a = "linear", R"(
+            Args:
+                name: name of the wall
+                sdfFilename: name of the ``.sdf`` file, describing the shape at time 0
+                h: resolution of the resampled SDF (see :any:`SDF`)
+                velocity: translation velocity (amplitude if **period** is positive)
+                omega: angular velocity (amplitude if **period** is positive)
+                center: center of rotation at time 0
+                period: oscillation period of the motion; the motion is constant if not positive
+                narrow_band_width: see :any:`SDF`
+                interpolation: see :any:`SDF`
+        )");
 }
 
 } // namespace mirheo
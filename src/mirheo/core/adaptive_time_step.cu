@@ -0,0 +1,104 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#include "adaptive_time_step.h"
+
+#include <mirheo/core/logger.h>
+#include <mirheo/core/pvs/particle_vector.h>
+#include <mirheo/core/pvs/views/pv.h>
+#include <mirheo/core/utils/cuda_common.h>
+#include <mirheo/core/utils/kernel_launch.h>
+#include <mirheo/core/utils/mpi_types.h>
+
+namespace mirheo
+{
+
+namespace adaptive_time_step_kernels
+{
+
+__global__ void maxVelocityAcceleration(PVview view, float *maxima)
+{
+    const int tid = blockIdx.x * blockDim.x + threadIdx.x;
+
+    real vel = 0.0_r, acc = 0.0_r;
+
+    if (tid < view.size)
+    {
+        vel = length(make_real3(view.readVelocity(tid)));
+        acc = length(make_real3(view.forces[tid])) * view.invMass;
+    }
+
+    vel = warpReduce(vel, [](real a, real b) { return math::max(a, b); });
+    acc = warpReduce(acc, [](real a, real b) { return math::max(a, b); });
+
+    // the magnitudes are non negative: their ordering is the one of their bit patterns
+    if (laneId() == 0)
+    {
+        atomicMax(reinterpret_cast<int*>(maxima + 0), __float_as_int(static_cast<float>(vel)));
+        atomicMax(reinterpret_cast<int*>(maxima + 1), __float_as_int(static_cast<float>(acc)));
+    }
+}
+
+} // namespace adaptive_time_step_kernels
+
+AdaptiveTimeStep::AdaptiveTimeStep(AdaptiveTimeStepParams params) :
+    params_(params)
+{
+    if (params_.dtMin <= 0.0_r || params_.dtMax < params_.dtMin)
+        die("Adaptive time step: the bounds must satisfy 0 < dtMin <= dtMax, got %g and %g",
+            params_.dtMin, params_.dtMax);
+
+    if (params_.maxDisplacement <= 0.0_r)
+        die("Adaptive time step: the maximum displacement must be positive, got %g", params_.maxDisplacement);
+
+    if (params_.maxGrowth < 1.0_r)
+        die("Adaptive time step: the maximum growth factor must be at least 1, got %g", params_.maxGrowth);
+
+    if (params_.every <= 0)
+        die("Adaptive time step: the update period must be positive, got %d", params_.every);
+}
+
+AdaptiveTimeStep::~AdaptiveTimeStep() = default;
+
+const AdaptiveTimeStepParams& AdaptiveTimeStep::getParams() const
+{
+    return params_;
+}
+
+void AdaptiveTimeStep::reduceLocal(const std::vector<ParticleVector*>& pvs, cudaStream_t stream)
+{
+    maxima_.clear(stream);
+
+    for (auto pv : pvs)
+    {
+        const PVview view(pv, pv->local());
+        const int nthreads = 128;
+
+        SAFE_KERNEL_LAUNCH(
+            adaptive_time_step_kernels::maxVelocityAcceleration,
+            getNblocks(view.size, nthreads), nthreads, 0, stream,
+            view, maxima_.devPtr() );
+    }
+
+    maxima_.downloadFromDevice(stream, ContainersSynch::Asynch);
+}
+
+real AdaptiveTimeStep::computeTimeStep(real dt, MPI_Comm comm)
+{
+    MPI_Check( MPI_Allreduce(MPI_IN_PLACE, maxima_.hostPtr(), 2, MPI_FLOAT, MPI_MAX, comm) );
+
+    const real vmax = static_cast<real>(maxima_[0]);
+    const real amax = static_cast<real>(maxima_[1]);
+    const real dx   = params_.maxDisplacement;
+
+    // positive root of amax dt^2 + vmax dt = dx, written to avoid cancellation
+    const real denominator = vmax + math::sqrt(vmax * vmax + 4.0_r * amax * dx);
+    real newDt = denominator > 0.0_r ? 2.0_r * dx / denominator : params_.dtMax;
+
+    newDt = math::min(newDt, params_.maxGrowth * dt);
+    newDt = math::min(math::max(newDt, params_.dtMin), params_.dtMax);
+
+    debug("Adaptive time step: max velocity %g, max acceleration %g, dt %g -> %g", vmax, amax, dt, newDt);
+
+    return newDt;
+}
+
+} // namespace mirheo
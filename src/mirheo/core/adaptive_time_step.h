@@ -0,0 +1,69 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include <mirheo/core/containers.h>
+#include <mirheo/core/datatypes.h>
+
+#include <mpi.h>
+#include <vector>
+
+namespace mirheo
+{
+
+class ParticleVector;
+
+/// Parameters of the AdaptiveTimeStep controller
+struct AdaptiveTimeStepParams
+{
+    real dtMin;           ///< lower bound of the time step
+    real dtMax;           ///< upper bound of the time step
+    real maxDisplacement; ///< target maximum displacement of any particle over one time step
+    real maxGrowth;       ///< the time step can increase at most by this factor per update (it decreases without limit)
+    int every;            ///< the time step is updated every this number of time steps
+};
+
+/** \brief Choose the time step from the current velocities and accelerations of the particles.
+
+    The time step is the largest one such that no particle moves by more than a given distance over one step,
+    \f$ |\mathbf{v}| \Delta t + |\mathbf{f}| / m \, \Delta t^2 \leq \Delta x_{max} \f$,
+    where the maximum velocity and acceleration are reduced over all the given particle vectors and all ranks.
+    It is then limited in growth and clamped to the given bounds.
+
+    Quantities depending on the time step (e.g. the DPD random force amplitudes) are recomputed
+    from MirState::dt at every step by the objects that use them.
+ */
+class AdaptiveTimeStep
+{
+public:
+    /** \brief Construct an AdaptiveTimeStep controller.
+        \param [in] params The parameters of the controller; dies if they are not consistent.
+     */
+    AdaptiveTimeStep(AdaptiveTimeStepParams params);
+    ~AdaptiveTimeStep();
+
+    /// \return The parameters of the controller
+    const AdaptiveTimeStepParams& getParams() const;
+
+    /** \brief Compute the local maximum velocity and acceleration of the particles.
+        \param [in] pvs The particle vectors to consider; their velocities and forces must be up to date
+        \param [in] stream The execution stream; the result is downloaded asynchronously
+
+        Meant to be executed between the force computation and the integration.
+     */
+    void reduceLocal(const std::vector<ParticleVector*>& pvs, cudaStream_t stream);
+
+    /** \brief Compute the new time step from the result of the last reduceLocal().
+        \param [in] dt The current time step
+        \param [in] comm The communicator used to reduce the maxima over all ranks
+        \return The new time step
+
+        The stream passed to reduceLocal() must have been synchronized.
+     */
+    real computeTimeStep(real dt, MPI_Comm comm);
+
+private:
+    AdaptiveTimeStepParams params_;
+    PinnedBuffer<float> maxima_ {2}; ///< maximum velocity and acceleration magnitudes
+};
+
+} // namespace mirheo
@@ -0,0 +1,108 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include <mirheo/core/containers.h>
+#include <mirheo/core/logger.h>
+
+#include <string>
+
+namespace mirheo
+{
+
+/** \brief Storage of a collision table whose capacity follows the number of collisions.
+
+    The device tables (see CollisionTable) count all the collisions, even those that do not fit in the storage.
+    After each kernel launch, downloadAndCheck() fetches the number of collisions; if the table overflowed,
+    the capacity is increased and the caller must launch the kernel again.
+
+    The memory is released only when the number of collisions stays well below the capacity for several
+    consecutive launches, so that the table is not reallocated at every time step.
+
+    \tparam T Information type of one collision
+ */
+template <typename T>
+class AdaptiveCollisionTable
+{
+public:
+    static constexpr int minCapacity = 128;          ///< the capacity never goes below that
+    static constexpr double growthFactor = 1.5;      ///< capacity relative to the number of collisions after a resize
+    static constexpr double shrinkThreshold = 4.0;   ///< the table is underused if capacity > shrinkThreshold * collisions
+    static constexpr int nStepsBeforeShrink = 100;   ///< number of consecutive underused launches before shrinking
+
+    /** \brief Construct an empty AdaptiveCollisionTable
+        \param [in] name Name of the table, used for logging
+        \param [in] initialCapacity The number of collisions that can be stored before the first resize
+     */
+    AdaptiveCollisionTable(std::string name = "collisions", int initialCapacity = 1024) :
+        name_(std::move(name)),
+        capacity_(initialCapacity > minCapacity ? initialCapacity : minCapacity)
+    {}
+
+    /// Reset the number of collisions and make sure the storage has the current capacity
+    void clear(cudaStream_t stream)
+    {
+        if (shrinkPending_)
+        {
+            collisionTable_ = DeviceBuffer<T>();
+            shrinkPending_ = false;
+        }
+        collisionTable_.resize_anew(capacity_);
+        nCollisions_.clear(stream);
+    }
+
+    int capacity() const {return capacity_;}            ///< \return The maximum number of collisions that can be stored
+    int size() const {return nCollisions_[0];}          ///< \return The number of collisions found in the last launch; valid after downloadAndCheck()
+    int* devCounter() {return nCollisions_.devPtr();}   ///< \return Device pointer to the number of collisions
+    T* devPtr() {return collisionTable_.devPtr();}      ///< \return Device pointer to the collisions
+
+    /** \brief Download the number of collisions and adapt the capacity.
+        \param [in] stream The stream used to download the number of collisions (synchronized)
+        \return \c true if all the collisions were stored; otherwise, the capacity is increased and the kernel filling
+                the table must be launched again after clear().
+     */
+    bool downloadAndCheck(cudaStream_t stream)
+    {
+        nCollisions_.downloadFromDevice(stream);
+        const int n = nCollisions_[0];
+
+        if (n > capacity_)
+        {
+            const int newCapacity = static_cast<int>(growthFactor * static_cast<double>(n));
+            debug("Collision table '%s' overflowed (%d collisions, capacity %d): retrying with capacity %d",
+                  name_.c_str(), n, capacity_, newCapacity);
+            capacity_ = newCapacity;
+            nStepsUnderused_ = 0;
+            return false;
+        }
+
+        if (static_cast<double>(n) * shrinkThreshold < static_cast<double>(capacity_) && capacity_ > minCapacity)
+        {
+            if (++nStepsUnderused_ >= nStepsBeforeShrink)
+            {
+                const int newCapacity = static_cast<int>(growthFactor * static_cast<double>(n));
+                capacity_ = newCapacity > minCapacity ? newCapacity : minCapacity;
+                // the current collisions are still in use; release the memory at the next clear()
+                shrinkPending_ = true;
+                nStepsUnderused_ = 0;
+                debug("Collision table '%s' shrunk to capacity %d", name_.c_str(), capacity_);
+            }
+        }
+        else
+        {
+            nStepsUnderused_ = 0;
+        }
+
+        return true;
+    }
+
+private:
+    std::string name_;
+    int capacity_;
+    int nStepsUnderused_ {0};
+    bool shrinkPending_ {false};
+
+    PinnedBuffer<int> nCollisions_ {1};
+    DeviceBuffer<T> collisionTable_;
+};
+
+} // namespace mirheo
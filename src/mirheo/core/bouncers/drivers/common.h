@@ -1,6 +1,9 @@
 // Copyright 2020 ETH Zurich. All Rights Reserved.
 #pragma once
 
+#include <mirheo/core/utils/cpu_gpu_defines.h>
+#include <mirheo/core/utils/helper_math.h>
+
 namespace mirheo
 {
 
@@ -27,25 +30,25 @@ struct CollisionTable
 
 
 template<typename T>
-__device__ static inline T fmin_vec(T v)
+__HD__ static inline T fmin_vec(T v)
 {
     return v;
 }
 
 template<typename T, typename... Args>
-__device__ static inline T fmin_vec(T v, Args... args)
+__HD__ static inline T fmin_vec(T v, Args... args)
 {
     return math::min(v, fmin_vec(args...));
 }
 
 template<typename T>
-__device__ static inline T fmax_vec(T v)
+__HD__ static inline T fmax_vec(T v)
 {
     return v;
 }
 
 template<typename T, typename... Args>
-__device__ static inline T fmax_vec(T v, Args... args)
+__HD__ static inline T fmax_vec(T v, Args... args)
 {
     return math::max(v, fmax_vec(args...));
 }
@@ -39,7 +39,7 @@ __device__ static inline Triangle readTriangle(const real4 *vertices, int startI
 
 
 
-__device__ static inline bool segmentTriangleQuickCheck(Triangle trNew, Triangle trOld, real3 xNew, real3 xOld)
+__HD__ static inline bool segmentTriangleQuickCheck(Triangle trNew, Triangle trOld, real3 xNew, real3 xOld)
 {
     const real3 v0 = trOld.v0;
     const real3 v1 = trOld.v1;
@@ -92,33 +92,73 @@ __device__ static inline bool segmentTriangleQuickCheck(Triangle trNew, Triangle
     return true;
 }
 
-__device__ static inline void findBouncesInCell(int pstart, int pend, int globTrid,
-                                                Triangle tr, Triangle trOld,
-                                                PVviewWithOldParticles pvView,
-                                                MeshView mesh, TriangleTable triangleTable)
+/// About maximum distance a particle can cover in one step
+constexpr real maxParticleDisplacement = 0.2_r;
+
+/// Margin added to the bounding boxes of the particle paths and swept triangles
+constexpr real sweptBoxMargin = 1e-3_r;
+
+/// Compute the bounding box of a triangle swept between its old and new positions
+__HD__ static inline void sweptTriangleBox(const Triangle& tr, const Triangle& trOld, real3& lo, real3& hi)
 {
+    lo = fmin_vec(trOld.v0, trOld.v1, trOld.v2, tr.v0, tr.v1, tr.v2);
+    hi = fmax_vec(trOld.v0, trOld.v1, trOld.v2, tr.v0, tr.v1, tr.v2);
+}
 
-#pragma unroll 2
-    for (int pid = pstart; pid < pend; pid++)
-    {
-        Particle p;
-        pvView.readPosition   (p,    pid);
-        const auto rOld = pvView.readOldPosition(pid);
+/// \return \c true if the two axis aligned boxes overlap
+__HD__ static inline bool boxesOverlap(real3 lo0, real3 hi0, real3 lo1, real3 hi1)
+{
+    return lo0.x <= hi1.x && lo1.x <= hi0.x
+        && lo0.y <= hi1.y && lo1.y <= hi0.y
+        && lo0.z <= hi1.z && lo1.z <= hi0.z;
+}
 
-        if (segmentTriangleQuickCheck(tr, trOld, p.r, rOld))
-            triangleTable.push_back({pid, globTrid});
-    }
+/** Call \p func for the linear index of every cell overlapping the swept box of a triangle,
+    inflated by the maximum particle displacement.
+ */
+template <class Func>
+__HD__ static inline void forEachTriangleCell(const CellListInfo& cinfo, real3 lo, real3 hi, Func func)
+{
+    const int3 cidLow  = cinfo.getCellIdAlongAxes(lo - maxParticleDisplacement);
+    const int3 cidHigh = cinfo.getCellIdAlongAxes(hi + maxParticleDisplacement);
+
+    int3 cid3;
+    for (cid3.z = cidLow.z; cid3.z <= cidHigh.z; cid3.z++)
+        for (cid3.y = cidLow.y; cid3.y <= cidHigh.y; cid3.y++)
+            for (cid3.x = cidLow.x; cid3.x <= cidHigh.x; cid3.x++)
+                func(cinfo.encode(cid3));
 }
 
-__global__ void findBouncesInMesh(OVviewWithNewOldVertices objView,
-                                  PVviewWithOldParticles pvView,
-                                  MeshView mesh, CellListInfo cinfo,
-                                  TriangleTable triangleTable)
+/** Count the number of triangles registered in each cell.
+    One THREAD per triangle.
+ */
+__global__ void countTrianglesPerCell(OVviewWithNewOldVertices objView, MeshView mesh,
+                                      CellListInfo cinfo, int *nTrianglesPerCell)
 {
-    // About maximum distance a particle can cover in one step
-    constexpr real tol = 0.2_r;
+    const int gid = blockIdx.x * blockDim.x + threadIdx.x;
+    const int objId = gid / mesh.ntriangles;
+    const int trid  = gid % mesh.ntriangles;
+    if (objId >= objView.nObjects) return;
+
+    const int3 triangle = mesh.triangles[trid];
+    const Triangle tr =    readTriangle(objView.vertices    , mesh.nvertices*objId, triangle);
+    const Triangle trOld = readTriangle(objView.old_vertices, mesh.nvertices*objId, triangle);
 
-    // One THREAD per triangle
+    real3 lo, hi;
+    sweptTriangleBox(tr, trOld, lo, hi);
+
+    forEachTriangleCell(cinfo, lo, hi, [&](int cid)
+    {
+        atomicAdd(nTrianglesPerCell + cid, 1);
+    });
+}
+
+/** Store the (global) triangle indices in the cells overlapped by their swept box.
+    One THREAD per triangle.
+ */
+__global__ void fillTriangleCells(OVviewWithNewOldVertices objView, MeshView mesh, CellListInfo cinfo,
+                                  const int *triangleCellStarts, int *triangleCellFill, int *triangleCells)
+{
     const int gid = blockIdx.x * blockDim.x + threadIdx.x;
     const int objId = gid / mesh.ntriangles;
     const int trid  = gid % mesh.ntriangles;
@@ -128,28 +168,65 @@ __global__ void findBouncesInMesh(OVviewWithNewOldVertices objView,
     const Triangle tr =    readTriangle(objView.vertices    , mesh.nvertices*objId, triangle);
     const Triangle trOld = readTriangle(objView.old_vertices, mesh.nvertices*objId, triangle);
 
-    const real3 lo = fmin_vec(trOld.v0, trOld.v1, trOld.v2, tr.v0, tr.v1, tr.v2);
-    const real3 hi = fmax_vec(trOld.v0, trOld.v1, trOld.v2, tr.v0, tr.v1, tr.v2);
+    real3 lo, hi;
+    sweptTriangleBox(tr, trOld, lo, hi);
 
-    const int3 cidLow  = cinfo.getCellIdAlongAxes(lo - tol);
-    const int3 cidHigh = cinfo.getCellIdAlongAxes(hi + tol);
+    forEachTriangleCell(cinfo, lo, hi, [&](int cid)
+    {
+        const int i = triangleCellStarts[cid] + atomicAdd(triangleCellFill + cid, 1);
+        triangleCells[i] = gid;
+    });
+}
 
-    int3 cid3;
-#pragma unroll 2
-    for (cid3.z = cidLow.z; cid3.z <= cidHigh.z; cid3.z++)
-        for (cid3.y = cidLow.y; cid3.y <= cidHigh.y; cid3.y++)
-            {
-                cid3.x = cidLow.x;
-                const int cidLo = math::max(cinfo.encode(cid3), 0);
+/** Find the candidate collisions between particles and triangles.
+    One THREAD per particle: only the triangles registered in the cell of the particle are checked.
+    Their swept bounding box must overlap with the particle path before the more expensive quick check.
+
+    The triangles are registered in all cells overlapping their swept box inflated by the maximum particle
+    displacement, so every particle crossing a triangle during the time step is in one of these cells at the
+    end of the time step.
+ */
+__global__ void findBouncesInTriangleCells(OVviewWithNewOldVertices objView,
+                                           PVviewWithOldParticles pvView,
+                                           MeshView mesh, CellListInfo cinfo,
+                                           const int *triangleCellStarts, const int *triangleCells,
+                                           TriangleTable triangleTable)
+{
+    const int pid = blockIdx.x * blockDim.x + threadIdx.x;
+    if (pid >= pvView.size) return;
+
+    Particle p;
+    pvView.readPosition(p, pid);
+    const real3 rOld = pvView.readOldPosition(pid);
+
+    const int cid = cinfo.getCellId(p.r);
+    const int start = triangleCellStarts[cid];
+    const int end   = triangleCellStarts[cid+1];
+
+    if (start == end) return;
+
+    const real3 plo = math::min(p.r, rOld) - sweptBoxMargin;
+    const real3 phi = math::max(p.r, rOld) + sweptBoxMargin;
 
-                cid3.x = cidHigh.x;
-                const int cidHi = math::min(cinfo.encode(cid3)+1, cinfo.totcells);
+    for (int i = start; i < end; ++i)
+    {
+        const int globTrid = triangleCells[i];
+        const int objId = globTrid / mesh.ntriangles;
+        const int trid  = globTrid % mesh.ntriangles;
+
+        const int3 triangle = mesh.triangles[trid];
+        const Triangle tr =    readTriangle(objView.vertices    , mesh.nvertices*objId, triangle);
+        const Triangle trOld = readTriangle(objView.old_vertices, mesh.nvertices*objId, triangle);
+
+        real3 lo, hi;
+        sweptTriangleBox(tr, trOld, lo, hi);
 
-                const int pstart = cinfo.cellStarts[cidLo];
-                const int pend   = cinfo.cellStarts[cidHi];
+        if (!boxesOverlap(plo, phi, lo, hi))
+            continue;
 
-                findBouncesInCell(pstart, pend, gid, tr, trOld, pvView, mesh, triangleTable);
-            }
+        if (segmentTriangleQuickCheck(tr, trOld, p.r, rOld))
+            triangleTable.push_back({pid, globTrid});
+    }
 }
 
 //=================================================================================================================
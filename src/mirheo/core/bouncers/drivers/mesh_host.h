@@ -0,0 +1,98 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include "mesh.h"
+
+#include <vector>
+
+namespace mirheo
+{
+
+namespace mesh_bounce_host
+{
+
+/** \brief Host implementation of the broad phase of the mesh bounce.
+    \param [in] cinfo The cell grid used to bin the swept triangles
+    \param [in] triangles The faces of the mesh
+    \param [in] nvertices The number of vertices of the mesh
+    \param [in] vertices The vertices of all objects at the end of the time step
+    \param [in] oldVertices The vertices of all objects at the beginning of the time step
+    \param [in] positions The particle positions at the end of the time step
+    \param [in] oldPositions The particle positions at the beginning of the time step
+    \return The candidate (particle index, global triangle index) pairs
+
+    Follows the same algorithm as the device version (mesh_bounce_kernels::findBouncesInTriangleCells),
+    with the candidates sorted by particle index.
+ */
+inline std::vector<int2> findBounceCandidates(const CellListInfo& cinfo,
+                                              const std::vector<int3>& triangles, int nvertices,
+                                              const std::vector<real3>& vertices,
+                                              const std::vector<real3>& oldVertices,
+                                              const std::vector<real3>& positions,
+                                              const std::vector<real3>& oldPositions)
+{
+    using namespace mesh_bounce_kernels;
+
+    const int ntriangles = static_cast<int>(triangles.size());
+    const int nObjects = static_cast<int>(vertices.size()) / nvertices;
+
+    auto getTriangle = [&](const std::vector<real3>& v, int objId, int3 t) -> Triangle
+    {
+        const int start = objId * nvertices;
+        return {v[start + t.x], v[start + t.y], v[start + t.z]};
+    };
+
+    std::vector<std::vector<int>> triangleCells(cinfo.totcells);
+
+    for (int objId = 0; objId < nObjects; ++objId)
+    {
+        for (int trid = 0; trid < ntriangles; ++trid)
+        {
+            const Triangle tr    = getTriangle(vertices,    objId, triangles[trid]);
+            const Triangle trOld = getTriangle(oldVertices, objId, triangles[trid]);
+
+            real3 lo, hi;
+            sweptTriangleBox(tr, trOld, lo, hi);
+
+            const int globTrid = objId * ntriangles + trid;
+            forEachTriangleCell(cinfo, lo, hi, [&](int cid)
+            {
+                triangleCells[cid].push_back(globTrid);
+            });
+        }
+    }
+
+    std::vector<int2> candidates;
+
+    for (size_t pid = 0; pid < positions.size(); ++pid)
+    {
+        const real3 r    = positions[pid];
+        const real3 rOld = oldPositions[pid];
+
+        const real3 plo = math::min(r, rOld) - sweptBoxMargin;
+        const real3 phi = math::max(r, rOld) + sweptBoxMargin;
+
+        const int cid = cinfo.getCellId(r);
+
+        for (int globTrid : triangleCells[cid])
+        {
+            const int objId = globTrid / ntriangles;
+            const int trid  = globTrid % ntriangles;
+
+            const Triangle tr    = getTriangle(vertices,    objId, triangles[trid]);
+            const Triangle trOld = getTriangle(oldVertices, objId, triangles[trid]);
+
+            real3 lo, hi;
+            sweptTriangleBox(tr, trOld, lo, hi);
+
+            if (boxesOverlap(plo, phi, lo, hi) && segmentTriangleQuickCheck(tr, trOld, r, rOld))
+                candidates.push_back({static_cast<int>(pid), globTrid});
+        }
+    }
+
+    return candidates;
+}
+
+} // namespace mesh_bounce_host
+
+} // namespace mirheo
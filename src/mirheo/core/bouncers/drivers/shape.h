@@ -42,10 +42,82 @@ __device__ static inline real3 rescue(real3 candidate, real dt, real tol, const
     return candidate;
 }
 
+/// Maximum distance travelled by the surface of a rotating object between two consecutive sub-steps
+constexpr real maxSubstepSweep = 0.1_r;
+
+/// Maximum number of sub-steps used to resolve the motion of a rotating object within one time step
+constexpr int maxSubsteps = 32;
+
+/** Rotation of an object within one time step, integrated from its angular velocity.
+    The rotation q(t) = c(t) R(t) q_old is composed of the rotation R(t) of angle t * |omega| dt about the
+    mean angular velocity of the step, and of a small correction c(t) (slerp from identity) that makes it
+    match the final orientation exactly.
+    Unlike a slerp between the old and new orientations, this follows objects that rotate by more than pi per
+    time step, for which the shortest arc between the two orientations is aliased.
+ */
+struct SubstepRotation
+{
+    real3 rotationVector; ///< mean angular velocity times the time step (world frame)
+    Quaternion<real> correction; ///< remaining rotation between the integrated and the final orientation
+
+    /// \return The total angle swept during the time step
+    __device__ inline real angle() const
+    {
+        return length(rotationVector) + Quaternion<real>::rotationAngle(Quaternion<real>::createFromComponents(1.0_r, 0.0_r, 0.0_r, 0.0_r), correction);
+    }
+};
+
+__device__ static inline Quaternion<real> rotationFromVector(real3 phi)
+{
+    const real angle = length(phi);
+    if (angle < 1e-6_r)
+        return Quaternion<real>::createFromComponents(1.0_r, 0.0_r, 0.0_r, 0.0_r);
+    return Quaternion<real>::createFromRotation(angle, phi / angle);
+}
+
+__device__ static inline SubstepRotation getSubstepRotation(const RealRigidMotion& oldMotion, const RealRigidMotion& motion, real dt)
+{
+    SubstepRotation rot;
+    rot.rotationVector = 0.5_r * dt * (oldMotion.omega + motion.omega);
+
+    const auto qIntegrated = rotationFromVector(rot.rotationVector) * oldMotion.q;
+    rot.correction = (motion.q * qIntegrated.conjugate()).normalized();
+
+    // the correction should be the smallest of the two equivalent quaternions
+    if (rot.correction.w < 0.0_r)
+        rot.correction *= -1.0_r;
+    return rot;
+}
+
+/** Number of sub-steps needed to resolve the rotation of an object within one time step.
+    This is 1 for objects that rotate slowly compared to their size, in which case the
+    motion in the object frame is well approximated by a straight line.
+    The angle is derived from the angular velocity, so that fast rotations (more than pi per step) are not aliased.
+ */
+__device__ static inline int getNumSubsteps(const RealRigidMotion& oldMotion, const RealRigidMotion& motion, real radius, real dt)
+{
+    const real theta = getSubstepRotation(oldMotion, motion, dt).angle();
+    const int n = 1 + static_cast<int>(theta * radius / maxSubstepSweep);
+    return math::min(n, maxSubsteps);
+}
+
+/// Interpolate the position and orientation of an object within a time step; \p t is in [0, 1]
+__device__ static inline RealRigidMotion interpolateMotion(const RealRigidMotion& oldMotion, const RealRigidMotion& motion,
+                                                           real t, real dt)
+{
+    const auto rot = getSubstepRotation(oldMotion, motion, dt);
+    const auto identity = Quaternion<real>::createFromComponents(1.0_r, 0.0_r, 0.0_r, 0.0_r);
+
+    RealRigidMotion m = motion;
+    m.r = oldMotion.r + t * (motion.r - oldMotion.r);
+    m.q = Quaternion<real>::slerp(identity, rot.correction, t) * rotationFromVector(t * rot.rotationVector) * oldMotion.q;
+    return m;
+}
+
 template <class Shape, class BounceKernel>
 __device__ static inline void bounceCellArray(
         const RSOVviewWithOldMotion<Shape>& ovView, PVviewWithOldParticles& pvView,
-        int objId, const int *validCells, int nCells,
+        int objId, int nSubsteps, const int *validCells, int nCells,
         CellListInfo cinfo, const real dt, const BounceKernel& bounceKernel)
 {
     const real threshold = 2e-5_r;
@@ -72,13 +144,17 @@ __device__ static inline void bounceCellArray(
         const real3 oldCoo = old_motion.q.inverseRotate(rOld - old_motion.r);
         const real3 dr = coo - oldCoo;
 
+        const bool endsInside = shape.inOutFunction(coo) <= 0.0_r;
+        const bool startsInside = shape.inOutFunction(oldCoo) <= 0.0_r;
+
         // If the particle is outside - skip it, it's fine
-        if (shape.inOutFunction(coo) > 0.0_r) continue;
+        // With sub-steps, a particle outside at both ends may still have crossed a fast rotating object
+        if (!endsInside && (nSubsteps == 1 || startsInside)) continue;
 
         real3 newCoo;
 
         // worst case scenario: was already inside before, we need to rescue the particle
-        if (shape.inOutFunction(oldCoo) <= 0.0_r)
+        if (startsInside)
         {
             newCoo = rescue(coo, dt, threshold, shape);
 
@@ -95,6 +171,43 @@ __device__ static inline void bounceCellArray(
                 newCoo = oldCoo;
             }
         }
+        // fast rotation: follow the particle in the frame of the moving object and find the first crossing
+        else if (nSubsteps > 1)
+        {
+            auto bodyCoordinates = [=] (real t)
+            {
+                const auto m = interpolateMotion(old_motion, motion, t, dt);
+                const real3 r = rOld + t * (p.r - rOld);
+                return m.q.inverseRotate(r - m.r);
+            };
+
+            constexpr root_finder::Bounds limits {0._r, 1._r};
+            const auto root = root_finder::firstRootSampled([=] (const real t) { return shape.inOutFunction(bodyCoordinates(t));},
+                                                            limits, nSubsteps);
+
+            // no crossing could be resolved: the particle only grazed the surface
+            if (root == root_finder::invalidRoot)
+            {
+                if (!endsInside) continue;
+                newCoo = rescue(coo, dt, threshold, shape);
+            }
+            else
+            {
+                newCoo = bodyCoordinates(max(root.x, limits.lo));
+                newCoo += threshold * shape.normal(newCoo);
+
+                if (shape.inOutFunction(newCoo) < 0.0_r)
+                {
+                    printf("Sub-stepped bounce-back failed on particle %ld (%g %g %g) (local: (%g %g %g)), %d sub-steps, t %f. Recovering to old position\n",
+                           p.getId(),
+                           p.r.x, p.r.y, p.r.z,
+                           coo.x, coo.y, coo.z,
+                           nSubsteps, root.x);
+
+                    newCoo = oldCoo;
+                }
+            }
+        }
         // otherwise find intersection and perform the bounce
         else
         {
@@ -144,7 +257,7 @@ __device__ static inline void bounceCellArray(
 }
 
 template <class Shape>
-__device__ static inline bool isValidCell(int3 cid3, const RealRigidMotion& motion, CellListInfo cinfo, const Shape& shape)
+__device__ static inline bool isValidCellAt(int3 cid3, const RealRigidMotion& motion, CellListInfo cinfo, const Shape& shape)
 {
     constexpr real threshold = 0.5_r;
 
@@ -170,6 +283,24 @@ __device__ static inline bool isValidCell(int3 cid3, const RealRigidMotion& moti
              shape.inOutFunction(v111) < threshold );
 }
 
+/// A cell is valid if it intersects the surface of the object at the end of the step or at any of the sub-steps
+template <class Shape>
+__device__ static inline bool isValidCell(int3 cid3, const RealRigidMotion& oldMotion, const RealRigidMotion& motion,
+                                          int nSubsteps, real dt, CellListInfo cinfo, const Shape& shape)
+{
+    if (isValidCellAt(cid3, motion, cinfo, shape))
+        return true;
+
+    // t = 0 (start of the step) to t = (n-1)/n; t = 1 is the end of the step, tested above
+    for (int k = 0; k < nSubsteps; ++k)
+    {
+        const real t = static_cast<real>(k) / static_cast<real>(nSubsteps);
+        if (isValidCellAt(cid3, interpolateMotion(oldMotion, motion, t, dt), cinfo, shape))
+            return true;
+    }
+    return false;
+}
+
 template <class Shape, class BounceKernel>
 __global__ void bounce(RSOVviewWithOldMotion<Shape> ovView, PVviewWithOldParticles pvView,
                        CellListInfo cinfo, const real dt, const BounceKernel bounceKernel)
@@ -191,8 +322,25 @@ __global__ void bounce(RSOVviewWithOldMotion<Shape> ovView, PVviewWithOldParticl
         nCells = 0;
     __syncthreads();
 
-    const int3 cidLow  = cinfo.getCellIdAlongAxes(ovView.comAndExtents[objId].low  - tol);
-    const int3 cidHigh = cinfo.getCellIdAlongAxes(ovView.comAndExtents[objId].high + tol);
+    const auto extent = ovView.comAndExtents[objId];
+    const real radius = length(max(extent.high - extent.com, extent.com - extent.low));
+
+    const auto motion    = toRealMotion(ovView.motions[objId]);
+    const auto oldMotion = toRealMotion(ovView.old_motions[objId]);
+    const int nSubsteps = getNumSubsteps(oldMotion, motion, radius, dt);
+
+    real3 lo = extent.low  - tol;
+    real3 hi = extent.high + tol;
+
+    // the object may stick out of its final bounding box at intermediate orientations
+    if (nSubsteps > 1)
+    {
+        lo = min(lo, extent.com - radius - tol);
+        hi = max(hi, extent.com + radius + tol);
+    }
+
+    const int3 cidLow  = cinfo.getCellIdAlongAxes(lo);
+    const int3 cidHigh = cinfo.getCellIdAlongAxes(hi);
 
     const int3 span = cidHigh - cidLow + make_int3(1,1,1);
     const int totCells = span.x * span.y * span.z;
@@ -204,7 +352,7 @@ __global__ void bounce(RSOVviewWithOldMotion<Shape> ovView, PVviewWithOldParticl
 
         if ( i < totCells &&
              cid < cinfo.totcells &&
-             isValidCell(cid3, toRealMotion(ovView.motions[objId]), cinfo, ovView.shape) )
+             isValidCell(cid3, oldMotion, motion, nSubsteps, dt, cinfo, ovView.shape) )
         {
             const int id = atomicAggInc(static_cast<int*>(&nCells));
             validCells[id] = cid;
@@ -215,7 +363,7 @@ __global__ void bounce(RSOVviewWithOldMotion<Shape> ovView, PVviewWithOldParticl
         // If we have enough cells ready - process them
         if (nCells >= blockDim.x)
         {
-            bounceCellArray(ovView, pvView, objId, validCells, blockDim.x, cinfo, dt, bounceKernel);
+            bounceCellArray(ovView, pvView, objId, nSubsteps, validCells, blockDim.x, cinfo, dt, bounceKernel);
 
             __syncthreads();
 
@@ -229,7 +377,7 @@ __global__ void bounce(RSOVviewWithOldMotion<Shape> ovView, PVviewWithOldParticl
     __syncthreads();
 
     // Process remaining
-    bounceCellArray(ovView, pvView, objId, validCells, nCells, cinfo, dt, bounceKernel);
+    bounceCellArray(ovView, pvView, objId, nSubsteps, validCells, nCells, cinfo, dt, bounceKernel);
 }
 
 } // namespace shape_bounce_kernels
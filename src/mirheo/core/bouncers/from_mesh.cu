@@ -10,6 +10,11 @@
 #include <mirheo/core/rigid/operations.h>
 #include <mirheo/core/utils/kernel_launch.h>
 
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wshadow"
+#include <extern/cub/cub/device/device_scan.cuh>
+#pragma GCC diagnostic pop
+
 namespace mirheo
 {
 
@@ -75,29 +80,19 @@ void BounceFromMesh::exec(ParticleVector *pv, CellList *cl, ParticleVectorLocali
 
     ov_->findExtentAndCOM(stream, locality);
 
-    const int totalTriangles = ov_->mesh->getNtriangles() * activeOV->getNumObjects();
-
-    // Set maximum possible number of _coarse_ and _fine_ collisions with triangles
-    // In case of crash, the estimate should be increased
-    const int maxCoarseCollisions = static_cast<int>(coarseCollisionsPerTri_ * static_cast<real>(totalTriangles));
-    coarseTable_.collisionTable.resize_anew(maxCoarseCollisions);
-    coarseTable_.nCollisions.clear(stream);
-    mesh_bounce_kernels::TriangleTable devCoarseTable { maxCoarseCollisions,
-                                                        coarseTable_.nCollisions.devPtr(),
-                                                        coarseTable_.collisionTable.devPtr() };
+    auto& tables = tables_[pv->getName()];
+    auto& coarseTable = tables.coarse;
+    auto& fineTable   = tables.fine;
 
-    const int maxFineCollisions = static_cast<int>(fineCollisionsPerTri_ * static_cast<real>(totalTriangles));
-    fineTable_.collisionTable.resize_anew(maxFineCollisions);
-    fineTable_.nCollisions.clear(stream);
-    mesh_bounce_kernels::TriangleTable devFineTable { maxFineCollisions,
-                                                      fineTable_.nCollisions.devPtr(),
-                                                      fineTable_.collisionTable.devPtr() };
+    auto makeDeviceTable = [](AdaptiveCollisionTable<int2>& table)
+    {
+        return mesh_bounce_kernels::TriangleTable { table.capacity(), table.devCounter(), table.devPtr() };
+    };
 
     // Setup collision times array. For speed and simplicity initial time will be 0,
     // and after the collisions detected its i-th element will be t_i-1.0_r, where 0 <= t_i <= 1
     // is the collision time, or 0 if no collision with the particle found
     collisionTimes_.resize_anew(pv->local()->size());
-    collisionTimes_.clear(stream);
 
     const int nthreads = 128;
 
@@ -115,34 +110,37 @@ void BounceFromMesh::exec(ParticleVector *pv, CellList *cl, ParticleVectorLocali
     PVviewWithOldParticles pvView(pv, pv->local());
 
     // Step 1, find all the candidate collisions
-    SAFE_KERNEL_LAUNCH(
-            mesh_bounce_kernels::findBouncesInMesh,
-            getNblocks(totalTriangles, nthreads), nthreads, 0, stream,
-            vertexView, pvView, ov_->mesh.get(), cl->cellInfo(), devCoarseTable );
+    _buildTriangleCellIndex(vertexView, cl->cellInfo(), stream);
+
+    // the tables count all collisions: on overflow, they are enlarged and the search is repeated
+    do {
+        coarseTable.clear(stream);
+
+        SAFE_KERNEL_LAUNCH(
+                mesh_bounce_kernels::findBouncesInTriangleCells,
+                getNblocks(pvView.size, nthreads), nthreads, 0, stream,
+                vertexView, pvView, ov_->mesh.get(), cl->cellInfo(),
+                triangleCellStarts_.devPtr(), triangleCells_.devPtr(), makeDeviceTable(coarseTable) );
 
-    coarseTable_.nCollisions.downloadFromDevice(stream);
-    debug("Found %d triangle collision candidates", coarseTable_.nCollisions[0]);
+    } while (!coarseTable.downloadAndCheck(stream));
 
-    if (coarseTable_.nCollisions[0] > maxCoarseCollisions)
-        die("Found too many triangle collision candidates (coarse) (%d, max %d),"
-            "something may be broken or you need to increase the estimate",
-            coarseTable_.nCollisions[0], maxCoarseCollisions);
+    debug("Found %d triangle collision candidates", coarseTable.size());
 
     // Step 2, filter the candidates
-    SAFE_KERNEL_LAUNCH(
-            mesh_bounce_kernels::refineCollisions,
-            getNblocks(coarseTable_.nCollisions[0], nthreads), nthreads, 0, stream,
-            vertexView, pvView, ov_->mesh.get(),
-            coarseTable_.nCollisions[0], devCoarseTable.indices,
-            devFineTable, collisionTimes_.devPtr() );
+    do {
+        fineTable.clear(stream);
+        collisionTimes_.clear(stream);
 
-    fineTable_.nCollisions.downloadFromDevice(stream);
-    debug("Found %d precise triangle collisions", fineTable_.nCollisions[0]);
+        SAFE_KERNEL_LAUNCH(
+                mesh_bounce_kernels::refineCollisions,
+                getNblocks(coarseTable.size(), nthreads), nthreads, 0, stream,
+                vertexView, pvView, ov_->mesh.get(),
+                coarseTable.size(), coarseTable.devPtr(),
+                makeDeviceTable(fineTable), collisionTimes_.devPtr() );
 
-    if (fineTable_.nCollisions[0] > maxFineCollisions)
-        die("Found too many triangle collisions (precise) (%d, max %d),"
-            "something may be broken or you need to increase the estimate",
-            fineTable_.nCollisions[0], maxFineCollisions);
+    } while (!fineTable.downloadAndCheck(stream));
+
+    debug("Found %d precise triangle collisions", fineTable.size());
 
     // Step 3, resolve the collisions
     mpark::visit([&](auto& bounceKernel)
@@ -151,9 +149,9 @@ void BounceFromMesh::exec(ParticleVector *pv, CellList *cl, ParticleVectorLocali
 
         SAFE_KERNEL_LAUNCH(
             mesh_bounce_kernels::performBouncingTriangle,
-            getNblocks(fineTable_.nCollisions[0], nthreads), nthreads, 0, stream,
+            getNblocks(fineTable.size(), nthreads), nthreads, 0, stream,
             vertexView, pvView, ov_->mesh.get(),
-            fineTable_.nCollisions[0], devFineTable.indices, collisionTimes_.devPtr(),
+            fineTable.size(), fineTable.devPtr(), collisionTimes_.devPtr(),
             getState()->dt, bounceKernel );
 
     }, varBounceKernel_);
@@ -171,4 +169,44 @@ void BounceFromMesh::exec(ParticleVector *pv, CellList *cl, ParticleVectorLocali
     }
 }
 
+void BounceFromMesh::_buildTriangleCellIndex(const OVviewWithNewOldVertices& vertexView, const CellListInfo& cinfo,
+                                             cudaStream_t stream)
+{
+    const int nthreads = 128;
+    const int totalTriangles = vertexView.nObjects * ov_->mesh->getNtriangles();
+    const MeshView mesh(ov_->mesh.get());
+
+    nTrianglesPerCell_ .resize_anew(cinfo.totcells + 1);
+    triangleCellStarts_.resize_anew(cinfo.totcells + 1);
+    nTrianglesPerCell_.clear(stream);
+
+    SAFE_KERNEL_LAUNCH(
+            mesh_bounce_kernels::countTrianglesPerCell,
+            getNblocks(totalTriangles, nthreads), nthreads, 0, stream,
+            vertexView, mesh, cinfo, nTrianglesPerCell_.devPtr() );
+
+    size_t bufSize = 0;
+    cub::DeviceScan::ExclusiveSum(nullptr, bufSize, nTrianglesPerCell_.devPtr(), triangleCellStarts_.devPtr(),
+                                  cinfo.totcells + 1, stream);
+    if (bufSize > scanBuffer_.size())
+        scanBuffer_.resize_anew(bufSize);
+    cub::DeviceScan::ExclusiveSum(scanBuffer_.devPtr(), bufSize, nTrianglesPerCell_.devPtr(), triangleCellStarts_.devPtr(),
+                                  cinfo.totcells + 1, stream);
+
+    CUDA_Check( cudaMemcpyAsync(nTriangleCellEntries_.devPtr(), triangleCellStarts_.devPtr() + cinfo.totcells,
+                                sizeof(int), cudaMemcpyDeviceToDevice, stream) );
+    nTriangleCellEntries_.downloadFromDevice(stream);
+
+    debug("Registered %d triangles in %d cell entries for the mesh bounce", totalTriangles, nTriangleCellEntries_[0]);
+
+    triangleCells_.resize_anew(nTriangleCellEntries_[0]);
+    nTrianglesPerCell_.clear(stream);
+
+    SAFE_KERNEL_LAUNCH(
+            mesh_bounce_kernels::fillTriangleCells,
+            getNblocks(totalTriangles, nthreads), nthreads, 0, stream,
+            vertexView, mesh, cinfo, triangleCellStarts_.devPtr(),
+            nTrianglesPerCell_.devPtr(), triangleCells_.devPtr() );
+}
+
 } // namespace mirheo
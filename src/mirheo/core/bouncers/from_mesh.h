@@ -1,17 +1,21 @@
 // Copyright 2020 ETH Zurich. All Rights Reserved.
 #pragma once
 
+#include "collision_table.h"
 #include "interface.h"
 #include "kernels/api.h"
 
 #include <mirheo/core/containers.h>
 
+#include <map>
 #include <random>
 
 namespace mirheo
 {
 
 class RigidObjectVector;
+class CellListInfo;
+struct OVviewWithNewOldVertices;
 
 
 /** \brief Bounce particles against a triangle mesh.
@@ -52,18 +56,20 @@ public:
     std::vector<std::string> getChannelsToBeSentBack() const override;
 
 private:
-    template<typename T>
-    struct CollisionTableWrapper
+    /// collision tables of one ParticleVector; their capacity follows the collision rate of that ParticleVector
+    struct CollisionTables
     {
-        PinnedBuffer<int> nCollisions{1};
-        DeviceBuffer<T> collisionTable;
+        AdaptiveCollisionTable<int2> coarse {"coarse mesh collisions"}; ///< collision table for the first step
+        AdaptiveCollisionTable<int2> fine   {"fine mesh collisions"};   ///< collision table for the second step
     };
 
-    const real coarseCollisionsPerTri_ = 5.0_r; ///< maximum average possible number of collision per triangle in one step
-    const real fineCollisionsPerTri_   = 1.0_r; ///< maximum average number of collision per triangle in one step
+    std::map<std::string, CollisionTables> tables_; ///< collision tables per ParticleVector name
 
-    CollisionTableWrapper<int2> coarseTable_; ///< collision table for the first step
-    CollisionTableWrapper<int2> fineTable_;   ///< collision table for the second step
+    DeviceBuffer<int> nTrianglesPerCell_;   ///< number of swept triangles overlapping each cell
+    DeviceBuffer<int> triangleCellStarts_;  ///< prefix sum of nTrianglesPerCell_
+    DeviceBuffer<int> triangleCells_;       ///< global triangle indices, sorted by cells
+    PinnedBuffer<int> nTriangleCellEntries_ {1}; ///< total number of entries in triangleCells_
+    DeviceBuffer<char> scanBuffer_;         ///< work space to perform the prefix sum
 
     /** times stored as int so that we can use atomicMax
         note that times are always positive, thus guarantees ordering
@@ -76,6 +82,11 @@ private:
     RigidObjectVector *rov_;
 
     void exec(ParticleVector *pv, CellList *cl, ParticleVectorLocality locality, cudaStream_t stream) override;
+
+    /** Bin the triangles of the active objects into the cells overlapped by their swept bounding box
+        (inflated by the maximum particle displacement).
+     */
+    void _buildTriangleCellIndex(const OVviewWithNewOldVertices& vertexView, const CellListInfo& cinfo, cudaStream_t stream);
 };
 
 } // namespace mirheo
@@ -62,21 +62,12 @@ void BounceFromRod::exec(ParticleVector *pv, CellList *cl, ParticleVectorLocalit
 
     const int totalSegments = activeRV->getNumSegmentsPerRod() * activeRV->getNumObjects();
 
-    // Set maximum possible number of collisions with segments
-    // In case of crash, the estimate should be increased
-    const int maxCollisions = static_cast<int>(collisionsPerSeg_ * static_cast<real>(totalSegments));
-    table_.collisionTable.resize_anew(maxCollisions);
-    table_.nCollisions.clear(stream);
-    rod_bounce_kernels::SegmentTable devCollisionTable { maxCollisions,
-                                                       table_.nCollisions.devPtr(),
-                                                       table_.collisionTable.devPtr() };
-
+    auto& table = tables_[pv->getName()];
 
     // Setup collision times array. For speed and simplicity initial time will be 0,
     // and after the collisions detected its i-th element will be t_i-1.0_r, where 0 <= t_i <= 1
     // is the collision time, or 0 if no collision with the particle found
     collisionTimes.resize_anew(pv->local()->size());
-    collisionTimes.clear(stream);
 
     const int nthreads = 128;
 
@@ -86,18 +77,22 @@ void BounceFromRod::exec(ParticleVector *pv, CellList *cl, ParticleVectorLocalit
     PVviewWithOldParticles pvView(pv, pv->local());
 
     // Step 1, find all the candidate collisions
-    SAFE_KERNEL_LAUNCH(
-            rod_bounce_kernels::findBounces,
-            getNblocks(totalSegments, nthreads), nthreads, 0, stream,
-            rvView, radius_, pvView, cl->cellInfo(), devCollisionTable, collisionTimes.devPtr() );
+    // the table counts all collisions: on overflow, it is enlarged and the search is repeated
+    do {
+        table.clear(stream);
+        collisionTimes.clear(stream);
 
-    table_.nCollisions.downloadFromDevice(stream);
-    const int nCollisions = table_.nCollisions[0];
-    debug("Found %d rod collision candidates", nCollisions);
+        rod_bounce_kernels::SegmentTable devCollisionTable { table.capacity(), table.devCounter(), table.devPtr() };
+
+        SAFE_KERNEL_LAUNCH(
+                rod_bounce_kernels::findBounces,
+                getNblocks(totalSegments, nthreads), nthreads, 0, stream,
+                rvView, radius_, pvView, cl->cellInfo(), devCollisionTable, collisionTimes.devPtr() );
+
+    } while (!table.downloadAndCheck(stream));
 
-    if (nCollisions > maxCollisions)
-        die("Found too many rod collisions (%d),"
-            "something may be broken or you need to increase the estimate", nCollisions);
+    const int nCollisions = table.size();
+    debug("Found %d rod collision candidates", nCollisions);
 
     // Step 2, resolve the collisions
     mpark::visit([&](auto& bounceKernel)
@@ -107,7 +102,7 @@ void BounceFromRod::exec(ParticleVector *pv, CellList *cl, ParticleVectorLocalit
         SAFE_KERNEL_LAUNCH(
             rod_bounce_kernels::performBouncing,
             getNblocks(nCollisions, nthreads), nthreads, 0, stream,
-            rvView, radius_, pvView, nCollisions, devCollisionTable.indices, collisionTimes.devPtr(),
+            rvView, radius_, pvView, nCollisions, table.devPtr(), collisionTimes.devPtr(),
             getState()->dt, bounceKernel);
 
     }, varBounceKernel_);
@@ -1,11 +1,13 @@
 // Copyright 2020 ETH Zurich. All Rights Reserved.
 #pragma once
 
+#include "collision_table.h"
 #include "interface.h"
 #include "kernels/api.h"
 
 #include <mirheo/core/containers.h>
 
+#include <map>
 #include <random>
 
 namespace mirheo
@@ -45,20 +47,7 @@ public:
     std::vector<std::string> getChannelsToBeSentBack() const override;
 
 private:
-    template <typename T>
-    struct CollisionTableWrapper
-    {
-        PinnedBuffer<int> nCollisions{1};
-        DeviceBuffer<T> collisionTable;
-    };
-
-    /**
-     * Maximum supported number of collisions per step
-     * will be bouncesPerSeg * total number of triangles in mesh
-     */
-    const real collisionsPerSeg_ = 5.0_r;
-
-    CollisionTableWrapper<int2> table_;
+    std::map<std::string, AdaptiveCollisionTable<int2>> tables_; ///< collision tables per ParticleVector name
 
     /**
        times stored as int so that we can use atomicMax
@@ -377,7 +377,12 @@ void CellList::clearChannels(const std::vector<std::string>& channelNames, cudaS
     for (const auto& channelName : channelNames)
     {
         debug2("%s : clearing channel '%s'", _makeName().c_str(), channelName.c_str());
-        localPV_->dataPerParticle.getGenericData(channelName)->clearDevice(stream);
+
+        // the forces may have been partially cleared by the integrator
+        if (channelName == channel_names::forces)
+            localPV_->clearForces(stream);
+        else
+            localPV_->dataPerParticle.getGenericData(channelName)->clearDevice(stream);
     }
 }
 
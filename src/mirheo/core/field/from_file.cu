@@ -3,11 +3,16 @@
 
 #include <cassert>
 #include <fstream>
+#include <map>
 #include <texture_types.h>
 #include <mirheo/core/utils/kernel_launch.h>
 #include <mirheo/core/utils/cuda_common.h>
 #include <mirheo/core/utils/mpi_types.h>
 
+#ifdef MIRHEO_WITH_ZLIB
+#include <zlib.h>
+#endif
+
 namespace mirheo
 {
 
@@ -138,12 +143,19 @@ __global__ void inverseDistanceWeightedInterpolation(const float* in, int3 inDim
 } // interpolate_kernels
 
 
+/// first line of the tiled SDF files
+static const std::string tiledSdfMagic = "MIRHEO_TILED_SDF";
+
 struct HeaderInfo
 {
     int3 resolution;
     float3 extents;
     int64_t fullSdfSize_byte;
     int64_t endHeader_byte;
+
+    int tiled;      ///< 1 for the tiled format, 0 for the plain one
+    int3 tileSize;  ///< number of nodes of a tile along each direction (tiled format only)
+    int compressed; ///< 1 if the tiles are compressed with zlib (tiled format only)
 };
 
 inline auto multiplyComps(int3 v) {return v.x * v.y * v.z;}
@@ -175,6 +187,15 @@ static HeaderInfo readHeader(const std::string& fileName, const MPI_Comm& comm)
 
         auto fstart = file.tellg();
 
+        std::string firstLine;
+        std::getline(file, firstLine);
+        info.tiled = (firstLine == tiledSdfMagic);
+        info.tileSize = make_int3(0);
+        info.compressed = 0;
+
+        if (!info.tiled)
+            file.seekg(fstart);
+
         file >> info.extents.x >> info.extents.y >> info.extents.z >>
             info.resolution.x >> info.resolution.y >> info.resolution.z;
         info.fullSdfSize_byte = (int64_t) multiplyComps(info.resolution) * sizeof(float);
@@ -183,10 +204,34 @@ static HeaderInfo readHeader(const std::string& fileName, const MPI_Comm& comm)
              fileName.c_str(), info.extents.x, info.extents.y, info.extents.z,
              info.resolution.x, info.resolution.y, info.resolution.z);
 
-        file.seekg( 0, std::ios::end );
-        auto fend = file.tellg();
+        if (info.tiled)
+        {
+            std::string compression;
+            file >> info.tileSize.x >> info.tileSize.y >> info.tileSize.z >> compression;
+
+            if (compression != "none" && compression != "zlib")
+                die("'%s': unknown tile compression '%s'", fileName.c_str(), compression.c_str());
+            if (info.tileSize.x <= 0 || info.tileSize.y <= 0 || info.tileSize.z <= 0)
+                die("'%s': invalid tile size %d %d %d", fileName.c_str(),
+                    info.tileSize.x, info.tileSize.y, info.tileSize.z);
+
+            info.compressed = (compression == "zlib");
 
-        info.endHeader_byte = (fend - fstart) - info.fullSdfSize_byte;
+            // the index starts just after the end of the header line
+            std::string endOfLine;
+            std::getline(file, endOfLine);
+            info.endHeader_byte = file.tellg() - fstart;
+
+            info("Field file '%s' is tiled in %dx%dx%d nodes (%s compression)", fileName.c_str(),
+                 info.tileSize.x, info.tileSize.y, info.tileSize.z, compression.c_str());
+        }
+        else
+        {
+            file.seekg( 0, std::ios::end );
+            auto fend = file.tellg();
+
+            info.endHeader_byte = (fend - fstart) - info.fullSdfSize_byte;
+        }
 
         file.close();
     }
@@ -195,6 +240,9 @@ static HeaderInfo readHeader(const std::string& fileName, const MPI_Comm& comm)
     MPI_Check( MPI_Bcast(&info.resolution,       3, MPI_INT,       root, comm) );
     MPI_Check( MPI_Bcast(&info.fullSdfSize_byte, 1, MPI_INT64_T,   root, comm) );
     MPI_Check( MPI_Bcast(&info.endHeader_byte,   1, MPI_INT64_T,   root, comm) );
+    MPI_Check( MPI_Bcast(&info.tiled,            1, MPI_INT,       root, comm) );
+    MPI_Check( MPI_Bcast(&info.tileSize,         3, MPI_INT,       root, comm) );
+    MPI_Check( MPI_Bcast(&info.compressed,       1, MPI_INT,       root, comm) );
 
     return info;
 }
@@ -236,16 +284,28 @@ struct LocalSdfPiece
     int3 resolution;
 };
 
-static LocalSdfPiece prepareRelevantSdfPiece(const std::vector<float>& fullSdfData, float3 extendedDomainStart, float3 extendedDomainSize,
+/// Range [startId, endId) of the nodes of the initial grid needed by the local subdomain (may be out of the grid)
+static void getRelevantSdfRange(float3 extendedDomainStart, float3 extendedDomainSize, float3 initialSdfH,
+                                int3& startId, int3& endId)
+{
+    constexpr int margin = 3; // +2 from cubic interpolation, +1 from possible round-off errors
+    startId = make_int3( math::floor( extendedDomainStart                     / initialSdfH) ) - margin;
+    endId   = make_int3( math::ceil ((extendedDomainStart+extendedDomainSize) / initialSdfH) ) + margin;
+}
+
+/** Carve the piece of the initial grid needed by the local subdomain.
+    \tparam NodeGetter Returns the value of a node of the initial grid, float(int3 id)
+ */
+template <class NodeGetter>
+static LocalSdfPiece prepareRelevantSdfPiece(NodeGetter getNode, float3 extendedDomainStart, float3 extendedDomainSize,
                                              float3 initialSdfH, int3 initialSdfResolution)
 {
     LocalSdfPiece sdfPiece;
     // Find your relevant chunk of data
     // We cannot send big sdf files directly, so we'll carve a piece now
 
-    constexpr int margin = 3; // +2 from cubic interpolation, +1 from possible round-off errors
-    const int3 startId = make_int3( math::floor( extendedDomainStart                     / initialSdfH) ) - margin;
-    const int3 endId   = make_int3( math::ceil ((extendedDomainStart+extendedDomainSize) / initialSdfH) ) + margin;
+    int3 startId, endId;
+    getRelevantSdfRange(extendedDomainStart, extendedDomainSize, initialSdfH, startId, endId);
 
     const float3 startInLocalCoord = make_float3(startId)*initialSdfH - (extendedDomainStart + 0.5*extendedDomainSize);
 
@@ -265,14 +325,142 @@ static LocalSdfPiece prepareRelevantSdfPiece(const std::vector<float>& fullSdfDa
                 const int origIz = (k+startId.z + initialSdfResolution.z) % initialSdfResolution.z;
 
                 const auto dstId = (k*sdfPiece.resolution.y + j)*sdfPiece.resolution.x + i;
-                const auto srcId = (origIz*initialSdfResolution.y + origIy)*initialSdfResolution.x + origIx;
-                locSdfDataPtr[ dstId ] = fullSdfData[ srcId ];
+                locSdfDataPtr[ dstId ] = getNode(make_int3(origIx, origIy, origIz));
             }
     return sdfPiece;
 }
 
-FieldFromFile::FieldFromFile(const MirState *state, std::string name, std::string fieldFileName, real3 h) :
-    Field(state, name, h),
+/// The tiles of a tiled SDF file that were read by the local rank
+struct SdfTiles
+{
+    int3 resolution; ///< number of nodes of the whole grid
+    int3 tileSize;   ///< number of nodes of a tile along each direction
+    int3 nTiles;     ///< number of tiles along each direction
+    std::map<int, std::vector<float>> tiles; ///< values of the read tiles (x is the fast index), by tile id
+
+    /// number of nodes of the given tile along each direction; the last tiles may be smaller
+    int3 getTileDims(int3 tile) const
+    {
+        return math::min(tileSize, resolution - tile * tileSize);
+    }
+
+    /// value at the given node of the grid; the tile containing it must have been read
+    float operator()(int3 id) const
+    {
+        const int3 tile = id / tileSize;
+        const int3 dims = getTileDims(tile);
+        const int3 l = id - tile * tileSize;
+
+        const auto& data = tiles.at((tile.z * nTiles.y + tile.y) * nTiles.x + tile.x);
+        return data[(l.z * dims.y + l.y) * dims.x + l.x];
+    }
+};
+
+/// \return ids of the tiles that contain the nodes [start, end) along one direction, with periodic wrapping
+static std::vector<int> getOverlappingTiles(int start, int end, int resolution, int tileSize)
+{
+    const int nTiles = (resolution + tileSize - 1) / tileSize;
+    std::vector<bool> needed(nTiles, false);
+
+    for (int i = start; i < end; ++i)
+        needed[((i % resolution + resolution) % resolution) / tileSize] = true;
+
+    std::vector<int> ids;
+    for (int t = 0; t < nTiles; ++t)
+        if (needed[t])
+            ids.push_back(t);
+    return ids;
+}
+
+static std::vector<float> decompressTile(const std::vector<char>& buffer, size_t nValues, const std::string& fileName)
+{
+    std::vector<float> values(nValues);
+#ifdef MIRHEO_WITH_ZLIB
+    uLongf size = static_cast<uLongf>(nValues * sizeof(float));
+    const int status = uncompress(reinterpret_cast<Bytef*>(values.data()), &size,
+                                  reinterpret_cast<const Bytef*>(buffer.data()), static_cast<uLong>(buffer.size()));
+
+    if (status != Z_OK || size != nValues * sizeof(float))
+        die("'%s': could not decompress a tile (zlib error %d)", fileName.c_str(), status);
+#else
+    (void) buffer;
+    die("'%s': the tiles are compressed but Mirheo was compiled without zlib", fileName.c_str());
+#endif
+    return values;
+}
+
+/** Read only the tiles of a tiled SDF file that overlap the extended local subdomain.
+    Each rank reads its tiles independently; the whole grid is never gathered.
+ */
+static SdfTiles readSdfTiles(const std::string& fileName, const MPI_Comm& comm, const HeaderInfo& info,
+                             float3 extendedDomainStart, float3 extendedDomainSize, float3 initialSdfH)
+{
+    SdfTiles sdfTiles;
+    sdfTiles.resolution = info.resolution;
+    sdfTiles.tileSize   = info.tileSize;
+    sdfTiles.nTiles     = (info.resolution + info.tileSize - 1) / info.tileSize;
+
+    const int totTiles = multiplyComps(sdfTiles.nTiles);
+
+    int3 startId, endId;
+    getRelevantSdfRange(extendedDomainStart, extendedDomainSize, initialSdfH, startId, endId);
+
+    const auto tilesX = getOverlappingTiles(startId.x, endId.x, info.resolution.x, info.tileSize.x);
+    const auto tilesY = getOverlappingTiles(startId.y, endId.y, info.resolution.y, info.tileSize.y);
+    const auto tilesZ = getOverlappingTiles(startId.z, endId.z, info.resolution.z, info.tileSize.z);
+
+    MPI_File fh;
+    MPI_Status status;
+    MPI_Check( MPI_File_open(comm, fileName.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &fh) );
+
+    // offset and size in bytes of each tile
+    std::vector<int64_t> index(2 * totTiles);
+    MPI_Check( MPI_File_read_at(fh, info.endHeader_byte, index.data(), 2 * totTiles, MPI_INT64_T, &status) );
+
+    int64_t readSize_byte = 0;
+    std::vector<char> buffer;
+
+    for (int tz : tilesZ)
+    for (int ty : tilesY)
+    for (int tx : tilesX)
+    {
+        const int3 tile {tx, ty, tz};
+        const int tileId = (tz * sdfTiles.nTiles.y + ty) * sdfTiles.nTiles.x + tx;
+        const int64_t offset = index[2 * tileId + 0];
+        const int64_t size   = index[2 * tileId + 1];
+        const size_t nValues = static_cast<size_t>(multiplyComps(sdfTiles.getTileDims(tile)));
+
+        if (!info.compressed && size != static_cast<int64_t>(nValues * sizeof(float)))
+            die("'%s': tile %d has %lld bytes instead of %zu", fileName.c_str(), tileId,
+                static_cast<long long>(size), nValues * sizeof(float));
+
+        buffer.resize(static_cast<size_t>(size));
+        MPI_Check( MPI_File_read_at(fh, offset, buffer.data(), static_cast<int>(size), MPI_BYTE, &status) );
+        readSize_byte += size;
+
+        if (info.compressed)
+        {
+            sdfTiles.tiles[tileId] = decompressTile(buffer, nValues, fileName);
+        }
+        else
+        {
+            auto& values = sdfTiles.tiles[tileId];
+            values.resize(nValues);
+            std::copy(buffer.begin(), buffer.end(), reinterpret_cast<char*>(values.data()));
+        }
+    }
+
+    MPI_Check( MPI_File_close(&fh) );
+
+    debug("Read %zu of %d tiles (%.2f MB) from field file '%s'", sdfTiles.tiles.size(), totTiles,
+          static_cast<double>(readSize_byte) / (1024.0 * 1024.0), fileName.c_str());
+
+    return sdfTiles;
+}
+
+FieldFromFile::FieldFromFile(const MirState *state, std::string name, std::string fieldFileName, real3 h,
+                             real narrowBandWidth, FieldInterpolation interpolation) :
+    Field(state, name, h, narrowBandWidth, interpolation),
     fieldFileName_(fieldFileName)
 {}
 
@@ -301,20 +489,37 @@ void FieldFromFile::setup(const MPI_Comm& comm)
     auto headerInfo = readHeader(fieldFileName_, comm);
     const float3 initialSdfH = make_float3(domain.globalSize) / make_float3(headerInfo.resolution-1);
 
-    // Read heavy data
-    const auto fullSdfData = readSdf(fieldFileName_, comm, headerInfo);
-
     const float3 scale3 = make_float3(domain.globalSize) / headerInfo.extents;
     if ( !componentsAreEqual(scale3) )
         die("Sdf size and domain size mismatch");
     const float lenScalingFactor = (scale3.x + scale3.y + scale3.z) / 3;
 
-    auto sdfPiece = prepareRelevantSdfPiece(fullSdfData,
-                                            make_float3(domain.globalStart - margin3_), make_float3(extendedDomainSize_),
-                                            initialSdfH, headerInfo.resolution);
+    const float3 extendedDomainStart = make_float3(domain.globalStart - margin3_);
+    const float3 extendedDomainSize  = make_float3(extendedDomainSize_);
+
+    // Read heavy data
+    LocalSdfPiece sdfPiece;
+    if (headerInfo.tiled)
+    {
+        const auto sdfTiles = readSdfTiles(fieldFileName_, comm, headerInfo,
+                                           extendedDomainStart, extendedDomainSize, initialSdfH);
+
+        sdfPiece = prepareRelevantSdfPiece(sdfTiles, extendedDomainStart, extendedDomainSize,
+                                           initialSdfH, headerInfo.resolution);
+    }
+    else
+    {
+        const auto fullSdfData = readSdf(fieldFileName_, comm, headerInfo);
+        const int3 res = headerInfo.resolution;
+
+        sdfPiece = prepareRelevantSdfPiece([&fullSdfData, res] (int3 id)
+        {
+            return fullSdfData[(id.z*res.y + id.y)*res.x + id.x];
+        }, extendedDomainStart, extendedDomainSize, initialSdfH, headerInfo.resolution);
+    }
 
     // Interpolate
-    DeviceBuffer<float> fieldRawData (multiplyComps(resolution_));
+    PinnedBuffer<float> fieldRawData (multiplyComps(resolution_));
 
     const dim3 threads(8, 8, 8);
     const dim3 blocks((resolution_.x+threads.x-1) / threads.x,
@@ -329,7 +534,7 @@ void FieldFromFile::setup(const MPI_Comm& comm)
             fieldRawData.devPtr(), resolution_, make_float3(h_),
             sdfPiece.offset, lenScalingFactor );
 
-    _setupArrayTexture(fieldRawData.devPtr());
+    _setupData(fieldRawData);
 }
 
 } // namespace mirheo
@@ -3,11 +3,41 @@
 
 #include <mirheo/core/utils/cuda_common.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
 namespace mirheo
 {
 
-FieldFromFunction::FieldFromFunction(const MirState *state, std::string name, FieldFunction func, real3 h) :
-    Field(state, name, h),
+FieldBatchFunction makeSerialFieldBatchFunction(FieldFunction func)
+{
+    return [func](int n, const real3 *positions, real *values)
+    {
+        for (int i = 0; i < n; ++i)
+            values[i] = func(positions[i]);
+    };
+}
+
+FieldBatchFunction makeParallelFieldBatchFunction(FieldFunction func)
+{
+    return [func](int n, const real3 *positions, real *values)
+    {
+        #pragma omp parallel for schedule(static)
+        for (int i = 0; i < n; ++i)
+            values[i] = func(positions[i]);
+    };
+}
+
+FieldFromFunction::FieldFromFunction(const MirState *state, std::string name, FieldFunction func, real3 h,
+                                     real narrowBandWidth, FieldInterpolation interpolation) :
+    FieldFromFunction(state, std::move(name), makeParallelFieldBatchFunction(std::move(func)), h,
+                      narrowBandWidth, interpolation)
+{}
+
+FieldFromFunction::FieldFromFunction(const MirState *state, std::string name, FieldBatchFunction func, real3 h,
+                                     real narrowBandWidth, FieldInterpolation interpolation) :
+    Field(state, name, h, narrowBandWidth, interpolation),
     func_(func)
 {}
 
@@ -38,28 +68,43 @@ void FieldFromFunction::setup(__UNUSED const MPI_Comm& comm)
 
     CUDA_Check( cudaDeviceSynchronize() );
 
-    PinnedBuffer<float> fieldRawData (resolution_.x * resolution_.y * resolution_.z);
-
-    int3 i;
-    int id = 0;
-    for (i.z = 0; i.z < resolution_.z; ++i.z) {
-        for (i.y = 0; i.y < resolution_.y; ++i.y) {
-            for (i.x = 0; i.x < resolution_.x; ++i.x) {
-                real3 r {static_cast<real>(i.x) * h_.x,
-                         static_cast<real>(i.y) * h_.y,
-                         static_cast<real>(i.z) * h_.z};
-                r -= extendedDomainSize_ * 0.5_r;
-                r  = domain.local2global(r);
-                r  = make_periodic(r, domain.globalSize);
-
-                fieldRawData[id++] = static_cast<float>(func_(r));
-            }
+    const int64_t n = static_cast<int64_t>(resolution_.x) * resolution_.y * resolution_.z;
+    PinnedBuffer<float> fieldRawData (n);
+
+    // the nodes are passed to the function in chunks to bound the memory used for the positions
+    constexpr int64_t chunkSize = 1 << 18;
+    std::vector<real3> positions(static_cast<size_t>(std::min(n, chunkSize)));
+    std::vector<real>  values   (positions.size());
+
+    for (int64_t start = 0; start < n; start += chunkSize)
+    {
+        const int chunkNodes = static_cast<int>(std::min(chunkSize, n - start));
+
+        #pragma omp parallel for schedule(static)
+        for (int i = 0; i < chunkNodes; ++i)
+        {
+            const int64_t id = start + i;
+            const int3 node {static_cast<int>( id % resolution_.x),
+                             static_cast<int>((id / resolution_.x) % resolution_.y),
+                             static_cast<int>( id / (static_cast<int64_t>(resolution_.x) * resolution_.y))};
+
+            real3 r {static_cast<real>(node.x) * h_.x,
+                     static_cast<real>(node.y) * h_.y,
+                     static_cast<real>(node.z) * h_.z};
+            r -= extendedDomainSize_ * 0.5_r;
+            r  = domain.local2global(r);
+            positions[static_cast<size_t>(i)] = make_periodic(r, domain.globalSize);
         }
+
+        func_(chunkNodes, positions.data(), values.data());
+
+        for (int i = 0; i < chunkNodes; ++i)
+            fieldRawData[start + i] = static_cast<float>(values[static_cast<size_t>(i)]);
     }
 
     fieldRawData.uploadToDevice(defaultStream);
 
-    _setupArrayTexture(fieldRawData.devPtr());
+    _setupData(fieldRawData);
 }
 
 } // namespace mirheo
@@ -1,4 +1,6 @@
 // Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
 #include "interface.h"
 
 #include <functional>
@@ -9,6 +11,28 @@ namespace mirheo
 /// A function that describes a scala field
 using FieldFunction = std::function<real(real3)>;
 
+/** \brief A function that evaluates a scalar field on a batch of positions.
+
+    Arguments: the number of positions n, the n positions and the n output values.
+ */
+using FieldBatchFunction = std::function<void(int, const real3*, real*)>;
+
+/** \brief Evaluate a FieldFunction one position at a time, in the calling thread.
+    \param [in] func The scalar field function
+    \return The batch function
+
+    This is the only safe choice for functions that are not thread safe, e.g. python functions.
+ */
+FieldBatchFunction makeSerialFieldBatchFunction(FieldFunction func);
+
+/** \brief Evaluate a FieldFunction on the positions of a batch in parallel with OpenMP.
+    \param [in] func The scalar field function; must be thread safe
+    \return The batch function
+
+    Equivalent to makeSerialFieldBatchFunction() if Mirheo was not compiled with OpenMP.
+ */
+FieldBatchFunction makeParallelFieldBatchFunction(FieldFunction func);
+
 /** \brief a \c Field that can be initialized from FieldFunction
  */
 class FieldFromFunction : public Field
@@ -17,14 +41,31 @@ public:
     /** \brief Construct a FieldFromFunction object
         \param [in] state The global state of the system
         \param [in] name The name of the field object
-        \param [in] func The scalar field function
+        \param [in] func The scalar field function; must be thread safe
         \param [in] h the grid size
+        \param [in] narrowBandWidth see Field
+        \param [in] interpolation see Field
 
         The scalar values will be discretized and stored on the grid.
-        This can be useful as one can have a general scalar field configured
-        on the host (e.g. from python) but usable on the device.
+        The function is evaluated on the grid nodes in parallel (see makeParallelFieldBatchFunction()).
+        Functions that are not thread safe, e.g. python functions, must be passed as a
+        FieldBatchFunction, see makeSerialFieldBatchFunction().
+    */
+    FieldFromFunction(const MirState *state, std::string name, FieldFunction func, real3 h,
+                      real narrowBandWidth = 0.0_r,
+                      FieldInterpolation interpolation = FieldInterpolation::Linear);
+
+    /** \brief Construct a FieldFromFunction object from a function evaluated on batches of positions
+        \param [in] state The global state of the system
+        \param [in] name The name of the field object
+        \param [in] func The scalar field function, called on chunks of grid nodes
+        \param [in] h the grid size
+        \param [in] narrowBandWidth see Field
+        \param [in] interpolation see Field
     */
-    FieldFromFunction(const MirState *state, std::string name, FieldFunction func, real3 h);
+    FieldFromFunction(const MirState *state, std::string name, FieldBatchFunction func, real3 h,
+                      real narrowBandWidth = 0.0_r,
+                      FieldInterpolation interpolation = FieldInterpolation::Linear);
     ~FieldFromFunction();
 
     /// move constructor
@@ -33,7 +74,7 @@ public:
     void setup(const MPI_Comm& comm) override;
 
 private:
-    FieldFunction func_; ///< The scalar field
+    FieldBatchFunction func_; ///< The scalar field
 };
 
 } // namespace mirheo
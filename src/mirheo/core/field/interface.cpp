@@ -4,13 +4,19 @@
 #include <texture_types.h>
 #include <mirheo/core/utils/cuda_common.h>
 
+#include <vector>
+
 namespace mirheo
 {
 
-Field::Field(const MirState *state, std::string name, real3 hField) :
+Field::Field(const MirState *state, std::string name, real3 hField, real narrowBandWidth,
+             FieldInterpolation interpolation) :
     MirSimulationObject(state, name),
     fieldArray_(nullptr)
 {
+    narrowBandWidth_    = narrowBandWidth;
+    interpolation_      = interpolation;
+
     // We'll make sdf a bit bigger, so that particles that flew away
     // would also be correctly bounced back
     extendedDomainSize_ = state->domain.localSize + 2.0_r * margin3_;
@@ -34,6 +40,11 @@ const FieldDeviceHandler& Field::handler() const
     return *(FieldDeviceHandler*)this;
 }
 
+real Field::getNarrowBandWidth() const
+{
+    return narrowBandWidth_;
+}
+
 void Field::_setupArrayTexture(const float *fieldDevPtr)
 {
     debug("setting up cuda array and texture object for field '%s'", getCName());
@@ -68,4 +79,81 @@ void Field::_setupArrayTexture(const float *fieldDevPtr)
     CUDA_Check( cudaDeviceSynchronize() );
 }
 
+void Field::_setupNarrowBand(const float *fieldHostPtr)
+{
+    debug("setting up narrow band bricks for field '%s'", getCName());
+
+    const real band = narrowBandWidth_;
+    const int3 ncells = resolution_ - 1;
+    nBricks_ = (ncells + brickSize - 1) / brickSize;
+
+    const int totBricks = nBricks_.x * nBricks_.y * nBricks_.z;
+    constexpr int brickVolume = brickNodes * brickNodes * brickNodes;
+
+    std::vector<int> brickMap(totBricks);
+    std::vector<float> bricks;
+    std::vector<float> brick(brickVolume);
+
+    int3 b;
+    for (b.z = 0; b.z < nBricks_.z; ++b.z)
+    for (b.y = 0; b.y < nBricks_.y; ++b.y)
+    for (b.x = 0; b.x < nBricks_.x; ++b.x)
+    {
+        bool active = false;
+        int3 l;
+        for (l.z = 0; l.z < brickNodes; ++l.z)
+        for (l.y = 0; l.y < brickNodes; ++l.y)
+        for (l.x = 0; l.x < brickNodes; ++l.x)
+        {
+            // the last bricks may stick out of the grid; repeat the last nodes
+            const int3 node = math::min(b * brickSize + l, resolution_ - 1);
+            const real val = fieldHostPtr[(node.z * resolution_.y + node.y) * resolution_.x + node.x];
+
+            active |= math::abs(val) < band;
+            brick[(l.z * brickNodes + l.y) * brickNodes + l.x] = static_cast<float>(math::min(math::max(val, -band), band));
+        }
+
+        const int bid = (b.z * nBricks_.y + b.y) * nBricks_.x + b.x;
+
+        if (active)
+        {
+            brickMap[bid] = static_cast<int>(bricks.size() / brickVolume);
+            bricks.insert(bricks.end(), brick.begin(), brick.end());
+        }
+        else
+        {
+            brickMap[bid] = brick[0] < 0.0_r ? farNegative : farPositive;
+        }
+    }
+
+    const int nActive = static_cast<int>(bricks.size() / brickVolume);
+    const double denseMB  = static_cast<double>(resolution_.x) * resolution_.y * resolution_.z * sizeof(float) / (1024.0 * 1024.0);
+    const double sparseMB = (static_cast<double>(bricks.size()) * sizeof(float) + totBricks * sizeof(int)) / (1024.0 * 1024.0);
+
+    info("Field '%s': %d of %d bricks intersect the narrow band of width %g (%.1f MB instead of %.1f MB)",
+         getCName(), nActive, totBricks, band, sparseMB, denseMB);
+
+    brickMapStorage_.resize_anew(totBricks);
+    CUDA_Check( cudaMemcpy(brickMapStorage_.devPtr(), brickMap.data(), totBricks * sizeof(int), cudaMemcpyHostToDevice) );
+
+    brickDataStorage_.resize_anew(bricks.size());
+    CUDA_Check( cudaMemcpy(brickDataStorage_.devPtr(), bricks.data(), bricks.size() * sizeof(float), cudaMemcpyHostToDevice) );
+
+    brickMap_  = brickMapStorage_.devPtr();
+    brickData_ = brickDataStorage_.devPtr();
+}
+
+void Field::_setupData(PinnedBuffer<float>& fieldData)
+{
+    if (narrowBandWidth_ > 0.0_r)
+    {
+        fieldData.downloadFromDevice(defaultStream);
+        _setupNarrowBand(fieldData.hostPtr());
+    }
+    else
+    {
+        _setupArrayTexture(fieldData.devPtr());
+    }
+}
+
 } // namespace mirheo
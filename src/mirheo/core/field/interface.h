@@ -1,6 +1,8 @@
 // Copyright 2020 ETH Zurich. All Rights Reserved.
 #pragma once
 
+#include "utils.h"
+
 #include <mirheo/core/domain.h>
 #include <mirheo/core/containers.h>
 #include <mirheo/core/mirheo_object.h>
@@ -23,11 +25,32 @@ T tex3D(__UNUSED cudaTextureObject_t t,
 }
 #endif
 
+/// Interpolation of the grid values of a Field
+enum class FieldInterpolation
+{
+    Linear, ///< trilinear interpolation; gradients are computed with finite differences
+    Cubic   ///< tricubic (Catmull-Rom) interpolation, continuously differentiable; gradients are analytic
+};
+
 /** \brief a device-compatible structure that represents a scalar field
+
+    The field is stored on a uniform grid, either densely in a texture or, in narrow band mode,
+    in bricks of \c brickSize^3 cells that cover only the region where the field is smaller
+    (in magnitude) than the band width.
+    Outside of the band, the field is clamped to plus or minus the band width.
+
+    The field is interpolated either trilinearly from the 8 surrounding grid nodes, or with tricubic
+    Catmull-Rom splines from the 64 surrounding nodes (see FieldInterpolation).
+    The latter gives smooth gradients from a single stencil evaluation and allows coarser grids.
  */
 class FieldDeviceHandler
 {
 public:
+    static constexpr int brickSize = 8; ///< number of cells along each direction of a brick (narrow band only)
+    static constexpr int brickNodes = brickSize + 1; ///< number of grid nodes along each direction of a brick
+    static constexpr int farNegative = -1; ///< brick map entry of a brick entirely below the band
+    static constexpr int farPositive = -2; ///< brick map entry of a brick entirely above the band
+
     /** \brief Evaluate the field at a given position
         \param [in] x The position, in local coordinates
         \return The scalar value at \p x
@@ -40,21 +63,177 @@ public:
      */
     __D__ inline real operator()(real3 x) const
     {
-        //https://en.wikipedia.org/wiki/Trilinear_interpolation
-        real s000, s001, s010, s011, s100, s101, s110, s111;
-        real sx00, sx01, sx10, sx11, sxy0, sxy1, sxyz;
+        if (interpolation_ == FieldInterpolation::Cubic)
+            return _cubic<false>(x, nullptr);
 
         const real3 texcoord = math::floor((x + extendedDomainSize_*0.5_r) * invh_);
         const real3 lambda = (x - (texcoord * h_ - extendedDomainSize_*0.5_r)) * invh_;
 
-        auto access = [this, &texcoord] (int dx, int dy, int dz)
+        if (brickMap_ != nullptr)
+        {
+            // the cells outside of the grid are clamped to the closest one, as in _node()
+            const int3 cell = math::min(math::max(make_int3(texcoord), make_int3(0)), resolution_ - 2);
+            const int3 brick = math::min(cell / brickSize, nBricks_ - 1);
+            const int brickId = brickMap_[(brick.z * nBricks_.y + brick.y) * nBricks_.x + brick.x];
+
+            if (brickId == farNegative) return -narrowBandWidth_;
+            if (brickId == farPositive) return  narrowBandWidth_;
+
+            const float *data = brickData_ + brickId * brickNodes * brickNodes * brickNodes;
+            const int3 l = cell - brick * brickSize;
+            const real3 lambdaCell = math::min(math::max(lambda + texcoord - make_real3(cell), make_real3(0.0_r)), make_real3(1.0_r));
+
+            return _interpolate(lambdaCell, [data, l] (int dx, int dy, int dz)
+            {
+                return static_cast<real>(data[((l.z + dz) * brickNodes + l.y + dy) * brickNodes + l.x + dx]);
+            });
+        }
+
+        return _interpolate(lambda, [this, &texcoord] (int dx, int dy, int dz)
         {
             const auto val = tex3D<float>(fieldTex_,
                                           static_cast<float>(texcoord.x + static_cast<real>(dx)),
                                           static_cast<float>(texcoord.y + static_cast<real>(dy)),
                                           static_cast<float>(texcoord.z + static_cast<real>(dz)));
             return static_cast<real>(val);
-        };
+        });
+    }
+
+    /** \brief Evaluate the gradient of the field at a given position
+        \param [in] x The position, in local coordinates
+        \param [in] h The step used for finite differences (linear interpolation only)
+        \return The gradient of the field at \p x
+
+        The gradient is analytic with cubic interpolation.
+     */
+    __D__ inline real3 gradient(real3 x, real h) const
+    {
+        if (interpolation_ == FieldInterpolation::Cubic)
+        {
+            real3 grad;
+            _cubic<true>(x, &grad);
+            return grad;
+        }
+        return computeGradient<FieldDeviceHandler>(*this, x, h); // finite differences
+    }
+
+    /** \brief Evaluate the field and, where needed, its gradient at a given position
+        \param [in] x The position, in local coordinates
+        \param [in] h The step used for finite differences (linear interpolation only)
+        \param [in] gradientThreshold The gradient is computed only where the value is larger than minus this threshold
+        \param [out] grad The gradient of the field at \p x, or zero where it is not needed
+        \return The scalar value at \p x
+
+        With cubic interpolation, the value and the gradient come from a single pass over the 64 surrounding nodes.
+     */
+    __D__ inline real valueAndGradient(real3 x, real h, real gradientThreshold, real3 *grad) const
+    {
+        real val;
+        if (interpolation_ == FieldInterpolation::Cubic)
+        {
+            val = _cubic<true>(x, grad);
+        }
+        else
+        {
+            val = (*this)(x);
+            if (val > -gradientThreshold)
+                *grad = computeGradient<FieldDeviceHandler>(*this, x, h);
+        }
+
+        if (val <= -gradientThreshold)
+            *grad = make_real3(0.0_r);
+
+        return val;
+    }
+
+private:
+    /// value at the grid node i; the nodes outside of the grid are clamped to the closest one
+    __D__ inline real _node(int3 i) const
+    {
+        i = math::min(math::max(i, make_int3(0)), resolution_ - 1);
+
+        if (brickMap_ != nullptr)
+        {
+            // the last node of a brick is also the first of the next one
+            const int3 brick = math::min(i / brickSize, nBricks_ - 1);
+            const int brickId = brickMap_[(brick.z * nBricks_.y + brick.y) * nBricks_.x + brick.x];
+
+            if (brickId == farNegative) return -narrowBandWidth_;
+            if (brickId == farPositive) return  narrowBandWidth_;
+
+            const int3 l = i - brick * brickSize;
+            const float *data = brickData_ + brickId * brickNodes * brickNodes * brickNodes;
+            return static_cast<real>(data[(l.z * brickNodes + l.y) * brickNodes + l.x]);
+        }
+
+        const auto val = tex3D<float>(fieldTex_,
+                                      static_cast<float>(i.x),
+                                      static_cast<float>(i.y),
+                                      static_cast<float>(i.z));
+        return static_cast<real>(val);
+    }
+
+    /// Catmull-Rom weights of the nodes -1, 0, 1, 2 at t in [0, 1] and their derivatives
+    __D__ static inline void _cubicWeights(real t, real w[4], real dw[4])
+    {
+        const real t2 = t * t;
+        const real t3 = t2 * t;
+
+        w[0] = 0.5_r * (-t3 + 2.0_r * t2 - t);
+        w[1] = 0.5_r * (3.0_r * t3 - 5.0_r * t2 + 2.0_r);
+        w[2] = 0.5_r * (-3.0_r * t3 + 4.0_r * t2 + t);
+        w[3] = 0.5_r * (t3 - t2);
+
+        dw[0] = 0.5_r * (-3.0_r * t2 + 4.0_r * t - 1.0_r);
+        dw[1] = 0.5_r * (9.0_r * t2 - 10.0_r * t);
+        dw[2] = 0.5_r * (-9.0_r * t2 + 8.0_r * t + 1.0_r);
+        dw[3] = 0.5_r * (3.0_r * t2 - 2.0_r * t);
+    }
+
+    /// tricubic interpolation of the value and, if withGradient, of the gradient at x
+    template <bool withGradient>
+    __D__ inline real _cubic(real3 x, real3 *grad) const
+    {
+        const real3 coord = (x + extendedDomainSize_*0.5_r) * invh_;
+        const real3 base = math::floor(coord);
+        const real3 t = coord - base;
+        const int3 i0 = make_int3(base);
+
+        real wx[4], wy[4], wz[4], dwx[4], dwy[4], dwz[4];
+        _cubicWeights(t.x, wx, dwx);
+        _cubicWeights(t.y, wy, dwy);
+        _cubicWeights(t.z, wz, dwz);
+
+        real val = 0.0_r;
+        real3 g {0.0_r, 0.0_r, 0.0_r};
+
+        for (int dz = 0; dz < 4; ++dz)
+        for (int dy = 0; dy < 4; ++dy)
+        for (int dx = 0; dx < 4; ++dx)
+        {
+            const real f = _node(i0 + make_int3(dx - 1, dy - 1, dz - 1));
+            val += wx[dx] * wy[dy] * wz[dz] * f;
+
+            if (withGradient)
+            {
+                g.x += dwx[dx] *  wy[dy] *  wz[dz] * f;
+                g.y +=  wx[dx] * dwy[dy] *  wz[dz] * f;
+                g.z +=  wx[dx] *  wy[dy] * dwz[dz] * f;
+            }
+        }
+
+        if (withGradient)
+            *grad = g * invh_;
+
+        return val;
+    }
+
+    template <class Accessor>
+    __D__ static inline real _interpolate(real3 lambda, Accessor access)
+    {
+        //https://en.wikipedia.org/wiki/Trilinear_interpolation
+        real s000, s001, s010, s011, s100, s101, s110, s111;
+        real sx00, sx01, sx10, sx11, sxy0, sxy1, sxyz;
 
         s000 = access(0, 0, 0);
         s001 = access(0, 0, 1);
@@ -84,6 +263,13 @@ protected:
     real3 h_;    ///< grid spacing
     real3 invh_; ///< 1 / h
     real3 extendedDomainSize_; ///< subdomain size extended with a margin
+    int3 resolution_;  ///< number of grid points along each dimension
+    FieldInterpolation interpolation_; ///< interpolation of the grid values
+
+    real narrowBandWidth_;       ///< values are clamped to +- this value in narrow band mode; non positive for dense storage
+    int3 nBricks_;               ///< number of bricks along each direction (narrow band only)
+    const int *brickMap_ {nullptr};      ///< index of the brick data of each brick, or farNegative/farPositive (narrow band only)
+    const float *brickData_ {nullptr};   ///< grid values of the active bricks, brickNodes^3 per brick (narrow band only)
 };
 
 /** \brief Driver class used to create a FieldDeviceHandler.
@@ -95,8 +281,12 @@ public:
         \param [in] state The global state of the system
         \param [in] name The name of the field object
         \param [in] h the grid size
+        \param [in] narrowBandWidth If positive, store only the bricks where the field magnitude is below
+                   this value and clamp the field to +- this value elsewhere. Otherwise, store the whole grid.
+        \param [in] interpolation The interpolation of the grid values
      */
-    Field(const MirState *state, std::string name, real3 h);
+    Field(const MirState *state, std::string name, real3 h, real narrowBandWidth = 0.0_r,
+          FieldInterpolation interpolation = FieldInterpolation::Linear);
     virtual ~Field();
 
     /// move constructor
@@ -105,6 +295,9 @@ public:
     /// \return The handler that can be used on the device
     const FieldDeviceHandler& handler() const;
 
+    /// \return The distance to the zero level set beyond which the values are clamped; non positive for dense storage
+    real getNarrowBandWidth() const;
+
     /** Prepare the internal state of the \c Field.
         Must be called before handler().
         \param [in] comm The cartesian communicator of the domain.
@@ -112,7 +305,6 @@ public:
     virtual void setup(const MPI_Comm& comm) = 0;
 
 protected:
-    int3 resolution_;       ///< number of grid points along each dimension
     cudaArray *fieldArray_; ///< contains the field data
 
     /// Additional distance along each direction in which to store the field data around the local subdomain.
@@ -123,6 +315,49 @@ protected:
         \param [in] fieldDevPtr The scalar values at each grid point (x is the fast index)
     */
     void _setupArrayTexture(const float *fieldDevPtr);
+
+    /** \brief store the bricks of the given grid data that intersect the narrow band
+        \param [in] fieldHostPtr The scalar values at each grid point (x is the fast index)
+    */
+    void _setupNarrowBand(const float *fieldHostPtr);
+
+    /** \brief store the given grid data with the storage selected at construction
+        \param [in,out] fieldData The scalar values at each grid point (x is the fast index); the device data must be up to date
+    */
+    void _setupData(PinnedBuffer<float>& fieldData);
+
+private:
+    DeviceBuffer<int> brickMapStorage_;    ///< storage of brickMap_
+    DeviceBuffer<float> brickDataStorage_; ///< storage of brickData_
 };
 
+/** \brief compute the gradient of a field on the device
+    \param [in] field The field
+    \param [in] x The position at which to compute the gradient
+    \param [in] h The step size used to compute the gradient with finite differences, if needed
+    \return The gradient of \p field at \p x; analytic if the field uses cubic interpolation
+
+    This overload is selected instead of the generic finite differences for fields.
+ */
+inline __D__ real3 computeGradient(const FieldDeviceHandler& field, real3 x, real h)
+{
+    return field.gradient(x, h);
+}
+
+/** \brief compute the value of a field and, where needed, its gradient on the device
+    \param [in] field The field
+    \param [in] x The position at which to evaluate the field
+    \param [in] h The step size used to compute the gradient with finite differences, if needed
+    \param [in] gradientThreshold The gradient is computed only where the value is larger than minus this threshold
+    \param [out] grad The gradient of \p field at \p x, or zero where it is not needed
+    \return The value of \p field at \p x
+
+    This overload is selected instead of the generic one for fields; with cubic interpolation,
+    it reads the grid nodes once for both the value and the gradient.
+ */
+inline __D__ real computeValueAndGradient(const FieldDeviceHandler& field, real3 x, real h, real gradientThreshold, real3 *grad)
+{
+    return field.valueAndGradient(x, h, gradientThreshold, grad);
+}
+
 } // namespace mirheo
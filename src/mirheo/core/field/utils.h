@@ -31,4 +31,21 @@ inline __D__ real3 computeGradient(const FieldHandler& field, real3 x, real h)
     return (1.0_r / (2.0_r * h)) * diff;
 }
 
+/** \brief compute the value of a scalar field and, where needed, its gradient using finite differences on the device
+    \tparam FieldHandler Type of device handler describing the field. Must contain parenthesis operator
+    \param [in] field The functor that describes the continuous scalar field
+    \param [in] x The position at which to evaluate the field
+    \param [in] h The step size used to compute the gradient
+    \param [in] gradientThreshold The gradient is computed only where the value is larger than minus this threshold
+    \param [out] grad The approximation of the gradient of \p field at \p x, or zero where it is not needed
+    \return The value of \p field at \p x
+ */
+template <typename FieldHandler>
+inline __D__ real computeValueAndGradient(const FieldHandler& field, real3 x, real h, real gradientThreshold, real3 *grad)
+{
+    const real val = field(x);
+    *grad = val > -gradientThreshold ? computeGradient(field, x, h) : make_real3(0.0_r);
+    return val;
+}
+
 } // namespace mirheo
@@ -0,0 +1,46 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#include "membrane_with_parameter_scales.h"
+
+#include <mirheo/core/pvs/membrane_vector.h>
+
+namespace mirheo
+{
+
+MembraneWithParameterScalesIC::MembraneWithParameterScalesIC(const std::vector<ComQ>& comQ,
+                                                             const std::vector<real4>& scales,
+                                                             real globalScale) :
+    MembraneIC(comQ, globalScale),
+    scales_(scales)
+{
+    if (comQ.size() != scales.size())
+        die("MembraneWithParameterScalesIC: expected the same number of scales (%zu) as objects (%zu)",
+            scales.size(), comQ.size());
+}
+
+MembraneWithParameterScalesIC::~MembraneWithParameterScalesIC() = default;
+
+void MembraneWithParameterScalesIC::exec(const MPI_Comm& comm, ParticleVector *pv, cudaStream_t stream)
+{
+    MembraneIC::exec(comm, pv, stream);
+
+    auto ov = static_cast<MembraneVector*>(pv);
+    const auto domain = pv->getState()->domain;
+    const auto map = createMap(domain);
+    const int nObjsLocal = static_cast<int>(map.size());
+
+    ov->requireDataPerObject<real4>(channel_names::membraneParameterScales, DataManager::PersistenceMode::Active);
+    LocalObjectVector *lov = ov->local();
+
+    auto& scalesBuff = *lov->dataPerObject.getData<real4>(channel_names::membraneParameterScales);
+
+    for (int objId = 0; objId < nObjsLocal; ++objId)
+    {
+        const int srcId = map[objId];
+        scalesBuff[objId] = scales_[srcId];
+    }
+    scalesBuff.uploadToDevice(stream);
+
+    info("Initialized %d '%s' membrane parameter scales", nObjsLocal, ov->getCName());
+}
+
+} // namespace mirheo
@@ -0,0 +1,35 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include "membrane.h"
+
+namespace mirheo
+{
+
+/** \brief Initialize MembraneVector objects with per-membrane parameter scales
+
+    See MembraneIC.
+    Attach an additional field to each membrane that scales the membrane forces
+    (see \c channel_names::membraneParameterScales).
+    This allows to simulate an ensemble of independent membranes with different properties
+    within a single MembraneVector, e.g. for parameter studies.
+*/
+class MembraneWithParameterScalesIC : public MembraneIC
+{
+public:
+    /** \brief Construct a MembraneWithParameterScalesIC object
+        \param [in] comQ List of (position, orientation) corresponding to each object.
+                    The size of the list is the number of membrane objects that will be initialized.
+        \param [in] scales List of (shear, bending, constraints, viscosity) force scales. must have the same size as \p comQ.
+        \param [in] globalScale scale the membranes by this scale when placing the initial vertices.
+    */
+    MembraneWithParameterScalesIC(const std::vector<ComQ>& comQ, const std::vector<real4>& scales, real globalScale = 1.0);
+    ~MembraneWithParameterScalesIC();
+
+    void exec(const MPI_Comm& comm, ParticleVector *pv, cudaStream_t stream) override;
+
+private:
+    std::vector<real4> scales_;
+};
+
+} // namespace mirheo
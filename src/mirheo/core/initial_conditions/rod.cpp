@@ -134,31 +134,28 @@ void RodIC::exec(const MPI_Comm& comm, ParticleVector *pv, cudaStream_t stream)
 
     assert(objSize == static_cast<int>(positions.size()));
 
-    for (auto& entry : comQ_)
+    for (const int srcId : createMap(domain))
     {
-        real3 com = entry.r;
+        const auto& entry = comQ_[srcId];
+        const real3 com = domain.global2local(entry.r);
         const auto q = Quaternion<real>::createFromComponents(entry.q).normalized();
 
-        if (domain.inSubDomain(com))
-        {
-            com = domain.global2local(com);
-            int oldSize = rv->local()->size();
-            rv->local()->resize(oldSize + objSize, stream);
-
-            real4 *pos = rv->local()->positions() .data();
-            real4 *vel = rv->local()->velocities().data();
+        int oldSize = rv->local()->size();
+        rv->local()->resize(oldSize + objSize, stream);
 
-            for (int i = 0; i < objSize; i++)
-            {
-                const real3 r = com + q.rotate(positions[i]);
-                const Particle p {{r.x, r.y, r.z, 0._r}, make_real4(0._r)};
+        real4 *pos = rv->local()->positions() .data();
+        real4 *vel = rv->local()->velocities().data();
 
-                pos[oldSize + i] = p.r2Real4();
-                vel[oldSize + i] = p.u2Real4();
-            }
+        for (int i = 0; i < objSize; i++)
+        {
+            const real3 r = com + q.rotate(positions[i]);
+            const Particle p {{r.x, r.y, r.z, 0._r}, make_real4(0._r)};
 
-            nObjs++;
+            pos[oldSize + i] = p.r2Real4();
+            vel[oldSize + i] = p.u2Real4();
         }
+
+        nObjs++;
     }
 
     rv->local()->positions() .uploadToDevice(stream);
@@ -169,5 +166,17 @@ void RodIC::exec(const MPI_Comm& comm, ParticleVector *pv, cudaStream_t stream)
     info("Initialized %d '%s' rods", nObjs, rv->getCName());
 }
 
+std::vector<int> RodIC::createMap(DomainInfo domain) const
+{
+    std::vector<int> map;
+    for (size_t i = 0; i < comQ_.size(); ++i)
+    {
+        const real3 com = comQ_[i].r;
+        if (domain.inSubDomain(com))
+            map.push_back(static_cast<int>(i));
+    }
+    return map;
+}
+
 
 } // namespace mirheo
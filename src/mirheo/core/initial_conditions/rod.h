@@ -4,6 +4,7 @@
 #include "interface.h"
 
 #include <mirheo/core/datatypes.h>
+#include <mirheo/core/domain.h>
 
 #include <functional>
 #include <string>
@@ -44,6 +45,14 @@ public:
 
     void exec(const MPI_Comm& comm, ParticleVector *pv, cudaStream_t stream) override;
 
+protected:
+    /** \brief create a list which contains the indices of all rods in the current subdomain.
+        \param [in] domain Domain information
+
+        The indices correspond to the indices of the comQ_ member variable, in the order of the created rods.
+    */
+    std::vector<int> createMap(DomainInfo domain) const;
+
 private:
     std::vector<ComQ> comQ_;
     MappingFunc3D centerLine_;
@@ -0,0 +1,46 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#include "rod_with_parameter_scales.h"
+
+#include <mirheo/core/pvs/rod_vector.h>
+
+namespace mirheo
+{
+
+RodWithParameterScalesIC::RodWithParameterScalesIC(const std::vector<ComQ>& comQ, const std::vector<real3>& scales,
+                                                   MappingFunc3D centerLine, MappingFunc1D torsion, real a,
+                                                   real3 initialMaterialFrame) :
+    RodIC(comQ, centerLine, torsion, a, initialMaterialFrame),
+    scales_(scales)
+{
+    if (comQ.size() != scales.size())
+        die("RodWithParameterScalesIC: expected the same number of scales (%zu) as objects (%zu)",
+            scales.size(), comQ.size());
+}
+
+RodWithParameterScalesIC::~RodWithParameterScalesIC() = default;
+
+void RodWithParameterScalesIC::exec(const MPI_Comm& comm, ParticleVector *pv, cudaStream_t stream)
+{
+    RodIC::exec(comm, pv, stream);
+
+    auto rv = static_cast<RodVector*>(pv);
+    const auto domain = pv->getState()->domain;
+    const auto map = createMap(domain);
+    const int nObjsLocal = static_cast<int>(map.size());
+
+    rv->requireDataPerObject<real3>(channel_names::rodParameterScales, DataManager::PersistenceMode::Active);
+    LocalRodVector *lrv = rv->local();
+
+    auto& scalesBuff = *lrv->dataPerObject.getData<real3>(channel_names::rodParameterScales);
+
+    for (int objId = 0; objId < nObjsLocal; ++objId)
+    {
+        const int srcId = map[objId];
+        scalesBuff[objId] = scales_[srcId];
+    }
+    scalesBuff.uploadToDevice(stream);
+
+    info("Initialized %d '%s' rod parameter scales", nObjsLocal, rv->getCName());
+}
+
+} // namespace mirheo
@@ -0,0 +1,39 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include "rod.h"
+
+namespace mirheo
+{
+
+/** \brief Initialize RodVector objects with per-rod parameter scales
+
+    See RodIC.
+    Attach an additional field to each rod that scales the rod forces
+    (see \c channel_names::rodParameterScales).
+    This allows to have rods with different elastic properties within a single RodVector.
+*/
+class RodWithParameterScalesIC : public RodIC
+{
+public:
+    /** \brief Construct a RodWithParameterScalesIC object
+        \param [in] comQ list of center of mass and orientation of each rod.
+        \param [in] scales List of (bounds, bending, twist) force scales. must have the same size as \p comQ.
+        \param centerLine Function describing the centerline in the frame of reference of the rod
+        \param torsion Function describing the torsion along the centerline.
+        \param a The width of the rod (the cross particles are separated by \p a).
+        \param initialMaterialFrame If set, this describes the orientation  of the local material frame at the start of the rod (in the object frame of reference).
+        If not set, this is chosen arbitrarily.
+    */
+    RodWithParameterScalesIC(const std::vector<ComQ>& comQ, const std::vector<real3>& scales,
+                             MappingFunc3D centerLine, MappingFunc1D torsion, real a,
+                             real3 initialMaterialFrame = DefaultFrame);
+    ~RodWithParameterScalesIC();
+
+    void exec(const MPI_Comm& comm, ParticleVector *pv, cudaStream_t stream) override;
+
+private:
+    std::vector<real3> scales_;
+};
+
+} // namespace mirheo
@@ -7,7 +7,9 @@
 #include "forcing_terms/periodic_poiseuille.h"
 #include "minimize.h"
 #include "oscillate.h"
+#include "rigid_motion.h"
 #include "rigid_vv.h"
+#include "rod_constraints.h"
 #include "sub_step.h"
 #include "translate.h"
 #include "vv.h"
@@ -29,21 +31,22 @@ createMinimize(const MirState *state, const std::string& name, real maxDisplacem
 }
 
 inline std::shared_ptr<IntegratorVV<ForcingTermNone>>
-createVV(const MirState *state, const std::string& name)
+createVV(const MirState *state, const std::string& name, bool resetForces)
 {
     ForcingTermNone forcing;
-    return std::make_shared<IntegratorVV<ForcingTermNone>> (state, name, forcing);
+    return std::make_shared<IntegratorVV<ForcingTermNone>> (state, name, forcing, resetForces);
 }
 
 inline std::shared_ptr<IntegratorVV<ForcingTermConstDP>>
-createVV_constDP(const MirState *state, const std::string& name, real3 extraForce)
+createVV_constDP(const MirState *state, const std::string& name, real3 extraForce, bool resetForces)
 {
     ForcingTermConstDP forcing(extraForce);
-    return std::make_shared<IntegratorVV<ForcingTermConstDP>> (state, name, forcing);
+    return std::make_shared<IntegratorVV<ForcingTermConstDP>> (state, name, forcing, resetForces);
 }
 
 inline std::shared_ptr<IntegratorVV<ForcingTermPeriodicPoiseuille>>
-createVV_PeriodicPoiseuille(const MirState *state, const std::string& name, real force, std::string direction)
+createVV_PeriodicPoiseuille(const MirState *state, const std::string& name, real force, std::string direction,
+                            bool resetForces)
 {
     ForcingTermPeriodicPoiseuille::Direction dir;
     if      (direction == "x") dir = ForcingTermPeriodicPoiseuille::Direction::x;
@@ -52,7 +55,7 @@ createVV_PeriodicPoiseuille(const MirState *state, const std::string& name, real
     else die("Direction can only be 'x' or 'y' or 'z'");
 
     ForcingTermPeriodicPoiseuille forcing(force, dir);
-    return std::make_shared<IntegratorVV<ForcingTermPeriodicPoiseuille>> (state, name, forcing);
+    return std::make_shared<IntegratorVV<ForcingTermPeriodicPoiseuille>> (state, name, forcing, resetForces);
 }
 
 inline std::shared_ptr<IntegratorConstOmega>
@@ -73,6 +76,13 @@ createOscillating(const MirState *state, const std::string& name, real3 velocity
     return std::make_shared<IntegratorOscillate> (state, name, velocity, period);
 }
 
+inline std::shared_ptr<IntegratorRigidMotion>
+createRigidMotion(const MirState *state, const std::string& name, real3 velocity, real3 omega, real3 center, real period)
+{
+    VelocityFieldRigidMotion motion(velocity, omega, center, period);
+    return std::make_shared<IntegratorRigidMotion> (state, name, motion);
+}
+
 inline std::shared_ptr<IntegratorVVRigid>
 createRigidVV(const MirState *state, const std::string& name)
 {
@@ -86,6 +96,13 @@ createSubStep(const MirState *state, const std::string& name, int substeps,
     return std::make_shared<IntegratorSubStep> (state, name, substeps, fastForces);
 }
 
+inline std::shared_ptr<IntegratorRodConstraints>
+createRodConstraints(const MirState *state, const std::string& name, const BaseRodInteraction *rodForces,
+                     int nIterations, int substeps, const std::vector<Interaction*>& fastForces)
+{
+    return std::make_shared<IntegratorRodConstraints> (state, name, rodForces, nIterations, substeps, fastForces);
+}
+
 /** \brief Integrator factory. Instantiate the correct integrator depending on the snapshot parameters.
     \param [in] state The global state of the system.
     \param [in] loader The \c Loader object. Provides load context and unserialization functions.
@@ -21,9 +21,10 @@ namespace integration_kernels
  *
  * Will read positions from \c oldPositions channel and write to positions
  * Will read velocities from velocities and write to velocities
+ * If \p resetForces is set, the forces are set to zero once read
  */
 template<typename Transform>
-__global__ void integrate(PVviewWithOldParticles pvView, const real dt, Transform transform)
+__global__ void integrate(PVviewWithOldParticles pvView, const real dt, Transform transform, bool resetForces)
 {
     const int pid = blockIdx.x * blockDim.x + threadIdx.x;
     if (pid >= pvView.size) return;
@@ -38,13 +39,24 @@ __global__ void integrate(PVviewWithOldParticles pvView, const real dt, Transfor
 
     writeNoCache(pvView.positions  + pid, p.r2Real4());
     writeNoCache(pvView.velocities + pid, p.u2Real4());
+
+    if (resetForces)
+        pvView.forces[pid] = make_real4(0.0_r, 0.0_r, 0.0_r, 0.0_r);
 }
 
 } // namespace integration_kernels
 
 
+/** \brief Advance the local particles of a ParticleVector with the given transform.
+    \param [in,out] pv The ParticleVector to advance
+    \param [in] dt The time step
+    \param [in] transform The integration scheme (see integration_kernels::integrate())
+    \param [in] stream The stream used for execution
+    \param [in] resetForces If true, the forces are set to zero in the same sweep, which saves a separate clear
+           of the forces before the next force computation (see LocalParticleVector::setNumClearedForces())
+ */
 template<typename Transform>
-static void integrate(ParticleVector *pv, real dt, Transform transform, cudaStream_t stream)
+static void integrate(ParticleVector *pv, real dt, Transform transform, cudaStream_t stream, bool resetForces = false)
 {
     constexpr int nthreads = 128;
 
@@ -55,7 +67,10 @@ static void integrate(ParticleVector *pv, real dt, Transform transform, cudaStre
     SAFE_KERNEL_LAUNCH(
         integration_kernels::integrate,
         getNblocks(pvView.size, nthreads), nthreads, 0, stream,
-        pvView, dt, transform );
+        pvView, dt, transform, resetForces );
+
+    if (resetForces)
+        pv->local()->setNumClearedForces(pvView.size);
 }
 
 } // namespace mirheo
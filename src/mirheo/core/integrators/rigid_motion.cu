@@ -0,0 +1,39 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#include "rigid_motion.h"
+#include "integration_kernel.h"
+
+#include <mirheo/core/logger.h>
+#include <mirheo/core/pvs/particle_vector.h>
+
+namespace mirheo
+{
+
+IntegratorRigidMotion::IntegratorRigidMotion(const MirState *state, const std::string& name, VelocityFieldRigidMotion motion) :
+    Integrator(state, name),
+    motion_(motion)
+{}
+
+IntegratorRigidMotion::~IntegratorRigidMotion() = default;
+
+void IntegratorRigidMotion::execute(ParticleVector *pv, cudaStream_t stream)
+{
+    const auto t = static_cast<real>(getState()->currentTime);
+    const DomainInfo domain = getState()->domain;
+
+    VelocityFieldRigidMotion now  = motion_;
+    VelocityFieldRigidMotion next = motion_;
+    now .setup(t,                  domain);
+    next.setup(t + getState()->dt, domain);
+
+    // the transform is applied exactly, so that the particles do not drift away from the wall
+    auto move = [now, next, domain] __device__ (Particle& p, real3 f, real invm, real dt)
+    {
+        p.r += now.displacementTo(next, domain.local2global(p.r));
+        p.u = next(p.r);
+    };
+
+    integrate(pv, getState()->dt, move, stream);
+    invalidatePV_(pv);
+}
+
+} // namespace mirheo
@@ -0,0 +1,33 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include "interface.h"
+
+#include <mirheo/core/walls/velocity_field/rigid_motion.h>
+
+namespace mirheo
+{
+
+/** \brief Move ParticleVector particles rigidly, following a VelocityFieldRigidMotion.
+
+    The positions are moved with the exact rigid transform between two time steps and the velocities
+    are set to the one of the motion, regardless of the forces.
+    This is meant to move the frozen particles of a MovingSDFWall together with the wall.
+ */
+class IntegratorRigidMotion : public Integrator
+{
+public:
+    /** \param [in] state The global state of the system. The time step and domain used during the execution are passed through this object.
+        \param [in] name The name of the integrator.
+        \param [in] motion The rigid motion; must be the same as the one of the wall.
+    */
+    IntegratorRigidMotion(const MirState *state, const std::string& name, VelocityFieldRigidMotion motion);
+    ~IntegratorRigidMotion();
+
+    void execute(ParticleVector *pv, cudaStream_t stream) override;
+
+private:
+    VelocityFieldRigidMotion motion_; ///< the motion, set up at time 0
+};
+
+} // namespace mirheo
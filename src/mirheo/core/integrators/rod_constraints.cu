@@ -0,0 +1,287 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#include "rod_constraints.h"
+#include "integration_kernel.h"
+
+#include <mirheo/core/interactions/interface.h>
+#include <mirheo/core/interactions/rod/base_rod.h>
+#include <mirheo/core/logger.h>
+#include <mirheo/core/pvs/rod_vector.h>
+#include <mirheo/core/pvs/views/rv.h>
+#include <mirheo/core/utils/common.h>
+#include <mirheo/core/utils/cuda_common.h>
+#include <mirheo/core/utils/kernel_launch.h>
+
+namespace mirheo
+{
+
+namespace rod_constraints_kernels
+{
+
+/// Equilibrium lengths between the particles of a segment; see GPU_RodBoundsParameters
+struct SegmentLengths
+{
+    real lcenter; ///< between neighbouring particles on the center line
+    real lcross;  ///< between 2 opposite particles on the material frame
+    real ldiag;   ///< between particles of the material frame and of the center line
+    real lring;   ///< between neighbouring particles on the material frame
+};
+
+/** SHAKE correction of a single length constraint between two particles of equal masses.
+    The correction is applied along the bond vector at the beginning of the time step.
+ */
+__device__ inline void satisfyConstraint(real3& ri, real3& rj, const real3& ri0, const real3& rj0, real l)
+{
+    const real3 dr0 = ri0 - rj0;
+    const real3 dr  = ri  - rj;
+    const real denom = 4.0_r * dot(dr, dr0);
+
+    if (math::abs(denom) < 1e-6_r * l * l)
+        return;
+
+    const real lambda = (dot(dr, dr) - l * l) / denom;
+    ri -= lambda * dr0;
+    rj += lambda * dr0;
+}
+
+/** One SHAKE sweep over the constraints of the segments of given parity.
+    Segments with the same parity do not share any particle, so each of them is processed by one thread.
+ */
+__global__ void satisfySegmentConstraints(RVviewWithOldParticles view, SegmentLengths lengths, int parity)
+{
+    const int nPerRod = (view.nSegments + 1 - parity) / 2;
+    const int i = threadIdx.x + blockIdx.x * blockDim.x;
+    const int rodId     = i / nPerRod;
+    const int segmentId = 2 * (i % nPerRod) + parity;
+
+    if (rodId     >= view.nObjects ) return;
+    if (segmentId >= view.nSegments) return;
+
+    const int start = view.objSize * rodId + segmentId * 5;
+
+    real3 r0 = make_real3(view.positions[start + 0]);
+    real3 u0 = make_real3(view.positions[start + 1]);
+    real3 u1 = make_real3(view.positions[start + 2]);
+    real3 v0 = make_real3(view.positions[start + 3]);
+    real3 v1 = make_real3(view.positions[start + 4]);
+    real3 r1 = make_real3(view.positions[start + 5]);
+
+    const real3 r0Old = make_real3(view.oldPositions[start + 0]);
+    const real3 u0Old = make_real3(view.oldPositions[start + 1]);
+    const real3 u1Old = make_real3(view.oldPositions[start + 2]);
+    const real3 v0Old = make_real3(view.oldPositions[start + 3]);
+    const real3 v1Old = make_real3(view.oldPositions[start + 4]);
+    const real3 r1Old = make_real3(view.oldPositions[start + 5]);
+
+#define CONSTRAINT(a, b, l) satisfyConstraint(a, b, a##Old, b##Old, lengths. l)
+
+    CONSTRAINT(r0, u0, ldiag);
+    CONSTRAINT(r0, u1, ldiag);
+    CONSTRAINT(r0, v0, ldiag);
+    CONSTRAINT(r0, v1, ldiag);
+
+    CONSTRAINT(r1, u0, ldiag);
+    CONSTRAINT(r1, u1, ldiag);
+    CONSTRAINT(r1, v0, ldiag);
+    CONSTRAINT(r1, v1, ldiag);
+
+    CONSTRAINT(u0, v0, lring);
+    CONSTRAINT(v0, u1, lring);
+    CONSTRAINT(u1, v1, lring);
+    CONSTRAINT(v1, u0, lring);
+
+    CONSTRAINT(u0, u1, lcross);
+    CONSTRAINT(v0, v1, lcross);
+
+    CONSTRAINT(r0, r1, lcenter);
+
+#undef CONSTRAINT
+
+    auto store = [&](int id, real3 r)
+    {
+        const real4 p = view.positions[start + id];
+        view.positions[start + id] = make_real4(r.x, r.y, r.z, p.w);
+    };
+
+    store(0, r0);
+    store(1, u0);
+    store(2, u1);
+    store(3, v0);
+    store(4, v1);
+    store(5, r1);
+}
+
+/// set the velocities to the constrained displacements over the time step
+__global__ void updateVelocities(PVviewWithOldParticles view, real dt)
+{
+    const int pid = threadIdx.x + blockIdx.x * blockDim.x;
+    if (pid >= view.size) return;
+
+    const real3 r  = make_real3(view.positions   [pid]);
+    const real3 r0 = make_real3(view.oldPositions[pid]);
+    const real4 u  = view.velocities[pid];
+    const real3 v  = (r - r0) / dt;
+
+    view.velocities[pid] = make_real4(v.x, v.y, v.z, u.w);
+}
+
+} // namespace rod_constraints_kernels
+
+IntegratorRodConstraints::IntegratorRodConstraints(const MirState *state, const std::string& name,
+                                                   const BaseRodInteraction *rodForces,
+                                                   int nIterations, int substeps,
+                                                   const std::vector<Interaction*>& fastForces) :
+    Integrator(state, name),
+    nIterations_(nIterations),
+    substeps_(substeps),
+    fastForces_(fastForces),
+    subState_(*state)
+{
+    if (rodForces == nullptr)
+        die("Integrator '%s' needs the rod forces defining the equilibrium lengths", getCName());
+
+    const auto& rodParams = rodForces->getParameters();
+    a0_ = rodParams.a0;
+    l0_ = rodParams.l0;
+
+    if (a0_ <= 0.0_r || l0_ <= 0.0_r)
+        die("Integrator '%s': the rod forces '%s' must have positive equilibrium lengths (given a0 = %g, l0 = %g)",
+            getCName(), rodForces->getCName(), a0_, l0_);
+
+    if (rodParams.ksCenter != 0.0_r || rodParams.ksFrame != 0.0_r)
+        warn("Integrator '%s': the rod forces '%s' have non zero bound stiffnesses; "
+             "the bounds are already enforced by the constraints", getCName(), rodForces->getCName());
+
+    if (nIterations_ < 1)
+        die("Integrator '%s' needs at least one iteration (given %d)", getCName(), nIterations_);
+
+    if (substeps_ < 1)
+        die("Integrator '%s' needs at least one sub step (given %d)", getCName(), substeps_);
+
+    for (auto ff : fastForces_)
+    {
+        if (!ff->isSelfObjectInteraction())
+            die("IntegratorRodConstraints '%s': expects a self-interaction (given '%s').",
+                getCName(), ff->getCName());
+
+        if (auto rf = dynamic_cast<const BaseRodInteraction*>(ff))
+        {
+            const auto& p = rf->getParameters();
+            if (p.a0 != a0_ || p.l0 != l0_)
+                die("IntegratorRodConstraints '%s': the fast forces '%s' have equilibrium lengths a0 = %g, l0 = %g "
+                    "different from those of the constraints (a0 = %g, l0 = %g)",
+                    getCName(), rf->getCName(), p.a0, p.l0, a0_, l0_);
+        }
+    }
+
+    debug("setup rod constraints integrator '%s' with %d iterations and %d sub steps",
+          getCName(), nIterations_, substeps_);
+}
+
+IntegratorRodConstraints::~IntegratorRodConstraints() = default;
+
+void IntegratorRodConstraints::setPrerequisites(ParticleVector *pv)
+{
+    if (dynamic_cast<RodVector*>(pv) == nullptr)
+        die("Integrator '%s' only works with rod vectors, can't work with %s", getCName(), pv->getCName());
+
+    for (auto ff : fastForces_)
+        ff->setPrerequisites(pv, pv, nullptr, nullptr);
+}
+
+void IntegratorRodConstraints::execute(ParticleVector *pv, cudaStream_t stream)
+{
+    auto rv = dynamic_cast<RodVector*>(pv);
+
+    debug("Integrating %d rods '%s' with constraints, timestep is %f",
+          rv->local()->getNumObjects(), rv->getCName(), getState()->dt);
+
+    if (substeps_ == 1 && fastForces_.empty())
+    {
+        _constrainedStep(rv, getState()->dt, stream);
+        invalidatePV_(pv);
+        return;
+    }
+
+    slowForces_.copyFromDevice(pv->local()->forces(), stream);
+    previousPositions_.copyFromDevice(pv->local()->positions(), stream);
+
+    _updateSubState();
+
+    for (auto& ff : fastForces_)
+        ff->setState(&subState_);
+
+    for (int substep = 0; substep < substeps_; ++substep)
+    {
+        if (substep != 0)
+            pv->local()->forces().copy(slowForces_, stream);
+
+        for (auto ff : fastForces_)
+            ff->local(pv, pv, nullptr, nullptr, stream);
+
+        _constrainedStep(rv, subState_.dt, stream);
+
+        subState_.currentTime += subState_.dt;
+        subState_.currentStep ++;
+    }
+
+    // restore previous positions into old_particles channel
+    pv->local()->dataPerParticle.getData<real4>(channel_names::oldPositions)->copy(previousPositions_, stream);
+
+    for (auto& ff : fastForces_)
+        ff->setState(getState());
+
+    invalidatePV_(pv);
+}
+
+void IntegratorRodConstraints::_constrainedStep(RodVector *rv, real dt, cudaStream_t stream)
+{
+    auto vv = [] __device__ (Particle& p, real3 f, real invm, real dt)
+    {
+        p.u += f * invm * dt;
+        p.r += p.u * dt;
+    };
+
+    integrate(rv, dt, vv, stream);
+
+    RVviewWithOldParticles view(rv, rv->local());
+
+    rod_constraints_kernels::SegmentLengths lengths;
+    lengths.lcenter = l0_;
+    lengths.lcross  = a0_;
+    lengths.lring   = 0.5_r * math::sqrt(2.0_r) * a0_;
+    lengths.ldiag   = 0.5_r * math::sqrt(a0_*a0_ + l0_*l0_);
+
+    const int nthreads = 128;
+
+    for (int iter = 0; iter < nIterations_; ++iter)
+    {
+        for (int parity = 0; parity < 2; ++parity)
+        {
+            const int nPerRod = (view.nSegments + 1 - parity) / 2;
+            const int nblocks = getNblocks(view.nObjects * nPerRod, nthreads);
+
+            if (nPerRod == 0)
+                continue;
+
+            SAFE_KERNEL_LAUNCH(
+                rod_constraints_kernels::satisfySegmentConstraints,
+                nblocks, nthreads, 0, stream,
+                view, lengths, parity);
+        }
+    }
+
+    PVviewWithOldParticles pvView(rv, rv->local());
+
+    SAFE_KERNEL_LAUNCH(
+        rod_constraints_kernels::updateVelocities,
+        getNblocks(pvView.size, nthreads), nthreads, 0, stream,
+        pvView, dt);
+}
+
+void IntegratorRodConstraints::_updateSubState()
+{
+    subState_ = *getState();
+    subState_.dt = getState()->dt / static_cast<real>(substeps_);
+}
+
+} // namespace mirheo
@@ -0,0 +1,78 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include "interface.h"
+
+#include <mirheo/core/containers.h>
+#include <mirheo/core/datatypes.h>
+
+#include <vector>
+
+namespace mirheo
+{
+
+class BaseRodInteraction;
+class Interaction;
+class RodVector;
+
+/** \brief Advance RodVector objects with rigid bounds enforced by constraints.
+
+    The particles are first advanced with the velocity-Verlet scheme.
+    The lengths between the particles of each segment (center line and material frame) are then
+    restored with SHAKE iterations, and the velocities are set to the constrained displacement
+    divided by the time step.
+    The constraints replace the stiff bound forces of the rod model, which usually limit the time step.
+
+    Optionally, each time step can be split into sub steps during which the "fast" forces (e.g. bending and twist)
+    are updated while the other forces are kept constant, similarly to IntegratorSubStep.
+
+    Constraints of even and odd segments of a rod do not share particles; they are processed in two
+    alternating phases, each segment being handled by a single thread.
+
+    \rst
+    .. warning::
+        The fast forces should NOT be registered in the \c Simulation.
+        The bound stiffness of the rod interaction should be set to zero as the bounds are already constrained.
+    \endrst
+ */
+class IntegratorRodConstraints : public Integrator
+{
+public:
+    /** \brief construct a IntegratorRodConstraints object.
+        \param [in] state The global state of the system. The time step and domain used during the execution are passed through this object.
+        \param [in] name The name of the integrator.
+        \param [in] rodForces The rod interaction of the rods; its equilibrium lengths a0 and l0 define the constraints.
+        \param [in] nIterations Number of SHAKE iterations per (sub) time step.
+        \param [in] substeps Number of sub steps.
+        \param [in] fastForces Internal interactions executed at each sub step.
+
+        This constructor will die if the fast forces need to exchange ghost particles with other ranks,
+        or if the fast rod forces have different equilibrium lengths than \p rodForces.
+    */
+    IntegratorRodConstraints(const MirState *state, const std::string& name, const BaseRodInteraction *rodForces,
+                             int nIterations, int substeps, const std::vector<Interaction*>& fastForces);
+
+    ~IntegratorRodConstraints();
+
+    void execute(ParticleVector *pv, cudaStream_t stream) override;
+
+    void setPrerequisites(ParticleVector *pv) override;
+
+private:
+    void _constrainedStep(RodVector *rv, real dt, cudaStream_t stream);
+    void _updateSubState();
+
+private:
+    real a0_; ///< equilibrium length between two opposite material frame particles
+    real l0_; ///< equilibrium length between two consecutive center line particles
+    int nIterations_; ///< number of SHAKE iterations
+    int substeps_;    ///< number of sub steps
+
+    std::vector<Interaction*> fastForces_; ///< interactions (self) called `substeps` times per time step
+    MirState subState_;
+
+    DeviceBuffer<Force> slowForces_ {};
+    DeviceBuffer<real4> previousPositions_ {};
+};
+
+} // namespace mirheo
@@ -7,7 +7,7 @@
 #include "forcing_terms/periodic_poiseuille.h"
 
 #include <mirheo/core/logger.h>
-#include <mirheo/core/pvs/particle_vector.h>
+#include <mirheo/core/pvs/object_vector.h>
 #include <mirheo/core/utils/config.h>
 #include <mirheo/core/utils/reflection.h>
 
@@ -15,16 +15,19 @@ namespace mirheo
 {
 
 template<class ForcingTerm>
-IntegratorVV<ForcingTerm>::IntegratorVV(const MirState *state, const std::string& name, ForcingTerm forcingTerm) :
+IntegratorVV<ForcingTerm>::IntegratorVV(const MirState *state, const std::string& name, ForcingTerm forcingTerm,
+                                        bool resetForces) :
     Integrator(state, name),
-    forcingTerm_(forcingTerm)
+    forcingTerm_(forcingTerm),
+    resetForces_(resetForces)
 {}
 
 template<class ForcingTerm>
 IntegratorVV<ForcingTerm>::IntegratorVV(const MirState *state, Loader& loader,
                                         const ConfigObject& object) :
     IntegratorVV(state, (const std::string&)object["name"],
-                 loader.load<ForcingTerm>(object["forcingTerm"]))
+                 loader.load<ForcingTerm>(object["forcingTerm"]),
+                 loader.load<bool>(object["resetForces"]))
 {}
 
 template<class ForcingTerm>
@@ -44,9 +47,19 @@ ConfigObject IntegratorVV<ForcingTerm>::_saveSnapshot(
 {
     ConfigObject config = Integrator::_saveSnapshot(saver, typeName);
     config.emplace("forcingTerm", saver(forcingTerm_));
+    config.emplace("resetForces", saver(resetForces_));
     return config;
 }
 
+template<class ForcingTerm>
+void IntegratorVV<ForcingTerm>::setPrerequisites(ParticleVector *pv)
+{
+    // the forces of objects are not cleared through the cell lists (see Simulation)
+    if (resetForces_ && dynamic_cast<ObjectVector*>(pv) != nullptr)
+        die("Integrator '%s' resets the forces and can not be used with the object vector '%s'",
+            getCName(), pv->getCName());
+}
+
 /**
  * The new coordinates and velocities of a particle will be computed
  * as follows:
@@ -93,7 +106,7 @@ void IntegratorVV<ForcingTerm>::execute(ParticleVector *pv, cudaStream_t stream)
         p.r += p.u * dt;
     };
 
-    integrate(pv, dt, st2, stream);
+    integrate(pv, dt, st2, stream, resetForces_);
     invalidatePV_(pv);
 }
 
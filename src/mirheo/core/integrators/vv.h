@@ -18,8 +18,12 @@ public:
     /** \param [in] state The global state of the system. The time step and domain used during the execution are passed through this object.
         \param [in] name The name of the integrator.
         \param [in] forcingTerm Additional force added to the particles.
+        \param [in] resetForces If true, the forces are set to zero in the integration kernel,
+                   which saves the separate clear of the forces at the next time step.
+                   Can only be used with ParticleVector objects that are not ObjectVector.
+                   The forces are not available after integration (e.g. to plugins).
     */
-    IntegratorVV(const MirState *state, const std::string& name, ForcingTerm forcingTerm);
+    IntegratorVV(const MirState *state, const std::string& name, ForcingTerm forcingTerm, bool resetForces = false);
 
     /// Load the integrator from a snapshot.
     IntegratorVV(const MirState *state, Loader& loader, const ConfigObject& object);
@@ -33,6 +37,7 @@ public:
       */
     void saveSnapshotAndRegister(Saver& saver);
 
+    void setPrerequisites(ParticleVector *pv) override;
     void execute(ParticleVector *pv, cudaStream_t stream) override;
 
 protected:
@@ -44,6 +49,7 @@ protected:
 
 private:
     ForcingTerm forcingTerm_;
+    bool resetForces_;
 };
 
 } // namespace mirheo
@@ -4,6 +4,7 @@
 #include "membrane/base_membrane.h"
 #include "membrane/factory.h"
 #include "obj_rod_binding.h"
+#include "rigid_contact.h"
 #include "pairwise/base_pairwise.h"
 #include "pairwise/factory.h"
 #include "pairwise/factory_helper.h"
@@ -253,6 +254,22 @@ interaction_factory::createInteractionObjRodBinding(const MirState *state, std::
     return std::make_shared<ObjectRodBindingInteraction>(state, name, torque, relAnchor, kBound);
 }
 
+std::shared_ptr<RigidContactInteraction>
+interaction_factory::createInteractionRigidContact(const MirState *state, std::string name,
+                                                  real kContact, real contactDistance,
+                                                  real viscosity, real lubricationDistance, real minGap)
+{
+    if (kContact < 0.0_r)
+        die("Interaction '%s': k_contact must be non negative, got %g", name.c_str(), kContact);
+    if (viscosity < 0.0_r)
+        die("Interaction '%s': viscosity must be non negative, got %g", name.c_str(), viscosity);
+    if (minGap <= 0.0_r)
+        die("Interaction '%s': min_gap must be positive, got %g", name.c_str(), minGap);
+
+    const RigidContactParams params {kContact, contactDistance, viscosity, lubricationDistance, minGap};
+    return std::make_shared<RigidContactInteraction>(state, name, params);
+}
+
 static bool startsWith(const std::string &text, const char *tmp)
 {
     return text.compare(0, strlen(tmp), tmp) == 0;
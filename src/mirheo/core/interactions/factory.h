@@ -16,6 +16,7 @@ class BaseMembraneInteraction;
 class BaseRodInteraction;
 class BasePairwiseInteraction;
 class ObjectRodBindingInteraction;
+class RigidContactInteraction;
 
 namespace interaction_factory
 {
@@ -40,6 +41,11 @@ std::shared_ptr<ObjectRodBindingInteraction>
 createInteractionObjRodBinding(const MirState *state, std::string name,
                                real torque, real3 relAnchor, real kBound);
 
+std::shared_ptr<RigidContactInteraction>
+createInteractionRigidContact(const MirState *state, std::string name,
+                              real kContact, real contactDistance,
+                              real viscosity, real lubricationDistance, real minGap);
+
 /** \brief Interaction factory. Instantiate the correct interaction object depending on the snapshot parameters.
     \param [in] state The global state of the system.
     \param [in] loader The \c Loader object. Provides load context and unserialization functions.
@@ -2,6 +2,7 @@
 #pragma once
 
 #include "force_kernels/common.h"
+#include "object_scales.h"
 
 namespace mirheo
 {
@@ -79,7 +80,8 @@ __device__ inline mReal3 bondTriangleForce(
         const ParticleMReal& p, int locId, int rbcId,
         const OVviewWithAreaVolume& view,
         const MembraneMeshView& mesh,
-        const GPU_CommonMembraneParameters& parameters)
+        const GPU_CommonMembraneParameters& parameters,
+        const MembraneForceScales& scales)
 {
     mReal3 f0 = make_mReal3(0.0_mr);
     const int startId = mesh.maxDegree * locId;
@@ -92,6 +94,8 @@ __device__ inline mReal3 bondTriangleForce(
     const mReal totArea   = view.area_volumes[rbcId].x;
     const mReal totVolume = view.area_volumes[rbcId].y;
 
+    const mReal fluctScale = math::sqrt(scales.viscosity);
+
 #pragma unroll 2
     for (int i = 0; i < degree; i++)
     {
@@ -104,11 +108,11 @@ __device__ inline mReal3 bondTriangleForce(
 
         const auto eq = triangleInteraction.getEquilibriumDesc(mesh, i1, i2);
 
-        f0 += triangleInteraction (p.r, p1.r, p2.r, eq)
-            + _fconstrainArea     (p.r, p1.r, p2.r, totArea,   parameters)
-            + _fconstrainVolume   (p.r, p1.r, p2.r, totVolume, parameters)
-            + _fvisc              (p,   p1,                    parameters)
-            + _ffluct             (p.r, p1.r, idv0, idv1,      parameters);
+        f0 += scales.shear       *  triangleInteraction (p.r, p1.r, p2.r, eq)
+            + scales.constraints * (_fconstrainArea     (p.r, p1.r, p2.r, totArea,   parameters)
+                                  + _fconstrainVolume   (p.r, p1.r, p2.r, totVolume, parameters))
+            + scales.viscosity   *  _fvisc              (p,   p1,                    parameters)
+            + fluctScale         *  _ffluct             (p.r, p1.r, idv0, idv1,      parameters);
 
         idv1 = idv2;
         p1   = p2;
@@ -121,7 +125,8 @@ template <class DihedralInteraction>
 __device__ inline mReal3 dihedralForce(int locId, int rbcId,
                                        const typename DihedralInteraction::ViewType& view,
                                        DihedralInteraction& dihedralInteraction,
-                                       const MembraneMeshView& mesh)
+                                       const MembraneMeshView& mesh,
+                                       mReal scale)
 {
     const int offset = rbcId * mesh.nvertices;
 
@@ -159,12 +164,12 @@ __device__ inline mReal3 dihedralForce(int locId, int rbcId,
 
         f0 += dihedralInteraction(v0, v1, v2, v3, f1);
 
-        atomicAdd(view.forces + idv1, make_real3(f1));
+        atomicAdd(view.forces + idv1, make_real3(scale * f1));
 
         v1   = v2  ; v2   = v3  ;
         idv1 = idv2; idv2 = idv3;
     }
-    return f0;
+    return scale * f0;
 }
 
 template <class TriangleInteraction, class DihedralInteraction, class Filter>
@@ -174,7 +179,8 @@ __global__ void computeMembraneForces(TriangleInteraction triangleInteraction,
                                       OVviewWithAreaVolume view,
                                       MembraneMeshView mesh,
                                       GPU_CommonMembraneParameters parameters,
-                                      Filter filter)
+                                      Filter filter,
+                                      MembraneObjectScales objectScales)
 {
     // RBC particles are at the same time mesh vertices
     assert(view.objSize == mesh.nvertices);
@@ -187,10 +193,11 @@ __global__ void computeMembraneForces(TriangleInteraction triangleInteraction,
     if (!filter.inWhiteList(rbcId)) return;
 
     const auto p = fetchParticle(view, pid);
+    const auto scales = objectScales.get(rbcId);
 
     mReal3 f;
-    f  = bondTriangleForce(triangleInteraction, p, locId, rbcId, view, mesh, parameters);
-    f += dihedralForce(locId, rbcId, dihedralView, dihedralInteraction, mesh);
+    f  = bondTriangleForce(triangleInteraction, p, locId, rbcId, view, mesh, parameters, scales);
+    f += dihedralForce(locId, rbcId, dihedralView, dihedralInteraction, mesh, scales.bending);
 
     atomicAdd(view.forces + pid, make_real3(f));
 }
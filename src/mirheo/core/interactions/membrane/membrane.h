@@ -4,6 +4,7 @@
 #include "base_membrane.h"
 #include "drivers.h"
 #include "force_kernels/parameters.h"
+#include "object_scales.h"
 #include "prerequisites.h"
 
 #include <mirheo/core/interactions/interface.h>
@@ -154,13 +155,14 @@ public:
         DihedralInteraction dihedralInteraction(dihedralParams_, scale);
         TriangleInteraction triangleInteraction(triangleParams_, mesh, scale);
         filter_.setup(mv);
+        objectScales_.setup(mv);
 
         SAFE_KERNEL_LAUNCH(
             membrane_forces_kernels::computeMembraneForces,
             nblocks, nthreads, 0, stream,
             triangleInteraction,
             dihedralInteraction, dihedralView,
-            view, meshView, devParams, filter_);
+            view, meshView, devParams, filter_, objectScales_);
 
     }
 
@@ -258,6 +260,7 @@ private:
     typename DihedralInteraction::ParametersType dihedralParams_; ///< dihedral forces parameters
     typename TriangleInteraction::ParametersType triangleParams_; ///< traingle forces parameters
     Filter filter_; ///< describes the cells to apply the forces to
+    MembraneObjectScales objectScales_; ///< optional per-membrane scaling of the forces
     StepRandomGen stepGen_; ///< RNG
 };
 
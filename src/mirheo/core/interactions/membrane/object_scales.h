@@ -0,0 +1,65 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include "force_kernels/real.h"
+
+#include <mirheo/core/pvs/membrane_vector.h>
+#include <mirheo/core/utils/cpu_gpu_defines.h>
+
+namespace mirheo
+{
+
+/// Multiplicative factors applied to each family of membrane forces of a single membrane
+struct MembraneForceScales
+{
+    mReal shear;       ///< multiplies the triangle (shear and local area) forces
+    mReal bending;     ///< multiplies the dihedral (bending and ADE) forces
+    mReal constraints; ///< multiplies the total area and volume constraint forces
+    mReal viscosity;   ///< multiplies the viscous forces; the random forces are scaled by its square root
+};
+
+/** \brief Fetch per-membrane parameter scales, if available.
+
+    The scales of each membrane are stored in the optional object channel \c channel_names::membraneParameterScales
+    as (shear, bending, constraints, viscosity).
+    When the channel does not exist, all scales are equal to 1.
+    This allows to simulate many membranes with different elastic properties (e.g. an ensemble of independent
+    replicas in a parameter study) within a single MembraneVector and a single kernel launch.
+ */
+class MembraneObjectScales
+{
+public:
+    /** \brief Set internal state of the object.
+        \param [in] mv The MembraneVector that will be used
+
+        This must be called after every change of \p mv DataManager
+     */
+    void setup(MembraneVector *mv)
+    {
+        auto& dataPerObject = mv->local()->dataPerObject;
+
+        if (dataPerObject.checkChannelExists(channel_names::membraneParameterScales))
+            scales_ = dataPerObject.getData<real4>(channel_names::membraneParameterScales)->devPtr();
+        else
+            scales_ = nullptr;
+    }
+
+    /** \brief Get the scales of a given membrane
+        \param [in] membraneId The index of the membrane
+        \return The force scales of that membrane
+     */
+    inline __D__ MembraneForceScales get(long membraneId) const
+    {
+        if (scales_ == nullptr)
+            return {1.0_mr, 1.0_mr, 1.0_mr, 1.0_mr};
+
+        const real4 s = scales_[membraneId];
+        return {static_cast<mReal>(s.x), static_cast<mReal>(s.y),
+                static_cast<mReal>(s.z), static_cast<mReal>(s.w)};
+    }
+
+private:
+    const real4 *scales_ {nullptr}; ///< Points to the MembraneVector object channel containing the scales (may be null)
+};
+
+} // namespace mirheo
@@ -0,0 +1,283 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#include "rigid_contact.h"
+
+#include <mirheo/core/analytical_shapes/api.h>
+#include <mirheo/core/pvs/rigid_ashape_object_vector.h>
+#include <mirheo/core/pvs/views/rsov.h>
+#include <mirheo/core/rigid/utils.h>
+#include <mirheo/core/utils/cuda_common.h>
+#include <mirheo/core/utils/kernel_launch.h>
+#include <mirheo/core/utils/quaternion.h>
+
+namespace mirheo
+{
+
+namespace rigid_contact_kernels
+{
+
+/// Project a point on the surface of an object with a few Newton iterations on its in/out function
+template <class Shape>
+__D__ inline real3 projectOnSurface(const Shape& shape, const RealRigidMotion& motion, real3 x)
+{
+    constexpr int nIters = 4;
+    constexpr real eps = 1e-3_r;
+    constexpr real minSlope = 1e-6_r;
+
+    real3 y = motion.q.inverseRotate(x - motion.r);
+
+    for (int i = 0; i < nIters; ++i)
+    {
+        const real f = shape.inOutFunction(y);
+        const real3 n = shape.normal(y);
+
+        // the in/out function is not necessarily a distance, e.g. for ellipsoids
+        const real slope = (shape.inOutFunction(y + eps * n) - shape.inOutFunction(y - eps * n)) / (2.0_r * eps);
+        if (math::abs(slope) < minSlope)
+            break;
+
+        y -= (f / slope) * n;
+    }
+
+    return motion.q.rotate(y) + motion.r;
+}
+
+template <class Shape>
+__D__ inline real3 getNormal(const Shape& shape, const RealRigidMotion& motion, real3 x)
+{
+    return motion.q.rotate(shape.normal(motion.q.inverseRotate(x - motion.r)));
+}
+
+/** Add the contact and lubrication force (and torque) exerted by object B on object A.
+    The closest points of the two (convex) surfaces are found by alternating projections.
+ */
+template <class ShapeA, class ShapeB>
+__D__ inline void addPairForce(const ShapeA& shapeA, const RealRigidMotion& mA,
+                               const ShapeB& shapeB, const RealRigidMotion& mB,
+                               const RigidContactParams& params, real3& force, real3& torque)
+{
+    constexpr int nAlternations = 4;
+    constexpr real eps = 1e-6_r;
+
+    real3 pB = projectOnSurface(shapeB, mB, 0.5_r * (mA.r + mB.r));
+    real3 pA = projectOnSurface(shapeA, mA, pB);
+
+    for (int i = 0; i < nAlternations; ++i)
+    {
+        pB = projectOnSurface(shapeB, mB, pA);
+        pA = projectOnSurface(shapeA, mA, pB);
+    }
+
+    // normal pointing from A to B
+    real3 n = getNormal(shapeA, mA, pA) - getNormal(shapeB, mB, pB);
+    const real nl = length(n);
+    if (nl < eps)
+        return;
+    n /= nl;
+
+    // negative when the objects overlap
+    const real h = dot(pB - pA, n);
+
+    if (h >= params.contactDistance && h >= params.lubricationDistance)
+        return;
+
+    const real3 pc = 0.5_r * (pA + pB);
+    real fn = 0.0_r;
+
+    if (h < params.contactDistance)
+        fn -= params.kContact * (params.contactDistance - h);
+
+    if (h < params.lubricationDistance)
+    {
+        const real RA = length(pA - mA.r);
+        const real RB = length(pB - mB.r);
+        const real R = RA * RB / (RA + RB);
+
+        const real3 vA = mA.vel + cross(mA.omega, pc - mA.r);
+        const real3 vB = mB.vel + cross(mB.omega, pc - mB.r);
+        const real vn = dot(vB - vA, n);
+
+        const real hreg = math::max(h, params.minGap);
+        fn += 6.0_r * static_cast<real>(M_PI) * params.viscosity * R * R * (1.0_r / hreg - 1.0_r / params.lubricationDistance) * vn;
+    }
+
+    const real3 f = fn * n;
+    force  += f;
+    torque += cross(pc - mA.r, f);
+}
+
+/// One thread per object of A; adds the forces exerted by all neighbouring objects of B
+template <class ShapeA, class ShapeB>
+__global__ void computeContactForces(RSOVview<ShapeA> viewA, RSOVview<ShapeB> viewB, ObjectCellListView cellsB,
+                                     RigidContactParams params, bool skipSelf)
+{
+    const int objId = threadIdx.x + blockIdx.x * blockDim.x;
+    if (objId >= viewA.nObjects) return;
+
+    const auto mA = toRealMotion(viewA.motions[objId]);
+
+    real3 force  {0.0_r, 0.0_r, 0.0_r};
+    real3 torque {0.0_r, 0.0_r, 0.0_r};
+
+    // the extents of B are inflated by the radius of A and the cutoff: the center of A is enough to find neighbours
+    cellsB.forEachObjectContaining(mA.r, [&](int otherId)
+    {
+        if (skipSelf && otherId == objId)
+            return;
+
+        const auto mB = toRealMotion(viewB.motions[otherId]);
+        addPairForce(viewA.shape, mA, viewB.shape, mB, params, force, torque);
+    });
+
+    if (dot(force, force) > 0.0_r)
+    {
+        atomicAdd(&viewA.motions[objId].force,  make_rigidReal3(force));
+        atomicAdd(&viewA.motions[objId].torque, make_rigidReal3(torque));
+    }
+}
+
+} // namespace rigid_contact_kernels
+
+template <class F>
+static void dispatchShape(RigidObjectVector *rov, F&& f)
+{
+#define DISPATCH(Shape)                                                   \
+    if (auto rsov = dynamic_cast<RigidShapedObjectVector<Shape>*>(rov))   \
+        return f(rsov);
+
+    ASHAPE_TABLE(DISPATCH)
+
+#undef DISPATCH
+
+    die("Rigid contact interactions can only be used with rigid objects with analytical shapes (%s is not)",
+        rov->getCName());
+}
+
+static RigidObjectVector* toRigid(ParticleVector *pv, const std::string& interactionName)
+{
+    auto rov = dynamic_cast<RigidObjectVector*>(pv);
+    if (rov == nullptr)
+        die("Interaction '%s' can only be used with rigid objects (%s is not)", interactionName.c_str(), pv->getCName());
+    return rov;
+}
+
+RigidContactInteraction::RigidContactInteraction(const MirState *state, std::string name, RigidContactParams params) :
+    Interaction(state, name),
+    params_(params)
+{
+    if (getGapCutoff() <= 0.0_r)
+        die("Interaction '%s': the contact or the lubrication distance must be positive", getCName());
+}
+
+RigidContactInteraction::~RigidContactInteraction() = default;
+
+void RigidContactInteraction::setPrerequisites(ParticleVector *pv1, ParticleVector *pv2,
+                                               __UNUSED CellList *cl1, __UNUSED CellList *cl2)
+{
+    auto check = [](auto rsov) { (void) rsov; };
+    dispatchShape(toRigid(pv1, getName()), check);
+    dispatchShape(toRigid(pv2, getName()), check);
+}
+
+void RigidContactInteraction::local(ParticleVector *pv1, ParticleVector *pv2,
+                                    __UNUSED CellList *cl1, __UNUSED CellList *cl2, cudaStream_t stream)
+{
+    auto rov1 = toRigid(pv1, getName());
+    auto rov2 = toRigid(pv2, getName());
+
+    if (rov1 == rov2)
+    {
+        _computeForces(rov1, rov1, ParticleVectorLocality::Local, true, stream);
+    }
+    else
+    {
+        _computeForces(rov1, rov2, ParticleVectorLocality::Local, false, stream);
+        _computeForces(rov2, rov1, ParticleVectorLocality::Local, false, stream);
+    }
+}
+
+void RigidContactInteraction::halo(ParticleVector *pv1, ParticleVector *pv2,
+                                   __UNUSED CellList *cl1, __UNUSED CellList *cl2, cudaStream_t stream)
+{
+    auto rov1 = toRigid(pv1, getName());
+    auto rov2 = toRigid(pv2, getName());
+
+    // each rank computes the forces on its own objects only: no reverse exchange is needed
+    _computeForces(rov1, rov2, ParticleVectorLocality::Halo, false, stream);
+
+    if (rov1 != rov2)
+        _computeForces(rov2, rov1, ParticleVectorLocality::Halo, false, stream);
+}
+
+real RigidContactInteraction::getCutoffRadius() const
+{
+    return math::max(Interaction::getCutoffRadius(), getGapCutoff());
+}
+
+real RigidContactInteraction::getGapCutoff() const
+{
+    return math::max(params_.contactDistance, params_.lubricationDistance);
+}
+
+/// Radius of the sphere centered at the object center and enclosing all its frozen particles
+real RigidContactInteraction::_getBoundingRadius(RigidObjectVector *rov)
+{
+    // the frozen particles never change: compute the radius only once per object vector
+    auto it = boundingRadii_.find(rov);
+    if (it != boundingRadii_.end())
+        return it->second;
+
+    real r2 = 0.0_r;
+    for (const auto& r : rov->initialPositions)
+        r2 = math::max(r2, dot(make_real3(r), make_real3(r)));
+
+    const real radius = math::sqrt(r2);
+    boundingRadii_[rov] = radius;
+    return radius;
+}
+
+void RigidContactInteraction::_computeForces(RigidObjectVector *rovA, RigidObjectVector *rovB,
+                                             ParticleVectorLocality localityB, bool skipSelf, cudaStream_t stream)
+{
+    dispatchShape(rovA, [&](auto rsovA)
+    {
+        dispatchShape(rovB, [&](auto rsovB)
+        {
+            this->_computeForces(rsovA, rsovB, localityB, skipSelf, stream);
+        });
+    });
+}
+
+template <class ShapeA, class ShapeB>
+void RigidContactInteraction::_computeForces(RigidShapedObjectVector<ShapeA> *rsovA, RigidShapedObjectVector<ShapeB> *rsovB,
+                                             ParticleVectorLocality localityB, bool skipSelf, cudaStream_t stream)
+{
+    const RSOVview<ShapeA> viewA(rsovA, rsovA->local());
+    const RSOVview<ShapeB> viewB(rsovB, rsovB->get(localityB));
+
+    if (viewA.nObjects == 0 || viewB.nObjects == 0)
+        return;
+
+    debug("Computing rigid contact forces on %d local '%s' objects from %d %s '%s' objects",
+          viewA.nObjects, rsovA->getCName(), viewB.nObjects,
+          getParticleVectorLocalityStr(localityB).c_str(), rsovB->getCName());
+
+    auto& cells = (localityB == ParticleVectorLocality::Local) ? localCells_ : haloCells_;
+
+    rsovB->findExtentAndCOM(stream, localityB);
+
+    // the analytical surfaces may stick out of the frozen particles
+    constexpr real surfaceTolerance = 0.5_r;
+
+    const real radiusB = _getBoundingRadius(rsovB);
+    const real margin = _getBoundingRadius(rsovA) + getGapCutoff() + surfaceTolerance;
+    cells.build(viewB, 2.0_r * radiusB + margin, margin, getState()->domain.localSize, stream);
+
+    const int nthreads = 128;
+
+    SAFE_KERNEL_LAUNCH(
+        rigid_contact_kernels::computeContactForces<ShapeA COMMA ShapeB>,
+        getNblocks(viewA.nObjects, nthreads), nthreads, 0, stream,
+        viewA, viewB, cells.getView(), params_, skipSelf );
+}
+
+} // namespace mirheo
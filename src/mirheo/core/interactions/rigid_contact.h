@@ -0,0 +1,90 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include "interface.h"
+
+#include <mirheo/core/object_cell_list.h>
+#include <mirheo/core/pvs/object_vector.h>
+
+#include <map>
+
+namespace mirheo
+{
+
+class RigidObjectVector;
+template <class Shape> class RigidShapedObjectVector;
+
+/// Parameters of the RigidContactInteraction
+struct RigidContactParams
+{
+    real kContact;            ///< stiffness of the contact force
+    real contactDistance;     ///< gap below which the contact force is active
+    real viscosity;           ///< viscosity of the solvent used for the lubrication force
+    real lubricationDistance; ///< gap below which the lubrication force is active
+    real minGap;              ///< the lubrication force is regularized at gaps smaller than this value
+};
+
+/** \brief Short range contact and lubrication forces between rigid objects with analytical shapes.
+
+    The forces are computed directly from the RigidMotion of the objects and their analytical shape,
+    not from the frozen particles.
+    This allows to prevent overlaps in dense suspensions with much fewer particles per object than
+    what a particle based repulsion would need.
+
+    For each pair of objects, the closest points on the two surfaces are found by alternating
+    projections; the resulting gap \f$ h \f$ and normal \f$ \mathbf{n} \f$ define
+    - a contact force \f$ k_c (h_c - h) \mathbf{n} \f$ when \f$ h < h_c \f$;
+    - a normal lubrication force \f$ 6 \pi \mu R^2 \left( \frac{1}{\max(h, h_{min})} - \frac{1}{h_l} \right) v_n \mathbf{n} \f$ when \f$ h < h_l \f$,
+      where \f$ v_n \f$ is the normal relative velocity at the contact point and \f$ R \f$ is the reduced
+      distance between the centers and the closest points (the reduced radius for spheres).
+
+    The forces and torques are added to the RigidMotion of the objects.
+    Neighbouring objects are found from an ObjectCellList owned by the interaction;
+    the particle cell lists of the objects are not used.
+ */
+class RigidContactInteraction : public Interaction
+{
+public:
+    /** Construct a RigidContactInteraction interaction
+        \param [in] state The global state of the system
+        \param [in] name The name of the interaction
+        \param [in] params The parameters of the forces
+     */
+    RigidContactInteraction(const MirState *state, std::string name, RigidContactParams params);
+
+    ~RigidContactInteraction();
+
+    void setPrerequisites(ParticleVector *pv1, ParticleVector *pv2, CellList *cl1, CellList *cl2) override;
+    void local(ParticleVector *pv1, ParticleVector *pv2, CellList *cl1, CellList *cl2, cudaStream_t stream) override;
+    void halo (ParticleVector *pv1, ParticleVector *pv2, CellList *cl1, CellList *cl2, cudaStream_t stream) override;
+
+    /** \return The cut-off radius used to create the particle cell lists and the halo of the objects.
+        The particle cell lists are not used by this interaction: this is the largest gap at which the objects
+        interact, but not smaller than the default cut-off, so that no finer cell list is built at every time step.
+     */
+    real getCutoffRadius() const override;
+
+    /// \return The largest gap at which the objects interact
+    real getGapCutoff() const;
+
+private:
+    real _getBoundingRadius(RigidObjectVector *rov);
+
+    void _computeForces(RigidObjectVector *rovA, RigidObjectVector *rovB, ParticleVectorLocality localityB,
+                        bool skipSelf, cudaStream_t stream);
+
+    template <class ShapeA, class ShapeB>
+    void _computeForces(RigidShapedObjectVector<ShapeA> *rsovA, RigidShapedObjectVector<ShapeB> *rsovB,
+                        ParticleVectorLocality localityB, bool skipSelf, cudaStream_t stream);
+
+private:
+    RigidContactParams params_;
+
+    // local and halo forces may be computed concurrently
+    ObjectCellList localCells_; ///< cell list of the local objects
+    ObjectCellList haloCells_;  ///< cell list of the halo objects
+
+    std::map<const RigidObjectVector*, real> boundingRadii_; ///< cached radii of the spheres enclosing the frozen particles
+};
+
+} // namespace mirheo
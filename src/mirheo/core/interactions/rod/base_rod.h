@@ -1,6 +1,8 @@
 // Copyright 2020 ETH Zurich. All Rights Reserved.
 #pragma once
 
+#include "kernels/parameters.h"
+
 #include <mirheo/core/interactions/interface.h>
 
 namespace mirheo
@@ -24,6 +26,9 @@ public:
     void halo(ParticleVector *pv1, ParticleVector *pv2, CellList *cl1, CellList *cl2, cudaStream_t stream) final;
 
     bool isSelfObjectInteraction() const final;
+
+    /// \return The parameters of the rod forces (equilibrium lengths, stiffnesses, states)
+    virtual const RodParameters& getParameters() const = 0;
 };
 
 } // namespace mirheo
@@ -3,6 +3,7 @@
 
 #include "kernels/real.h"
 #include "kernels/bisegment.h"
+#include "object_scales.h"
 
 #include <mirheo/core/pvs/rod_vector.h>
 #include <mirheo/core/pvs/views/rv.h>
@@ -40,29 +41,17 @@ __device__ inline rReal3 fbound(const rReal3& r0, const rReal3& r1, const real k
     return (linv * fmagn) * dr;
 }
 
-__global__ void computeRodBoundForces(RVview view, GPU_RodBoundsParameters params)
+/** Add the bound forces of a single segment.
+    The particles r0, u0, u1, v0, v1, r1 are consecutive in memory.
+ */
+__device__ inline void computeSegmentBoundForces(const GPU_RodBoundsParameters& params, rReal ksScale,
+                                                 const rReal3& r0, const rReal3& u0, const rReal3& u1,
+                                                 const rReal3& v0, const rReal3& v1, const rReal3& r1,
+                                                 rReal3& fr0, rReal3& fu0, rReal3& fu1,
+                                                 rReal3& fv0, rReal3& fv1, rReal3& fr1)
 {
-    const int i = threadIdx.x + blockIdx.x * blockDim.x;
-    const int rodId     = i / view.nSegments;
-    const int segmentId = i % view.nSegments;
-    const int start = view.objSize * rodId + segmentId * 5;
-
-    if (rodId     >= view.nObjects ) return;
-    if (segmentId >= view.nSegments) return;
-
-    auto r0 = fetchPosition(view, start + 0);
-    auto u0 = fetchPosition(view, start + 1);
-    auto u1 = fetchPosition(view, start + 2);
-    auto v0 = fetchPosition(view, start + 3);
-    auto v1 = fetchPosition(view, start + 4);
-    auto r1 = fetchPosition(view, start + 5);
-
-    rReal3 fr0{0._rr, 0._rr, 0._rr}, fr1{0._rr, 0._rr, 0._rr};
-    rReal3 fu0{0._rr, 0._rr, 0._rr}, fu1{0._rr, 0._rr, 0._rr};
-    rReal3 fv0{0._rr, 0._rr, 0._rr}, fv1{0._rr, 0._rr, 0._rr};
-
 #define BOUND(a, b, k, l) do {                          \
-        auto f = fbound(a, b, params. k, params. l);    \
+        auto f = fbound(a, b, ksScale * params. k, params. l); \
         f##a += f;                                      \
         f##b -= f;                                      \
     } while(0)
@@ -88,6 +77,34 @@ __global__ void computeRodBoundForces(RVview view, GPU_RodBoundsParameters param
     BOUND(r0, r1, ksCenter, lcenter);
 
 #undef BOUND
+}
+
+__global__ void computeRodBoundForces(RVview view, GPU_RodBoundsParameters params, RodObjectScales objectScales)
+{
+    const int i = threadIdx.x + blockIdx.x * blockDim.x;
+    const int rodId     = i / view.nSegments;
+    const int segmentId = i % view.nSegments;
+    const int start = view.objSize * rodId + segmentId * 5;
+
+    if (rodId     >= view.nObjects ) return;
+    if (segmentId >= view.nSegments) return;
+
+    const rReal ksScale = objectScales.get(rodId).bounds;
+
+    auto r0 = fetchPosition(view, start + 0);
+    auto u0 = fetchPosition(view, start + 1);
+    auto u1 = fetchPosition(view, start + 2);
+    auto v0 = fetchPosition(view, start + 3);
+    auto v1 = fetchPosition(view, start + 4);
+    auto r1 = fetchPosition(view, start + 5);
+
+    rReal3 fr0{0._rr, 0._rr, 0._rr}, fr1{0._rr, 0._rr, 0._rr};
+    rReal3 fu0{0._rr, 0._rr, 0._rr}, fu1{0._rr, 0._rr, 0._rr};
+    rReal3 fv0{0._rr, 0._rr, 0._rr}, fv1{0._rr, 0._rr, 0._rr};
+
+    computeSegmentBoundForces(params, ksScale,
+                              r0, u0, u1, v0, v1, r1,
+                              fr0, fu0, fu1, fv0, fv1, fr1);
 
     atomicAdd(view.forces + start + 0, make_real3(fr0));
     atomicAdd(view.forces + start + 1, make_real3(fu0));
@@ -104,8 +121,32 @@ __device__ inline int getState(const RVview& view, int i)
     else             return 0;
 }
 
+/** Compute the bending and twist forces of a bisegment, scaled by the per-rod scales.
+    Only the forces acting on r0, r2, pm0 and pm1 are returned; the others follow from momentum conservation.
+ */
 template <int Nstates>
-__global__ void computeRodBiSegmentForces(RVview view, GPU_RodBiSegmentParameters<Nstates> params, bool saveEnergies)
+__device__ inline void computeBiSegmentElasticForces(const BiSegment<Nstates>& bisegment, int state,
+                                                     const GPU_RodBiSegmentParameters<Nstates>& params,
+                                                     const RodForceScales& scales,
+                                                     rReal3& fr0, rReal3& fr2, rReal3& fpm0, rReal3& fpm1)
+{
+    rReal3 br0, br2, bpm0, bpm1; // bending
+    rReal3 tr0, tr2, tpm0, tpm1; // twist
+    br0 = br2 = bpm0 = bpm1 = make_rReal3(0.0_rr);
+    tr0 = tr2 = tpm0 = tpm1 = make_rReal3(0.0_rr);
+
+    bisegment.computeBendingForces(state, params, br0, br2, bpm0, bpm1);
+    bisegment.computeTwistForces  (state, params, tr0, tr2, tpm0, tpm1);
+
+    fr0  = scales.bending * br0  + scales.twist * tr0;
+    fr2  = scales.bending * br2  + scales.twist * tr2;
+    fpm0 = scales.bending * bpm0 + scales.twist * tpm0;
+    fpm1 = scales.bending * bpm1 + scales.twist * tpm1;
+}
+
+template <int Nstates>
+__global__ void computeRodBiSegmentForces(RVview view, GPU_RodBiSegmentParameters<Nstates> params,
+                                          RodObjectScales objectScales, bool saveEnergies)
 {
     constexpr int stride = 5;
     const int i = threadIdx.x + blockIdx.x * blockDim.x;
@@ -119,13 +160,11 @@ __global__ void computeRodBiSegmentForces(RVview view, GPU_RodBiSegmentParameter
 
     const BiSegment<Nstates> bisegment(view, start);
 
-    rReal3 fr0, fr2, fpm0, fpm1;
-    fr0 = fr2 = fpm0 = fpm1 = make_rReal3(0.0_rr);
-
     const int state = getState<Nstates>(view, i);
+    const auto scales = objectScales.get(rodId);
 
-    bisegment.computeBendingForces(state, params, fr0, fr2, fpm0, fpm1);
-    bisegment.computeTwistForces  (state, params, fr0, fr2, fpm0, fpm1);
+    rReal3 fr0, fr2, fpm0, fpm1;
+    computeBiSegmentElasticForces(bisegment, state, params, scales, fr0, fr2, fpm0, fpm1);
 
     // by conservation of momentum
     auto fr1  = -(fr0 + fr2);
@@ -141,10 +180,83 @@ __global__ void computeRodBiSegmentForces(RVview view, GPU_RodBiSegmentParameter
     atomicAdd(view.forces + start + stride + 1, make_real3(fpm1));
     atomicAdd(view.forces + start + stride + 2, make_real3(fpp1));
 
-    if (saveEnergies) view.energies[i] = bisegment.computeEnergy(state, params);
+    if (saveEnergies) view.energies[i] = bisegment.computeEnergy(state, params, scales.bending, scales.twist);
+}
+
+/** Compute the bound and elastic forces of the rods in a single pass.
+    One thread per segment: the bound forces of the segment and the elastic forces of the bisegment
+    that starts at this segment (if any) are accumulated in registers before being added to the particles.
+    The positions are fetched only once and no intermediate quantities are stored in global memory.
+    This is used when there are no polymorphic state transitions.
+ */
+template <int Nstates>
+__global__ void computeRodForcesFused(RVview view, GPU_RodBoundsParameters boundParams,
+                                      GPU_RodBiSegmentParameters<Nstates> biSegmentParams,
+                                      RodObjectScales objectScales, bool saveEnergies)
+{
+    constexpr int stride = 5;
+    const int i = threadIdx.x + blockIdx.x * blockDim.x;
+    const int nBiSegments = view.nSegments - 1;
+    const int rodId     = i / view.nSegments;
+    const int segmentId = i % view.nSegments;
+    const int start = view.objSize * rodId + segmentId * stride;
+
+    if (rodId     >= view.nObjects ) return;
+    if (segmentId >= view.nSegments) return;
+
+    const auto scales = objectScales.get(rodId);
+
+    const auto r0 = fetchPosition(view, start + 0);
+    const auto u0 = fetchPosition(view, start + 1);
+    const auto u1 = fetchPosition(view, start + 2);
+    const auto v0 = fetchPosition(view, start + 3);
+    const auto v1 = fetchPosition(view, start + 4);
+    const auto r1 = fetchPosition(view, start + 5);
+
+    rReal3 fr0{0._rr, 0._rr, 0._rr}, fr1{0._rr, 0._rr, 0._rr};
+    rReal3 fu0{0._rr, 0._rr, 0._rr}, fu1{0._rr, 0._rr, 0._rr};
+    rReal3 fv0{0._rr, 0._rr, 0._rr}, fv1{0._rr, 0._rr, 0._rr};
+
+    computeSegmentBoundForces(boundParams, scales.bounds,
+                              r0, u0, u1, v0, v1, r1,
+                              fr0, fu0, fu1, fv0, fv1, fr1);
+
+    if (segmentId < nBiSegments)
+    {
+        const int biSegmentIndex = rodId * nBiSegments + segmentId;
+        const auto pm1 = fetchPosition(view, start + stride + 1);
+        const auto pp1 = fetchPosition(view, start + stride + 2);
+        const auto r2  = fetchPosition(view, start + 2 * stride);
+
+        const BiSegment<Nstates> bisegment(r0, r1, r2, u0, u1, pm1, pp1);
+        const int state = getState<Nstates>(view, biSegmentIndex);
+
+        rReal3 efr0, efr2, efpm0, efpm1;
+        computeBiSegmentElasticForces(bisegment, state, biSegmentParams, scales, efr0, efr2, efpm0, efpm1);
+
+        // by conservation of momentum
+        fr0 += efr0;
+        fr1 -= efr0 + efr2;
+        fu0 += efpm0;
+        fu1 -= efpm0;
+
+        atomicAdd(view.forces + start + 2 * stride, make_real3( efr2));
+        atomicAdd(view.forces + start + stride + 1, make_real3( efpm1));
+        atomicAdd(view.forces + start + stride + 2, make_real3(-efpm1));
+
+        if (saveEnergies)
+            view.energies[biSegmentIndex] = bisegment.computeEnergy(state, biSegmentParams, scales.bending, scales.twist);
+    }
+
+    atomicAdd(view.forces + start + 0, make_real3(fr0));
+    atomicAdd(view.forces + start + 1, make_real3(fu0));
+    atomicAdd(view.forces + start + 2, make_real3(fu1));
+    atomicAdd(view.forces + start + 3, make_real3(fv0));
+    atomicAdd(view.forces + start + 4, make_real3(fv1));
+    atomicAdd(view.forces + start + 5, make_real3(fr1));
 }
 
-__global__ void computeRodCurvatureSmoothing(RVview view, real kbi,
+__global__ void computeRodCurvatureSmoothing(RVview view, real kSmoothing, RodObjectScales objectScales,
                                              const real4 *kappa, const real2 *tau_l)
 {
     constexpr int stride = 5;
@@ -158,6 +270,7 @@ __global__ void computeRodCurvatureSmoothing(RVview view, real kbi,
     if (biSegmentId >= nBiSegments   ) return;
 
     const BiSegment<0> bisegment(view, start);
+    const rReal kbi = kSmoothing * objectScales.get(rodId).bending;
 
     rReal3 gradr0x, gradr0y, gradr0z;
     rReal3 gradr2x, gradr2y, gradr2z;
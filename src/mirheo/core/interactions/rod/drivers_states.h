@@ -3,6 +3,7 @@
 
 #include "kernels/real.h"
 #include "kernels/bisegment.h"
+#include "object_scales.h"
 
 #include <mirheo/core/pvs/rod_vector.h>
 #include <mirheo/core/pvs/views/rv.h>
@@ -19,7 +20,8 @@ struct GPU_SpinParameters
     real J;    ///< Ising energy coupling
     real kBT;  ///< temperature in energy units
     real beta; ///< 1/kBT
-    real seed; ///< random seed
+    real seedProposal;   ///< random seed of the proposed states
+    real seedAcceptance; ///< random seed of the acceptance tests, independent of seedProposal
 };
 
 namespace rod_states_kernels
@@ -72,14 +74,16 @@ __global__ void computeBisegmentData(RVview view, real4 *kappa, real2 *tau_l)
 }
 
 template <int Nstates>
-__global__ void findPolymorphicStates(RVview view, GPU_RodBiSegmentParameters<Nstates> params, const real4 *kappa, const real2 *tau_l)
+__global__ void findPolymorphicStates(RVview view, GPU_RodBiSegmentParameters<Nstates> params, RodObjectScales objectScales,
+                                      const real4 *kappa, const real2 *tau_l)
 {
     const int tid   = threadIdx.x;
     const int rodId = blockIdx.x;
 
     const int nBiSegments = view.nSegments - 1;
+    const auto scales = objectScales.get(rodId);
 
-    for (int biSegmentId = tid; biSegmentId < nBiSegments; ++biSegmentId)
+    for (int biSegmentId = tid; biSegmentId < nBiSegments; biSegmentId += blockDim.x)
     {
         rReal2 k0, k1;
         rReal tau, l;
@@ -88,12 +92,12 @@ __global__ void findPolymorphicStates(RVview view, GPU_RodBiSegmentParameters<Ns
         fetchBisegmentData(i, kappa, tau_l, k0, k1, tau, l);
 
         int state = 0;
-        rReal E = computeEnergy(l, k0, k1, tau, state, params);
+        rReal E = computeEnergy(l, k0, k1, tau, state, params, scales.bending, scales.twist);
 
         #pragma unroll
         for (int s = 1; s < Nstates; ++s)
         {
-            rReal Es = computeEnergy(l, k0, k1, tau, s, params);
+            rReal Es = computeEnergy(l, k0, k1, tau, s, params, scales.bending, scales.twist);
             if (Es < E)
             {
                 E = Es;
@@ -105,80 +109,142 @@ __global__ void findPolymorphicStates(RVview view, GPU_RodBiSegmentParameters<Ns
     }
 }
 
+/** Compute the elastic energy of every bisegment in every polymorphic state.
+    One thread per (bisegment, state) pair; the energy of state s of bisegment i is stored at i * Nstates + s.
+    The curvatures and torsions do not change during the MC sweeps, so the energies are evaluated only once per time step.
+ */
 template <int Nstates>
-__device__ inline int randomOtherState(int current, real seed)
+__global__ void computeStatesEnergies(RVview view, GPU_RodBiSegmentParameters<Nstates> params, RodObjectScales objectScales,
+                                      const real4 *kappa, const real2 *tau_l, real *stateEnergies)
 {
-    real u = Saru::uniform01(seed, threadIdx.x, 123456 * current + 98765 * blockIdx.x );
-    unsigned int r = static_cast<unsigned int>(4294967295.0_r * u);
-    int s = r % (Nstates - 1);
-    return s >= current ? (s + 1) % Nstates : s;
+    const int j = threadIdx.x + blockIdx.x * blockDim.x;
+    const int i     = j / Nstates;
+    const int state = j % Nstates;
+    const int nBiSegments = view.nSegments - 1;
+    const int rodId = i / nBiSegments;
+
+    if (rodId >= view.nObjects) return;
+
+    rReal2 k0, k1;
+    rReal tau, l;
+    fetchBisegmentData(i, kappa, tau_l, k0, k1, tau, l);
+
+    const auto scales = objectScales.get(rodId);
+    stateEnergies[j] = computeEnergy(l, k0, k1, tau, state, params, scales.bending, scales.twist);
 }
 
+/// Set each bisegment to its minimum energy state, given the precomputed energies of each state (see computeStatesEnergies())
 template <int Nstates>
-__device__ inline int acceptReject(int sprev, int scurrent, int snext,
-                                   const rReal2& k0, const rReal2& k1, const rReal& tau, const rReal& l,
-                                   const GPU_RodBiSegmentParameters<Nstates>& params,
-                                   const GPU_SpinParameters& spinParams)
+__global__ void findGroundStates(RVview view, const real *stateEnergies)
 {
-    int sother = randomOtherState<Nstates>(scurrent, spinParams.seed);
+    const int i = threadIdx.x + blockIdx.x * blockDim.x;
+    const int nBiSegments = view.nSegments - 1;
+
+    if (i >= view.nObjects * nBiSegments) return;
+
+    const real *E = stateEnergies + i * Nstates;
+
+    int state = 0;
+    real Emin = E[0];
+
+    #pragma unroll
+    for (int s = 1; s < Nstates; ++s)
+    {
+        if (E[s] < Emin)
+        {
+            Emin = E[s];
+            state = s;
+        }
+    }
 
-    real Ecurrent = computeEnergy(l, k0, k1, tau, scurrent, params)
-        + spinParams.J * (math::abs(scurrent-sprev) + math::abs(scurrent-snext));
+    view.states[i] = state;
+}
 
-    real Eother   = computeEnergy(l, k0, k1, tau, sother  , params)
-        + spinParams.J * (math::abs(sother  -sprev) + math::abs(sother  -snext));
+/// value of the neighbouring state for bisegments at the ends of the rod
+constexpr int noNeighbourState = -1;
 
-    real dE = Eother - Ecurrent;
+/// Ising coupling energy of a bisegment in state s with its neighbours; missing neighbours do not contribute
+__device__ inline real spinCouplingEnergy(int s, int sprev, int snext, real J)
+{
+    real E = 0.0_r;
+    if (sprev != noNeighbourState) E += J * math::abs(s - sprev);
+    if (snext != noNeighbourState) E += J * math::abs(s - snext);
+    return E;
+}
 
-    real u = Saru::uniform01(spinParams.seed, 12345 * threadIdx.x - 6789, 123456 * sother + 98765 * blockIdx.x );
+/** Choose uniformly at random a state different from the current one.
+    \param [in] current The current state
+    \param [in] seed Random seed, different at every MC step
+    \param [in] i Global index of the bisegment; the random streams of different bisegments are independent.
+ */
+template <int Nstates>
+__device__ inline int randomOtherState(int current, real seed, int i)
+{
+    const real u = Saru::uniform01(seed, i, current);
+    const unsigned int r = static_cast<unsigned int>(4294967295.0_r * u);
+    const int s = r % (Nstates - 1);
+    return s >= current ? (s + 1) % Nstates : s;
+}
 
-    if (spinParams.kBT < 1e-6)
+/** Metropolis update of a single bisegment with fixed neighbours.
+    \return the new state of the bisegment
+ */
+template <int Nstates>
+__device__ inline int acceptReject(int i, int sprev, int scurrent, int snext,
+                                   const real *stateEnergies,
+                                   const GPU_SpinParameters& spinParams)
+{
+    const int sother = randomOtherState<Nstates>(scurrent, spinParams.seedProposal, i);
+    const real *E = stateEnergies + i * Nstates;
+
+    const real Ecurrent = E[scurrent] + spinCouplingEnergy(scurrent, sprev, snext, spinParams.J);
+    const real Eother   = E[sother  ] + spinCouplingEnergy(sother,   sprev, snext, spinParams.J);
+
+    const real dE = Eother - Ecurrent;
+
+    if (spinParams.kBT < 1e-6_r)
         return dE < 0 ? sother : scurrent;
 
+    const real u = Saru::uniform01(spinParams.seedAcceptance, i, sother);
+
     if (u < math::exp(-dE * spinParams.beta))
         return sother;
 
     return scurrent;
 }
 
+/** One MC sweep over all bisegments of short rods.
+    One block per rod, one thread per bisegment (the rod must have at most blockDim.x bisegments).
+    The states are kept in shared memory and updated in two half sweeps (even then odd bisegments),
+    so that the neighbours of each updated bisegment are fixed during the update.
+ */
 template <int Nstates>
-__global__ void findPolymorphicStatesMCStep(RVview view, GPU_RodBiSegmentParameters<Nstates> params,
-                                            GPU_SpinParameters spinParams, const real4 *kappa, const real2 *tau_l)
+__global__ void findPolymorphicStatesMCStep(RVview view, GPU_SpinParameters spinParams, const real *stateEnergies)
 {
-    const int tid   = threadIdx.x;
+    const int biSegmentId = threadIdx.x;
     const int rodId = blockIdx.x;
 
     const int nBiSegments = view.nSegments - 1;
+    const int i = rodId * nBiSegments + biSegmentId;
+    const bool active = biSegmentId < nBiSegments;
 
     extern __shared__ int states[];
 
-    for (int biSegmentId = tid; biSegmentId < nBiSegments; biSegmentId += blockDim.x)
-    {
-        int i = rodId * nBiSegments + biSegmentId;
+    if (active)
         states[biSegmentId] = view.states[i];
-    }
 
     __syncthreads();
 
     auto execPhase = [&](int evenOdd)
     {
-        for (int biSegmentId = tid; biSegmentId < nBiSegments; biSegmentId += blockDim.x)
-        {
-            if (biSegmentId % 2 == evenOdd) continue;
-
-            rReal2 k0, k1;
-            rReal tau, l;
-            int i = rodId * nBiSegments + biSegmentId;
+        if (!active || biSegmentId % 2 != evenOdd)
+            return;
 
-            fetchBisegmentData(i, kappa, tau_l, k0, k1, tau, l);
+        const int scurrent = states[biSegmentId];
+        const int sprev = biSegmentId > 0               ? states[biSegmentId - 1] : noNeighbourState;
+        const int snext = biSegmentId < nBiSegments - 1 ? states[biSegmentId + 1] : noNeighbourState;
 
-            int scurrent = states[biSegmentId];
-            int sprev = states[math::max(biSegmentId - 1, 0            )];
-            int snext = states[math::min(biSegmentId + 1, nBiSegments-1)];
-
-            states[biSegmentId] = acceptReject(sprev, scurrent, snext,
-                                               k0, k1, tau, l, params, spinParams);
-        }
+        states[biSegmentId] = acceptReject<Nstates>(i, sprev, scurrent, snext, stateEnergies, spinParams);
     };
 
     constexpr int evenStep = 0;
@@ -190,11 +256,38 @@ __global__ void findPolymorphicStatesMCStep(RVview view, GPU_RodBiSegmentParamet
     execPhase(oddStep);
     __syncthreads();
 
-    for (int biSegmentId = tid; biSegmentId < nBiSegments; biSegmentId += blockDim.x)
-    {
-        int i = rodId * nBiSegments + biSegmentId;
+    if (active)
         view.states[i] = states[biSegmentId];
-    }
+}
+
+/** One half MC sweep over the bisegments of a given parity, for rods of any length.
+    One thread per updated bisegment, independently of the rod it belongs to.
+    Bisegments of the same parity are not neighbours, hence they can be updated concurrently
+    with the same detailed balance as the sequential scheme (checkerboard decomposition).
+    \param [in,out] view The rods data; the states are read and updated in global memory
+    \param [in] spinParams The Ising model parameters and the random seed of this half sweep
+    \param [in] stateEnergies The precomputed energies of each bisegment in each state
+    \param [in] parity 0 to update even bisegments, 1 to update odd ones
+ */
+template <int Nstates>
+__global__ void findPolymorphicStatesMCHalfStep(RVview view, GPU_SpinParameters spinParams, const real *stateEnergies, int parity)
+{
+    const int nBiSegments = view.nSegments - 1;
+    const int nPerRod = (nBiSegments + 1 - parity) / 2;
+    const int j = threadIdx.x + blockIdx.x * blockDim.x;
+
+    const int rodId = j / nPerRod;
+    const int biSegmentId = 2 * (j % nPerRod) + parity;
+
+    if (rodId >= view.nObjects) return;
+
+    const int i = rodId * nBiSegments + biSegmentId;
+
+    const int scurrent = view.states[i];
+    const int sprev = biSegmentId > 0               ? view.states[i - 1] : noNeighbourState;
+    const int snext = biSegmentId < nBiSegments - 1 ? view.states[i + 1] : noNeighbourState;
+
+    view.states[i] = acceptReject<Nstates>(i, sprev, scurrent, snext, stateEnergies, spinParams);
 }
 
 } // namespace rod_states_kernels
@@ -55,11 +55,14 @@ __device__ inline rReal2 symmetricMatMult(const rReal3& A, const rReal2& x)
     \param [in] tau The torsion of the bisegment
     \param [in] state Polymorphic state
     \param [in] params Energy parameters
+    \param [in] bendingScale Multiplier of the bending energy
+    \param [in] twistScale Multiplier of the twist energy
     \return The elastic energy
  */
 template <int Nstates>
 __device__ inline rReal computeEnergy(rReal l, rReal2 kappa0, rReal2 kappa1, rReal tau, int state,
-                                     const GPU_RodBiSegmentParameters<Nstates>& params)
+                                     const GPU_RodBiSegmentParameters<Nstates>& params,
+                                     rReal bendingScale = 1.0_rr, rReal twistScale = 1.0_rr)
 {
     const rReal2 dkappa0 = kappa0 - make_rReal2(params.kappaEq[state]);
     const rReal2 dkappa1 = kappa1 - make_rReal2(params.kappaEq[state]);
@@ -73,7 +76,7 @@ __device__ inline rReal computeEnergy(rReal l, rReal2 kappa0, rReal2 kappa1, rRe
 
     const rReal Et = 0.5_rr * l * params.kTwist * dtau * dtau;
 
-    return Eb + Et + params.groundE[state];
+    return bendingScale * Eb + twistScale * Et + params.groundE[state];
 }
 
 /** Helper class to compute elastic forces and energy on a bisegment
@@ -97,17 +100,29 @@ struct BiSegment
 
     /** Fetch bisegment data and prepare helper quantities
      */
-    __device__ inline BiSegment(const RVview& view, int start)
+    __device__ inline BiSegment(const RVview& view, int start) :
+        BiSegment(fetchPosition(view, start + 0),
+                  fetchPosition(view, start + 5),
+                  fetchPosition(view, start + 10),
+                  fetchPosition(view, start + 1),
+                  fetchPosition(view, start + 2),
+                  fetchPosition(view, start + 6),
+                  fetchPosition(view, start + 7))
+    {}
+
+    /** Prepare helper quantities from already fetched positions
+        \param [in] r0 First particle on the center line
+        \param [in] r1 Second particle on the center line
+        \param [in] r2 Third particle on the center line
+        \param [in] pm0 First material frame particle of the first segment
+        \param [in] pp0 Opposite material frame particle of the first segment
+        \param [in] pm1 First material frame particle of the second segment
+        \param [in] pp1 Opposite material frame particle of the second segment
+     */
+    __device__ inline BiSegment(const rReal3& r0, const rReal3& r1, const rReal3& r2,
+                                const rReal3& pm0, const rReal3& pp0,
+                                const rReal3& pm1, const rReal3& pp1)
     {
-        const auto r0  = fetchPosition(view, start + 0);
-        const auto r1  = fetchPosition(view, start + 5);
-        const auto r2  = fetchPosition(view, start + 10);
-
-        const auto pm0 = fetchPosition(view, start + 1);
-        const auto pp0 = fetchPosition(view, start + 2);
-        const auto pm1 = fetchPosition(view, start + 6);
-        const auto pp1 = fetchPosition(view, start + 7);
-
         e0 = r1 - r0;
         e1 = r2 - r1;
 
@@ -438,13 +453,14 @@ struct BiSegment
     }
 
     /// Compute the energy of the bisegment
-    __device__ inline rReal computeEnergy(int state, const GPU_RodBiSegmentParameters<Nstates>& params) const
+    __device__ inline rReal computeEnergy(int state, const GPU_RodBiSegmentParameters<Nstates>& params,
+                                          rReal bendingScale = 1.0_rr, rReal twistScale = 1.0_rr) const
     {
         rReal2 kappa0, kappa1;
         rReal tau;
         computeCurvatures(kappa0, kappa1);
         computeTorsion(tau);
-        return mirheo::computeEnergy(l, kappa0, kappa1, tau, state, params);
+        return mirheo::computeEnergy(l, kappa0, kappa1, tau, state, params, bendingScale, twistScale);
     }
 };
 
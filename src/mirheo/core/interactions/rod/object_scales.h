@@ -0,0 +1,62 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include "kernels/real.h"
+
+#include <mirheo/core/pvs/rod_vector.h>
+#include <mirheo/core/utils/cpu_gpu_defines.h>
+
+namespace mirheo
+{
+
+/// Multiplicative factors applied to each family of rod forces of a single rod
+struct RodForceScales
+{
+    rReal bounds;  ///< multiplies the spring constants of the bounds (centerline and material frame)
+    rReal bending; ///< multiplies the bending tensor
+    rReal twist;   ///< multiplies the twist coefficient
+};
+
+/** \brief Fetch per-rod parameter scales, if available.
+
+    The scales of each rod are stored in the optional object channel \c channel_names::rodParameterScales
+    as (bounds, bending, twist).
+    When the channel does not exist, all scales are equal to 1.
+    This is the rod counterpart of MembraneObjectScales.
+ */
+class RodObjectScales
+{
+public:
+    /** \brief Set internal state of the object.
+        \param [in] rv The RodVector that will be used
+
+        This must be called after every change of \p rv DataManager
+     */
+    void setup(RodVector *rv)
+    {
+        auto& dataPerObject = rv->local()->dataPerObject;
+
+        if (dataPerObject.checkChannelExists(channel_names::rodParameterScales))
+            scales_ = dataPerObject.getData<real3>(channel_names::rodParameterScales)->devPtr();
+        else
+            scales_ = nullptr;
+    }
+
+    /** \brief Get the scales of a given rod
+        \param [in] rodId The index of the rod
+        \return The force scales of that rod
+     */
+    inline __D__ RodForceScales get(long rodId) const
+    {
+        if (scales_ == nullptr)
+            return {1.0_rr, 1.0_rr, 1.0_rr};
+
+        const real3 s = scales_[rodId];
+        return {static_cast<rReal>(s.x), static_cast<rReal>(s.y), static_cast<rReal>(s.z)};
+    }
+
+private:
+    const real3 *scales_ {nullptr}; ///< Points to the RodVector object channel containing the scales (may be null)
+};
+
+} // namespace mirheo
@@ -17,7 +17,9 @@ namespace mirheo
 template <int Nstates>
 static void updateStatesAndApplyForces(__UNUSED RodVector *rv,
                                        __UNUSED const GPU_RodBiSegmentParameters<Nstates> devParams,
+                                       __UNUSED const RodObjectScales& objectScales,
                                        __UNUSED StatesParametersNone& stateParams,
+                                       __UNUSED DeviceBuffer<real>& stateEnergies,
                                        __UNUSED cudaStream_t stream)
 {}
 
@@ -25,7 +27,9 @@ static void updateStatesAndApplyForces(__UNUSED RodVector *rv,
 template <int Nstates>
 static void updateStatesAndApplyForces(RodVector *rv,
                                        const GPU_RodBiSegmentParameters<Nstates> devParams,
-                                       StatesSmoothingParameters& stateParams, cudaStream_t stream)
+                                       const RodObjectScales& objectScales,
+                                       StatesSmoothingParameters& stateParams,
+                                       __UNUSED DeviceBuffer<real>& stateEnergies, cudaStream_t stream)
 {
     RVview view(rv, rv->local());
 
@@ -37,14 +41,14 @@ static void updateStatesAndApplyForces(RodVector *rv,
 
     SAFE_KERNEL_LAUNCH(rod_states_kernels::findPolymorphicStates<Nstates>,
                        nblocks, nthreads, 0, stream,
-                       view, devParams, kappa, tau_l);
+                       view, devParams, objectScales, kappa, tau_l);
 
     nthreads = 128;
     nblocks  = getNblocks(view.nObjects * (view.nSegments-1), nthreads);
 
     SAFE_KERNEL_LAUNCH(rod_forces_kernels::computeRodCurvatureSmoothing,
                        nblocks, nthreads, 0, stream,
-                       view, stateParams.kSmoothing, kappa, tau_l);
+                       view, stateParams.kSmoothing, objectScales, kappa, tau_l);
 }
 
 static auto getGPUParams(StatesSpinParameters& p)
@@ -53,14 +57,71 @@ static auto getGPUParams(StatesSpinParameters& p)
     dp.J    = p.J;
     dp.kBT  = p.kBT;
     dp.beta = 1.0 /  p.kBT;
-    dp.seed = p.generate();
+    dp.seedProposal   = p.generate();
+    dp.seedAcceptance = p.generate();
     return dp;
 }
 
+/// maximum number of bisegments per rod for which a MC sweep is performed within a single block
+constexpr int maxBiSegmentsPerBlockMC = 512;
+
+/** \brief Perform the Metropolis sweeps of the Ising model of polymorphic states.
+    \tparam Nstates Number of polymorphic states
+    \param [in,out] view The rods data; the states are updated in place
+    \param [in,out] stateParams The Ising model parameters; its random generator is advanced
+    \param [in] stateEnergies The energies of each bisegment in each state
+    \param [in] stream The stream to execute the kernels on
+ */
+template <int Nstates>
+static void runSpinMonteCarloSweeps(RVview view, StatesSpinParameters& stateParams,
+                                    const real *stateEnergies, cudaStream_t stream)
+{
+    const int nBiSegments = view.nSegments - 1;
+
+    if (nBiSegments <= maxBiSegmentsPerBlockMC)
+    {
+        // short rods: one block per rod, the whole sweep is done in shared memory
+        const int nthreads = ((nBiSegments + 31) / 32) * 32;
+        const int nblocks = view.nObjects;
+        const size_t shMemSize = sizeof(int) * nBiSegments;
+
+        for (int i = 0; i < stateParams.nsteps; ++i)
+        {
+            const auto devSpinParams = getGPUParams(stateParams);
+
+            SAFE_KERNEL_LAUNCH(rod_states_kernels::findPolymorphicStatesMCStep<Nstates>,
+                               nblocks, nthreads, shMemSize, stream,
+                               view, devSpinParams, stateEnergies);
+        }
+    }
+    else
+    {
+        // long rods: checkerboard decomposition over all bisegments of all rods
+        const int nthreads = 128;
+
+        for (int i = 0; i < stateParams.nsteps; ++i)
+        {
+            const auto devSpinParams = getGPUParams(stateParams);
+
+            for (int parity = 0; parity < 2; ++parity)
+            {
+                const int nPerRod = (nBiSegments + 1 - parity) / 2;
+                const int nblocks = getNblocks(view.nObjects * nPerRod, nthreads);
+
+                SAFE_KERNEL_LAUNCH(rod_states_kernels::findPolymorphicStatesMCHalfStep<Nstates>,
+                                   nblocks, nthreads, 0, stream,
+                                   view, devSpinParams, stateEnergies, parity);
+            }
+        }
+    }
+}
+
 template <int Nstates>
 static void updateStatesAndApplyForces(RodVector *rv,
                                        const GPU_RodBiSegmentParameters<Nstates> devParams,
-                                       StatesSpinParameters& stateParams, cudaStream_t stream)
+                                       const RodObjectScales& objectScales,
+                                       StatesSpinParameters& stateParams,
+                                       DeviceBuffer<real>& stateEnergies, cudaStream_t stream)
 {
     auto lrv = rv->local();
     RVview view(rv, lrv);
@@ -68,33 +129,34 @@ static void updateStatesAndApplyForces(RodVector *rv,
     auto kappa = lrv->dataPerBisegment.getData<real4>(channel_names::rodKappa)->devPtr();
     auto tau_l = lrv->dataPerBisegment.getData<real2>(channel_names::rodTau_l)->devPtr();
 
-    auto& states = *lrv->dataPerBisegment.getData<int>(channel_names::polyStates);
-    states.clear(stream);
+    const int nBiSegments = view.nSegments - 1;
+    const int nBiSegmentsTot = view.nObjects * nBiSegments;
 
-    // initialize to ground energies without spin interactions
+    if (nBiSegmentsTot == 0)
+        return;
+
+    // the curvatures do not change during the sweeps: evaluate the energies of all states once
+    stateEnergies.resize_anew(nBiSegmentsTot * Nstates);
     {
         const int nthreads = 128;
-        const int nblocks = view.nObjects;
+        const int nblocks = getNblocks(nBiSegmentsTot * Nstates, nthreads);
 
-        SAFE_KERNEL_LAUNCH(rod_states_kernels::findPolymorphicStates<Nstates>,
+        SAFE_KERNEL_LAUNCH(rod_states_kernels::computeStatesEnergies<Nstates>,
                            nblocks, nthreads, 0, stream,
-                           view, devParams, kappa, tau_l);
+                           view, devParams, objectScales, kappa, tau_l, stateEnergies.devPtr());
     }
 
-    const int nthreads = 512;
-    const int nblocks = view.nObjects;
-
-    // TODO check if it fits into shared mem
-    const size_t shMemSize = sizeof(states[0]) * (view.nSegments - 1);
-
-    for (int i = 0; i < stateParams.nsteps; ++i)
+    // initialize to ground energies without spin interactions
     {
-        auto devSpinParams = getGPUParams(stateParams);
+        const int nthreads = 128;
+        const int nblocks = getNblocks(nBiSegmentsTot, nthreads);
 
-        SAFE_KERNEL_LAUNCH(rod_states_kernels::findPolymorphicStatesMCStep<Nstates>,
-                           nblocks, nthreads, shMemSize, stream,
-                           view, devParams, devSpinParams, kappa, tau_l);
+        SAFE_KERNEL_LAUNCH(rod_states_kernels::findGroundStates<Nstates>,
+                           nblocks, nthreads, 0, stream,
+                           view, stateEnergies.devPtr());
     }
+
+    runSpinMonteCarloSweeps<Nstates>(view, stateParams, stateEnergies.devPtr(), stream);
 }
 
 } // namespace mirheo
@@ -5,6 +5,7 @@
 #include "drivers_forces.h"
 #include "drivers_states.h"
 #include "kernels/parameters.h"
+#include "object_scales.h"
 #include "polymorphic_states.h"
 
 #include <mirheo/core/pvs/rod_vector.h>
@@ -73,6 +74,11 @@ public:
 
     ~RodInteraction() = default;
 
+    const RodParameters& getParameters() const override
+    {
+        return parameters_;
+    }
+
     void setPrerequisites(ParticleVector *pv1,
                           __UNUSED ParticleVector *pv2,
                           __UNUSED CellList *cl1,
@@ -107,12 +113,36 @@ public:
         debug("Computing internal rod forces for %d rods of '%s'",
               rv->local()->getNumObjects(), rv->getCName());
 
-        _computeBoundForces                    (rv, stream);
-        _updatePolymorphicStatesAndApplyForces (rv, stream);
-        _computeElasticForces                  (rv, stream);
+        objectScales_.setup(rv);
+
+        if (Nstates == 1)
+        {
+            _computeAllForcesFused(rv, stream);
+        }
+        else
+        {
+            _computeBoundForces                    (rv, stream);
+            _updatePolymorphicStatesAndApplyForces (rv, stream);
+            _computeElasticForces                  (rv, stream);
+        }
     }
 
 private:
+    void _computeAllForcesFused(RodVector *rv, cudaStream_t stream)
+    {
+        RVview view(rv, rv->local());
+
+        const int nthreads = 128;
+        const int nblocks  = getNblocks(view.nObjects * view.nSegments, nthreads);
+
+        auto boundParams     = getBoundParams(parameters_);
+        auto biSegmentParams = getBiSegmentParams<Nstates>(parameters_);
+
+        SAFE_KERNEL_LAUNCH(rod_forces_kernels::computeRodForcesFused<Nstates>,
+                           nblocks, nthreads, 0, stream,
+                           view, boundParams, biSegmentParams, objectScales_, saveEnergies_);
+    }
+
     void _computeBoundForces(RodVector *rv, cudaStream_t stream)
     {
         RVview view(rv, rv->local());
@@ -124,7 +154,7 @@ private:
 
         SAFE_KERNEL_LAUNCH(rod_forces_kernels::computeRodBoundForces,
                            nblocks, nthreads, 0, stream,
-                           view, devParams);
+                           view, devParams, objectScales_);
     }
 
     void _updatePolymorphicStatesAndApplyForces(RodVector *rv, cudaStream_t stream)
@@ -144,7 +174,7 @@ private:
                                nblocks, nthreads, 0, stream,
                                view, kappa, tau_l);
 
-            updateStatesAndApplyForces<Nstates>(rv, devParams, stateParameters_, stream);
+            updateStatesAndApplyForces<Nstates>(rv, devParams, objectScales_, stateParameters_, stateEnergies_, stream);
         }
     }
 
@@ -158,12 +188,14 @@ private:
 
         SAFE_KERNEL_LAUNCH(rod_forces_kernels::computeRodBiSegmentForces<Nstates>,
                            nblocks, nthreads, 0, stream,
-                           view, devParams, saveEnergies_);
+                           view, devParams, objectScales_, saveEnergies_);
     }
 
 private:
     RodParameters parameters_;
     StateParameters stateParameters_;
+    RodObjectScales objectScales_;
+    DeviceBuffer<real> stateEnergies_; ///< work space for the energies of each bisegment in each polymorphic state
     bool saveEnergies_;
 };
 
@@ -2,6 +2,7 @@
 #include "marching_cubes.h"
 
 #include <cstdint>
+#include <utility>
 
 namespace mirheo
 {
@@ -90,99 +91,236 @@ static int getConfig(const real vs[8])
         ((vs[7] < 0.0_r) << 7);
 }
 
+namespace
+{
+/// Samples of the field on a plane of grid nodes normal to x, and the vertices on the edges of the plane.
+/// The node (iy, iz) has index iy * (N.z + 1) + iz.
+struct NodePlane
+{
+    std::vector<real3> positions;   ///< global positions of the nodes
+    std::vector<real> values;       ///< field values at the nodes
+    std::vector<int> yEdgeVertices; ///< vertex on the edge (iy, iz) - (iy+1, iz), with index iy * (N.z + 1) + iz; -1 if none
+    std::vector<int> zEdgeVertices; ///< vertex on the edge (iy, iz) - (iy, iz+1), with index iy * N.z + iz; -1 if none
+};
+
+/// The values at the two ends of an edge and the position of its first end
+struct EdgeSample
+{
+    real3 r;
+    real va, vb;
+};
+} // anonymous namespace
+
+/** Create the vertices on the edges crossed by the zero level set.
+    The vertices are numbered in the order of the edges, whatever the number of threads.
+ */
+template <class GetEdge>
+static void addEdgeVertices(int numEdges, real3 axis, GetEdge getEdge,
+                            std::vector<int>& edgeVertices, std::vector<real3>& vertices)
+{
+    edgeVertices.resize(static_cast<size_t>(numEdges));
+
+    #pragma omp parallel for schedule(static)
+    for (int e = 0; e < numEdges; ++e)
+    {
+        const EdgeSample edge = getEdge(e);
+        edgeVertices[e] = ((edge.va < 0.0_r) != (edge.vb < 0.0_r)) ? 1 : 0;
+    }
+
+    int numVertices = static_cast<int>(vertices.size());
+    for (auto& v : edgeVertices)
+        v = v ? numVertices++ : -1;
+
+    vertices.resize(static_cast<size_t>(numVertices));
+
+    #pragma omp parallel for schedule(static)
+    for (int e = 0; e < numEdges; ++e)
+    {
+        const int id = edgeVertices[e];
+        if (id < 0)
+            continue;
+
+        const EdgeSample edge = getEdge(e);
+        vertices[id] = edge.r + axis * edge.va / (edge.va - edge.vb);
+    }
+}
+
+static void samplePlane(int ix, int3 N, real3 h, real3 start,
+                        const ImplicitSurfaceBatchFunction& field,
+                        NodePlane& plane, std::vector<real3>& vertices)
+{
+    const int nz = N.z + 1;
+    const int numNodes = (N.y + 1) * nz;
+
+    plane.positions.resize(static_cast<size_t>(numNodes));
+    plane.values   .resize(static_cast<size_t>(numNodes));
+
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < numNodes; ++i)
+    {
+        const int iy = i / nz;
+        const int iz = i % nz;
+        plane.positions[i] = {start.x + static_cast<real>(ix) * h.x,
+                              start.y + static_cast<real>(iy) * h.y,
+                              start.z + static_cast<real>(iz) * h.z};
+    }
+
+    // the field is called from this thread only: it does not need to be thread safe
+    field(numNodes, plane.positions.data(), plane.values.data());
+
+    const auto& r = plane.positions;
+    const auto& v = plane.values;
+
+    addEdgeVertices(N.y * nz, real3{0.0_r, h.y, 0.0_r},
+                    [&](int e) { return EdgeSample{r[e], v[e], v[e + nz]}; },
+                    plane.yEdgeVertices, vertices);
+
+    addEdgeVertices((N.y + 1) * N.z, real3{0.0_r, 0.0_r, h.z},
+                    [&](int e)
+                    {
+                        const int i = (e / N.z) * nz + e % N.z;
+                        return EdgeSample{r[i], v[i], v[i + 1]};
+                    },
+                    plane.zEdgeVertices, vertices);
+}
+
+/// Create the triangles of the cells between two planes of nodes, in the order of the cells (iy, iz)
+static void addSlabTriangles(int3 N, const NodePlane& lo, const NodePlane& hi,
+                             const std::vector<int>& xEdgeVertices,
+                             std::vector<int>& cellOffsets, std::vector<int3>& triangles)
+{
+    const int nz = N.z + 1;
+    const int numCells = N.y * N.z;
+
+    auto getCellConfig = [&](int i)
+    {
+        const real vs[8] = {lo.values[i],      hi.values[i],
+                            lo.values[i + nz], hi.values[i + nz],
+                            lo.values[i + 1],      hi.values[i + 1],
+                            lo.values[i + nz + 1], hi.values[i + nz + 1]};
+        return marchingCubeTris[getConfig(vs)];
+    };
+
+    cellOffsets.resize(static_cast<size_t>(numCells));
+
+    #pragma omp parallel for schedule(static)
+    for (int c = 0; c < numCells; ++c)
+    {
+        const int i = (c / N.z) * nz + c % N.z;
+        cellOffsets[c] = static_cast<int>(getCellConfig(i) & 0xF);
+    }
+
+    int numTriangles = static_cast<int>(triangles.size());
+    for (auto& offset : cellOffsets)
+    {
+        const int n = offset;
+        offset = numTriangles;
+        numTriangles += n;
+    }
+
+    triangles.resize(static_cast<size_t>(numTriangles));
+
+    #pragma omp parallel for schedule(static)
+    for (int c = 0; c < numCells; ++c)
+    {
+        const int i  = (c / N.z) * nz + c % N.z; // node and x, y edges
+        const int ez = c;                        // z edges
+
+        const uint64_t config = getCellConfig(i);
+        const int nTriangles = static_cast<int>(config & 0xF);
+
+        if (nTriangles == 0)
+            continue;
+
+        // same numbering as the corners (0, dx, dy, dx+dy, dz, ...) of a cell
+        const int edgeIndices[12] =
+            {xEdgeVertices[i], xEdgeVertices[i + nz], xEdgeVertices[i + 1], xEdgeVertices[i + nz + 1],
+             lo.yEdgeVertices[i], hi.yEdgeVertices[i], lo.yEdgeVertices[i + 1], hi.yEdgeVertices[i + 1],
+             lo.zEdgeVertices[ez], hi.zEdgeVertices[ez], lo.zEdgeVertices[ez + N.z], hi.zEdgeVertices[ez + N.z]};
+
+        int offset = 4;
+        auto nextIndex = [&]()
+        {
+            const int edge = static_cast<int>((config >> offset) & 0xF);
+            offset += 4;
+            return edgeIndices[edge];
+        };
+
+        for (int t = 0; t < nTriangles; ++t)
+        {
+            int3 triangle;
+            triangle.x = nextIndex();
+            triangle.y = nextIndex();
+            triangle.z = nextIndex();
+            triangles[cellOffsets[c] + t] = triangle;
+        }
+    }
+}
+
+void computeIndexedMesh(DomainInfo domain, real3 resolution,
+                        const ImplicitSurfaceBatchFunction& field,
+                        IndexedMesh& mesh)
+{
+    const int3 N {int (domain.localSize.x / resolution.x),
+                  int (domain.localSize.y / resolution.y),
+                  int (domain.localSize.z / resolution.z)};
+
+    const real3 h {domain.localSize.x / static_cast<real>(N.x),
+                   domain.localSize.y / static_cast<real>(N.y),
+                   domain.localSize.z / static_cast<real>(N.z)};
+
+    mesh.vertices.clear();
+    mesh.triangles.clear();
+
+    if (N.x <= 0 || N.y <= 0 || N.z <= 0)
+        return;
+
+    // only two planes of samples are alive at any time
+    NodePlane lo, hi;
+    std::vector<int> xEdgeVertices, cellOffsets;
+
+    samplePlane(0, N, h, domain.globalStart, field, lo, mesh.vertices);
+
+    for (int ix = 0; ix < N.x; ++ix)
+    {
+        samplePlane(ix + 1, N, h, domain.globalStart, field, hi, mesh.vertices);
+
+        addEdgeVertices((N.y + 1) * (N.z + 1), real3{h.x, 0.0_r, 0.0_r},
+                        [&](int i) { return EdgeSample{lo.positions[i], lo.values[i], hi.values[i]}; },
+                        xEdgeVertices, mesh.vertices);
+
+        addSlabTriangles(N, lo, hi, xEdgeVertices, cellOffsets, mesh.triangles);
+
+        std::swap(lo, hi);
+    }
+
+    const int numVertices = static_cast<int>(mesh.vertices.size());
+
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < numVertices; ++i)
+        mesh.vertices[i] = domain.global2local(mesh.vertices[i]);
+}
+
 void computeTriangles(DomainInfo domain, real3 resolution,
                       const ImplicitSurfaceFunction& field,
                       std::vector<Triangle>& triangles)
 {
-    int3 N {int (domain.localSize.x / resolution.x),
-            int (domain.localSize.y / resolution.y),
-            int (domain.localSize.z / resolution.z)};
-
-    real3 h {domain.localSize.x / static_cast<real>(N.x),
-             domain.localSize.y / static_cast<real>(N.y),
-             domain.localSize.z / static_cast<real>(N.z)};
-
-    std::vector<real3> vertices;
-    std::vector<int> indices;
-    triangles.clear();
-
-    real3 dx {h.x, 0.0, 0.0};
-    real3 dy {0.0, h.y, 0.0};
-    real3 dz {0.0, 0.0, h.z};
-
-    for (int ix = 0; ix < N.x; ++ix) {
-        for (int iy = 0; iy < N.y; ++iy) {
-            for (int iz = 0; iz < N.z; ++iz) {
-
-                real3 r {domain.globalStart.x + static_cast<real>(ix) * h.x,
-                         domain.globalStart.y + static_cast<real>(iy) * h.y,
-                         domain.globalStart.z + static_cast<real>(iz) * h.z};
-
-                const real vs[8] =
-                    {field(r               ),
-                     field(r + dx          ),
-                     field(r      + dy     ),
-                     field(r + dx + dy     ),
-                     field(r           + dz),
-                     field(r + dx      + dz),
-                     field(r      + dy + dz),
-                     field(r + dx + dy + dz),
-                    };
-
-                const int configN = getConfig(vs);
-
-                if (configN == 0 || configN == 255)
-                    continue;
-
-                int edgeIndices[12];
-
-                auto processEdge = [&](int edgeId, real va, real vb, real3 axis, const real3 &base)
-                {
-                    if ((va < 0.0) == (vb < 0.0))
-                        return;
-
-                    real3 v = base;
-                    v += axis * va / (va - vb);
-                    edgeIndices[edgeId] = static_cast<int>(vertices.size());
-                    vertices.push_back(v);
-                };
-
-                processEdge(0,  vs[0], vs[1], dx, r          );
-                processEdge(1,  vs[2], vs[3], dx, r + dy     );
-                processEdge(2,  vs[4], vs[5], dx, r      + dz);
-                processEdge(3,  vs[6], vs[7], dx, r + dy + dz);
-
-                processEdge(4,  vs[0], vs[2], dy, r          );
-                processEdge(5,  vs[1], vs[3], dy, r + dx     );
-                processEdge(6,  vs[4], vs[6], dy, r      + dz);
-                processEdge(7,  vs[5], vs[7], dy, r + dx + dz);
-
-                processEdge(8,  vs[0], vs[4], dz, r          );
-                processEdge(9,  vs[1], vs[5], dz, r + dx     );
-                processEdge(10, vs[2], vs[6], dz, r      + dy);
-                processEdge(11, vs[3], vs[7], dz, r + dx + dy);
-
-                const uint64_t config = marchingCubeTris[configN];
-                const int  nTriangles = config & 0xF;
-                const int    nIndices = nTriangles * 3;
-
-                int offset = 4;
-
-                for (int i = 0; i < nIndices; i++) {
-                    const int edge = static_cast<int>((config >> offset) & 0xF);
-                    indices.push_back(edgeIndices[edge]);
-                    offset += 4;
-                }
-            }
-        }
-    }
+    // the field may not be thread safe (e.g. a python function): evaluate it serially
+    auto batchField = [&field](int n, const real3 *positions, real *values)
+    {
+        for (int i = 0; i < n; ++i)
+            values[i] = field(positions[i]);
+    };
+
+    IndexedMesh mesh;
+    computeIndexedMesh(domain, resolution, batchField, mesh);
+
+    triangles.resize(mesh.triangles.size());
 
-    for (size_t i = 0; i < indices.size(); i += 3) {
-        Triangle t;
-        t.a = domain.global2local(vertices[indices[i+0]]);
-        t.b = domain.global2local(vertices[indices[i+1]]);
-        t.c = domain.global2local(vertices[indices[i+2]]);
-        triangles.push_back(t);
+    for (size_t i = 0; i < triangles.size(); ++i)
+    {
+        const int3 t = mesh.triangles[i];
+        triangles[i] = {mesh.vertices[t.x], mesh.vertices[t.y], mesh.vertices[t.z]};
     }
 }
 
@@ -15,6 +15,10 @@ namespace marching_cubes
 /// The zero level set represents the surface
 using ImplicitSurfaceFunction = std::function< real(real3) >;
 
+/// Same as ImplicitSurfaceFunction, evaluated on a batch of positions.
+/// Arguments: the number of positions n, the n positions and the n output values.
+using ImplicitSurfaceBatchFunction = std::function< void(int, const real3*, real*) >;
+
 /// simple tructure that represents a triangle in 3D
 struct Triangle
 {
@@ -23,6 +27,13 @@ struct Triangle
     real3 c; ///< vertex 2
 };
 
+/// triangle mesh in which the vertices are shared by the adjacent triangles
+struct IndexedMesh
+{
+    std::vector<real3> vertices; ///< vertex positions
+    std::vector<int3> triangles; ///< indices of the 3 vertices of each triangle
+};
+
 /** \brief Create an explicit surface (triangles) from implicit surface (scalar field)
     using marching cubes
     \param [in] domain Domain information
@@ -34,6 +45,23 @@ void computeTriangles(DomainInfo domain, real3 resolution,
                       const ImplicitSurfaceFunction& surface,
                       std::vector<Triangle>& triangles);
 
+/** \brief Create an indexed triangle mesh from implicit surface (scalar field) using marching cubes
+    \param [in] domain Domain information
+    \param [in] resolution the grid spacing in each direction
+    \param [in] surface The scalar field that represents implicitly the surface (0 levelset)
+    \param [out] mesh The explicit surface representation, in local coordinates
+
+    The grid is swept by slabs along x: \p surface is called once per plane of grid nodes,
+    so that every node is sampled only once and the memory used for the samples is bounded by two planes.
+    The vertices on the edges crossed by the surface are shared by all the cells around the edge.
+    The work within a slab is parallelized with OpenMP if available; \p surface itself is always
+    called from the calling thread.
+    The triangles are in the same order as the ones of computeTriangles().
+ */
+void computeIndexedMesh(DomainInfo domain, real3 resolution,
+                        const ImplicitSurfaceBatchFunction& surface,
+                        IndexedMesh& mesh);
+
 } // namespace marching_cubes
 
 } // namespace mirheo
@@ -18,6 +18,7 @@
 #include <mirheo/core/utils/config.h>
 #include <mirheo/core/utils/cuda_common.h>
 #include <mirheo/core/utils/path.h>
+#include <mirheo/core/utils/strprintf.h>
 #include <mirheo/core/version.h>
 #include <mirheo/core/walls/interface.h>
 #include <mirheo/core/walls/simple_stationary_wall.h>
@@ -350,6 +351,14 @@ void Mirheo::setWallBounce(Wall *wall, ParticleVector *pv, real maximumPartTrave
         sim_->setWallBounce(wall->getName(), pv->getName(), maximumPartTravel);
 }
 
+void Mirheo::setAdaptiveTimeStep(real dtMin, real dtMax, real maxDisplacement, real maxGrowth, int every)
+{
+    ensureNotInitialized();
+
+    if (isComputeTask())
+        sim_->setAdaptiveTimeStep({dtMin, dtMax, maxDisplacement, maxGrowth, every});
+}
+
 MirState* Mirheo::getState()
 {
     return state_.get();
@@ -397,7 +406,7 @@ void Mirheo::dumpWalls2XDMF(std::vector<std::shared_ptr<Wall>> walls, real3 h, c
     wall_helpers::dumpWalls2XDMF(sdfWalls, h, state_->domain, filename, sim_->getCartComm());
 }
 
-double Mirheo::computeVolumeInsideWalls(std::vector<std::shared_ptr<Wall>> walls, long nSamplesPerRank)
+double Mirheo::computeVolumeInsideWalls(std::vector<std::shared_ptr<Wall>> walls, long nSamplesPerRank, real h)
 {
     if (!isComputeTask()) return 0;
 
@@ -416,6 +425,9 @@ double Mirheo::computeVolumeInsideWalls(std::vector<std::shared_ptr<Wall>> walls
         sim_->getWallByNameOrDie(wall->getName());
     }
 
+    if (h > 0.0_r)
+        return wall_helpers::volumeInsideWallsOnGrid(sdfWalls, state_->domain, sim_->getCartComm(), h);
+
     return wall_helpers::volumeInsideWalls(sdfWalls, state_->domain, sim_->getCartComm(), nSamplesPerRank);
 }
 
@@ -423,7 +435,8 @@ std::shared_ptr<ParticleVector> Mirheo::makeFrozenWallParticles(std::string pvNa
                                                                std::vector<std::shared_ptr<Wall>> walls,
                                                                std::vector<std::shared_ptr<Interaction>> interactions,
                                                                std::shared_ptr<Integrator> integrator,
-                                                               real numDensity, real mass, int nsteps)
+                                                               real numDensity, real mass, int nsteps,
+                                                               const std::string& cacheFolder)
 {
     ensureNotInitialized();
 
@@ -452,11 +465,52 @@ std::shared_ptr<ParticleVector> Mirheo::makeFrozenWallParticles(std::string pvNa
         info("Working with wall '%s'", wall->getCName());
     }
 
+    auto pv = std::make_shared<ParticleVector>(getState(), pvName, mass);
+
+    std::string cacheFile;
+    if (!cacheFolder.empty())
+    {
+        MPI_Comm comm = sim_->getCartComm();
+
+        std::string parameters = strprintf("density %g mass %g nsteps %d dt %g integrator %s",
+                                           numDensity, mass, nsteps, getState()->dt, integrator->getCName());
+        for (const auto& interaction : interactions)
+            parameters += strprintf(" interaction %s rc %g", interaction->getCName(), interaction->getCutoffRadius());
+
+        const std::string key = wall_helpers::computeWallsGeometryKey(sdfWalls, state_->domain, comm, parameters);
+        const std::string folder = joinPaths(cacheFolder, key);
+
+        int rank;
+        MPI_Check( MPI_Comm_rank(comm, &rank) );
+        cacheFile = joinPaths(folder, "frozen_" + createStrZeroPadded(rank) + ".bin");
+
+        // all ranks must agree, otherwise some of them would run the equilibration alone
+        int found = wall_helpers::loadFrozenParticles(pv.get(), cacheFile);
+        MPI_Check( MPI_Allreduce(MPI_IN_PLACE, &found, 1, MPI_INT, MPI_MIN, comm) );
+
+        if (found)
+        {
+            info("Reusing frozen particles from '%s'", folder.c_str());
+
+            pv->setStatic(true);
+            sim_->registerParticleVector(pv, nullptr);
+
+            for (auto &wall : walls)
+                wall->attachFrozen(pv.get());
+
+            return pv;
+        }
+
+        pv->local()->resize_anew(0);
+
+        if (!createFoldersCollective(comm, folder))
+            die("Could not create the frozen particles cache folder '%s'", folder.c_str());
+    }
+
     MirState stateCpy = *getState();
 
     Simulation wallsim(sim_->getCartComm(), MPI_COMM_NULL, getState(), CheckpointInfo{});
 
-    auto pv = std::make_shared<ParticleVector>(getState(), pvName, mass);
     auto ic = std::make_shared<UniformIC>(numDensity);
 
     wallsim.registerParticleVector(pv, ic);
@@ -482,9 +536,24 @@ std::shared_ptr<ParticleVector> Mirheo::makeFrozenWallParticles(std::string pvNa
 
     info("wall thickness is set to %g", wallThickness);
 
+    // the frozen particles are selected from the SDF values up to the wall thickness
+    for (auto wall : sdfWalls)
+    {
+        const real band = wall->getNarrowBandWidth();
+        if (band > 0.0_r && band <= wallThickness)
+            die("The narrow band width of wall '%s' (%g) must be larger than the wall thickness (%g), "
+                "i.e. the largest cut-off radius plus %g", wall->getCName(), band, wallThickness, wallThicknessTolerance);
+    }
+
     wall_helpers::freezeParticlesInWalls(sdfWalls, pv.get(), wallLevelSet, wallLevelSet + wallThickness);
     info("\n");
 
+    if (!cacheFile.empty())
+        wall_helpers::saveFrozenParticles(pv.get(), cacheFile);
+
+    // the frozen particles never move: no need to rebuild their cell-lists and halo at every step
+    // (setting an integrator, e.g. to follow a moving wall, clears this flag)
+    pv->setStatic(true);
     sim_->registerParticleVector(pv, nullptr);
 
     for (auto &wall : walls)
@@ -688,6 +757,7 @@ void Mirheo::logCompileOptions() const
     info("MEMBRANE_DOUBLE : %d", compile_options.membraneDouble);
     info("ROD_DOUBLE      : %d", compile_options.rodDouble     );
     info("USE_NVTX        : %d", compile_options.useNvtx       );
+    info("USE_ZLIB        : %d", compile_options.useZlib       );
 }
 
 void Mirheo::saveSnapshot(const std::string& path)
@@ -193,6 +193,17 @@ public:
     */
     void setWallBounce(Wall *wall, ParticleVector *pv, real maximumPartTravel = 0.25f);
 
+    /** \brief Let the time step follow the velocities and forces of the integrated particles.
+        \param dtMin Lower bound of the time step
+        \param dtMax Upper bound of the time step
+        \param maxDisplacement Target maximum displacement of any particle over one time step
+        \param maxGrowth The time step can increase at most by this factor per update
+        \param every The time step is updated every this number of time steps
+
+        See AdaptiveTimeStep for more information.
+    */
+    void setAdaptiveTimeStep(real dtMin, real dtMax, real maxDisplacement, real maxGrowth = 1.1_r, int every = 1);
+
     MirState* getState(); ///< \return the global state of the system
     const MirState* getState() const; ///< \return the global state of the system (const version)
     Simulation* getSimulation();  ///< \return the Simulation object; \c nullptr on postprocess tasks.
@@ -206,12 +217,13 @@ public:
      */
     void dumpWalls2XDMF(std::vector<std::shared_ptr<Wall>> walls, real3 h, const std::string& filename);
 
-    /** \brief Compute the volume inside the geometry formed by the given walls with simple Monte-Carlo integration.
+    /** \brief Compute the volume inside the geometry formed by the given walls.
         \param walls List of \c Wall objects. The union of these walls form the geometry.
         \param nSamplesPerRank The number of Monte-Carlo samples per rank
-        \return The Monte-Carlo estimate of the volume
+        \param h If positive, the SDF is integrated on a grid with this spacing instead of using Monte-Carlo samples
+        \return The estimate of the volume
      */
-    double computeVolumeInsideWalls(std::vector<std::shared_ptr<Wall>> walls, long nSamplesPerRank = 100000);
+    double computeVolumeInsideWalls(std::vector<std::shared_ptr<Wall>> walls, long nSamplesPerRank = 100000, real h = 0.0_r);
 
     /** \brief Create a layer of frozen particles inside the given walls.
         \param pvName The name of the frozen ParticleVector that will be created
@@ -221,16 +233,20 @@ public:
         \param numDensity The number density used to initialize the particles
         \param mass The mass of one particle
         \param nsteps Number of equilibration steps
-        \return The frozen particles
+        \param cacheFolder If not empty, the frozen particles are stored in and reused from this folder
+        \return The frozen particles, marked as static (see ParticleVector::setStatic())
 
         This will run a simulation of "bulk" particles and select the particles that are inside the effective
         cut-off radius of the given list of interactions.
+        When a cache folder is given, the particles are looked up with a key made of the geometry of the walls,
+        the domain decomposition and the parameters of the equilibration; the simulation is skipped on hit.
      */
     std::shared_ptr<ParticleVector> makeFrozenWallParticles(std::string pvName,
                                                             std::vector<std::shared_ptr<Wall>> walls,
                                                             std::vector<std::shared_ptr<Interaction>> interactions,
                                                             std::shared_ptr<Integrator> integrator,
-                                                            real numDensity, real mass, int nsteps);
+                                                            real numDensity, real mass, int nsteps,
+                                                            const std::string& cacheFolder = "");
 
     /** \brief Create frozen particles inside the given objects.
         \param checker The ObjectBelongingChecker to split inside particles
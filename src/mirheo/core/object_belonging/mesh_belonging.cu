@@ -1,6 +1,7 @@
 // Copyright 2020 ETH Zurich. All Rights Reserved.
 #include "mesh_belonging.h"
 
+#include <mirheo/core/bouncers/drivers/common.h>
 #include <mirheo/core/celllist.h>
 #include <mirheo/core/pvs/object_vector.h>
 #include <mirheo/core/pvs/views/ov.h>
@@ -8,6 +9,8 @@
 #include <mirheo/core/utils/kernel_launch.h>
 #include <mirheo/core/utils/quaternion.h>
 
+#include <algorithm>
+
 namespace mirheo
 {
 
@@ -103,57 +106,285 @@ __device__ static inline BelongingTags oneParticleInsideMesh(int pid, real3 r, i
 }
 
 /**
- * OVview view is only used to provide # of objects and extent information
- * Actual data is in \p vertices
- * @param cinfo is the cell-list sync'd with the target ParticleVector data
+ * One thread per particle: register the objects whose extents contain the particle
+ */
+__global__ void findCandidates(PVview pvView, ObjectCellListView objCells, CollisionTable<int2> candidates)
+{
+    const int pid = blockIdx.x * blockDim.x + threadIdx.x;
+    if (pid >= pvView.size) return;
+
+    const real3 r = make_real3(pvView.readPosition(pid));
+
+    objCells.forEachObjectContaining(r, [&](int objId)
+    {
+        candidates.push_back({pid, objId});
+    });
+}
+
+/**
+ * One warp per (particle, object) candidate pair
+ * Actual object data is in \p vertices
+ * @param pvView is sync'd with the cell-list of the target ParticleVector
  */
-template<int WARPS_PER_OBJ>
-__global__ void insideMesh(const OVview ovView, const MeshView mesh, const real4 *vertices, CellListInfo cinfo, PVview pvView, BelongingTags* tags)
+__global__ void insideMesh(int nCandidates, const int2 *candidates, const COMandExtent *comAndExtents,
+                           const MeshView mesh, const real4 *vertices, PVview pvView, BelongingTags* tags)
 {
     const int gid = blockIdx.x*blockDim.x + threadIdx.x;
     const int wid = gid / warpSize;
-    const int objId = wid / WARPS_PER_OBJ;
+    if (wid >= nCandidates) return;
 
-    const int locWid = wid % WARPS_PER_OBJ;
+    const int2 pidObjId = candidates[wid];
+    const int pid   = pidObjId.x;
+    const int objId = pidObjId.y;
 
-    if (objId >= ovView.nObjects) return;
+    const real3 r = make_real3(pvView.readPosition(pid));
+    const auto tag = oneParticleInsideMesh(pid, r, objId, comAndExtents[objId].com, mesh, vertices);
 
-    const int3 cidLow  = cinfo.getCellIdAlongAxes(ovView.comAndExtents[objId].low  - 0.5_r);
-    const int3 cidHigh = cinfo.getCellIdAlongAxes(ovView.comAndExtents[objId].high + 0.5_r);
+    // Only tag particles inside, default is outside anyways
+    if (laneId() == 0 && tag != BelongingTags::Outside)
+        tags[pid] = tag;
+}
 
-    const int3 span = cidHigh - cidLow + make_int3(1,1,1);
-    const int totCells = span.x * span.y * span.z;
+/**
+ * One warp works on one particle
+ * The result is valid on the first lane only; its magnitude is close to 1 inside and to 0 outside,
+ * its sign depends on the orientation of the mesh.
+ */
+__device__ static inline real oneParticleWindingNumber(real3 r, int objId, const MeshView mesh, const real4 *vertices)
+{
+    real omega = 0.0_r;
 
-    for (int i = locWid; i < totCells; i += WARPS_PER_OBJ)
+    for (int i = laneId(); i < mesh.ntriangles; i += warpSize)
     {
-        const int3 cid3 = make_int3( i % span.x, (i/span.x) % span.y, i / (span.x*span.y) ) + cidLow;
-        const int  cid = cinfo.encode(cid3);
-        if (cid < 0 || cid >= cinfo.totcells) continue;
+        const int3 trid = mesh.triangles[i];
 
-        int pstart = cinfo.cellStarts[cid];
-        int pend   = cinfo.cellStarts[cid+1];
+        const real3 v0 = fetchPosition(vertices, objId*mesh.nvertices + trid.x) - r;
+        const real3 v1 = fetchPosition(vertices, objId*mesh.nvertices + trid.y) - r;
+        const real3 v2 = fetchPosition(vertices, objId*mesh.nvertices + trid.z) - r;
 
-#pragma unroll 3
-        for (int pid = pstart; pid < pend; pid++)
-        {
-            const Particle p(pvView.readParticle(pid));
+        omega += winding_number::triangleSolidAngle(v0, v1, v2);
+    }
+
+    omega = warpReduce(omega, [] (real a, real b) { return a+b; });
+    return omega / (4.0_r * static_cast<real>(M_PI));
+}
+
+/// Regular grids of n^3 nodes covering the inflated extents of each object
+struct WindingGrids
+{
+    int n;        ///< number of nodes along each direction
+    real margin;  ///< the extents of the objects are inflated by this distance
+    real *values; ///< winding numbers at the nodes, n^3 per object
+
+    __device__ inline void getGeometry(const COMandExtent& e, real3& origin, real3& h) const
+    {
+        origin = e.low - margin;
+        h = (e.high - e.low + 2.0_r * margin) / static_cast<real>(n - 1);
+    }
+
+    __device__ inline bool isInside(int objId, int3 node) const
+    {
+        return math::abs(values[objId * n*n*n + (node.z * n + node.y) * n + node.x]) > 0.5_r;
+    }
+};
+
+/**
+ * One block row per object (blockIdx.x), one thread per grid node
+ * The triangles are staged in shared memory and shared by all the nodes of the block
+ */
+__global__ void computeWindingGrids(const COMandExtent *comAndExtents, const MeshView mesh,
+                                    const real4 *vertices, WindingGrids grids)
+{
+    extern __shared__ real3 triangleVertices[];
+
+    const int objId = blockIdx.x;
+    const int nodeId = blockIdx.y * blockDim.x + threadIdx.x;
+    const int n = grids.n;
+    const int nnodes = n * n * n;
 
-            auto tag = oneParticleInsideMesh(pid, p.r, objId, ovView.comAndExtents[objId].com, mesh, vertices);
+    real3 origin, h;
+    grids.getGeometry(comAndExtents[objId], origin, h);
 
-            // Only tag particles inside, default is outside anyways
-            if (laneId() == 0 && tag != BelongingTags::Outside)
-                tags[pid] = tag;
+    const int3 node {nodeId % n, (nodeId / n) % n, nodeId / (n*n)};
+    const real3 r = origin + make_real3(node) * h;
+
+    real omega = 0.0_r;
+
+    for (int start = 0; start < mesh.ntriangles; start += blockDim.x)
+    {
+        const int i = start + threadIdx.x;
+
+        __syncthreads();
+        if (i < mesh.ntriangles)
+        {
+            const int3 trid = mesh.triangles[i];
+            triangleVertices[3*threadIdx.x + 0] = fetchPosition(vertices, objId*mesh.nvertices + trid.x);
+            triangleVertices[3*threadIdx.x + 1] = fetchPosition(vertices, objId*mesh.nvertices + trid.y);
+            triangleVertices[3*threadIdx.x + 2] = fetchPosition(vertices, objId*mesh.nvertices + trid.z);
         }
+        __syncthreads();
+
+        const int nloaded = math::min(static_cast<int>(blockDim.x), mesh.ntriangles - start);
+
+        for (int j = 0; j < nloaded; ++j)
+            omega += winding_number::triangleSolidAngle(triangleVertices[3*j + 0] - r,
+                                                        triangleVertices[3*j + 1] - r,
+                                                        triangleVertices[3*j + 2] - r);
     }
+
+    if (nodeId < nnodes)
+        grids.values[objId * nnodes + nodeId] = omega / (4.0_r * static_cast<real>(M_PI));
+}
+
+/**
+ * One thread per (particle, object) candidate pair
+ * Particles in grid cells with all corners inside are tagged, the ones in mixed cells are
+ * registered in \p nearSurface for an exact check.
+ */
+__global__ void classifyWithGrids(int nCandidates, const int2 *candidates, const COMandExtent *comAndExtents,
+                                  WindingGrids grids, PVview pvView, BelongingTags *tags,
+                                  CollisionTable<int2> nearSurface)
+{
+    const int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i >= nCandidates) return;
+
+    const int2 pidObjId = candidates[i];
+    const int pid   = pidObjId.x;
+    const int objId = pidObjId.y;
+
+    real3 origin, h;
+    grids.getGeometry(comAndExtents[objId], origin, h);
+
+    const real3 x = (make_real3(pvView.readPosition(pid)) - origin) / h;
+    const real upper = static_cast<real>(grids.n - 1);
+
+    if (x.x < 0.0_r || x.y < 0.0_r || x.z < 0.0_r ||
+        x.x > upper || x.y > upper || x.z > upper)
+        return;
+
+    const int3 c = math::min(make_int3(math::floor(x)), make_int3(grids.n - 2));
+
+    int nInside = 0;
+    for (int dz = 0; dz <= 1; ++dz)
+    for (int dy = 0; dy <= 1; ++dy)
+    for (int dx = 0; dx <= 1; ++dx)
+        if (grids.isInside(objId, c + make_int3(dx, dy, dz)))
+            ++nInside;
+
+    if (nInside == 8)
+        tags[pid] = BelongingTags::Inside;
+    else if (nInside > 0)
+        nearSurface.push_back(pidObjId);
+}
+
+/**
+ * One warp per (particle, object) pair close to the surface
+ */
+__global__ void insideMeshWindingNumber(int nCandidates, const int2 *candidates, const MeshView mesh,
+                                        const real4 *vertices, PVview pvView, BelongingTags *tags)
+{
+    const int gid = blockIdx.x*blockDim.x + threadIdx.x;
+    const int wid = gid / warpSize;
+    if (wid >= nCandidates) return;
+
+    const int2 pidObjId = candidates[wid];
+    const int pid   = pidObjId.x;
+    const int objId = pidObjId.y;
+
+    const real3 r = make_real3(pvView.readPosition(pid));
+    const real w = oneParticleWindingNumber(r, objId, mesh, vertices);
+
+    if (laneId() == 0 && math::abs(w) > 0.5_r)
+        tags[pid] = BelongingTags::Inside;
+}
+
+/**
+ * One thread per (object, tree node): refit the far field data of the hierarchy to the current vertices
+ */
+__global__ void computeTreeGeometry(int nObjects, winding_number::TreeView tree, const MeshView mesh,
+                                    const real4 *vertices, real4 *nodeCenters, real4 *nodeNormals)
+{
+    const int i = blockIdx.x * blockDim.x + threadIdx.x;
+    const int objId  = i / tree.nnodes;
+    const int nodeId = i % tree.nnodes;
+    if (objId >= nObjects) return;
+
+    auto getVertex = [&](int v) { return fetchPosition(vertices, objId * mesh.nvertices + v); };
+
+    winding_number::computeNodeGeometry(tree.nodes[nodeId], tree.triangles, getVertex,
+                                        nodeCenters[i], nodeNormals[i]);
+}
+
+/**
+ * One thread per (particle, object) candidate pair
+ */
+__global__ void insideMeshHierarchical(int nCandidates, const int2 *candidates, winding_number::TreeView tree,
+                                       const MeshView mesh, const real4 *vertices,
+                                       const real4 *nodeCenters, const real4 *nodeNormals,
+                                       PVview pvView, BelongingTags *tags)
+{
+    const int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i >= nCandidates) return;
+
+    const int2 pidObjId = candidates[i];
+    const int pid   = pidObjId.x;
+    const int objId = pidObjId.y;
+
+    auto getVertex = [&](int v) { return fetchPosition(vertices, objId * mesh.nvertices + v); };
+
+    const real3 r = make_real3(pvView.readPosition(pid));
+    const real w = winding_number::evaluate(r, tree,
+                                            nodeCenters + objId * tree.nnodes,
+                                            nodeNormals + objId * tree.nnodes,
+                                            getVertex);
+
+    if (math::abs(w) > 0.5_r)
+        tags[pid] = BelongingTags::Inside;
 }
 
 } // namespace mesh_belonging_kernels
 
+/// cells of about the size of one object
+static real getObjectCellSize(const Mesh *mesh)
+{
+    real3 lo {+1e30_r, +1e30_r, +1e30_r}, hi {-1e30_r, -1e30_r, -1e30_r};
+    for (const auto& v : mesh->getVertices())
+    {
+        lo = math::min(lo, make_real3(v));
+        hi = math::max(hi, make_real3(v));
+    }
+    const real3 meshSize = hi - lo;
+    return math::max(1.0_r, math::max(meshSize.x, math::max(meshSize.y, meshSize.z)));
+}
+
+/// register the (particle, object) pairs such that the particle is inside the inflated extents of the object
+static void findCandidates(const PVview& pvView, const ObjectCellList& objectCells,
+                           AdaptiveCollisionTable<int2>& candidates, cudaStream_t stream)
+{
+    constexpr int nthreads = 128;
+
+    do {
+        candidates.clear(stream);
+        const CollisionTable<int2> table {candidates.capacity(), candidates.devCounter(), candidates.devPtr()};
+
+        SAFE_KERNEL_LAUNCH(
+            mesh_belonging_kernels::findCandidates,
+            getNblocks(pvView.size, nthreads), nthreads, 0, stream,
+            pvView, objectCells.getView(), table);
+
+    } while (!candidates.downloadAndCheck(stream));
+}
+
+// particles may be slightly outside of the extents computed from the object particles
+constexpr real extentsMargin = 0.5_r;
+
 void MeshBelongingChecker::_tagInner(ParticleVector *pv, CellList *cl, cudaStream_t stream)
 {
     tags_.resize_anew(pv->local()->size());
     tags_.clearDevice(stream);
 
+    const real cellSize = getObjectCellSize(ov_->mesh.get());
+
     auto computeTags = [&](ParticleVectorLocality locality)
     {
         ov_->findExtentAndCOM(stream, locality);
@@ -167,14 +398,22 @@ void MeshBelongingChecker::_tagInner(ParticleVector *pv, CellList *cl, cudaStrea
               view.nObjects, getParticleVectorLocalityStr(locality).c_str(),
               ov_->getCName(), pv->local()->size(), pv->getCName());
 
+        if (view.nObjects == 0)
+            return;
+
+        objectCells_.build(view, cellSize, extentsMargin, ov_->getState()->domain.localSize, stream);
+
         constexpr int nthreads = 128;
-        constexpr int warpsPerObject = 1024;
+        const auto pvView = cl->getView<PVview>();
+
+        findCandidates(pvView, objectCells_, candidates_, stream);
 
         SAFE_KERNEL_LAUNCH(
-            mesh_belonging_kernels::insideMesh<warpsPerObject>,
-            getNblocks(warpsPerObject*32*view.nObjects, nthreads), nthreads, 0, stream,
-            view, meshView, reinterpret_cast<real4*>(vertices->devPtr()),
-            cl->cellInfo(), cl->getView<PVview>(), tags_.devPtr());
+            mesh_belonging_kernels::insideMesh,
+            getNblocks(32 * candidates_.size(), nthreads), nthreads, 0, stream,
+            candidates_.size(), candidates_.devPtr(), view.comAndExtents,
+            meshView, reinterpret_cast<real4*>(vertices->devPtr()),
+            pvView, tags_.devPtr());
     };
 
 
@@ -182,4 +421,180 @@ void MeshBelongingChecker::_tagInner(ParticleVector *pv, CellList *cl, cudaStrea
     computeTags(ParticleVectorLocality::Halo);
 }
 
+MeshGridBelongingChecker::MeshGridBelongingChecker(const MirState *state, const std::string& name, int gridSize) :
+    ObjectVectorBelongingChecker(state, name),
+    gridSize_(gridSize)
+{
+    if (gridSize_ < 2)
+        die("Belonging checker '%s': the grid size must be at least 2, got %d", getCName(), gridSize_);
+}
+
+void MeshGridBelongingChecker::_tagInner(ParticleVector *pv, CellList *cl, cudaStream_t stream)
+{
+    tags_.resize_anew(pv->local()->size());
+    tags_.clearDevice(stream);
+
+    const real cellSize = getObjectCellSize(ov_->mesh.get());
+    const int nnodes = gridSize_ * gridSize_ * gridSize_;
+
+    auto computeTags = [&](ParticleVectorLocality locality)
+    {
+        ov_->findExtentAndCOM(stream, locality);
+
+        auto lov = ov_->get(locality);
+        auto view = OVview(ov_, lov);
+        auto vertices = reinterpret_cast<real4*>(lov->getMeshVertices(stream)->devPtr());
+        auto meshView = MeshView(ov_->mesh.get());
+
+        debug("Computing inside/outside tags (against mesh grids) for %d %s objects '%s' and %d '%s' particles",
+              view.nObjects, getParticleVectorLocalityStr(locality).c_str(),
+              ov_->getCName(), pv->local()->size(), pv->getCName());
+
+        if (view.nObjects == 0)
+            return;
+
+        objectCells_.build(view, cellSize, extentsMargin, ov_->getState()->domain.localSize, stream);
+
+        const auto pvView = cl->getView<PVview>();
+        findCandidates(pvView, objectCells_, candidates_, stream);
+
+        if (candidates_.size() == 0)
+            return;
+
+        windingNumbers_.resize_anew(view.nObjects * nnodes);
+        const mesh_belonging_kernels::WindingGrids grids {gridSize_, extentsMargin, windingNumbers_.devPtr()};
+
+        constexpr int nthreads = 128;
+        const size_t shMemSize = 3 * nthreads * sizeof(real3);
+
+        SAFE_KERNEL_LAUNCH(
+            mesh_belonging_kernels::computeWindingGrids,
+            dim3(view.nObjects, getNblocks(nnodes, nthreads)), nthreads, shMemSize, stream,
+            view.comAndExtents, meshView, vertices, grids);
+
+        do {
+            nearSurface_.clear(stream);
+            const CollisionTable<int2> table {nearSurface_.capacity(), nearSurface_.devCounter(), nearSurface_.devPtr()};
+
+            SAFE_KERNEL_LAUNCH(
+                mesh_belonging_kernels::classifyWithGrids,
+                getNblocks(candidates_.size(), nthreads), nthreads, 0, stream,
+                candidates_.size(), candidates_.devPtr(), view.comAndExtents,
+                grids, pvView, tags_.devPtr(), table);
+
+        } while (!nearSurface_.downloadAndCheck(stream));
+
+        debug("%d out of %d candidate particles are close to the surface of '%s' and need an exact check",
+              nearSurface_.size(), candidates_.size(), ov_->getCName());
+
+        SAFE_KERNEL_LAUNCH(
+            mesh_belonging_kernels::insideMeshWindingNumber,
+            getNblocks(32 * nearSurface_.size(), nthreads), nthreads, 0, stream,
+            nearSurface_.size(), nearSurface_.devPtr(), meshView, vertices,
+            pvView, tags_.devPtr());
+    };
+
+    computeTags(ParticleVectorLocality::Local);
+    computeTags(ParticleVectorLocality::Halo);
+}
+
+
+MeshWindingNumberBelongingChecker::MeshWindingNumberBelongingChecker(const MirState *state, const std::string& name,
+                                                                     real farFieldRatio, int leafSize) :
+    ObjectVectorBelongingChecker(state, name),
+    farFieldRatio_(farFieldRatio),
+    leafSize_(leafSize)
+{
+    if (farFieldRatio_ <= 0.0_r)
+        die("Belonging checker '%s': the far field ratio must be positive, got %g", getCName(), farFieldRatio_);
+    if (leafSize_ < 1)
+        die("Belonging checker '%s': the leaf size must be positive, got %d", getCName(), leafSize_);
+}
+
+void MeshWindingNumberBelongingChecker::setup(ObjectVector *ov)
+{
+    ObjectVectorBelongingChecker::setup(ov);
+
+    if (ov->mesh == nullptr)
+        die("Belonging checker '%s' needs objects with a mesh ('%s' has none)", getCName(), ov->getCName());
+
+    const auto& meshVertices = ov->mesh->getVertices();
+    const auto& meshFaces    = ov->mesh->getFaces();
+
+    std::vector<real3> vertices;
+    for (const auto& v : meshVertices)
+        vertices.push_back(make_real3(v));
+
+    std::vector<int3> triangles(meshFaces.begin(), meshFaces.end());
+
+    const auto nodes = winding_number::buildTree(vertices, triangles, leafSize_);
+
+    treeNodes_.resize_anew(nodes.size());
+    std::copy(nodes.begin(), nodes.end(), treeNodes_.begin());
+    treeNodes_.uploadToDevice(defaultStream);
+
+    treeTriangles_.resize_anew(triangles.size());
+    std::copy(triangles.begin(), triangles.end(), treeTriangles_.begin());
+    treeTriangles_.uploadToDevice(defaultStream);
+
+    debug("Belonging checker '%s': built a hierarchy of %d nodes for the %d triangles of '%s'",
+          getCName(), static_cast<int>(nodes.size()), static_cast<int>(triangles.size()), ov->getCName());
+}
+
+void MeshWindingNumberBelongingChecker::_tagInner(ParticleVector *pv, CellList *cl, cudaStream_t stream)
+{
+    tags_.resize_anew(pv->local()->size());
+    tags_.clearDevice(stream);
+
+    const real cellSize = getObjectCellSize(ov_->mesh.get());
+    const winding_number::TreeView tree {static_cast<int>(treeNodes_.size()), treeNodes_.devPtr(),
+                                         treeTriangles_.devPtr(), farFieldRatio_};
+
+    auto computeTags = [&](ParticleVectorLocality locality)
+    {
+        ov_->findExtentAndCOM(stream, locality);
+
+        auto lov = ov_->get(locality);
+        auto view = OVview(ov_, lov);
+        auto vertices = reinterpret_cast<real4*>(lov->getMeshVertices(stream)->devPtr());
+        auto meshView = MeshView(ov_->mesh.get());
+
+        debug("Computing inside/outside tags (against mesh winding number) for %d %s objects '%s' and %d '%s' particles",
+              view.nObjects, getParticleVectorLocalityStr(locality).c_str(),
+              ov_->getCName(), pv->local()->size(), pv->getCName());
+
+        if (view.nObjects == 0)
+            return;
+
+        objectCells_.build(view, cellSize, extentsMargin, ov_->getState()->domain.localSize, stream);
+
+        const auto pvView = cl->getView<PVview>();
+        findCandidates(pvView, objectCells_, candidates_, stream);
+
+        if (candidates_.size() == 0)
+            return;
+
+        const int nnodes = view.nObjects * tree.nnodes;
+        nodeCenters_.resize_anew(nnodes);
+        nodeNormals_.resize_anew(nnodes);
+
+        constexpr int nthreads = 128;
+
+        SAFE_KERNEL_LAUNCH(
+            mesh_belonging_kernels::computeTreeGeometry,
+            getNblocks(nnodes, nthreads), nthreads, 0, stream,
+            view.nObjects, tree, meshView, vertices,
+            nodeCenters_.devPtr(), nodeNormals_.devPtr());
+
+        SAFE_KERNEL_LAUNCH(
+            mesh_belonging_kernels::insideMeshHierarchical,
+            getNblocks(candidates_.size(), nthreads), nthreads, 0, stream,
+            candidates_.size(), candidates_.devPtr(), tree, meshView, vertices,
+            nodeCenters_.devPtr(), nodeNormals_.devPtr(), pvView, tags_.devPtr());
+    };
+
+    computeTags(ParticleVectorLocality::Local);
+    computeTags(ParticleVectorLocality::Halo);
+}
+
 } // namespace mirheo
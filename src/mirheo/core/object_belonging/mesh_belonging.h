@@ -2,6 +2,9 @@
 #pragma once
 
 #include "object_belonging.h"
+#include "winding_number.h"
+
+#include <mirheo/core/bouncers/collision_table.h>
 
 namespace mirheo
 {
@@ -13,6 +16,76 @@ public:
 
 protected:
     void _tagInner(ParticleVector *pv, CellList *cl, cudaStream_t stream) override;
+
+private:
+    AdaptiveCollisionTable<int2> candidates_ {"mesh belonging candidates"}; ///< (particle, object) pairs to check
+};
+
+/** \brief Check in/out status of particles against an ObjectVector with a triangle mesh, using a coarse grid per object.
+
+    At each check, the generalized winding number of the current mesh is evaluated at the nodes of a
+    regular grid covering each object, so that deformable objects are supported.
+    A particle is classified from the grid cell containing it when the 8 corners of that cell agree;
+    otherwise the particle is close to the surface and its exact winding number is computed.
+
+    The cost is O(grid nodes x triangles) per object instead of O(particles x triangles) for MeshBelongingChecker.
+    The grid spacing must be smaller than the thinnest parts of the objects.
+ */
+class MeshGridBelongingChecker : public ObjectVectorBelongingChecker
+{
+public:
+    /** \brief Construct a MeshGridBelongingChecker object.
+        \param [in] state Simulation state.
+        \param [in] name Name of the checker.
+        \param [in] gridSize Number of grid nodes along each direction of an object. Must be at least 2.
+     */
+    MeshGridBelongingChecker(const MirState *state, const std::string& name, int gridSize);
+
+protected:
+    void _tagInner(ParticleVector *pv, CellList *cl, cudaStream_t stream) override;
+
+private:
+    int gridSize_;
+    DeviceBuffer<real> windingNumbers_; ///< winding numbers at the grid nodes of all objects
+    AdaptiveCollisionTable<int2> candidates_   {"mesh grid belonging candidates"};   ///< (particle, object) pairs to check
+    AdaptiveCollisionTable<int2> nearSurface_  {"mesh grid belonging near surface"}; ///< pairs that need an exact check
+};
+
+/** \brief Check in/out status of particles against an ObjectVector with a triangle mesh, using the generalized winding number.
+
+    The winding number is evaluated with a bounding volume hierarchy of the mesh triangles (see winding_number::evaluate()):
+    groups of triangles far from a particle are approximated by their dipole term.
+    The hierarchy is built once from the reference mesh and its geometry is refitted to each object at each check,
+    which supports deformable objects.
+
+    Unlike the ray parity test of MeshBelongingChecker, the result is robust to meshes with small holes or
+    self intersections.
+ */
+class MeshWindingNumberBelongingChecker : public ObjectVectorBelongingChecker
+{
+public:
+    /** \brief Construct a MeshWindingNumberBelongingChecker object.
+        \param [in] state Simulation state.
+        \param [in] name Name of the checker.
+        \param [in] farFieldRatio Groups of triangles are approximated when their distance to a particle is larger than this ratio times their radius. Must be positive.
+        \param [in] leafSize Maximum number of triangles in the leaves of the hierarchy.
+     */
+    MeshWindingNumberBelongingChecker(const MirState *state, const std::string& name, real farFieldRatio, int leafSize);
+
+    void setup(ObjectVector *ov) override;
+
+protected:
+    void _tagInner(ParticleVector *pv, CellList *cl, cudaStream_t stream) override;
+
+private:
+    real farFieldRatio_;
+    int leafSize_;
+
+    PinnedBuffer<winding_number::TreeNode> treeNodes_; ///< nodes of the hierarchy, in depth-first order
+    PinnedBuffer<int3> treeTriangles_;                  ///< triangles of the mesh, in tree order
+    DeviceBuffer<real4> nodeCenters_;                   ///< center and radius of each node of each object
+    DeviceBuffer<real4> nodeNormals_;                   ///< area weighted normal of each node of each object
+    AdaptiveCollisionTable<int2> candidates_ {"mesh winding number belonging candidates"}; ///< (particle, object) pairs to check
 };
 
 } // namespace mirheo
@@ -3,6 +3,7 @@
 
 #include "interface.h"
 #include <mirheo/core/containers.h>
+#include <mirheo/core/object_cell_list.h>
 
 namespace mirheo
 {
@@ -48,6 +49,7 @@ protected:
     DeviceBuffer<BelongingTags> tags_; ///< Work space to store the in/out status of each input particle.
     PinnedBuffer<int> nInside_{1};  ///< Number of particles inside the registered ObjectVector.
     PinnedBuffer<int> nOutside_{1}; ///< Number of particles outside the registered ObjectVector.
+    ObjectCellList objectCells_;    ///< Cell list of the objects, to find the objects that may contain a particle.
 };
 
 } // namespace mirheo
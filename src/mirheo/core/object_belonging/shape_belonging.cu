@@ -16,43 +16,25 @@ namespace mirheo
 namespace shape_belonging_kernels
 {
 
+/// One thread per particle; only the objects whose extents contain the particle are checked
 template <class Shape>
-__global__ void computeTags(RSOVview<Shape> rsView, CellListInfo cinfo, PVview pvView, BelongingTags *tags)
+__global__ void computeTags(RSOVview<Shape> rsView, ObjectCellListView objCells, PVview pvView, BelongingTags *tags)
 {
     const real tolerance = 5e-6_r;
 
-    const int objId = blockIdx.x;
-    const int tid = threadIdx.x;
-    if (objId >= rsView.nObjects) return;
+    const int pid = blockIdx.x * blockDim.x + threadIdx.x;
+    if (pid >= pvView.size) return;
 
-    const int3 cidLow  = cinfo.getCellIdAlongAxes<CellListsProjection::Clamp>(rsView.comAndExtents[objId].low  - 1.5_r);
-    const int3 cidHigh = cinfo.getCellIdAlongAxes<CellListsProjection::Clamp>(rsView.comAndExtents[objId].high + 2.5_r);
+    const real3 r = make_real3(pvView.readPosition(pid));
 
-    const int3 span = cidHigh - cidLow + make_int3(1,1,1);
-    const int totCells = span.x * span.y * span.z;
-
-    for (int i = tid; i < totCells; i += blockDim.x)
+    objCells.forEachObjectContaining(r, [&](int objId)
     {
-        const int3 cid3 = make_int3( i % span.x, (i/span.x) % span.y, i / (span.x*span.y) ) + cidLow;
-        const int  cid = cinfo.encode(cid3);
-        if (cid >= cinfo.totcells) continue;
-
-        int pstart = cinfo.cellStarts[cid];
-        int pend   = cinfo.cellStarts[cid+1];
-
-        for (int pid = pstart; pid < pend; pid++)
-        {
-            const Particle p(pvView.readParticle(pid));
-            const auto motion = toRealMotion(rsView.motions[objId]);
-
-            const real3 coo = motion.q.inverseRotate(p.r - motion.r);
+        const auto motion = toRealMotion(rsView.motions[objId]);
+        const real3 coo = motion.q.inverseRotate(r - motion.r);
 
-            const real v = rsView.shape.inOutFunction(coo);
-
-            if (v <= tolerance)
-                tags[pid] = BelongingTags::Inside;
-        }
-    }
+        if (rsView.shape.inOutFunction(coo) <= tolerance)
+            tags[pid] = BelongingTags::Inside;
+    });
 }
 
 } // namespace shape_belonging_kernels
@@ -69,6 +51,12 @@ void ShapeBelongingChecker<Shape>::_tagInner(ParticleVector *pv, CellList *cl, c
 
     auto pvView = cl->getView<PVview>();
 
+    // cells of about the size of one object
+    real r2 = 0.0_r;
+    for (const auto& r : rsov->initialPositions)
+        r2 = math::max(r2, dot(make_real3(r), make_real3(r)));
+    const real cellSize = math::max(1.0_r, 2.0_r * math::sqrt(r2));
+
     auto computeTags = [&](ParticleVectorLocality locality)
     {
         ov_->findExtentAndCOM(stream, locality);
@@ -79,12 +67,19 @@ void ShapeBelongingChecker<Shape>::_tagInner(ParticleVector *pv, CellList *cl, c
               rsovView.nObjects, getParticleVectorLocalityStr(locality).c_str(),
               Shape::desc, ov_->getCName(), pv->local()->size(), pv->getCName());
 
-        constexpr int nthreads = 512;
+        if (rsovView.nObjects == 0)
+            return;
+
+        // the analytical surface may be slightly outside of the extents computed from the frozen particles
+        constexpr real margin = 1.5_r;
+        objectCells_.build(rsovView, cellSize, margin, ov_->getState()->domain.localSize, stream);
+
+        constexpr int nthreads = 128;
 
         SAFE_KERNEL_LAUNCH(
             shape_belonging_kernels::computeTags,
-            rsovView.nObjects, nthreads, 0, stream,
-            rsovView, cl->cellInfo(), pvView, tags_.devPtr());
+            getNblocks(pvView.size, nthreads), nthreads, 0, stream,
+            rsovView, objectCells_.getView(), pvView, tags_.devPtr());
     };
 
     computeTags(ParticleVectorLocality::Local);
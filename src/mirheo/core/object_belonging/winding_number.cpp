@@ -0,0 +1,78 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#include "winding_number.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace mirheo
+{
+
+namespace winding_number
+{
+
+static real getComponent(real3 v, int axis)
+{
+    return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+}
+
+static void splitNode(std::vector<TreeNode>& nodes, std::vector<int>& order, const std::vector<real3>& centroids,
+                      int start, int end, int leafSize)
+{
+    const int id = static_cast<int>(nodes.size());
+    nodes.push_back({start, end, -1});
+
+    if (end - start > leafSize)
+    {
+        real3 lo = centroids[order[start]];
+        real3 hi = lo;
+        for (int i = start; i < end; ++i)
+        {
+            lo = math::min(lo, centroids[order[i]]);
+            hi = math::max(hi, centroids[order[i]]);
+        }
+
+        const real3 size = hi - lo;
+        const int axis = size.x >= size.y && size.x >= size.z ? 0 : (size.y >= size.z ? 1 : 2);
+        const int mid = (start + end) / 2;
+
+        std::nth_element(order.begin() + start, order.begin() + mid, order.begin() + end, [&](int a, int b)
+        {
+            return getComponent(centroids[a], axis) < getComponent(centroids[b], axis);
+        });
+
+        splitNode(nodes, order, centroids, start, mid, leafSize);
+        splitNode(nodes, order, centroids, mid,   end, leafSize);
+    }
+
+    nodes[id].skip = static_cast<int>(nodes.size());
+}
+
+std::vector<TreeNode> buildTree(const std::vector<real3>& vertices, std::vector<int3>& triangles, int leafSize)
+{
+    const int n = static_cast<int>(triangles.size());
+
+    std::vector<real3> centroids(n);
+    for (int i = 0; i < n; ++i)
+    {
+        const int3 t = triangles[i];
+        centroids[i] = (vertices[t.x] + vertices[t.y] + vertices[t.z]) / 3.0_r;
+    }
+
+    std::vector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+
+    std::vector<TreeNode> nodes;
+    if (n > 0)
+        splitNode(nodes, order, centroids, 0, n, std::max(1, leafSize));
+
+    std::vector<int3> sorted(n);
+    for (int i = 0; i < n; ++i)
+        sorted[i] = triangles[order[i]];
+    triangles = std::move(sorted);
+
+    return nodes;
+}
+
+} // namespace winding_number
+
+} // namespace mirheo
@@ -0,0 +1,174 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include <mirheo/core/datatypes.h>
+#include <mirheo/core/utils/cpu_gpu_defines.h>
+#include <mirheo/core/utils/helper_math.h>
+
+#include <vector>
+
+namespace mirheo
+{
+
+/** Generalized winding number of triangle meshes.
+
+    The winding number of a closed, outward oriented mesh is 1 inside and 0 outside.
+    Contrary to ray parity tests, it degrades gracefully for meshes with holes or self intersections.
+    See Jacobson et al., "Robust inside-outside segmentation using generalized winding numbers" (2013)
+    and Barill et al., "Fast winding numbers for soups and clouds" (2018).
+ */
+namespace winding_number
+{
+
+/** \brief Solid angle of a triangle seen from the origin (Van Oosterom and Strackee).
+    \param [in] a, b, c The vertices of the triangle, relative to the origin
+    \return The signed solid angle; positive if the triangle is oriented counter-clockwise when seen from outside
+ */
+__HD__ inline real triangleSolidAngle(real3 a, real3 b, real3 c)
+{
+    const real la = length(a);
+    const real lb = length(b);
+    const real lc = length(c);
+
+    const real det = dot(a, cross(b, c));
+    const real div = la * lb * lc + dot(a, b) * lc + dot(a, c) * lb + dot(b, c) * la;
+
+    return 2.0_r * math::atan2(det, div);
+}
+
+/** \brief A node of a bounding volume hierarchy of the triangles of a mesh.
+
+    The nodes are stored in depth-first order, so that the first child of a node is the next node
+    and the traversal needs no stack.
+    A node is a leaf iff its skip index is the next node.
+ */
+struct TreeNode
+{
+    int start; ///< first triangle (in tree order) covered by the node
+    int end;   ///< one past the last triangle covered by the node
+    int skip;  ///< index of the next node to visit when the subtree of this node is not traversed
+};
+
+/// A view of the hierarchy of a mesh topology, shared by all objects with that mesh
+struct TreeView
+{
+    int nnodes;                ///< number of nodes
+    const TreeNode *nodes;     ///< the nodes, in depth-first order
+    const int3 *triangles;     ///< the triangles of the mesh, sorted in tree order
+    real farFieldRatio;        ///< a node is approximated by its dipole when the distance to its center is larger than this ratio times its radius
+};
+
+/** \brief Build the hierarchy of a mesh by recursive median splits of the triangle centroids.
+    \param [in] vertices The vertices of the (reference) mesh
+    \param [in,out] triangles The triangles of the mesh; reordered in tree order on return
+    \param [in] leafSize Maximum number of triangles in a leaf
+    \return The nodes in depth-first order
+ */
+std::vector<TreeNode> buildTree(const std::vector<real3>& vertices, std::vector<int3>& triangles, int leafSize);
+
+/** \brief Compute the far field data of a node for the current vertex positions.
+    \tparam VertexFetcher Function with signature real3(int vertexId)
+    \param [in] node The node
+    \param [in] triangles The triangles in tree order
+    \param [in] getVertex Returns the position of a vertex
+    \param [out] centerRadius Area weighted center of the node triangles (xyz) and radius of the sphere enclosing them (w)
+    \param [out] areaNormal Sum of the area weighted normals of the node triangles (xyz)
+ */
+template <class VertexFetcher>
+__HD__ inline void computeNodeGeometry(const TreeNode& node, const int3 *triangles, VertexFetcher getVertex,
+                                       real4& centerRadius, real4& areaNormal)
+{
+    real3 weightedCenter {0.0_r, 0.0_r, 0.0_r};
+    real3 center         {0.0_r, 0.0_r, 0.0_r};
+    real3 normal         {0.0_r, 0.0_r, 0.0_r};
+    real area = 0.0_r;
+
+    for (int i = node.start; i < node.end; ++i)
+    {
+        const int3 t = triangles[i];
+        const real3 v0 = getVertex(t.x);
+        const real3 v1 = getVertex(t.y);
+        const real3 v2 = getVertex(t.z);
+
+        const real3 n = 0.5_r * cross(v1 - v0, v2 - v0);
+        const real a = length(n);
+        const real3 c = (v0 + v1 + v2) / 3.0_r;
+
+        normal         += n;
+        area           += a;
+        weightedCenter += a * c;
+        center         += c;
+    }
+
+    // degenerate triangles have no area but must still be enclosed
+    if (area > 0.0_r)
+        center = weightedCenter / area;
+    else
+        center /= static_cast<real>(node.end - node.start);
+
+    real radius2 = 0.0_r;
+    for (int i = node.start; i < node.end; ++i)
+    {
+        const int3 t = triangles[i];
+        radius2 = math::max(radius2, dot(getVertex(t.x) - center, getVertex(t.x) - center));
+        radius2 = math::max(radius2, dot(getVertex(t.y) - center, getVertex(t.y) - center));
+        radius2 = math::max(radius2, dot(getVertex(t.z) - center, getVertex(t.z) - center));
+    }
+
+    centerRadius = make_real4(center, math::sqrt(radius2));
+    areaNormal   = make_real4(normal, 0.0_r);
+}
+
+/** \brief Compute the generalized winding number of a mesh at a given point.
+    \tparam VertexFetcher Function with signature real3(int vertexId)
+    \param [in] r The point
+    \param [in] tree The hierarchy of the mesh
+    \param [in] centerRadius The far field data of the nodes (see computeNodeGeometry())
+    \param [in] areaNormals The far field data of the nodes (see computeNodeGeometry())
+    \param [in] getVertex Returns the position of a vertex
+    \return The winding number; its magnitude is close to 1 inside and to 0 outside
+
+    Nodes far enough from \p r are approximated by their dipole term; the other leaves are summed exactly.
+ */
+template <class VertexFetcher>
+__HD__ inline real evaluate(real3 r, const TreeView& tree, const real4 *centerRadius, const real4 *areaNormals,
+                            VertexFetcher getVertex)
+{
+    real omega = 0.0_r;
+    int i = 0;
+
+    while (i < tree.nnodes)
+    {
+        const TreeNode node = tree.nodes[i];
+        const real4 cr = centerRadius[i];
+        const real3 d = make_real3(cr.x, cr.y, cr.z) - r;
+        const real d2 = dot(d, d);
+        const real farDistance = tree.farFieldRatio * cr.w;
+
+        if (d2 > farDistance * farDistance)
+        {
+            const real4 n = areaNormals[i];
+            omega += dot(make_real3(n.x, n.y, n.z), d) / (d2 * math::sqrt(d2));
+            i = node.skip;
+        }
+        else if (node.skip == i + 1)
+        {
+            for (int j = node.start; j < node.end; ++j)
+            {
+                const int3 t = tree.triangles[j];
+                omega += triangleSolidAngle(getVertex(t.x) - r, getVertex(t.y) - r, getVertex(t.z) - r);
+            }
+            i = node.skip;
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    return omega / (4.0_r * static_cast<real>(M_PI));
+}
+
+} // namespace winding_number
+
+} // namespace mirheo
@@ -0,0 +1,126 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#include "object_cell_list.h"
+
+#include <mirheo/core/logger.h>
+#include <mirheo/core/pvs/views/ov.h>
+#include <mirheo/core/utils/cuda_common.h>
+#include <mirheo/core/utils/kernel_launch.h>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wshadow"
+#include <extern/cub/cub/device/device_scan.cuh>
+#pragma GCC diagnostic pop
+
+namespace mirheo
+{
+
+namespace object_cell_list_kernels
+{
+
+/// call f(cid) for every cell overlapped by the inflated bounding box of the object
+template <class Function>
+__device__ static inline void forEachOverlappedCell(const ObjectCellListView& cells, int objId, Function f)
+{
+    const COMandExtent e = cells.comAndExtents[objId];
+    const int3 lo = cells.getCellIdAlongAxes(e.low  - cells.margin);
+    const int3 hi = cells.getCellIdAlongAxes(e.high + cells.margin);
+
+    for (int cz = lo.z; cz <= hi.z; ++cz)
+    for (int cy = lo.y; cy <= hi.y; ++cy)
+    for (int cx = lo.x; cx <= hi.x; ++cx)
+        f(cells.encode(make_int3(cx, cy, cz)));
+}
+
+__global__ void countObjectsPerCell(int nObjects, ObjectCellListView cells, int *nObjectsPerCell)
+{
+    const int objId = threadIdx.x + blockIdx.x * blockDim.x;
+    if (objId >= nObjects) return;
+
+    forEachOverlappedCell(cells, objId, [&](int cid)
+    {
+        atomicAdd(nObjectsPerCell + cid, 1);
+    });
+}
+
+__global__ void fillCells(int nObjects, ObjectCellListView cells, int *cellCounters, int *cellObjects)
+{
+    const int objId = threadIdx.x + blockIdx.x * blockDim.x;
+    if (objId >= nObjects) return;
+
+    forEachOverlappedCell(cells, objId, [&](int cid)
+    {
+        const int id = cells.cellStarts[cid] + atomicAdd(cellCounters + cid, 1);
+        cellObjects[id] = objId;
+    });
+}
+
+} // namespace object_cell_list_kernels
+
+ObjectCellList::ObjectCellList() = default;
+ObjectCellList::~ObjectCellList() = default;
+
+void ObjectCellList::build(const OVview& view, real h, real margin, real3 localDomainSize, cudaStream_t stream)
+{
+    if (h <= 0.0_r)
+        die("Object cell list: the cell size must be positive, got %g", h);
+
+    // one layer of cells around the local domain for halo objects
+    const int3 ncells = math::max(make_int3(math::floor(localDomainSize / h)), make_int3(1)) + 2;
+    const real3 cellSize = localDomainSize / make_real3(ncells - 2);
+
+    view_.origin        = -0.5_r * localDomainSize - cellSize;
+    view_.invh          = 1.0_r / cellSize;
+    view_.ncells        = ncells;
+    view_.totcells      = ncells.x * ncells.y * ncells.z;
+    view_.margin        = margin;
+    view_.comAndExtents = view.comAndExtents;
+
+    const int totcells = view_.totcells;
+    const int nthreads = 128;
+
+    nObjectsPerCell_.resize_anew(totcells + 1);
+    cellStarts_     .resize_anew(totcells + 1);
+    nObjectsPerCell_.clear(stream);
+    view_.cellStarts = cellStarts_.devPtr();
+
+    SAFE_KERNEL_LAUNCH(
+        object_cell_list_kernels::countObjectsPerCell,
+        getNblocks(view.nObjects, nthreads), nthreads, 0, stream,
+        view.nObjects, view_, nObjectsPerCell_.devPtr() );
+
+    size_t bufSize = 0;
+    cub::DeviceScan::ExclusiveSum(nullptr, bufSize, nObjectsPerCell_.devPtr(), cellStarts_.devPtr(),
+                                  totcells + 1, stream);
+    if (bufSize > scanBuffer_.size())
+        scanBuffer_.resize_anew(bufSize);
+    cub::DeviceScan::ExclusiveSum(scanBuffer_.devPtr(), bufSize, nObjectsPerCell_.devPtr(), cellStarts_.devPtr(),
+                                  totcells + 1, stream);
+
+    CUDA_Check( cudaMemcpyAsync(nEntries_.devPtr(), cellStarts_.devPtr() + totcells,
+                                sizeof(int), cudaMemcpyDeviceToDevice, stream) );
+    nEntries_.downloadFromDevice(stream);
+
+    cellObjects_.resize_anew(nEntries_[0]);
+    nObjectsPerCell_.clear(stream);
+    view_.cellObjects = cellObjects_.devPtr();
+
+    SAFE_KERNEL_LAUNCH(
+        object_cell_list_kernels::fillCells,
+        getNblocks(view.nObjects, nthreads), nthreads, 0, stream,
+        view.nObjects, view_, nObjectsPerCell_.devPtr(), cellObjects_.devPtr() );
+
+    debug("Binned %d objects in %d object cell entries (%d x %d x %d cells)",
+          view.nObjects, nEntries_[0], ncells.x, ncells.y, ncells.z);
+}
+
+ObjectCellListView ObjectCellList::getView() const
+{
+    return view_;
+}
+
+int ObjectCellList::getNumEntries() const
+{
+    return nEntries_[0];
+}
+
+} // namespace mirheo
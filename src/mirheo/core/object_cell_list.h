@@ -0,0 +1,118 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include <mirheo/core/containers.h>
+#include <mirheo/core/datatypes.h>
+#include <mirheo/core/utils/cpu_gpu_defines.h>
+#include <mirheo/core/utils/helper_math.h>
+
+namespace mirheo
+{
+
+struct OVview;
+
+/** \brief A device-compatible view of an ObjectCellList.
+
+    Answers the question "which objects may contain this point?" with a single cell lookup:
+    every object is registered in all the cells that overlap its (inflated) bounding box,
+    so that no neighbouring cell needs to be visited and each object is found at most once.
+ */
+struct ObjectCellListView
+{
+    real3 origin;   ///< lower corner of the grid, in local coordinates
+    real3 invh;     ///< inverse of the cell dimensions
+    int3 ncells;    ///< number of cells along each direction
+    int totcells;   ///< total number of cells
+    real margin;    ///< the bounding boxes of the objects are inflated by this distance
+
+    const int *cellStarts  {nullptr}; ///< start of each cell in cellObjects (size totcells + 1)
+    const int *cellObjects {nullptr}; ///< object indices, sorted by cells
+    const COMandExtent *comAndExtents {nullptr}; ///< the extents used to build the cell list
+
+#ifdef __CUDACC__
+    /** \brief Map from position to cell indices
+        \param [in] r The position in **local coordinates**
+        \return cell indices, clamped to the grid
+     */
+    __D__ inline int3 getCellIdAlongAxes(real3 r) const
+    {
+        const int3 v = make_int3( math::floor(invh * (r - origin)) );
+        return math::min( ncells - 1, math::max(make_int3(0), v) );
+    }
+
+    /// map 3D cell indices to linear cell index
+    __D__ inline int encode(int3 cid3) const
+    {
+        return (cid3.z * ncells.y + cid3.y) * ncells.x + cid3.x;
+    }
+
+    /// \return \c true if \p r is inside the inflated bounding box of object \p objId
+    __D__ inline bool isInsideExtent(int objId, real3 r) const
+    {
+        const COMandExtent e = comAndExtents[objId];
+        return e.low.x - margin <= r.x && r.x <= e.high.x + margin &&
+               e.low.y - margin <= r.y && r.y <= e.high.y + margin &&
+               e.low.z - margin <= r.z && r.z <= e.high.z + margin;
+    }
+
+    /** \brief Apply a function to all objects whose inflated bounding box contains a given point
+        \tparam Function The function type, with signature void(int objId)
+        \param [in] r The position in **local coordinates**
+        \param [in] f The function to apply
+     */
+    template <class Function>
+    __D__ inline void forEachObjectContaining(real3 r, Function f) const
+    {
+        const int cid = encode(getCellIdAlongAxes(r));
+
+        for (int i = cellStarts[cid]; i < cellStarts[cid+1]; ++i)
+        {
+            const int objId = cellObjects[i];
+            if (isInsideExtent(objId, r))
+                f(objId);
+        }
+    }
+#endif
+};
+
+/** \brief Cell list of objects, built from their bounding boxes (see COMandExtent).
+
+    Objects are binned in every cell overlapped by their bounding box inflated by a margin.
+    The grid covers the local domain and one layer of cells around it, positions outside are
+    clamped to the boundary cells, so that halo objects can be binned as well.
+
+    Useful to find the objects that may interact with a given particle or object
+    without each object scanning its surroundings (see ObjectCellListView).
+ */
+class ObjectCellList
+{
+public:
+    ObjectCellList();
+    ~ObjectCellList();
+
+    /** \brief Bin the objects of a view.
+        \param [in] view The objects to bin; its comAndExtents must be up to date (see ObjectVector::findExtentAndCOM())
+        \param [in] h The minimum cell size; large cells decrease the number of entries, small ones the number of candidates per query
+        \param [in] margin The distance by which the bounding boxes are inflated
+        \param [in] localDomainSize Size of the local domain
+        \param [in] stream The execution stream; synchronized to allocate the entries
+     */
+    void build(const OVview& view, real h, real margin, real3 localDomainSize, cudaStream_t stream);
+
+    /// \return A view of the last built cell list
+    ObjectCellListView getView() const;
+
+    /// \return The number of (object, cell) pairs registered in the last built cell list
+    int getNumEntries() const;
+
+private:
+    ObjectCellListView view_;
+
+    DeviceBuffer<int> nObjectsPerCell_; ///< number of objects overlapping each cell
+    DeviceBuffer<int> cellStarts_;      ///< prefix sum of nObjectsPerCell_
+    DeviceBuffer<int> cellObjects_;     ///< object indices sorted by cell
+    PinnedBuffer<int> nEntries_ {1};    ///< total number of entries in cellObjects_
+    DeviceBuffer<char> scanBuffer_;     ///< work space to perform the prefix sum
+};
+
+} // namespace mirheo
@@ -9,6 +9,7 @@
 #include <mirheo/core/xdmf/type_map.h>
 #include <mirheo/core/xdmf/xdmf.h>
 
+#include <algorithm>
 #include <mpi.h>
 
 namespace mirheo
@@ -44,6 +45,7 @@ void swap(LocalParticleVector& a, LocalParticleVector &b)
     std::swap(a.pv_, b.pv_);
     swap(a.dataPerParticle, b.dataPerParticle);
     std::swap(a.np_, b.np_);
+    std::swap(a.nClearedForces_, b.nClearedForces_);
 }
 
 void LocalParticleVector::resize(int np, cudaStream_t stream)
@@ -51,6 +53,8 @@ void LocalParticleVector::resize(int np, cudaStream_t stream)
     if (np < 0) die("Tried to resize PV to %d < 0 particles", np);
     dataPerParticle.resize(np, stream);
     np_ = np;
+    // the new particles may contain garbage forces
+    nClearedForces_ = std::min(nClearedForces_, np);
 }
 
 void LocalParticleVector::resize_anew(int np)
@@ -58,6 +62,25 @@ void LocalParticleVector::resize_anew(int np)
     if (np < 0) die("Tried to resize PV to %d < 0 particles", np);
     dataPerParticle.resize_anew(np);
     np_ = np;
+    nClearedForces_ = 0;
+}
+
+void LocalParticleVector::setNumClearedForces(int n)
+{
+    if (n < 0 || n > np_)
+        die("Tried to declare %d cleared forces in a PV with %d particles", n, np_);
+    nClearedForces_ = n;
+}
+
+void LocalParticleVector::clearForces(cudaStream_t stream)
+{
+    const int n = np_ - nClearedForces_;
+
+    if (n > 0)
+        CUDA_Check( cudaMemsetAsync(forces().devPtr() + nClearedForces_, 0, n * sizeof(Force), stream) );
+
+    // the forces are about to be computed
+    nClearedForces_ = 0;
 }
 
 PinnedBuffer<real4>& LocalParticleVector::positions()
@@ -247,6 +270,7 @@ void ParticleVector::setForces_vector(const std::vector<real3>& forces)
 
     local()->forces().copy(myforces);
     local()->forces().uploadToDevice(defaultStream);
+    local()->setNumClearedForces(0);
 }
 
 void ParticleVector::_snapshotParticleData(MPI_Comm comm, const std::string& filename)
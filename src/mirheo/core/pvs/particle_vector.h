@@ -68,6 +68,22 @@ public:
     /// get velocities container reference
     PinnedBuffer<real4>& velocities();
 
+    /** \brief Declare that the forces of the first particles are zero.
+        \param [in] n The number of leading particles with zero forces; must not exceed size()
+
+        Used by integrators that reset the forces in the same sweep as the integration.
+        The next call to clearForces() can then skip these particles; the particles added by
+        a later resize() are still cleared.
+     */
+    void setNumClearedForces(int n);
+
+    /** \brief Set the forces to zero on the device.
+        \param [in] stream The stream used to clear the forces
+
+        Skips the particles declared by setNumClearedForces() since the last call.
+     */
+    void clearForces(cudaStream_t stream);
+
     /** \brief Set a unique Id for each particle in the simulation.
         \param [in] comm MPI communicator of the simulation
         \param [in] stream Stream used to transfer data between host and device
@@ -87,6 +103,7 @@ public:
 private:
     ParticleVector *pv_; ///< parent ParticleVector
     int np_; ///< number of particles
+    int nClearedForces_ {0}; ///< number of leading particles with forces known to be zero
 };
 
 /** \brief Base particles container.
@@ -176,6 +193,18 @@ public:
     /// get the particle mass
     real getMassPerParticle() const noexcept { return mass_; }
 
+    /** \brief Mark the particles as static, i.e. they never move nor change.
+
+        The cell-lists, halo and redistribution of static particles are computed once at the
+        beginning of each run instead of at every time step.
+        The Simulation resets this flag when an integrator, a bouncer or a wall bounce is set to the particles.
+        \param [in] isStatic \c true if the particles are static
+     */
+    void setStatic(bool isStatic) noexcept { isStatic_ = isStatic; }
+
+    /// \return \c true if the particles are static (see setStatic())
+    bool isStatic() const noexcept { return isStatic_; }
+
 protected:
     /** Construct a ParticleVector
         \param [in] state The simulation state
@@ -245,6 +274,7 @@ public:
 
 private:
     real mass_;
+    bool isStatic_ {false};
     std::unique_ptr<LocalParticleVector> local_, halo_;
 };
 
@@ -50,6 +50,56 @@ __global__ void collectRigidForces(ROVview ovView)
     }
 }
 
+/**
+ * Same as collectRigidForces(), for small objects.
+ * Each object is reduced by a group of groupSize consecutive lanes of a warp, so that a single
+ * block processes many objects. groupSize must be a power of 2 not larger than warpSize.
+ * Only one group writes to a given motion, hence no atomics are needed.
+ */
+__global__ void collectRigidForcesSegmented(ROVview ovView, int groupSize)
+{
+    const int gid = threadIdx.x + blockIdx.x * blockDim.x;
+    const int objId = gid / groupSize;
+    const int lane  = gid % groupSize;
+
+    RigidReal3 force {0,0,0};
+    RigidReal3 torque{0,0,0};
+
+    // no early exit: all lanes of the warp take part in the shuffles below
+    if (objId < ovView.nObjects)
+    {
+        const real3 com = make_real3( ovView.motions[objId].r );
+
+        for (int i = lane; i < ovView.objSize; i += groupSize)
+        {
+            const int offset = (objId * ovView.objSize + i);
+
+            const real3 frc = make_real3(ovView.forces[offset]);
+            const real3 r   = make_real3(ovView.readPosition(offset)) - com;
+
+            force  += frc;
+            torque += cross(r, frc);
+        }
+    }
+
+    // the first lane of each group gathers the values of its group only
+    for (int delta = groupSize / 2; delta > 0; delta /= 2)
+    {
+        force.x  += warpShflDown(force.x,  delta);
+        force.y  += warpShflDown(force.y,  delta);
+        force.z  += warpShflDown(force.z,  delta);
+        torque.x += warpShflDown(torque.x, delta);
+        torque.y += warpShflDown(torque.y, delta);
+        torque.z += warpShflDown(torque.z, delta);
+    }
+
+    if (lane == 0 && objId < ovView.nObjects)
+    {
+        ovView.motions[objId].force  += force;
+        ovView.motions[objId].torque += torque;
+    }
+}
+
 /**
  * Rotates and translates the initial positions according to new position and orientation
  * compute also velocity if template parameter set to corresponding value
@@ -96,15 +146,44 @@ __global__ void clearRigidForcesFromMotions(ROVview ovView)
 namespace rigid_operations
 {
 
-void collectRigidForces(const ROVview& view, cudaStream_t stream)
+/// objects with up to that many particles are reduced with collectRigidForcesSegmented
+constexpr int maxObjSizeSegmented = 128;
+
+static int getSegmentSize(int objSize)
+{
+    constexpr int maxGroupSize = 32; // warp size
+    int groupSize = 1;
+    while (groupSize < objSize && groupSize < maxGroupSize)
+        groupSize *= 2;
+    return groupSize;
+}
+
+void collectRigidForces(const ROVview& view, cudaStream_t stream, CollectForcesMode mode)
 {
     constexpr int nthreads = 128;
-    const int nblocks = view.nObjects;
 
-    SAFE_KERNEL_LAUNCH(
-        rigid_operations_kernels::collectRigidForces,
-        nblocks, nthreads, 0, stream,
-        view );
+    if (mode == CollectForcesMode::Auto)
+        mode = view.objSize <= maxObjSizeSegmented ? CollectForcesMode::Segmented : CollectForcesMode::OneBlockPerObject;
+
+    if (mode == CollectForcesMode::Segmented)
+    {
+        const int groupSize = getSegmentSize(view.objSize);
+        const int nblocks = getNblocks(view.nObjects * groupSize, nthreads);
+
+        SAFE_KERNEL_LAUNCH(
+            rigid_operations_kernels::collectRigidForcesSegmented,
+            nblocks, nthreads, 0, stream,
+            view, groupSize );
+    }
+    else
+    {
+        const int nblocks = view.nObjects;
+
+        SAFE_KERNEL_LAUNCH(
+            rigid_operations_kernels::collectRigidForces,
+            nblocks, nthreads, 0, stream,
+            view );
+    }
 }
 
 void applyRigidMotion(const ROVview& view, const PinnedBuffer<real4>& initialPositions,
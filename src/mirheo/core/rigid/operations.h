@@ -13,8 +13,21 @@ namespace rigid_operations
 /// controls to what quantities to apply the
 enum class ApplyTo { PositionsOnly, PositionsAndVelocities };
 
-/// Reduce the forces contained in the particles to the force and torque variable of the RigidMotion objects
-void collectRigidForces(const ROVview& view, cudaStream_t stream);
+/// controls how the particle forces are reduced to the RigidMotion objects
+enum class CollectForcesMode
+{
+    Auto,              ///< choose one of the modes below depending on the object size
+    OneBlockPerObject, ///< one block per object; efficient for large objects
+    Segmented          ///< many objects per block, each reduced by a part of a warp; efficient for small objects
+};
+
+/** Reduce the forces contained in the particles to the force and torque variable of the RigidMotion objects
+    \param view The view that contains the input particle forces and output RigidMotion
+    \param stream execution stream
+    \param mode The reduction strategy; the default picks the fastest one for the object size
+ */
+void collectRigidForces(const ROVview& view, cudaStream_t stream,
+                        CollectForcesMode mode = CollectForcesMode::Auto);
 
 /** Set the positions (and optionally velocities, according to the rigid motions
     \param view The view that contains the input RigidMotion and output particles
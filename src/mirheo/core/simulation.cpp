@@ -71,7 +71,8 @@ namespace mirheo
     _( pluginsSerializeSend                , "Plugins: serialize and send") \
     _( pluginsBeforeIntegration            , "Plugins: before integration") \
     _( pluginsAfterIntegration             , "Plugins: after integration") \
-    _( pluginsBeforeParticlesDistribution  , "Plugins: before particles distribution")
+    _( pluginsBeforeParticlesDistribution  , "Plugins: before particles distribution") \
+    _( adaptiveTimeStep                    , "Adaptive time step")
 
 
 struct SimulationTasks
@@ -383,6 +384,13 @@ void Simulation::setIntegrator(const std::string& integratorName, const std::str
 
     auto pv = getPVbyNameOrDie(pvName);
 
+    if (pv->isStatic())
+    {
+        info("Particle vector '%s' is not static anymore: it is integrated by '%s'",
+             pvName.c_str(), integratorName.c_str());
+        pv->setStatic(false);
+    }
+
     if (pvsIntegratorMap_.find(pvName) != pvsIntegratorMap_.end())
         die("particle vector '%s' already set to integrator '%s'",
             pvName.c_str(), pvsIntegratorMap_[pvName].c_str());
@@ -416,6 +424,13 @@ void Simulation::setBouncer(const std::string& bouncerName, const std::string& o
         die("No such bouncer: %s", bouncerName.c_str());
     auto bouncer = bouncerMap_[bouncerName].get();
 
+    if (pv->isStatic())
+    {
+        info("Particle vector '%s' is not static anymore: it is bounced by '%s'",
+             pvName.c_str(), bouncerName.c_str());
+        pv->setStatic(false);
+    }
+
     bouncer->setup(ov);
     bouncer->setPrerequisites(pv);
     bouncerPrototypes_.push_back({bouncer, pv});
@@ -433,10 +448,22 @@ void Simulation::setWallBounce(const std::string& wallName, const std::string& p
         die("Object Vectors can not be bounced from walls in the current implementaion. "
             "Invalid combination: wall '%s' and OV '%s'", wall->getCName(), ov->getCName());
 
+    if (pv->isStatic())
+    {
+        info("Particle vector '%s' is not static anymore: it is bounced by wall '%s'",
+             pvName.c_str(), wall->getCName());
+        pv->setStatic(false);
+    }
+
     wall->setPrerequisites(pv);
     wallPrototypes_.push_back( {wall, pv, maximumPartTravel} );
 }
 
+void Simulation::setAdaptiveTimeStep(AdaptiveTimeStepParams params)
+{
+    adaptiveTimeStep_ = std::make_unique<AdaptiveTimeStep>(params);
+}
+
 void Simulation::setObjectBelongingChecker(const std::string& checkerName, const std::string& objName)
 {
     if (belongingCheckerMap_.find(checkerName) == belongingCheckerMap_.end())
@@ -742,6 +769,8 @@ void Simulation::_prepareEngines()
     auto objHaloIntermediateImp         = std::make_unique<ObjectExtraExchanger>  (objHaloFinalImp.get());
     auto objHaloReverseIntermediateImp  = std::make_unique<ObjectReverseExchanger>(objHaloFinalImp.get());
     auto objHaloReverseFinalImp         = std::make_unique<ObjectReverseExchanger>(objHaloFinalImp.get());
+    auto staticRedistImp                = std::make_unique<ParticleRedistributor>();
+    auto staticHaloImp                  = std::make_unique<ParticleHaloExchanger>();
 
     debug("Attaching particle vectors to halo exchanger and redistributor");
     for (auto& pv : particleVectors_)
@@ -761,6 +790,9 @@ void Simulation::_prepareEngines()
 
         if (auto ov = dynamic_cast<ObjectVector*>(pvPtr))
         {
+            if (ov->isStatic())
+                die("Object vector '%s' can not be static", ov->getCName());
+
             objRedistImp->attach(ov);
 
             auto extraToExchange = _getExtraDataToExchange(ov);
@@ -772,8 +804,27 @@ void Simulation::_prepareEngines()
             objHaloIntermediateImp->attach(ov, extraInt);
             objHaloReverseIntermediateImp->attach(ov, reverseExchange);
         }
+        else if (pvPtr->isStatic() && extraInt.empty())
+        {
+            // A single halo made with the largest cut-off serves both stages.
+            // It is exchanged once per run, see _prepareStaticParticleVectors()
+            CellList *clHalo = clOut;
+            if (clHalo == nullptr || (clInt != nullptr && clInt->rc > clHalo->rc))
+                clHalo = clInt;
+
+            staticRedistImp->attach(pvPtr, cl);
+
+            if (clHalo != nullptr)
+                staticHaloImp->attach(pvPtr, clHalo, {});
+
+            staticParticleVectors_.insert(pvPtr);
+        }
         else
         {
+            if (pvPtr->isStatic())
+                info("Static particle vector '%s' has intermediate channels to exchange, "
+                     "its cell-lists and halo are updated at every step", pvPtr->getCName());
+
             partRedistImp->attach(pvPtr, cl);
 
             if (clInt != nullptr)
@@ -805,6 +856,40 @@ void Simulation::_prepareEngines()
     objHaloIntermediate_          = makeEngine(std::move(objHaloIntermediateImp));
     objHaloReverseIntermediate_   = makeEngine(std::move(objHaloReverseIntermediateImp));
     objHaloReverseFinal_          = makeEngine(std::move(objHaloReverseFinalImp));
+    staticRedistributor_          = makeEngine(std::move(staticRedistImp));
+    staticHalo_                   = makeEngine(std::move(staticHaloImp));
+}
+
+void Simulation::_prepareStaticParticleVectors()
+{
+    if (staticParticleVectors_.empty())
+        return;
+
+    info("Building cell-lists and halo of %d static particle vector(s)", (int) staticParticleVectors_.size());
+
+    auto buildCellLists = [this]()
+    {
+        for (auto pv : staticParticleVectors_)
+            for (auto& cl : cellListMap_[pv])
+                cl->build(defaultStream);
+    };
+
+    // the particles may have been changed between two runs, e.g. by a restart
+    for (auto pv : staticParticleVectors_)
+    {
+        pv->haloValid   = false;
+        pv->redistValid = false;
+        pv->cellListStamp++;
+    }
+
+    buildCellLists();
+    staticRedistributor_->init    (defaultStream);
+    staticRedistributor_->finalize(defaultStream);
+
+    // no-op if no particle has migrated
+    buildCellLists();
+    staticHalo_->init    (defaultStream);
+    staticHalo_->finalize(defaultStream);
 }
 
 void Simulation::_execSplitters()
@@ -842,11 +927,17 @@ void Simulation::_createTasks()
     }
 
     for (auto& clVec : cellListMap_)
+    {
+        // built once per run, see _prepareStaticParticleVectors()
+        if (staticParticleVectors_.find(clVec.first) != staticParticleVectors_.end())
+            continue;
+
         for (auto& cl : clVec.second)
         {
             auto clPtr = cl.get();
             scheduler_->addTask(tasks_->cellLists, [clPtr] (cudaStream_t stream) { clPtr->build(stream); } );
         }
+    }
 
     // Only particle forces, not object ones here
     for (auto& pv : particleVectors_)
@@ -970,6 +1061,19 @@ void Simulation::_createTasks()
     }
 
 
+    if (adaptiveTimeStep_)
+    {
+        std::vector<ParticleVector*> integratedPVs;
+        for (const auto& prototype : integratorPrototypes_)
+            integratedPVs.push_back(prototype.pv);
+
+        scheduler_->addTask(tasks_->adaptiveTimeStep, [this, integratedPVs] (cudaStream_t stream)
+        {
+            if (_isAdaptiveTimeStepUpdate())
+                adaptiveTimeStep_->reduceLocal(integratedPVs, stream);
+        });
+    }
+
     // As there are no primary cell-lists for objects
     // we need to separately clear real obj forces and forces in the cell-lists
     for (auto ov : objectVectors_)
@@ -1161,6 +1265,7 @@ static void buildDependencies(TaskScheduler *scheduler, SimulationTasks *tasks)
     scheduler->addDependency(tasks->accumulateInteractionFinal, {tasks->integration}, {tasks->haloForces, tasks->localForces});
 
     scheduler->addDependency(tasks->pluginsBeforeIntegration, {tasks->integration}, {tasks->accumulateInteractionFinal});
+    scheduler->addDependency(tasks->adaptiveTimeStep, {tasks->integration}, {tasks->accumulateInteractionFinal, tasks->objReverseFinalFinalize, tasks->pluginsBeforeIntegration});
     scheduler->addDependency(tasks->wallBounce, {}, {tasks->integration});
     scheduler->addDependency(tasks->wallCheck, {tasks->partRedistributeInit}, {tasks->wallBounce});
 
@@ -1221,6 +1326,19 @@ void Simulation::init()
 
     info("Time-step is set to %f", getCurrentDt());
 
+    if (adaptiveTimeStep_)
+    {
+        const auto& params = adaptiveTimeStep_->getParams();
+        info("Time-step will be adapted every %d steps within [%g, %g], for a maximum displacement of %g",
+             params.every, params.dtMin, params.dtMax, params.maxDisplacement);
+
+        for (const auto& prototype : wallPrototypes_)
+            if (params.maxDisplacement > prototype.maximumPartTravel)
+                warn("Adaptive time step: the maximum displacement (%g) is larger than the maximum travel "
+                     "of the particles '%s' bouncing on wall '%s' (%g)", params.maxDisplacement,
+                     prototype.pv->getCName(), prototype.wall->getCName(), prototype.maximumPartTravel);
+    }
+
     _createTasks();
     buildDependencies(scheduler_.get(), tasks_.get());
 }
@@ -1232,6 +1350,7 @@ void Simulation::run(int nsteps)
     scheduler_->forceExec( tasks_->objHaloFinalFinalize, defaultStream );
     scheduler_->forceExec( tasks_->objClearHaloForces,   defaultStream );
     scheduler_->forceExec( tasks_->objClearLocalForces,  defaultStream );
+    _prepareStaticParticleVectors();
     _execSplitters();
 
     MirState::StepType begin = state_->currentStep, end = state_->currentStep + nsteps;
@@ -1247,6 +1366,10 @@ void Simulation::run(int nsteps)
         scheduler_->run();
 
         state_->currentTime += state_->dt;
+
+        // the new time step is used from the next step on, so that all the objects see the same value within a step
+        if (_isAdaptiveTimeStepUpdate())
+            state_->dt = adaptiveTimeStep_->computeTimeStep(state_->dt, cartComm_);
     }
 
     // Finish the redistribution by rebuilding the cell-lists
@@ -1261,6 +1384,11 @@ void Simulation::run(int nsteps)
     notifyPostProcess(stoppingTag, stoppingMsg);
 }
 
+bool Simulation::_isAdaptiveTimeStepUpdate() const
+{
+    return adaptiveTimeStep_ && state_->currentStep % adaptiveTimeStep_->getParams().every == 0;
+}
+
 void Simulation::notifyPostProcess(int tag, int msg) const
 {
     if (interComm_ != MPI_COMM_NULL)
@@ -1,6 +1,7 @@
 // Copyright 2020 ETH Zurich. All Rights Reserved.
 #pragma once
 
+#include <mirheo/core/adaptive_time_step.h>
 #include <mirheo/core/containers.h>
 #include <mirheo/core/datatypes.h>
 #include <mirheo/core/exchangers/interface.h>
@@ -9,6 +10,7 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -175,6 +177,14 @@ public:
     void applyObjectBelongingChecker(const std::string& checkerName, const std::string& source,
                                      const std::string& inside, const std::string& outside, int checkEvery);
 
+    /** \brief Let the time step follow the velocities and forces of the integrated particles.
+        \param params The parameters of the controller, see AdaptiveTimeStep.
+
+        The time step is updated at the end of every \c params.every time steps, from the velocities
+        and forces of all the ParticleVector objects that have an \c Integrator.
+     */
+    void setAdaptiveTimeStep(AdaptiveTimeStepParams params);
+
 
     void init(); ///< setup all the simulation tasks from the registered objects and their relation. Must be called after all the register and set methods.
     void run(int nsteps); ///< advance the system for a given number of time steps. Must be called after init()
@@ -247,8 +257,10 @@ private:
     void _prepareWalls();
     void _preparePlugins();
     void _prepareEngines();
+    void _prepareStaticParticleVectors();
 
     void _execSplitters();
+    bool _isAdaptiveTimeStepUpdate() const;
 
     void _createTasks();
 
@@ -331,12 +343,15 @@ private:
 
     std::unique_ptr<InteractionManager> interactionsIntermediate_, interactionsFinal_;
 
+    std::unique_ptr<AdaptiveTimeStep> adaptiveTimeStep_; ///< nullptr if the time step is constant
+
     const bool gpuAwareMPI_;
 
     ExchangeEngineUniquePtr partRedistributor_, objRedistibutor_;
     ExchangeEngineUniquePtr partHaloIntermediate_, partHaloFinal_;
     ExchangeEngineUniquePtr objHaloIntermediate_, objHaloReverseIntermediate_;
     ExchangeEngineUniquePtr objHaloFinal_, objHaloReverseFinal_;
+    ExchangeEngineUniquePtr staticRedistributor_, staticHalo_; ///< used once per run for the static particle vectors
 
     std::map<std::string, int> pvIdMap_;
     std::vector< std::shared_ptr<ParticleVector> > particleVectors_;
@@ -351,6 +366,7 @@ private:
     std::vector< std::shared_ptr<SimulationPlugin> > plugins;
 
     std::map<ParticleVector*, std::vector< std::unique_ptr<CellList> >> cellListMap_;
+    std::set<ParticleVector*> staticParticleVectors_; ///< pvs whose cell-lists and halo are not updated at every step
 
     std::vector<IntegratorPrototype>          integratorPrototypes_;
     std::vector<InteractionPrototype>         interactionPrototypes_;
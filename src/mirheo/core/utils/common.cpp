@@ -29,6 +29,8 @@ const std::string comExtents  = "com_extents";
 const std::string areaVolumes = "area_volumes";
 
 const std::string membraneTypeId = "membrane_type_id";
+const std::string membraneParameterScales = "membrane_parameter_scales";
+const std::string rodParameterScales      = "rod_parameter_scales";
 
 const std::string areas          = "areas";
 const std::string meanCurvatures = "mean_curvatures";
@@ -45,7 +47,7 @@ const std::vector<std::string> reservedParticleFields =
 
 const std::vector<std::string> reservedObjectFields =
     {globalIds, motions, oldMotions, comExtents, areaVolumes, membraneTypeId,
-     areas, meanCurvatures, lenThetaTot};
+     membraneParameterScales, rodParameterScales, areas, meanCurvatures, lenThetaTot};
 
 const std::vector<std::string> reservedBisegmentFields =
     {polyStates, energies, rodKappa, rodTau_l};
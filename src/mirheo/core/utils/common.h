@@ -40,6 +40,8 @@ extern const std::string comExtents;  ///< center of mass and bounding box
 extern const std::string areaVolumes; ///< area and volume of membranes
 
 extern const std::string membraneTypeId; ///< Integers to differentiate between groups of membranes
+extern const std::string membraneParameterScales; ///< Per membrane multipliers of the shear, bending, constraints and viscous forces
+extern const std::string rodParameterScales;      ///< Per rod multipliers of the bounds, bending and twist forces
 
 // per object, specific to Juelicher bending + ADE
 extern const std::string areas;          ///< area of membranes
@@ -20,6 +20,11 @@ const CompileOptions compile_options{
 #else
     false,
 #endif
+#ifdef MIRHEO_WITH_ZLIB
+    true,
+#else
+    false,
+#endif
 };
 
 } // namespace mirheo
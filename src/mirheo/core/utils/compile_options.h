@@ -20,6 +20,7 @@ struct CompileOptions
     bool membraneDouble; ///< \c true if the membrane forces are computed in double precision
     bool rodDouble;      ///< \c true if the rod forces are computed in double precision
     bool useNvtx;        ///< \c true if NVTX information are enabled (for profiling)
+    bool useZlib;        ///< \c true if compressed tiled SDF files can be read
 };
 
 /// The global structure that stores all compile options
@@ -30,6 +31,7 @@ extern const CompileOptions compile_options;
     OP(useNvtx)                                 \
     OP(useDouble)                               \
     OP(membraneDouble)                          \
-    OP(rodDouble)
+    OP(rodDouble)                               \
+    OP(useZlib)
 
 } // namespace mirheo
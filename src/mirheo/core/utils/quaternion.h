@@ -201,6 +201,42 @@ class __align__(16) Quaternion
         return (q.conjugate() * qv * q).vectorPart();
     }
 
+    /** \brief Spherical linear interpolation between two rotations.
+        \param q0 The rotation at t = 0 (unit quaternion)
+        \param q1 The rotation at t = 1 (unit quaternion)
+        \param t The interpolation parameter, in [0, 1]
+        \return The rotation at t, along the shortest arc between \p q0 and \p q1
+     */
+    __HD__ static inline Quaternion slerp(const Quaternion& q0, Quaternion q1, Real t)
+    {
+        constexpr Real one = static_cast<Real>(1);
+        constexpr Real linearThreshold = static_cast<Real>(0.9995);
+
+        Real c = q0.w * q1.w + q0.x * q1.x + q0.y * q1.y + q0.z * q1.z;
+        if (c < static_cast<Real>(0))
+        {
+            q1 *= -one;
+            c = -c;
+        }
+
+        // nearly identical rotations: linear interpolation is accurate and avoids division by zero
+        if (c > linearThreshold)
+            return (q0 + t * (q1 - q0)).normalized();
+
+        const Real s = math::sqrt(one - c * c);
+        const Real theta = math::atan2(s, c);
+        return (math::sin((one - t) * theta) / s) * q0 + (math::sin(t * theta) / s) * q1;
+    }
+
+    /// \return The angle (in [0, pi]) of the rotation that transforms the rotation \p q0 into \p q1 (unit quaternions)
+    __HD__ static inline Real rotationAngle(const Quaternion& q0, const Quaternion& q1)
+    {
+        constexpr Real one = static_cast<Real>(1);
+        const Real c = math::abs(q0.w * q1.w + q0.x * q1.x + q0.y * q1.y + q0.z * q1.z);
+        const Real cc = c < one ? c : one;
+        return static_cast<Real>(2) * math::atan2(math::sqrt(one - cc * cc), cc);
+    }
+
     /// \return The time derivative of the given angular velocity, useful for time integration of rigid objects
     __HD__ inline Quaternion timeDerivative(Real3 omega) const
     {
@@ -100,6 +100,40 @@ __D__ inline real linearSearch(Equation F, const Bounds& limits, real tolerance
     return ri.x;
 }
 
+/** \brief Find the first root of a given function by sampling it on regular sub-intervals
+    \tparam Equation The equation type
+    \param F the equation to solve
+    \param limits the interval on which to solve the equation
+    \param nSamples the number of sub-intervals on which the sign of \p F is checked
+    \param tolerance Stop the iterations when F(x) is less that this tolerance
+    \return RootInfo object of the root in the first sub-interval where \p F changes sign.
+            return invalidRoot if \p F does not change sign at the sampled points.
+
+    Useful when F may have several roots in \p limits (e.g. a trajectory that crosses a surface twice),
+    as long as \p nSamples is large enough to separate them.
+ */
+template <typename Equation>
+__D__ inline RootInfo firstRootSampled(Equation F, const Bounds& limits, int nSamples, real tolerance = 1e-6_r)
+{
+    const real h = (limits.up - limits.lo) / static_cast<real>(nSamples);
+
+    real a = limits.lo;
+    real va = F(a);
+
+    for (int i = 1; i <= nSamples; ++i)
+    {
+        const real b = (i == nSamples) ? limits.up : limits.lo + static_cast<real>(i) * h;
+        const real vb = F(b);
+
+        if (va * vb <= 0.0_r)
+            return linearSearchVerbose(F, {a, b}, tolerance);
+
+        a  = b;
+        va = vb;
+    }
+    return invalidRoot;
+}
+
 /** \brief Find a root of a given function using Newton method
     \tparam F The function type
     \tparam FPrime The function derivative type
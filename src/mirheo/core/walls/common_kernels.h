@@ -37,9 +37,14 @@ __device__ inline real3 rescue(real3 candidate, real dt, real tol, int seed, con
     return candidate;
 }
 
+/** Bounce the particles of the given cells that crossed the wall surface.
+    If \p sdfsBeforeIntegration is not \c nullptr, the particles that were further than
+    \p maximumTravel from the surface before integration are skipped without evaluating the SDF.
+ */
 template <typename InsideWallChecker, typename VelocityField>
 __global__ void sdfBounce(PVviewWithOldParticles view, CellListInfo cinfo,
                           const int *wallCells, const int nWallCells, const real dt,
+                          const real *sdfsBeforeIntegration, const real maximumTravel,
                           const InsideWallChecker checker,
                           const VelocityField velField,
                           double3 *totalForce)
@@ -57,6 +62,10 @@ __global__ void sdfBounce(PVviewWithOldParticles view, CellListInfo cinfo,
 
         for (int pid = pstart; pid < pend; pid++)
         {
+            if (sdfsBeforeIntegration != nullptr &&
+                sdfsBeforeIntegration[pid] < -(maximumTravel + insideTolerance))
+                continue;
+
             Particle p(view.readParticle(pid));
             if (checker(p.r) <= -insideTolerance) continue;
 
@@ -3,13 +3,17 @@
 
 #include "interface.h"
 
+#include "moving_sdf_wall.h"
 #include "simple_stationary_wall.h"
 #include "stationary_walls/box.h"
+#include "stationary_walls/composite.h"
 #include "stationary_walls/cylinder.h"
+#include "stationary_walls/moving_sdf.h"
 #include "stationary_walls/plane.h"
 #include "stationary_walls/sdf.h"
 #include "stationary_walls/sphere.h"
 #include "velocity_field/oscillate.h"
+#include "velocity_field/rigid_motion.h"
 #include "velocity_field/rotate.h"
 #include "velocity_field/translate.h"
 #include "wall_with_velocity.h"
@@ -58,13 +62,33 @@ createPlaneWall(const MirState *state, const std::string& name, real3 normal, re
     return std::make_shared<SimpleStationaryWall<StationaryWallPlane>> (state, name, std::move(plane));
 }
 
+inline FieldInterpolation
+parseSDFInterpolation(const std::string& name, const std::string& interpolation)
+{
+    if (interpolation == "linear") return FieldInterpolation::Linear;
+    if (interpolation == "cubic")  return FieldInterpolation::Cubic;
+
+    die("Unknown SDF interpolation '%s' for wall '%s'; choose from 'linear' or 'cubic'",
+        interpolation.c_str(), name.c_str());
+}
+
 inline std::shared_ptr<SimpleStationaryWall<StationaryWallSDF>>
-createSDFWall(const MirState *state, const std::string& name, const std::string& sdfFilename, real3 h)
+createSDFWall(const MirState *state, const std::string& name, const std::string& sdfFilename, real3 h,
+              real narrowBandWidth, const std::string& interpolation)
 {
-    StationaryWallSDF sdf(state, sdfFilename, h);
+    const FieldInterpolation interp = parseSDFInterpolation(name, interpolation);
+
+    StationaryWallSDF sdf(state, sdfFilename, h, narrowBandWidth, interp);
     return std::make_shared<SimpleStationaryWall<StationaryWallSDF>> (state, name, std::move(sdf));
 }
 
+inline std::shared_ptr<SimpleStationaryWall<StationaryWallComposite>>
+createCompositeWall(const MirState *state, const std::string& name, const CompositeWallExpression& expression)
+{
+    StationaryWallComposite composite(expression);
+    return std::make_shared<SimpleStationaryWall<StationaryWallComposite>> (state, name, std::move(composite));
+}
+
 // Moving walls
 
 inline std::shared_ptr<WallWithVelocity<StationaryWallCylinder, VelocityFieldRotate>>
@@ -115,6 +139,18 @@ createOscillatingPlaneWall(const MirState *state, const std::string& name, real3
     return std::make_shared<WallWithVelocity<StationaryWallPlane, VelocityFieldOscillate>> (state, name, std::move(plane), std::move(osc));
 }
 
+inline std::shared_ptr<MovingSDFWall>
+createMovingSDFWall(const MirState *state, const std::string& name, const std::string& sdfFilename, real3 h,
+                    real3 velocity, real3 omega, real3 center, real period,
+                    real narrowBandWidth, const std::string& interpolation)
+{
+    const FieldInterpolation interp = parseSDFInterpolation(name, interpolation);
+
+    VelocityFieldRigidMotion motion(velocity, omega, center, period);
+    MovingWallSDF sdf(state, sdfFilename, h, narrowBandWidth, interp, motion);
+    return std::make_shared<MovingSDFWall> (state, name, std::move(sdf), std::move(motion));
+}
+
 /** \brief Wall factory. Instantiate the correct interaction object depending on the snapshot parameters.
     \param [in] state The global state of the system.
     \param [in] loader The \c Loader object. Provides load context and unserialization functions.
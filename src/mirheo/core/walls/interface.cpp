@@ -1,5 +1,7 @@
 // Copyright 2020 ETH Zurich. All Rights Reserved.
 #include "interface.h"
+
+#include <mirheo/core/logger.h>
 #include <mirheo/core/utils/config.h>
 
 namespace mirheo
@@ -17,4 +19,60 @@ ConfigObject Wall::_saveSnapshot(Saver& saver, const std::string &typeName)
     return MirSimulationObject::_saveSnapshot(saver, "Wall", typeName);
 }
 
+real SDFBasedWall::getNarrowBandWidth() const
+{
+    return 0.0_r;
+}
+
+SDFBasedWall::SdfPerParticleView
+SDFBasedWall::getCachedSdfPerParticle(ParticleVector *pv, real gradientThreshold, cudaStream_t stream)
+{
+    const MirState::StepType step = getState()->currentStep;
+    const int np = pv->local()->size();
+    SdfCache& cache = sdfCaches_[pv];
+
+    const bool upToDate = cache.step  == step
+        &&                cache.stamp == pv->cellListStamp
+        &&                cache.size  == np
+        &&                cache.gradientThreshold >= gradientThreshold;
+
+    if (!upToDate)
+    {
+        debug2("Computing the SDF of wall '%s' for %d particles of '%s'", getCName(), np, pv->getCName());
+
+        sdfPerParticle(pv->local(), &cache.sdfs, &cache.gradients, gradientThreshold, stream);
+
+        cache.step  = step;
+        cache.stamp = pv->cellListStamp;
+        cache.size  = np;
+        cache.gradientThreshold = gradientThreshold;
+    }
+
+    return {cache.sdfs.devPtr(), cache.gradients.devPtr()};
+}
+
+const real* SDFBasedWall::_getSdfBeforeIntegration(const ParticleVector *pv) const
+{
+    if (!useSdfCacheInBounce_)
+        return nullptr;
+
+    auto it = sdfCaches_.find(pv);
+    if (it == sdfCaches_.end())
+        return nullptr;
+
+    const SdfCache& cache = it->second;
+
+    // the integration increments the stamp exactly once; anything else invalidates the values
+    const bool valid = cache.step      == getState()->currentStep
+        &&             cache.stamp + 1 == pv->cellListStamp
+        &&             cache.size      == pv->local()->size();
+
+    return valid ? cache.sdfs.devPtr() : nullptr;
+}
+
+void SDFBasedWall::useSdfCacheInBounce(bool enabled)
+{
+    useSdfCacheInBounce_ = enabled;
+}
+
 } // namespace mirheo
@@ -6,6 +6,7 @@
 #include <mirheo/core/mirheo_object.h>
 #include <mirheo/core/pvs/particle_vector.h>
 
+#include <map>
 #include <mpi.h>
 #include <vector>
 #include <cuda_runtime.h>
@@ -130,6 +131,66 @@ public:
 
     /// \brief Get accumulated force of particles on the wall at the previous bounce() operation..
     virtual PinnedBuffer<double3>* getCurrentBounceForce() = 0;
+
+    /** \return The distance to the surface beyond which the SDF values are clamped (see Field),
+                or a non positive value if the SDF is exact everywhere.
+     */
+    virtual real getNarrowBandWidth() const;
+
+    /// Device pointers to the SDF values and gradients of the local particles of a ParticleVector.
+    struct SdfPerParticleView
+    {
+        const real *sdfs;       ///< SDF values at the particle positions
+        const real3 *gradients; ///< normalized SDF gradients at the particle positions (zero far from the surface)
+    };
+
+    /** \brief Compute the wall SDF and its gradient at particles positions, and cache them.
+        \param [in] pv Input particles (the local ones are used).
+        \param [in] gradientThreshold Compute gradients for particles that are only within that distance.
+        \param [in] stream The stream to execute the operation on.
+        \return The cached values, valid until the particles are moved or reordered.
+
+        The values are computed with sdfPerParticle() only if they are not already cached for the
+        current positions of the particles, so that several users of the same wall (e.g. plugins)
+        evaluate the SDF only once per particle and per time step.
+        The cached values also allow the bounce to skip the particles that were far from the surface
+        before integration (see _getSdfBeforeIntegration()).
+     */
+    SdfPerParticleView getCachedSdfPerParticle(ParticleVector *pv, real gradientThreshold, cudaStream_t stream);
+
+    /** \brief Allow or forbid the bounce to use the SDF values cached before integration.
+        \param [in] enabled If \c false, the bounce evaluates the SDF of all the particles of the boundary cells.
+
+        The cache is filled only by its users (e.g. plugins or check()), never by the bounce itself.
+        Enabled by default; the results do not depend on it.
+     */
+    void useSdfCacheInBounce(bool enabled);
+
+protected:
+    /** \brief Get the SDF values cached at the positions of the particles before the last integration.
+        \param [in] pv The particles.
+        \return The SDF values, or \c nullptr if they were not computed during the current time step
+                 or if the particles were modified by anything else than a single integration since then.
+
+        The particles are not reordered between integration and bounce, hence the values can be indexed
+        with the particle ids of the bounced particles.
+     */
+    const real* _getSdfBeforeIntegration(const ParticleVector *pv) const;
+
+private:
+    /// SDF values of the local particles of one ParticleVector
+    struct SdfCache
+    {
+        MirState::StepType step {-1};   ///< time step at which the values were computed
+        int stamp {-1};                 ///< cell list stamp of the particles when the values were computed
+        int size {0};                   ///< number of particles when the values were computed
+        real gradientThreshold {0.0_r}; ///< gradients are valid within that distance to the surface
+        DeviceBuffer<real> sdfs;        ///< SDF values
+        DeviceBuffer<real3> gradients;  ///< SDF gradients
+    };
+
+    std::map<const ParticleVector*, SdfCache> sdfCaches_; ///< cached SDF values per particle vector
+    bool useSdfCacheInBounce_ {true}; ///< see useSdfCacheInBounce()
 };
 
 } // namespace mirheo
@@ -0,0 +1,66 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#include "moving_sdf_wall.h"
+
+#include <mirheo/core/celllist.h>
+#include <mirheo/core/logger.h>
+#include <mirheo/core/pvs/particle_vector.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace mirheo
+{
+
+MovingSDFWall::MovingSDFWall(const MirState *state, const std::string& name, MovingWallSDF&& sdf, VelocityFieldRigidMotion&& motion) :
+    WallWithVelocity<MovingWallSDF, VelocityFieldRigidMotion>(state, name, std::move(sdf), VelocityFieldRigidMotion(motion)),
+    maximumWallSpeed_(motion.getMaximumSpeed(state->domain))
+{}
+
+void MovingSDFWall::removeInner(ParticleVector *pv)
+{
+    // called for all the particle vectors when the simulation is initialized, once the integrators are set
+    if (pv == _getFrozen() && pv->isStatic())
+        die("The frozen particles '%s' of the moving wall '%s' would stay in place: "
+            "they must be integrated with a RigidMotion integrator with the motion of the wall",
+            pv->getCName(), getCName());
+
+    WallWithVelocity<MovingWallSDF, VelocityFieldRigidMotion>::removeInner(pv);
+}
+
+void MovingSDFWall::attach(ParticleVector *pv, CellList *cl, real maximumPartTravel)
+{
+    // the boundary cells must stay valid while the wall moves by up to half a cell
+    const real h = std::min({cl->h.x, cl->h.y, cl->h.z});
+    const real wallTravel = maximumWallSpeed_ * getState()->dt;
+
+    int refreshEvery = std::numeric_limits<int>::max();
+    if (wallTravel > 0.0_r)
+        refreshEvery = std::max(1, static_cast<int>(0.5_r * h / wallTravel));
+
+    const real margin = (wallTravel > 0.0_r) ? refreshEvery * wallTravel : 0.0_r;
+
+    info("Wall '%s' moves by at most %g per step: boundary cells of '%s' are updated every %d steps",
+         getCName(), wallTravel, pv->getCName(), refreshEvery);
+
+    const size_t nAttached = particleVectors_.size();
+    WallWithVelocity<MovingWallSDF, VelocityFieldRigidMotion>::attach(pv, cl, maximumPartTravel + margin);
+
+    // frozen particles are not attached
+    if (particleVectors_.size() > nAttached)
+        refreshEvery_.push_back(refreshEvery);
+}
+
+void MovingSDFWall::bounce(cudaStream_t stream)
+{
+    const auto step = getState()->currentStep;
+
+    for (size_t i = 0; i < particleVectors_.size(); ++i)
+    {
+        if (step % refreshEvery_[i] == 0)
+            _findBoundaryCells(cellLists_[i], maximumPartTravels_[i], boundaryCells_[i], stream);
+    }
+
+    WallWithVelocity<MovingWallSDF, VelocityFieldRigidMotion>::bounce(stream);
+}
+
+} // namespace mirheo
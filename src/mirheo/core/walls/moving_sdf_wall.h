@@ -0,0 +1,45 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include "wall_with_velocity.h"
+#include "stationary_walls/moving_sdf.h"
+#include "velocity_field/rigid_motion.h"
+
+#include <vector>
+
+namespace mirheo
+{
+
+/** \brief SDF wall moving rigidly in time.
+
+    The SDF grid is never resampled: the shape is moved by transforming the positions at which it is evaluated
+    (see MovingWallSDF), and the wall velocity is the one of the rigid motion.
+
+    Contrary to stationary walls, the cells close to the surface change in time.
+    They are found with an additional margin covering the motion of the wall over several time steps,
+    and updated only once the wall may have travelled that margin.
+
+    The frozen particles must move with the wall, i.e. be integrated with an IntegratorRigidMotion
+    with the same motion; the wall refuses frozen particles that are left static.
+ */
+class MovingSDFWall : public WallWithVelocity<MovingWallSDF, VelocityFieldRigidMotion>
+{
+public:
+    /** \brief Construct a MovingSDFWall object.
+        \param [in] state The simulation state.
+        \param [in] name The wall name.
+        \param [in] sdf The moving shape.
+        \param [in] motion The rigid motion of the shape; must be the same as the one of \p sdf.
+     */
+    MovingSDFWall(const MirState *state, const std::string& name, MovingWallSDF&& sdf, VelocityFieldRigidMotion&& motion);
+
+    void removeInner(ParticleVector *pv) override;
+    void attach(ParticleVector *pv, CellList *cl, real maximumPartTravel) override;
+    void bounce(cudaStream_t stream) override;
+
+private:
+    real maximumWallSpeed_;          ///< upper bound of the wall velocity
+    std::vector<int> refreshEvery_;  ///< number of steps between two updates of the boundary cells, per attached pv
+};
+
+} // namespace mirheo
@@ -3,7 +3,9 @@
 
 #include "common_kernels.h"
 #include "stationary_walls/box.h"
+#include "stationary_walls/composite.h"
 #include "stationary_walls/cylinder.h"
+#include "stationary_walls/moving_sdf.h"
 #include "stationary_walls/plane.h"
 #include "stationary_walls/sdf.h"
 #include "stationary_walls/sphere.h"
@@ -175,19 +177,14 @@ __global__ void getBoundaryCells(real maximumTravel, CellListInfo cinfo, int *nB
 // Checking kernel
 //===============================================================================================
 
-template<typename InsideWallChecker>
-__global__ void checkInside(PVview view, int *nInside, const InsideWallChecker checker)
+__global__ void checkInside(int n, const real *sdfs, int *nInside)
 {
     const real checkTolerance = 1e-4_r;
 
     const int pid = blockIdx.x * blockDim.x + threadIdx.x;
-    if (pid >= view.size) return;
-
-    Real3_int coo(view.readPosition(pid));
-
-    real v = checker(coo.v);
+    if (pid >= n) return;
 
-    if (v > checkTolerance) atomicAggInc(nInside);
+    if (sdfs[pid] > checkTolerance) atomicAggInc(nInside);
 }
 
 //===============================================================================================
@@ -205,25 +202,20 @@ __global__ void computeSdfPerParticle(PVview view, real gradientThreshold, real
 
     const auto r = make_real3(view.readPosition(pid));
 
-    const real sdf = checker(r);
-    sdfs[pid] = sdf;
-
-    if (gradients != nullptr)
+    if (gradients == nullptr)
     {
-        if (sdf > -gradientThreshold)
-        {
-            const real3 grad = computeGradient(checker, r, h);
-
-            if (dot(grad, grad) < zeroTolerance)
-                gradients[pid] = make_real3(0, 0, 0);
-            else
-                gradients[pid] = normalize(grad);
-        }
-        else
-        {
-            gradients[pid] = make_real3(0, 0, 0);
-        }
+        sdfs[pid] = checker(r);
+        return;
     }
+
+    // SDF fields with cubic interpolation give both from a single stencil evaluation
+    real3 grad;
+    sdfs[pid] = computeValueAndGradient(checker, r, h, gradientThreshold, &grad);
+
+    if (dot(grad, grad) < zeroTolerance)
+        gradients[pid] = make_real3(0, 0, 0);
+    else
+        gradients[pid] = normalize(grad);
 }
 
 
@@ -253,6 +245,13 @@ __global__ void computeSdfOnGrid(CellListInfo gridInfo, real *sdfs, InsideWallCh
 
 } // namespace stationary_walls_kernels
 
+/// analytical shapes are exact everywhere; only the shapes stored on a grid may have a narrow band
+template<class InsideWallChecker>
+static real getCheckerNarrowBandWidth(__UNUSED const InsideWallChecker& checker) { return 0.0_r; }
+static real getCheckerNarrowBandWidth(const StationaryWallSDF&       checker) { return checker.getNarrowBandWidth(); }
+static real getCheckerNarrowBandWidth(const MovingWallSDF&           checker) { return checker.getNarrowBandWidth(); }
+static real getCheckerNarrowBandWidth(const StationaryWallComposite& checker) { return checker.getNarrowBandWidth(); }
+
 //===============================================================================================
 // Member functions
 //===============================================================================================
@@ -315,36 +314,52 @@ void SimpleStationaryWall<InsideWallChecker>::attach(ParticleVector *pv, CellLis
         die("PVs should only be attached to walls with the primary cell-lists! "
             "Invalid combination: wall %s, pv %s", getCName(), pv->getCName());
 
+    // the boundary cells and the bounce need exact SDF values up to the cut-off and the particle travel
+    const real band = getNarrowBandWidth();
+    if (band > 0.0_r && band <= math::max(cl->rc, maximumPartTravel))
+        die("The narrow band width of wall '%s' (%g) must be larger than the cut-off radius (%g) "
+            "and the maximum travel (%g) of the attached particle vector '%s'",
+            getCName(), band, cl->rc, maximumPartTravel, pv->getCName());
+
     CUDA_Check( cudaDeviceSynchronize() );
     particleVectors_.push_back(pv);
     cellLists_.push_back(cl);
+    maximumPartTravels_.push_back(maximumPartTravel);
+
+    DeviceBuffer<int> bc;
+    _findBoundaryCells(cl, maximumPartTravel, bc, defaultStream);
 
+    boundaryCells_.push_back(std::move(bc));
+    CUDA_Check( cudaDeviceSynchronize() );
+}
+
+template<class InsideWallChecker>
+void SimpleStationaryWall<InsideWallChecker>::_findBoundaryCells(CellList *cl, real maximumTravel,
+                                                                 DeviceBuffer<int>& boundaryCells, cudaStream_t stream)
+{
     const int nthreads = 128;
     const int nblocks = getNblocks(cl->totcells, nthreads);
 
     PinnedBuffer<int> nBoundaryCells(1);
-    nBoundaryCells.clear(defaultStream);
+    nBoundaryCells.clear(stream);
 
     SAFE_KERNEL_LAUNCH(
         stationary_walls_kernels::getBoundaryCells<QueryMode::Query>,
-        nblocks, nthreads, 0, defaultStream,
-        maximumPartTravel, cl->cellInfo(), nBoundaryCells.devPtr(),
+        nblocks, nthreads, 0, stream,
+        maximumTravel, cl->cellInfo(), nBoundaryCells.devPtr(),
         nullptr, insideWallChecker_.handler() );
 
-    nBoundaryCells.downloadFromDevice(defaultStream);
+    nBoundaryCells.downloadFromDevice(stream);
 
     debug("Found %d boundary cells", nBoundaryCells[0]);
-    DeviceBuffer<int> bc(nBoundaryCells[0]);
+    boundaryCells.resize_anew(nBoundaryCells[0]);
 
-    nBoundaryCells.clear(defaultStream);
+    nBoundaryCells.clear(stream);
     SAFE_KERNEL_LAUNCH(
         stationary_walls_kernels::getBoundaryCells<QueryMode::Collect>,
-        nblocks, nthreads, 0, defaultStream,
-        maximumPartTravel, cl->cellInfo(), nBoundaryCells.devPtr(),
-        bc.devPtr(), insideWallChecker_.handler() );
-
-    boundaryCells_.push_back(std::move(bc));
-    CUDA_Check( cudaDeviceSynchronize() );
+        nblocks, nthreads, 0, stream,
+        maximumTravel, cl->cellInfo(), nBoundaryCells.devPtr(),
+        boundaryCells.devPtr(), insideWallChecker_.handler() );
 }
 
 static bool keepAllpersistentDataPredicate(const DataManager::NamedChannelDesc& namedDesc)
@@ -476,6 +491,7 @@ void SimpleStationaryWall<InsideWallChecker>::bounce(cudaStream_t stream)
                 getNblocks(bc.size(), nthreads), nthreads, 0, stream,
                 view, cl->cellInfo(),
                 bc.devPtr(), bc.size(), dt,
+                _getSdfBeforeIntegration(pv), maximumPartTravels_[i],
                 insideWallChecker_.handler(),
                 VelocityFieldNone{},
                 bounceForce_.devPtr());
@@ -491,12 +507,15 @@ void SimpleStationaryWall<InsideWallChecker>::check(cudaStream_t stream)
     for (auto pv : particleVectors_)
     {
         nInside_.clearDevice(stream);
-        const PVview view(pv, pv->local());
+        const int np = pv->local()->size();
+
+        // the values are shared with the other users of the wall at the current positions
+        const auto cached = getCachedSdfPerParticle(pv, 0.0_r, stream);
 
         SAFE_KERNEL_LAUNCH(
             stationary_walls_kernels::checkInside,
-            getNblocks(view.size, nthreads), nthreads, 0, stream,
-            view, nInside_.devPtr(), insideWallChecker_.handler() );
+            getNblocks(np, nthreads), nthreads, 0, stream,
+            np, cached.sdfs, nInside_.devPtr() );
 
         nInside_.downloadFromDevice(stream);
 
@@ -579,6 +598,12 @@ PinnedBuffer<double3>* SimpleStationaryWall<InsideWallChecker>::getCurrentBounce
     return &bounceForce_;
 }
 
+template<class InsideWallChecker>
+real SimpleStationaryWall<InsideWallChecker>::getNarrowBandWidth() const
+{
+    return getCheckerNarrowBandWidth(insideWallChecker_);
+}
+
 template<class InsideWallChecker>
 void SimpleStationaryWall<InsideWallChecker>::saveSnapshotAndRegister(Saver& saver)
 {
@@ -611,6 +636,7 @@ loadSimpleStationaryWall(const MirState *state, Loader& loader, const ConfigObje
     MIR_LOAD_WALL(StationaryWallSDF);
     MIR_LOAD_WALL(StationaryWallPlane);
     MIR_LOAD_WALL(StationaryWallBox);
+    MIR_LOAD_WALL(StationaryWallComposite);
 #undef MIR_LOAD_WALL
     die("Unrecognized simple stationary wall type \"%s\".", type.c_str());
 }
@@ -620,5 +646,7 @@ template class SimpleStationaryWall<StationaryWallCylinder>;
 template class SimpleStationaryWall<StationaryWallSDF>;
 template class SimpleStationaryWall<StationaryWallPlane>;
 template class SimpleStationaryWall<StationaryWallBox>;
+template class SimpleStationaryWall<StationaryWallComposite>;
+template class SimpleStationaryWall<MovingWallSDF>;
 
 } // namespace mirheo
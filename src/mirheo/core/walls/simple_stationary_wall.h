@@ -52,6 +52,8 @@ public:
 
     PinnedBuffer<double3>* getCurrentBounceForce() override;
 
+    real getNarrowBandWidth() const override;
+
     /// Create a \c ConfigObject describing the plugin state and register it in the saver.
     void saveSnapshotAndRegister(Saver& saver) override;
 
@@ -59,6 +61,16 @@ protected:
     /// Implementation of snapshot saving. Reusable by potential derived classes.
     ConfigObject _saveSnapshot(Saver& saver, const std::string& typeName);
 
+    /** \brief Find the cells that may contain particles crossing the wall surface.
+        \param [in] cl The cell list
+        \param [in] maximumTravel Maximum distance between the particles and the surface to consider
+        \param [out] boundaryCells The ids of the found cells
+        \param [in] stream The stream used to execute the kernels; synchronized on return
+     */
+    void _findBoundaryCells(CellList *cl, real maximumTravel, DeviceBuffer<int>& boundaryCells, cudaStream_t stream);
+
+    /// \return The frozen particles attached to the wall, nullptr if none
+    ParticleVector* _getFrozen() const { return frozen_; }
 
 private:
     ParticleVector *frozen_ {nullptr}; ///< frozen particles attached to the wall
@@ -69,6 +81,7 @@ protected:
 
     std::vector<ParticleVector*> particleVectors_; ///< list of pvs that are attached for bounce
     std::vector<CellList*> cellLists_;             ///< list of cell lists corresponding to particleVectors_
+    std::vector<real> maximumPartTravels_;         ///< maximum travel of the particles of particleVectors_ over one time step
 
     std::vector<DeviceBuffer<int>> boundaryCells_; ///< ids of all cells adjacent to the wall surface
     PinnedBuffer<double3> bounceForce_{1};         ///< total force exerced on the walls via particles bounce
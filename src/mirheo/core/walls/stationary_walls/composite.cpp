@@ -0,0 +1,194 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#include "composite.h"
+#include "sdf.h"
+
+#include <mirheo/core/logger.h>
+#include <mirheo/core/walls/simple_stationary_wall.h>
+
+#include <algorithm>
+#include <limits>
+#include <typeinfo>
+
+namespace mirheo
+{
+
+/// \return the wall if it is exactly of type SimpleStationaryWall<InsideWallChecker> (not a moving wall), nullptr otherwise
+template <class InsideWallChecker>
+static SimpleStationaryWall<InsideWallChecker>* getExactWall(Wall *wall)
+{
+    if (typeid(*wall) != typeid(SimpleStationaryWall<InsideWallChecker>))
+        return nullptr;
+    return static_cast<SimpleStationaryWall<InsideWallChecker>*>(wall);
+}
+
+template <class InsideWallChecker>
+static void setupWalls(const std::vector<SimpleStationaryWall<InsideWallChecker>*>& walls,
+                       PinnedBuffer<InsideWallChecker>& handlers, MPI_Comm& comm, DomainInfo domain)
+{
+    handlers.resize_anew(walls.size());
+    for (size_t i = 0; i < walls.size(); ++i)
+    {
+        walls[i]->getChecker().setup(comm, domain);
+        handlers[i] = walls[i]->getChecker().handler();
+    }
+    handlers.uploadToDevice(defaultStream);
+}
+
+StationaryWallComposite::StationaryWallComposite(const CompositeWallExpression& expression)
+{
+    _compile(expression, 0);
+}
+
+StationaryWallComposite::StationaryWallComposite(StationaryWallComposite&&) = default;
+
+StationaryWallComposite::~StationaryWallComposite() = default;
+
+void StationaryWallComposite::setup(MPI_Comm& comm, DomainInfo domain)
+{
+    setupWalls(sphereWalls_,   spheres_,   comm, domain);
+    setupWalls(boxWalls_,      boxes_,     comm, domain);
+    setupWalls(cylinderWalls_, cylinders_, comm, domain);
+    setupWalls(planeWalls_,    planes_,    comm, domain);
+
+    fields_.resize_anew(sdfWalls_.size());
+    for (size_t i = 0; i < sdfWalls_.size(); ++i)
+    {
+        sdfWalls_[i]->getChecker().setup(comm, domain);
+        fields_[i] = sdfWalls_[i]->getChecker().handler();
+    }
+    fields_.uploadToDevice(defaultStream);
+
+    instructions_.resize_anew(program_.size());
+    std::copy(program_.begin(), program_.end(), instructions_.begin());
+    instructions_.uploadToDevice(defaultStream);
+
+    handler_.nInstructions = static_cast<int>(instructions_.size());
+    handler_.instructions  = instructions_.devPtr();
+    handler_.spheres       = spheres_  .devPtr();
+    handler_.boxes         = boxes_    .devPtr();
+    handler_.cylinders     = cylinders_.devPtr();
+    handler_.planes        = planes_   .devPtr();
+    handler_.fields        = fields_   .devPtr();
+    handler_.domain        = domain;
+
+    info("Composite wall: %zu instructions, %zu spheres, %zu boxes, %zu cylinders, %zu planes and %zu SDFs",
+         instructions_.size(), sphereWalls_.size(), boxWalls_.size(),
+         cylinderWalls_.size(), planeWalls_.size(), sdfWalls_.size());
+}
+
+const StationaryWallCompositeHandler& StationaryWallComposite::handler() const
+{
+    return handler_;
+}
+
+real StationaryWallComposite::getNarrowBandWidth() const
+{
+    real band = 0.0_r;
+    for (auto wall : sdfWalls_)
+    {
+        const real b = wall->getNarrowBandWidth();
+        if (b > 0.0_r)
+            band = band > 0.0_r ? std::min(band, b) : b;
+    }
+    return band;
+}
+
+void StationaryWallComposite::_compile(const CompositeWallExpression& expression, int depth)
+{
+    using Operation = CompositeWallExpression::Operation;
+
+    if (depth >= StationaryWallCompositeHandler::maxStackSize)
+        die("Composite wall: the expression is too deeply nested (at most %d levels are supported)",
+            StationaryWallCompositeHandler::maxStackSize);
+
+    if (expression.operation == Operation::Wall)
+    {
+        CompositeWallInstruction ins = _compileWall(expression.wall);
+        ins.operation = Operation::Wall;
+        program_.push_back(ins);
+        return;
+    }
+
+    if (expression.children.size() < 2)
+        die("Composite wall: operations need at least two operands, got %zu", expression.children.size());
+
+    _compile(expression.children[0], depth);
+
+    for (size_t i = 1; i < expression.children.size(); ++i)
+    {
+        const auto& child = expression.children[i];
+        CompositeWallInstruction ins {};
+
+        if (child.operation == Operation::Wall)
+        {
+            ins = _compileWall(child.wall);
+        }
+        else
+        {
+            _compile(child, depth + 1);
+            ins.primitive = CompositeWallInstruction::Primitive::None;
+            ins.id = -1;
+        }
+
+        ins.operation = expression.operation;
+        program_.push_back(ins);
+    }
+}
+
+CompositeWallInstruction StationaryWallComposite::_compileWall(const std::shared_ptr<Wall>& wall)
+{
+    if (wall == nullptr)
+        die("Composite wall: got an empty wall");
+
+    walls_.push_back(wall);
+
+    CompositeWallInstruction ins {};
+    const real inf = std::numeric_limits<real>::max();
+    ins.lo = make_real3(-inf);
+    ins.hi = make_real3( inf);
+
+    if (auto w = getExactWall<StationaryWallSphere>(wall.get()))
+    {
+        ins.primitive = CompositeWallInstruction::Primitive::Sphere;
+        ins.id = static_cast<int>(sphereWalls_.size());
+        w->getChecker().getWallBounds(ins.lo, ins.hi);
+        sphereWalls_.push_back(w);
+    }
+    else if (auto w = getExactWall<StationaryWallBox>(wall.get()))
+    {
+        // the SDF of a box is the distance to the closest face plane, not to the box:
+        // it does not decrease with the distance to the bounds, hence boxes are never skipped
+        ins.primitive = CompositeWallInstruction::Primitive::Box;
+        ins.id = static_cast<int>(boxWalls_.size());
+        boxWalls_.push_back(w);
+    }
+    else if (auto w = getExactWall<StationaryWallCylinder>(wall.get()))
+    {
+        ins.primitive = CompositeWallInstruction::Primitive::Cylinder;
+        ins.id = static_cast<int>(cylinderWalls_.size());
+        w->getChecker().getWallBounds(ins.lo, ins.hi);
+        cylinderWalls_.push_back(w);
+    }
+    else if (auto w = getExactWall<StationaryWallPlane>(wall.get()))
+    {
+        ins.primitive = CompositeWallInstruction::Primitive::Plane;
+        ins.id = static_cast<int>(planeWalls_.size());
+        w->getChecker().getWallBounds(ins.lo, ins.hi);
+        planeWalls_.push_back(w);
+    }
+    else if (auto w = getExactWall<StationaryWallSDF>(wall.get()))
+    {
+        ins.primitive = CompositeWallInstruction::Primitive::SDF;
+        ins.id = static_cast<int>(sdfWalls_.size());
+        sdfWalls_.push_back(w);
+    }
+    else
+    {
+        die("Composite wall: wall '%s' is not a stationary sphere, box, cylinder, plane or SDF wall",
+            wall->getCName());
+    }
+
+    return ins;
+}
+
+} // namespace mirheo
@@ -0,0 +1,213 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include "box.h"
+#include "cylinder.h"
+#include "plane.h"
+#include "sphere.h"
+
+#include <mirheo/core/containers.h>
+#include <mirheo/core/field/interface.h>
+#include <mirheo/core/utils/config.h>
+#include <mirheo/core/utils/reflection.h>
+
+#include <memory>
+#include <vector>
+
+namespace mirheo
+{
+
+class Wall;
+class StationaryWallSDF;
+template <class InsideWallChecker> class SimpleStationaryWall;
+
+/** \brief A constructive solid geometry (CSG) expression of walls.
+
+    The leaves of the expression are analytic or SDF walls; the inner nodes combine the
+    inside of their children (the regions where the SDF is positive).
+ */
+struct CompositeWallExpression
+{
+    /// The operation represented by a node of the expression
+    enum class Operation
+    {
+        Wall,         ///< a leaf: the inside of a wall
+        Union,        ///< the inside of any of the children
+        Intersection, ///< the inside of all the children
+        Difference    ///< the inside of the first child but of none of the others
+    };
+
+    Operation operation;                       ///< operation of the node
+    std::shared_ptr<Wall> wall;                ///< the wall of a leaf; unused for the other operations
+    std::vector<CompositeWallExpression> children; ///< the operands; unused for leaves
+};
+
+/// An instruction of the flattened expression of a StationaryWallComposite
+struct CompositeWallInstruction
+{
+    /// The kind of wall of the operand
+    enum class Primitive {None, Sphere, Box, Cylinder, Plane, SDF};
+
+    /** The operation; applied to the top of the stack and the operand if any,
+        otherwise to the two values on top of the stack.
+        Wall means pushing the operand on the stack.
+     */
+    CompositeWallExpression::Operation operation;
+    Primitive primitive; ///< The kind of wall of the operand, None if the operand is the top of the stack
+    int id;              ///< index of the operand in the list of walls of its kind
+    real3 lo;            ///< lower bounds of the inside of the operand in global coordinates
+    real3 hi;            ///< upper bounds of the inside of the operand in global coordinates
+};
+
+/// A device-compatible view of a StationaryWallComposite
+class StationaryWallCompositeHandler
+{
+public:
+    static constexpr int maxStackSize = 8; ///< maximum depth of the evaluation stack
+
+    /** \brief Get the SDF of the composite shape at a given position.
+        \param [in] r position in local coordinates
+        \return The SDF value
+
+        The operand of an instruction is not evaluated when its bounds show that it cannot change the result.
+     */
+    __D__ inline real operator()(real3 r) const
+    {
+        const real3 gr = domain.local2global(r);
+
+        real stack[maxStackSize];
+        int top = -1;
+
+        for (int i = 0; i < nInstructions; ++i)
+        {
+            const CompositeWallInstruction ins = instructions[i];
+
+            if (ins.primitive == CompositeWallInstruction::Primitive::None)
+            {
+                const real b = stack[top--];
+                stack[top] = _combine(ins.operation, stack[top], b);
+                continue;
+            }
+
+            if (ins.operation == CompositeWallExpression::Operation::Wall)
+            {
+                stack[++top] = _evaluate(ins, r);
+                continue;
+            }
+
+            // outside of its bounds, the SDF of the operand is smaller than minus the distance to the bounds
+            const real3 d3 = math::max(math::max(ins.lo - gr, gr - ins.hi), make_real3(0.0_r));
+            const real d = length(d3);
+
+            if (d > 0.0_r)
+            {
+                if (ins.operation == CompositeWallExpression::Operation::Union      && stack[top] >= -d) continue;
+                if (ins.operation == CompositeWallExpression::Operation::Difference && stack[top] <=  d) continue;
+            }
+
+            stack[top] = _combine(ins.operation, stack[top], _evaluate(ins, r));
+        }
+
+        return stack[0];
+    }
+
+    int nInstructions;                            ///< number of instructions
+    const CompositeWallInstruction *instructions; ///< flattened expression, in postfix order
+    const StationaryWallSphere   *spheres;        ///< sphere operands
+    const StationaryWallBox      *boxes;          ///< box operands
+    const StationaryWallCylinder *cylinders;      ///< cylinder operands
+    const StationaryWallPlane    *planes;         ///< plane operands
+    const FieldDeviceHandler     *fields;         ///< SDF operands
+    DomainInfo domain;                            ///< domain info
+
+private:
+    __D__ inline real _evaluate(const CompositeWallInstruction& ins, real3 r) const
+    {
+        switch (ins.primitive)
+        {
+        case CompositeWallInstruction::Primitive::Sphere:   return spheres  [ins.id](r);
+        case CompositeWallInstruction::Primitive::Box:      return boxes    [ins.id](r);
+        case CompositeWallInstruction::Primitive::Cylinder: return cylinders[ins.id](r);
+        case CompositeWallInstruction::Primitive::Plane:    return planes   [ins.id](r);
+        case CompositeWallInstruction::Primitive::SDF:      return fields   [ins.id](r);
+        default: return 0.0_r;
+        }
+    }
+
+    __D__ static inline real _combine(CompositeWallExpression::Operation operation, real a, real b)
+    {
+        switch (operation)
+        {
+        case CompositeWallExpression::Operation::Union:        return math::max(a,  b);
+        case CompositeWallExpression::Operation::Intersection: return math::min(a,  b);
+        case CompositeWallExpression::Operation::Difference:   return math::min(a, -b);
+        default: return a;
+        }
+    }
+};
+
+/** \brief Represents the combination of several walls by union, intersection and difference.
+
+    The whole expression is evaluated in a single pass, so that a wall made of many primitives
+    is bounced (and checked, frozen...) only once instead of once per primitive.
+    The operands of a union or a difference are skipped when the point is far enough from their bounds.
+    Only the bounded inside of spheres and cylinders provide such bounds, since their SDF is
+    the exact distance to the surface; the SDF of the other operands may be larger than minus
+    the distance to their bounds (e.g. the one of a box is the distance to the closest face plane).
+
+    The walls used in the expression must not be registered to the simulation themselves.
+ */
+class StationaryWallComposite
+{
+public:
+    /** \brief Construct a StationaryWallComposite.
+        \param [in] expression The CSG expression of the walls; the leaves must be
+                               (non moving) sphere, box, cylinder, plane or SDF walls.
+     */
+    StationaryWallComposite(const CompositeWallExpression& expression);
+    /// Move ctor.
+    StationaryWallComposite(StationaryWallComposite&&);
+    ~StationaryWallComposite();
+
+    /** \brief Synchronize internal state with simulation
+        \param [in] comm MPI carthesia communicator
+        \param [in] domain Domain info
+    */
+    void setup(MPI_Comm& comm, DomainInfo domain);
+
+    /// Get a handler of the shape representation usable on the device
+    const StationaryWallCompositeHandler& handler() const;
+
+    /// \return The smallest narrow band width of the SDF operands (see Field), or 0 if they are all exact
+    real getNarrowBandWidth() const;
+
+private:
+    void _compile(const CompositeWallExpression& expression, int depth);
+    CompositeWallInstruction _compileWall(const std::shared_ptr<Wall>& wall);
+
+private:
+    std::vector<std::shared_ptr<Wall>> walls_;      ///< keep the operands alive
+    std::vector<CompositeWallInstruction> program_; ///< flattened expression, in postfix order
+
+    std::vector<SimpleStationaryWall<StationaryWallSphere>*>   sphereWalls_;
+    std::vector<SimpleStationaryWall<StationaryWallBox>*>      boxWalls_;
+    std::vector<SimpleStationaryWall<StationaryWallCylinder>*> cylinderWalls_;
+    std::vector<SimpleStationaryWall<StationaryWallPlane>*>    planeWalls_;
+    std::vector<SimpleStationaryWall<StationaryWallSDF>*>      sdfWalls_;
+
+    PinnedBuffer<CompositeWallInstruction> instructions_;
+    PinnedBuffer<StationaryWallSphere>     spheres_;
+    PinnedBuffer<StationaryWallBox>        boxes_;
+    PinnedBuffer<StationaryWallCylinder>   cylinders_;
+    PinnedBuffer<StationaryWallPlane>      planes_;
+    PinnedBuffer<FieldDeviceHandler>       fields_;
+
+    StationaryWallCompositeHandler handler_;
+};
+
+MIRHEO_TYPE_NAME_AUTO(StationaryWallComposite);
+
+template <>
+struct TypeLoadSave<StationaryWallComposite> : TypeLoadSaveNotImplemented<StationaryWallComposite> { };
+
+} // namespace mirheo
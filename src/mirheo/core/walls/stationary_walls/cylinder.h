@@ -8,6 +8,8 @@
 #include <mirheo/core/utils/helper_math.h>
 #include <mirheo/core/utils/reflection.h>
 
+#include <limits>
+
 namespace mirheo
 {
 
@@ -68,6 +70,29 @@ public:
         return inside_ ? dist - radius_ : radius_ - dist;
     }
 
+    /** \brief Get the axis-aligned bounds of the inside of the wall.
+        \param [out] lo Lower bounds in global coordinates
+        \param [out] hi Upper bounds in global coordinates
+
+        The bounds are infinite along the directions where the inside of the wall is unbounded.
+    */
+    void getWallBounds(real3& lo, real3& hi) const
+    {
+        const real inf = std::numeric_limits<real>::max();
+        lo = make_real3(-inf);
+        hi = make_real3( inf);
+
+        if (inside_)
+            return;
+
+        const real2 l = make_real2(center_.x - radius_, center_.y - radius_);
+        const real2 h = make_real2(center_.x + radius_, center_.y + radius_);
+
+        if (dir_ == Direction::x) { lo.y = l.x; lo.z = l.y; hi.y = h.x; hi.z = h.y; }
+        if (dir_ == Direction::y) { lo.x = l.x; lo.z = l.y; hi.x = h.x; hi.z = h.y; }
+        if (dir_ == Direction::z) { lo.x = l.x; lo.y = l.y; hi.x = h.x; hi.y = h.y; }
+    }
+
 private:
     friend MemberVars<StationaryWallCylinder>;
 
@@ -0,0 +1,60 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#include "moving_sdf.h"
+
+#include <limits>
+
+namespace mirheo
+{
+
+static std::unique_ptr<MirState> makeWholeDomainState(const MirState *state)
+{
+    auto wholeDomainState = std::make_unique<MirState>(*state);
+    const real3 L = state->domain.globalSize;
+    wholeDomainState->domain = DomainInfo{L, make_real3(0.0_r), L};
+    return wholeDomainState;
+}
+
+MovingWallSDF::MovingWallSDF(const MirState *state, std::string sdfFileName, real3 sdfH, real narrowBandWidth,
+                             FieldInterpolation interpolation, VelocityFieldRigidMotion motion) :
+    state_(state),
+    wholeDomainState_(makeWholeDomainState(state)),
+    impl_(std::make_unique<FieldFromFile>(wholeDomainState_.get(), "field_"+sdfFileName, sdfFileName,
+                                          sdfH, narrowBandWidth, interpolation)),
+    motion_(motion),
+    handlerTime_(std::numeric_limits<real>::quiet_NaN())
+{}
+
+MovingWallSDF::MovingWallSDF(MovingWallSDF&&) = default;
+
+MovingWallSDF::~MovingWallSDF() = default;
+
+void MovingWallSDF::setup(MPI_Comm& comm, DomainInfo domain)
+{
+    impl_->setup(comm);
+
+    handler_.field  = impl_->handler();
+    handler_.domain = domain;
+    handlerTime_ = std::numeric_limits<real>::quiet_NaN();
+}
+
+real MovingWallSDF::getNarrowBandWidth() const
+{
+    return impl_->getNarrowBandWidth();
+}
+
+const MovingWallSDFHandler& MovingWallSDF::handler() const
+{
+    const real t = state_->currentTime;
+
+    if (t != handlerTime_)
+    {
+        VelocityFieldRigidMotion motion = motion_;
+        motion.setup(t, state_->domain);
+        handler_.motion = motion;
+        handlerTime_ = t;
+    }
+
+    return handler_;
+}
+
+} // namespace mirheo
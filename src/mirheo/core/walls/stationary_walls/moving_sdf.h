@@ -0,0 +1,121 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include <mirheo/core/field/from_file.h>
+#include <mirheo/core/utils/config.h>
+#include <mirheo/core/utils/reflection.h>
+#include <mirheo/core/walls/velocity_field/rigid_motion.h>
+
+#include <memory>
+
+namespace mirheo
+{
+
+/// A device-compatible view of a MovingWallSDF at a given time
+class MovingWallSDFHandler
+{
+public:
+    /** \brief Get the SDF of the moved shape at a given position.
+        \param [in] r position in local coordinates
+        \return The SDF value
+     */
+    __D__ inline real operator()(real3 r) const
+    {
+        const real3 L = domain.globalSize;
+        const real3 gr = motion.toInitialFrame(domain.local2global(r));
+
+        // the field covers the whole (periodic) domain
+        const real3 wrapped = gr - L * math::floor(gr / L);
+        return field(wrapped - 0.5_r * L);
+    }
+
+    /** \brief Get the SDF of the moved shape and, where needed, its gradient at a given position.
+        \param [in] r position in local coordinates
+        \param [in] h The step used for finite differences (linear interpolation only)
+        \param [in] gradientThreshold The gradient is computed only where the SDF is larger than minus this threshold
+        \param [out] grad The gradient of the SDF at \p r, or zero where it is not needed
+        \return The SDF value
+     */
+    __D__ inline real valueAndGradient(real3 r, real h, real gradientThreshold, real3 *grad) const
+    {
+        const real3 L = domain.globalSize;
+        const real3 gr = motion.toInitialFrame(domain.local2global(r));
+        const real3 wrapped = gr - L * math::floor(gr / L);
+
+        // the gradient is computed in the initial frame and rotated with the shape
+        real3 grad0;
+        const real val = field.valueAndGradient(wrapped - 0.5_r * L, h, gradientThreshold, &grad0);
+        *grad = motion.fromInitialFrameDirection(grad0);
+        return val;
+    }
+
+    FieldDeviceHandler field;        ///< SDF of the shape at time 0 on the whole domain
+    VelocityFieldRigidMotion motion; ///< rigid motion of the shape, set up at the current time
+    DomainInfo domain;               ///< domain info
+};
+
+/** \brief compute the SDF of a moving wall and, where needed, its gradient on the device
+    \param [in] sdf The moving SDF
+    \param [in] r The position at which to evaluate the SDF
+    \param [in] h The step size used to compute the gradient with finite differences, if needed
+    \param [in] gradientThreshold The gradient is computed only where the SDF is larger than minus this threshold
+    \param [out] grad The gradient of \p sdf at \p r, or zero where it is not needed
+    \return The SDF value at \p r
+ */
+inline __D__ real computeValueAndGradient(const MovingWallSDFHandler& sdf, real3 r, real h, real gradientThreshold, real3 *grad)
+{
+    return sdf.valueAndGradient(r, h, gradientThreshold, grad);
+}
+
+/** \brief Represent an SDF field on a grid that moves rigidly in time.
+
+    The grid is sampled once; the current position of the shape is obtained by transforming
+    the query points back to the initial frame of the shape at every lookup.
+    Since the shape may move anywhere, every rank stores the SDF on the whole domain.
+ */
+class MovingWallSDF
+{
+public:
+    /** \brief Construct a MovingWallSDF from a file.
+        \param [in] state Simulation state
+        \param [in] sdfFileName The input file name, describing the shape at time 0
+        \param [in] sdfH The grid spacing
+        \param [in] narrowBandWidth If positive, store the SDF only close to the wall (see Field)
+        \param [in] interpolation The interpolation of the SDF grid (see Field)
+        \param [in] motion The rigid motion of the shape
+     */
+    MovingWallSDF(const MirState *state, std::string sdfFileName, real3 sdfH, real narrowBandWidth,
+                  FieldInterpolation interpolation, VelocityFieldRigidMotion motion);
+    /// Move ctor.
+    MovingWallSDF(MovingWallSDF&&);
+    ~MovingWallSDF();
+
+    /** \brief Synchronize internal state with simulation
+        \param [in] comm MPI carthesia communicator
+        \param [in] domain Domain info
+    */
+    void setup(MPI_Comm& comm, DomainInfo domain);
+
+    /// Get a handler of the shape representation at the current simulation time usable on the device
+    const MovingWallSDFHandler& handler() const;
+
+    /// \return The narrow band width of the SDF grid (see Field)
+    real getNarrowBandWidth() const;
+
+private:
+    const MirState *state_;
+    std::unique_ptr<MirState> wholeDomainState_; ///< state seen by the field: a single subdomain covering the whole domain
+    std::unique_ptr<FieldFromFile> impl_;
+    VelocityFieldRigidMotion motion_;
+
+    // the transform is updated lazily when the simulation time changes
+    mutable MovingWallSDFHandler handler_;
+    mutable real handlerTime_;
+};
+
+MIRHEO_TYPE_NAME_AUTO(MovingWallSDF);
+
+template <>
+struct TypeLoadSave<MovingWallSDF> : TypeLoadSaveNotImplemented<MovingWallSDF> { };
+
+} // namespace mirheo
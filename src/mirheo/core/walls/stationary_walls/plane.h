@@ -8,6 +8,8 @@
 #include <mirheo/core/utils/helper_math.h>
 #include <mirheo/core/utils/reflection.h>
 
+#include <limits>
+
 namespace mirheo
 {
 
@@ -52,6 +54,19 @@ public:
         return dist;
     }
 
+    /** \brief Get the axis-aligned bounds of the inside of the wall.
+        \param [out] lo Lower bounds in global coordinates
+        \param [out] hi Upper bounds in global coordinates
+
+        The bounds are infinite along the directions where the inside of the wall is unbounded.
+    */
+    void getWallBounds(real3& lo, real3& hi) const
+    {
+        const real inf = std::numeric_limits<real>::max();
+        lo = make_real3(-inf);
+        hi = make_real3( inf);
+    }
+
 private:
     friend MemberVars<StationaryWallPlane>;
 
@@ -4,8 +4,9 @@
 namespace mirheo
 {
 
-StationaryWallSDF::StationaryWallSDF(const MirState *state, std::string sdfFileName, real3 sdfH) :
-    impl_(std::make_unique<FieldFromFile>(state, "field_"+sdfFileName, sdfFileName, sdfH))
+StationaryWallSDF::StationaryWallSDF(const MirState *state, std::string sdfFileName, real3 sdfH, real narrowBandWidth,
+                                     FieldInterpolation interpolation) :
+    impl_(std::make_unique<FieldFromFile>(state, "field_"+sdfFileName, sdfFileName, sdfH, narrowBandWidth, interpolation))
 {}
 
 StationaryWallSDF::StationaryWallSDF(StationaryWallSDF&&) = default;
@@ -15,6 +16,11 @@ const FieldDeviceHandler& StationaryWallSDF::handler() const
     return impl_->handler();
 }
 
+real StationaryWallSDF::getNarrowBandWidth() const
+{
+    return impl_->getNarrowBandWidth();
+}
+
 void StationaryWallSDF::setup(MPI_Comm& comm, __UNUSED DomainInfo domain)
 {
     return impl_->setup(comm);
@@ -17,8 +17,11 @@ public:
         \param [in] state Simulation state
         \param [in] sdfFileName The input file name
         \param [in] sdfH The grid spacing
+        \param [in] narrowBandWidth If positive, store the SDF only close to the wall (see Field)
+        \param [in] interpolation The interpolation of the SDF grid (see Field)
      */
-    StationaryWallSDF(const MirState *state, std::string sdfFileName, real3 sdfH);
+    StationaryWallSDF(const MirState *state, std::string sdfFileName, real3 sdfH, real narrowBandWidth = 0.0_r,
+                      FieldInterpolation interpolation = FieldInterpolation::Linear);
     /// Move ctor.
     StationaryWallSDF(StationaryWallSDF&&);
 
@@ -31,6 +34,9 @@ public:
     /// Get a handler of the shape representation usable on the device
     const FieldDeviceHandler& handler() const;
 
+    /// \return The narrow band width of the SDF grid (see Field)
+    real getNarrowBandWidth() const;
+
 private:
     std::unique_ptr<FieldFromFile> impl_;
 };
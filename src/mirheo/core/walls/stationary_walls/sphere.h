@@ -8,6 +8,8 @@
 #include <mirheo/core/utils/helper_math.h>
 #include <mirheo/core/utils/reflection.h>
 
+#include <limits>
+
 namespace mirheo
 {
 
@@ -55,6 +57,19 @@ public:
         return inside_ ? dist - radius_ : radius_ - dist;
     }
 
+    /** \brief Get the axis-aligned bounds of the inside of the wall.
+        \param [out] lo Lower bounds in global coordinates
+        \param [out] hi Upper bounds in global coordinates
+
+        The bounds are infinite along the directions where the inside of the wall is unbounded.
+    */
+    void getWallBounds(real3& lo, real3& hi) const
+    {
+        const real inf = std::numeric_limits<real>::max();
+        lo = inside_ ? make_real3(-inf) : center_ - radius_;
+        hi = inside_ ? make_real3( inf) : center_ + radius_;
+    }
+
 private:
     friend MemberVars<StationaryWallSphere>;
 
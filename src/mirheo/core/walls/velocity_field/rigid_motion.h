@@ -0,0 +1,150 @@
+// Copyright 2020 ETH Zurich. All Rights Reserved.
+#pragma once
+
+#include <mirheo/core/domain.h>
+#include <mirheo/core/datatypes.h>
+
+#include <mirheo/core/utils/cpu_gpu_defines.h>
+#include <mirheo/core/utils/helper_math.h>
+#include <mirheo/core/utils/quaternion.h>
+
+namespace mirheo
+{
+
+/** Velocity field of a rigid motion made of a translation and a rotation, constant or oscillating in time.
+
+    \rst
+    .. math::
+        \mathbf{v}(\mathbf{r}, t) = s(t) \left( \mathbf{v} + \mathbf{\omega} \times (\mathbf{r} - \mathbf{c}(t)) \right),
+
+    where :math:`s(t) = \cos{\frac {2 \pi t}{T}}` if the period :math:`T` is positive and :math:`s(t) = 1` otherwise.
+    The center of rotation :math:`\mathbf{c}(t)` moves with the translation.
+    \endrst
+
+    The transform from the initial position of the body to its current position is also provided,
+    so that a shape defined at time 0 can be evaluated at any time without being resampled.
+    Distances to the center of rotation follow the minimum image convention.
+*/
+class VelocityFieldRigidMotion
+{
+public:
+    /** Construct a VelocityFieldRigidMotion object
+        \param [in] velocity The translation velocity (maximum velocity if oscillating)
+        \param [in] omega The angular velocity (maximum angular velocity if oscillating)
+        \param [in] center Center of rotation at time 0 in global coordinates
+        \param [in] period Oscillation period in simulation time; no oscillation if not positive
+    */
+    VelocityFieldRigidMotion(real3 velocity, real3 omega, real3 center, real period) :
+        velocity_(velocity),
+        omega_(omega),
+        center0_(center),
+        period_(period)
+    {}
+
+    /** Synchronize with simulation state. Must be called at every time step.
+        \param [in] t Simulation time.
+        \param [in] domain domain info.
+     */
+    void setup(real t, DomainInfo domain)
+    {
+        domain_ = domain;
+
+        // s(t) and its integral from 0 to t
+        real scale = 1.0_r;
+        real integral = t;
+        if (period_ > 0.0_r)
+        {
+            const real w = static_cast<real>(2 * M_PI) / period_;
+            scale    = math::cos(w * t);
+            integral = math::sin(w * t) / w;
+        }
+
+        scale_  = scale;
+        center_ = center0_ + integral * velocity_;
+
+        const real omegaNorm = length(omega_);
+        if (omegaNorm > 0.0_r)
+            q_ = Quaternion<real>::createFromRotation(omegaNorm * integral, omega_ / omegaNorm);
+        else
+            q_ = Quaternion<real>::createFromComponents(1.0_r, 0.0_r, 0.0_r, 0.0_r);
+    }
+
+    /// get a handler that can be used on the device.
+    const VelocityFieldRigidMotion& handler() const
+    {
+        return *this;
+    }
+
+    /** \return An upper bound of the velocity magnitude in the whole domain at any time
+        \param [in] domain domain info.
+     */
+    real getMaximumSpeed(DomainInfo domain) const
+    {
+        return length(velocity_) + length(omega_) * 0.5_r * length(domain.globalSize);
+    }
+
+    /** Evaluate the velocity field at a given position
+        \param [in] r The position in local coordinates
+        \return The velocity value
+    */
+    __D__ inline real3 operator()(real3 r) const
+    {
+        const real3 dr = _minimumImage(domain_.local2global(r) - center_);
+        return scale_ * (velocity_ + cross(omega_, dr));
+    }
+
+    /** Transform a position to the frame of the body at time 0
+        \param [in] gr The position in global coordinates
+        \return The position that the body point currently at \p gr had at time 0, in global coordinates
+    */
+    __HD__ inline real3 toInitialFrame(real3 gr) const
+    {
+        const real3 dr = _minimumImage(gr - center_);
+        return q_.inverseRotate(dr) + center0_;
+    }
+
+    /** Displacement of a body point from the time of this motion to the time of another one
+        \param [in] next The same motion, set up at a later time
+        \param [in] gr The position of the body point at the time of this motion, in global coordinates
+        \return The displacement of the point, following the minimum image convention
+    */
+    __HD__ inline real3 displacementTo(const VelocityFieldRigidMotion& next, real3 gr) const
+    {
+        const real3 dr0 = q_.inverseRotate(_minimumImage(gr - center_));
+        const real3 target = next.q_.rotate(dr0) + next.center_;
+        return _minimumImage(target - gr);
+    }
+
+    /** Transform a direction from the frame of the body at time 0 to its current frame
+        \param [in] v The direction in the initial frame
+        \return The rotated direction
+    */
+    __HD__ inline real3 fromInitialFrameDirection(real3 v) const
+    {
+        return q_.rotate(v);
+    }
+
+private:
+    __HD__ inline real3 _minimumImage(real3 dr) const
+    {
+        const real3 L = domain_.globalSize;
+        dr.x -= L.x * math::floor(dr.x / L.x + 0.5_r);
+        dr.y -= L.y * math::floor(dr.y / L.y + 0.5_r);
+        dr.z -= L.z * math::floor(dr.z / L.z + 0.5_r);
+        return dr;
+    }
+
+private:
+    real3 velocity_;
+    real3 omega_;
+    real3 center0_;
+    real period_;
+
+    real scale_ {1.0_r};
+    real3 center_ {0.0_r, 0.0_r, 0.0_r};
+    Quaternion<real> q_ {Quaternion<real>::createFromComponents(1.0_r, 0.0_r, 0.0_r, 0.0_r)};
+
+    DomainInfo domain_;
+};
+
+} // namespace mirheo
@@ -6,12 +6,15 @@
 #include <mirheo/core/pvs/particle_vector.h>
 #include <mirheo/core/pvs/views/pv.h>
 #include <mirheo/core/utils/cuda_common.h>
+#include <mirheo/core/utils/file_wrapper.h>
 #include <mirheo/core/utils/kernel_launch.h>
 #include <mirheo/core/utils/path.h>
 #include <mirheo/core/walls/simple_stationary_wall.h>
 #include <mirheo/core/xdmf/type_map.h>
 #include <mirheo/core/xdmf/xdmf.h>
 
+#include <cmath>
+#include <cstdint>
 #include <curand_kernel.h>
 
 namespace mirheo
@@ -83,6 +86,21 @@ __global__ void countInside(int n, const real *sdf, int *nInside, real threshold
     if (laneId() == 0)
         atomicAdd(nInside, myval);
 }
+
+__global__ void sumInsideFractions(int n, const real *sdf, real invH, double *sumFractions)
+{
+    const int i = blockIdx.x * blockDim.x + threadIdx.x;
+    real fraction = 0._r;
+
+    // fraction of the cell where the sdf is negative, assuming a locally planar surface
+    if (i < n)
+        fraction = math::min(math::max(0.5_r - sdf[i] * invH, 0._r), 1._r);
+
+    fraction = warpReduce(fraction, [] (real a, real b) {return a + b;});
+
+    if (laneId() == 0)
+        atomicAdd(sumFractions, static_cast<double>(fraction));
+}
 } // namespace wall_helpers_kernels
 
 static void extract_particles(ParticleVector *pv, const real *sdfs, real minVal, real maxVal)
@@ -161,14 +179,13 @@ void wall_helpers::freezeParticlesInWalls(std::vector<SDFBasedWall*> walls, Part
 }
 
 
-void wall_helpers::dumpWalls2XDMF(std::vector<SDFBasedWall*> walls, real3 gridH, DomainInfo domain, std::string filename, MPI_Comm cartComm)
+/// Compute the sdf of the union of the walls at the centers of the cells of the grid (on the device only)
+static void mergedSdfOnGrid(const std::vector<SDFBasedWall*>& walls, const CellListInfo& gridInfo, PinnedBuffer<real>& sdfs_merged)
 {
-    CUDA_Check( cudaDeviceSynchronize() );
-    CellListInfo gridInfo(gridH, domain.localSize);
     const int n = gridInfo.totcells;
 
     DeviceBuffer<real> sdfs(n);
-    PinnedBuffer<real> sdfs_merged(n);
+    sdfs_merged.resize_anew(n);
 
     const int nthreads = 128;
     const int nblocks = getNblocks(n, nthreads);
@@ -181,13 +198,22 @@ void wall_helpers::dumpWalls2XDMF(std::vector<SDFBasedWall*> walls, real3 gridH,
 
     for (auto& wall : walls)
     {
-        wall->sdfOnGrid(gridH, &sdfs, defaultStream);
+        wall->sdfOnGrid(gridInfo.h, &sdfs, defaultStream);
 
         SAFE_KERNEL_LAUNCH(
             wall_helpers_kernels::merge_sdfs,
             nblocks, nthreads, 0, defaultStream,
             n, sdfs.devPtr(), sdfs_merged.devPtr());
     }
+}
+
+void wall_helpers::dumpWalls2XDMF(std::vector<SDFBasedWall*> walls, real3 gridH, DomainInfo domain, std::string filename, MPI_Comm cartComm)
+{
+    CUDA_Check( cudaDeviceSynchronize() );
+    CellListInfo gridInfo(gridH, domain.localSize);
+
+    PinnedBuffer<real> sdfs_merged;
+    mergedSdfOnGrid(walls, gridInfo, sdfs_merged);
 
     sdfs_merged.downloadFromDevice(defaultStream);
 
@@ -255,4 +281,142 @@ double wall_helpers::volumeInsideWalls(std::vector<SDFBasedWall*> walls, DomainI
     return totVolume;
 }
 
+double wall_helpers::volumeInsideWallsOnGrid(std::vector<SDFBasedWall*> walls, DomainInfo domain, MPI_Comm comm, real h)
+{
+    CUDA_Check( cudaDeviceSynchronize() );
+    const CellListInfo gridInfo(make_real3(h), domain.localSize);
+    const int n = gridInfo.totcells;
+
+    PinnedBuffer<real> sdfs_merged;
+    mergedSdfOnGrid(walls, gridInfo, sdfs_merged);
+
+    PinnedBuffer<double> sumFractions(1);
+    sumFractions.clear(defaultStream);
+
+    // the grid spacing may have been adapted to the subdomain size
+    const real3 gridH = gridInfo.h;
+    const real cellVolume = gridH.x * gridH.y * gridH.z;
+    const real invH = 1.0_r / std::cbrt(cellVolume);
+
+    const int nthreads = 128;
+    SAFE_KERNEL_LAUNCH(
+        wall_helpers_kernels::sumInsideFractions,
+        getNblocks(n, nthreads), nthreads, 0, defaultStream,
+        n, sdfs_merged.devPtr(), invH, sumFractions.devPtr());
+
+    sumFractions.downloadFromDevice(defaultStream, ContainersSynch::Synch);
+
+    double locVolume = sumFractions[0] * cellVolume;
+    double totVolume = 0;
+
+    MPI_Check( MPI_Allreduce(&locVolume, &totVolume, 1, MPI_DOUBLE, MPI_SUM, comm) );
+
+    return totVolume;
+}
+
+/// 64 bits FNV-1a hash, stable across runs and platforms
+static uint64_t hashBytes(const void *data, size_t size, uint64_t hash = 14695981039346656037ull)
+{
+    const auto bytes = reinterpret_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+std::string wall_helpers::computeWallsGeometryKey(std::vector<SDFBasedWall*> walls, DomainInfo domain, MPI_Comm comm,
+                                                  const std::string& parameters)
+{
+    CUDA_Check( cudaDeviceSynchronize() );
+
+    // coarse enough to be cheap, fine enough to distinguish geometries at the scale of a particle
+    const real gridSpacing = 0.5_r;
+    // the values are quantized so that round-off differences do not change the key
+    const real quantum = 1e-3_r;
+
+    const CellListInfo gridInfo(make_real3(gridSpacing), domain.localSize);
+
+    PinnedBuffer<real> sdfs_merged;
+    mergedSdfOnGrid(walls, gridInfo, sdfs_merged);
+    sdfs_merged.downloadFromDevice(defaultStream, ContainersSynch::Synch);
+
+    int rank;
+    MPI_Check( MPI_Comm_rank(comm, &rank) );
+
+    uint64_t hash = hashBytes(&rank, sizeof(rank));
+    hash = hashBytes(&domain.globalSize,  sizeof(domain.globalSize),  hash);
+    hash = hashBytes(&domain.globalStart, sizeof(domain.globalStart), hash);
+    hash = hashBytes(parameters.data(), parameters.size(), hash);
+
+    for (const real sdf : sdfs_merged)
+    {
+        const long long q = std::llround(sdf / quantum);
+        hash = hashBytes(&q, sizeof(q), hash);
+    }
+
+    uint64_t globalHash = 0;
+    MPI_Check( MPI_Allreduce(&hash, &globalHash, 1, MPI_UINT64_T, MPI_BXOR, comm) );
+
+    char key[32];
+    snprintf(key, sizeof(key), "%016llx", static_cast<unsigned long long>(globalHash));
+    return key;
+}
+
+void wall_helpers::saveFrozenParticles(ParticleVector *pv, const std::string& filename)
+{
+    auto lpv = pv->local();
+    lpv->positions ().downloadFromDevice(defaultStream, ContainersSynch::Asynch);
+    lpv->velocities().downloadFromDevice(defaultStream, ContainersSynch::Synch);
+
+    FileWrapper f(filename, "wb");
+
+    const int realSize = sizeof(real);
+    const int64_t n = lpv->size();
+
+    fwrite(&realSize, sizeof(realSize), 1, f.get());
+    fwrite(&n,        sizeof(n),        1, f.get());
+    fwrite(lpv->positions ().hostPtr(), sizeof(real4), n, f.get());
+    fwrite(lpv->velocities().hostPtr(), sizeof(real4), n, f.get());
+}
+
+bool wall_helpers::loadFrozenParticles(ParticleVector *pv, const std::string& filename)
+{
+    FileWrapper f;
+    if (f.open(filename, "rb") != FileWrapper::Status::Success)
+        return false;
+
+    int realSize {0};
+    int64_t n {0};
+
+    if (fread(&realSize, sizeof(realSize), 1, f.get()) != 1 ||
+        fread(&n,        sizeof(n),        1, f.get()) != 1)
+    {
+        warn("Could not read the header of frozen particles file '%s'", filename.c_str());
+        return false;
+    }
+
+    if (realSize != sizeof(real))
+    {
+        warn("Frozen particles file '%s' was written with another floating point precision", filename.c_str());
+        return false;
+    }
+
+    auto lpv = pv->local();
+    lpv->resize_anew(static_cast<int>(n));
+
+    if (static_cast<int64_t>(fread(lpv->positions ().hostPtr(), sizeof(real4), n, f.get())) != n ||
+        static_cast<int64_t>(fread(lpv->velocities().hostPtr(), sizeof(real4), n, f.get())) != n)
+    {
+        warn("Frozen particles file '%s' is truncated", filename.c_str());
+        lpv->resize_anew(0);
+        return false;
+    }
+
+    lpv->positions ().uploadToDevice(defaultStream);
+    lpv->velocities().uploadToDevice(defaultStream);
+    return true;
+}
+
 } // namespace mirheo
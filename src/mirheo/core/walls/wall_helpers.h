@@ -24,6 +24,45 @@ void dumpWalls2XDMF(std::vector<SDFBasedWall*> walls, real3 gridH, DomainInfo do
 
 double volumeInsideWalls(std::vector<SDFBasedWall*> walls, DomainInfo domain, MPI_Comm comm, long nSamplesPerRank);
 
+/** \brief Compute the volume inside the union of the walls by integrating their SDF on a uniform grid.
+    \param walls The walls
+    \param domain Domain info
+    \param comm The cartesian communicator of the simulation
+    \param h The grid spacing
+    \return The volume where the SDF is negative, summed over all ranks
+
+    Each cell contributes the fraction of its volume estimated from the SDF at its center.
+    This is exact for planes aligned with the grid and converges quadratically with h,
+    where Monte Carlo sampling converges with the square root of the number of samples.
+ */
+double volumeInsideWallsOnGrid(std::vector<SDFBasedWall*> walls, DomainInfo domain, MPI_Comm comm, real h);
+
+/** \brief Compute a key identifying the geometry of the walls and the given parameters.
+    \param walls The walls
+    \param domain Domain info
+    \param comm The cartesian communicator of the simulation
+    \param parameters Any additional description that must be part of the key
+    \return The key as an hexadecimal string, identical on all ranks
+
+    The geometry is described by the SDF sampled on a coarse grid of each subdomain, so that
+    two sets of walls with the same shape have the same key whatever their kind.
+ */
+std::string computeWallsGeometryKey(std::vector<SDFBasedWall*> walls, DomainInfo domain, MPI_Comm comm,
+                                    const std::string& parameters);
+
+/** \brief Dump the local frozen particles to a binary file.
+    \param pv The frozen particles
+    \param filename The file to write; it is meant to be used by the same rank only
+ */
+void saveFrozenParticles(ParticleVector *pv, const std::string& filename);
+
+/** \brief Read the local frozen particles from a file written by saveFrozenParticles().
+    \param pv The particles to set
+    \param filename The file to read
+    \return \c true on success, \c false if the file does not exist or cannot be used
+ */
+bool loadFrozenParticles(ParticleVector *pv, const std::string& filename);
+
 } // namespace wall_helpers
 
 } // namespace mirheo
@@ -4,10 +4,12 @@
 #include "common_kernels.h"
 #include "stationary_walls/box.h"
 #include "stationary_walls/cylinder.h"
+#include "stationary_walls/moving_sdf.h"
 #include "stationary_walls/plane.h"
 #include "stationary_walls/sdf.h"
 #include "stationary_walls/sphere.h"
 #include "velocity_field/oscillate.h"
+#include "velocity_field/rigid_motion.h"
 #include "velocity_field/rotate.h"
 #include "velocity_field/translate.h"
 
@@ -106,6 +108,7 @@ void WallWithVelocity<InsideWallChecker, VelocityField>::bounce(cudaStream_t str
                 bounce_kernels::sdfBounce,
                 getNblocks(bc.size(), nthreads), nthreads, 0, stream,
                 view, cl->cellInfo(), bc.devPtr(), bc.size(), dt,
+                this->_getSdfBeforeIntegration(pv), this->maximumPartTravels_[i],
                 this->insideWallChecker_.handler(),
                 velField_.handler(),
                 this->bounceForce_.devPtr());
@@ -119,5 +122,6 @@ template class WallWithVelocity<StationaryWallSphere,   VelocityFieldRotate>;
 template class WallWithVelocity<StationaryWallCylinder, VelocityFieldRotate>;
 template class WallWithVelocity<StationaryWallPlane,    VelocityFieldTranslate>;
 template class WallWithVelocity<StationaryWallPlane,    VelocityFieldOscillate>;
+template class WallWithVelocity<MovingWallSDF,          VelocityFieldRigidMotion>;
 
 } // namespace mirheo
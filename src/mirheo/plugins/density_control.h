@@ -6,6 +6,7 @@
 
 #include <mirheo/core/containers.h>
 #include <mirheo/core/datatypes.h>
+#include <mirheo/core/field/from_function.h>
 #include <mirheo/core/utils/file_wrapper.h>
 
 #include <functional>
@@ -23,7 +24,7 @@ class DensityControlPlugin : public SimulationPlugin
 {
 public:
 
-    using RegionFunc = std::function<real(real3)>;
+    using RegionFunc = FieldBatchFunction; ///< the region scalar field, evaluated on batches of positions
 
     DensityControlPlugin(const MirState *state, std::string name,
                          std::vector<std::string> pvNames, real targetDensity,
@@ -101,7 +101,7 @@ PairPlugin createBerendsenThermostatPlugin(
 }
 
 PairPlugin createDensityControlPlugin(bool computeTask, const MirState *state, std::string name, std::string fname, std::vector<ParticleVector*> pvs,
-                                      real targetDensity, std::function<real(real3)> region, real3 resolution,
+                                      real targetDensity, FieldBatchFunction region, real3 resolution,
                                       real levelLo, real levelHi, real levelSpace, real Kp, real Ki, real Kd,
                                       int tuneEvery, int dumpEvery, int sampleEvery)
 {
@@ -119,7 +119,7 @@ PairPlugin createDensityControlPlugin(bool computeTask, const MirState *state, s
 }
 
 PairPlugin createDensityOutletPlugin(bool computeTask, const MirState *state, std::string name, std::vector<ParticleVector*> pvs,
-                                     real numberDensity, std::function<real(real3)> region, real3 resolution)
+                                     real numberDensity, FieldBatchFunction region, real3 resolution)
 {
     auto simPl = computeTask ?
         std::make_shared<DensityOutletPlugin> (
@@ -139,7 +139,7 @@ PairPlugin createPlaneOutletPlugin(bool computeTask, const MirState *state, std:
 }
 
 PairPlugin createRateOutletPlugin(bool computeTask, const MirState *state, std::string name, std::vector<ParticleVector*> pvs,
-                                  real rate, std::function<real(real3)> region, real3 resolution)
+                                  real rate, FieldBatchFunction region, real3 resolution)
 {
     auto simPl = computeTask ?
         std::make_shared<RateOutletPlugin> (state, name, extractPVNames(pvs), rate, region, resolution)
@@ -362,7 +362,7 @@ PairPlugin createVacfPlugin(bool computeTask, const MirState *state, std::string
 }
 
 PairPlugin createVirialPressurePlugin(bool computeTask, const MirState *state, std::string name, ParticleVector *pv,
-                                      std::function<real(real3)> region, real3 h, int dumpEvery, std::string path)
+                                      FieldBatchFunction region, real3 h, int dumpEvery, std::string path)
 {
     auto simPl  = computeTask ? std::make_shared<VirialPressurePlugin> (state, name, pv->getName(), region, h, dumpEvery)
         : nullptr;
@@ -371,7 +371,7 @@ PairPlugin createVirialPressurePlugin(bool computeTask, const MirState *state, s
 }
 
 PairPlugin createVelocityInletPlugin(bool computeTask, const MirState *state, std::string name, ParticleVector *pv,
-                                     std::function< real(real3)> implicitSurface,
+                                     FieldBatchFunction implicitSurface,
                                      std::function<real3(real3)> velocityField,
                                      real3 resolution, real numberDensity, real kBT)
 {
@@ -1,6 +1,7 @@
 // Copyright 2020 ETH Zurich. All Rights Reserved.
 #pragma once
 
+#include <mirheo/core/field/from_function.h>
 #include <mirheo/core/plugins.h>
 #include <mirheo/core/pvs/object_vector.h>
 #include <mirheo/core/pvs/particle_vector.h>
@@ -37,18 +38,18 @@ PairPlugin createBerendsenThermostatPlugin(
         const std::vector<ParticleVector *> &pv, real tau, real T, real kBT, bool increaseIfLower);
 
 PairPlugin createDensityControlPlugin(bool computeTask, const MirState *state, std::string name, std::string fname, std::vector<ParticleVector*> pvs,
-                                      real targetDensity, std::function<real(real3)> region, real3 resolution,
+                                      real targetDensity, FieldBatchFunction region, real3 resolution,
                                       real levelLo, real levelHi, real levelSpace, real Kp, real Ki, real Kd,
                                       int tuneEvery, int dumpEvery, int sampleEvery);
 
 PairPlugin createDensityOutletPlugin(bool computeTask, const MirState *state, std::string name, std::vector<ParticleVector*> pvs,
-                                     real numberDensity, std::function<real(real3)> region, real3 resolution);
+                                     real numberDensity, FieldBatchFunction region, real3 resolution);
 
 PairPlugin createPlaneOutletPlugin(bool computeTask, const MirState *state, std::string name,
                                    std::vector<ParticleVector*> pvs, real4 plane);
 
 PairPlugin createRateOutletPlugin(bool computeTask, const MirState *state, std::string name, std::vector<ParticleVector*> pvs,
-                                  real rate, std::function<real(real3)> region, real3 resolution);
+                                  real rate, FieldBatchFunction region, real3 resolution);
 
 PairPlugin createDumpAveragePlugin(bool computeTask, const MirState *state, std::string name, std::vector<ParticleVector*> pvs,
                                    int sampleEvery, int dumpEvery, real3 binSize, std::vector<std::string> channelNames, std::string path);
@@ -117,10 +118,10 @@ PairPlugin createVacfPlugin(bool computeTask, const MirState *state, std::string
                             MirState::TimeType startTime, MirState::TimeType endTime, int dumpEvery, std::string path);
 
 PairPlugin createVirialPressurePlugin(bool computeTask, const MirState *state, std::string name, ParticleVector *pv,
-                                      std::function<real(real3)> region, real3 h, int dumpEvery, std::string path);
+                                      FieldBatchFunction region, real3 h, int dumpEvery, std::string path);
 
 PairPlugin createVelocityInletPlugin(bool computeTask, const MirState *state, std::string name, ParticleVector *pv,
-                                     std::function< real(real3)> implicitSurface,
+                                     FieldBatchFunction implicitSurface,
                                      std::function<real3(real3)> velocityField,
                                      real3 resolution, real numberDensity, real kBT);
 
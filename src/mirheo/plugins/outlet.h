@@ -2,6 +2,7 @@
 #pragma once
 
 #include <mirheo/core/containers.h>
+#include <mirheo/core/field/from_function.h>
 #include <mirheo/core/plugins.h>
 
 #include <functional>
@@ -56,7 +57,7 @@ private:
 class RegionOutletPlugin : public OutletPlugin
 {
 public:
-    using RegionFunc = std::function<real(real3)>;
+    using RegionFunc = FieldBatchFunction; ///< the region scalar field, evaluated on batches of positions
 
     RegionOutletPlugin(const MirState *state, std::string name, std::vector<std::string> pvNames,
                        RegionFunc region, real3 resolution);
@@ -123,6 +123,17 @@ __global__ void restrictRigidMotion(ROVviewWithOldMotion view, real3 targetVeloc
 
 #undef OMEGA_PER_DIM
 
+    // fully prescribed rotation: rotate exactly by the angle |omega| dt, which may exceed pi for fast rotations
+    if (targetOmega.x != PinObjectPlugin::Unrestricted &&
+        targetOmega.y != PinObjectPlugin::Unrestricted &&
+        targetOmega.z != PinObjectPlugin::Unrestricted)
+    {
+        const auto omega = make_rigidReal3(targetOmega);
+        const RigidReal omegaNorm = length(omega);
+        if (omegaNorm > 0)
+            motion.q = RigiQuaternion::createFromRotation(omegaNorm * dt, omega / omegaNorm) * old_motion.q;
+    }
+
     motion.q.normalize();
     view.motions[objId] = motion;
 }
@@ -150,30 +150,32 @@ void VelocityInletPlugin::setup(Simulation *simulation, const MPI_Comm& comm, co
 
     pv_ = simulation->getPVbyNameOrDie(pvName_);
 
-    std::vector<marching_cubes::Triangle> triangles;
-    marching_cubes::computeTriangles(getState()->domain, resolution_, implicitSurface_, triangles);
+    marching_cubes::IndexedMesh mesh;
+    marching_cubes::computeIndexedMesh(getState()->domain, resolution_, implicitSurface_, mesh);
 
-    const int nTriangles = triangles.size();
+    const int nTriangles = mesh.triangles.size();
+
+    // the velocity is evaluated once per vertex, not once per triangle corner
+    std::vector<real3> vertexVelocities(mesh.vertices.size());
+    for (size_t i = 0; i < mesh.vertices.size(); ++i)
+        vertexVelocities[i] = velocityField_(getState()->domain.local2global(mesh.vertices[i]));
 
     surfaceTriangles_.resize_anew(nTriangles * 3);
     surfaceVelocity_ .resize_anew(nTriangles * 3);
 
     {
         size_t i = 0;
-        for (const auto& t : triangles)
+        for (const auto& t : mesh.triangles)
         {
-            surfaceTriangles_[i++] = t.a;
-            surfaceTriangles_[i++] = t.b;
-            surfaceTriangles_[i++] = t.c;
+            for (int vid : {t.x, t.y, t.z})
+            {
+                surfaceTriangles_[i] = mesh.vertices[vid];
+                surfaceVelocity_ [i] = vertexVelocities[vid];
+                ++i;
+            }
         }
     }
 
-    for (size_t i = 0; i < surfaceTriangles_.size(); ++i)
-    {
-        const real3 r = getState()->domain.local2global(surfaceTriangles_[i]);
-        surfaceVelocity_[i] = velocityField_(r);
-    }
-
     surfaceTriangles_.uploadToDevice(defaultStream);
     surfaceVelocity_ .uploadToDevice(defaultStream);
 
@@ -2,6 +2,7 @@
 #pragma once
 
 #include <mirheo/core/containers.h>
+#include <mirheo/core/field/from_function.h>
 #include <mirheo/core/plugins.h>
 
 #include <functional>
@@ -16,7 +17,7 @@ class VelocityInletPlugin : public SimulationPlugin
 {
 public:
 
-    using ImplicitSurfaceFunc = std::function<real(real3)>;
+    using ImplicitSurfaceFunc = FieldBatchFunction;
     using VelocityFieldFunc = std::function<real3(real3)>;
 
     VelocityInletPlugin(const MirState *state, std::string name, std::string pvName,
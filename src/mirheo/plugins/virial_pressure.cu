@@ -41,7 +41,7 @@ __global__ void totalPressure(PVview view, const Stress *stress, FieldDeviceHand
 } // namespace virial_pressure_kernels
 
 VirialPressurePlugin::VirialPressurePlugin(const MirState *state, std::string name, std::string pvName,
-                                           FieldFunction func, real3 h, int dumpEvery) :
+                                           FieldBatchFunction func, real3 h, int dumpEvery) :
     SimulationPlugin(state, name),
     pvName_(pvName),
     dumpEvery_(dumpEvery),
@@ -20,7 +20,7 @@ class VirialPressurePlugin : public SimulationPlugin
 {
 public:
     VirialPressurePlugin(const MirState *state, std::string name, std::string pvName,
-                         FieldFunction func, real3 h, int dumpEvery);
+                         FieldBatchFunction func, real3 h, int dumpEvery);
 
     ~VirialPressurePlugin();
 
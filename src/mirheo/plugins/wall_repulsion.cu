@@ -8,17 +8,11 @@
 #include <mirheo/core/utils/cuda_common.h>
 #include <mirheo/core/utils/cuda_rng.h>
 #include <mirheo/core/utils/kernel_launch.h>
-#include <mirheo/core/walls/simple_stationary_wall.h>
+#include <mirheo/core/walls/interface.h>
 
 namespace mirheo
 {
 
-namespace channel_names
-{
-static const std::string      sdf =      "sdf";
-static const std::string grad_sdf = "grad_sdf";
-} // namespace channel_names
-
 namespace wall_repulsion_plugin_kernels
 {
 __global__ void forceFromSDF(PVview view, const real *sdfs, const real3 *gradients, real C, real h, real maxForce)
@@ -60,9 +54,6 @@ void WallRepulsionPlugin::setup(Simulation* simulation, const MPI_Comm& comm, co
     pv_ = simulation->getPVbyNameOrDie(pvName_);
     wall_ = dynamic_cast<SDFBasedWall*>(simulation->getWallByNameOrDie(wallName_));
 
-    pv_->requireDataPerParticle<real>(channel_names::sdf, DataManager::PersistenceMode::None);
-    pv_->requireDataPerParticle<real3>(channel_names::grad_sdf, DataManager::PersistenceMode::None);
-
     if (wall_ == nullptr)
         die("Wall repulsion plugin '%s' can only work with SDF-based walls, but got wall '%s'",
             getCName(), wallName_.c_str());
@@ -75,18 +66,16 @@ void WallRepulsionPlugin::beforeIntegration(cudaStream_t stream)
 {
     PVview view(pv_, pv_->local());
 
-    auto sdfs      = pv_->local()->dataPerParticle.getData<real>(channel_names::sdf);
-    auto gradients = pv_->local()->dataPerParticle.getData<real3>(channel_names::grad_sdf);
-
     const real gradientThreshold = h_ + 0.1_r;
 
-    wall_->sdfPerParticle(pv_->local(), sdfs, gradients, gradientThreshold, stream);
+    // shared with the other users of the wall, e.g. its bounce
+    const auto sdf = wall_->getCachedSdfPerParticle(pv_, gradientThreshold, stream);
 
     const int nthreads = 128;
     SAFE_KERNEL_LAUNCH(
          wall_repulsion_plugin_kernels::forceFromSDF,
          getNblocks(view.size, nthreads), nthreads, 0, stream,
-         view, sdfs->devPtr(), gradients->devPtr(), C_, h_, maxForce_ );
+         view, sdf.sdfs, sdf.gradients, C_, h_, maxForce_ );
 }
 
 void WallRepulsionPlugin::saveSnapshotAndRegister(Saver& saver)
@@ -0,0 +1,91 @@
+#!/usr/bin/env python
+
+import numpy as np
+import mirheo as mir
+
+ranks  = (1, 1, 1)
+domain = (8., 8., 8.)
+
+# the ellipsoid rotates by omega * dt = 3.5 > pi radians in one time step
+dt    = 0.01
+omega = 350.0
+axes  = (0.6, 0.25, 0.25)
+
+u = mir.Mirheo(ranks, domain, dt, debug_level=3, log_filename='log', no_splash=True)
+
+center = 0.5 * np.array(domain)
+
+def ellipsoid_value(r, e):
+    # < 1 inside the ellipsoid of main axis e centered at the origin
+    x = np.dot(r, e)
+    rr = np.sum(r**2, axis=1)
+    return x**2 / axes[0]**2 + (rr - x**2) / axes[1]**2
+
+def lattice(h, L):
+    g = np.arange(-L, L + 0.5 * h, h)
+    x, y, z = np.meshgrid(g, g, g, indexing='ij')
+    return np.stack([x.flatten(), y.flatten(), z.flatten()], axis=1)
+
+ex = np.array([1.0, 0.0, 0.0])
+
+coords = lattice(0.05, axes[0])
+coords = coords[ellipsoid_value(coords, ex) < 1]
+coords -= np.mean(coords, axis=0)
+
+# solvent at rest around the ellipsoid; only the bounced particles gain a velocity
+pos = lattice(0.1, 1.0)
+pos = pos[ellipsoid_value(pos, ex) > 1.1]
+
+# the solid of revolution swept by a rotation of more than pi about z
+in_swept = (pos[:,0]**2 + pos[:,1]**2) / axes[0]**2 + pos[:,2]**2 / axes[2]**2 < 0.9
+num_swept = np.sum(in_swept)
+
+pv_sol = mir.ParticleVectors.ParticleVector('pv', mass = 1)
+ic_sol = mir.InitialConditions.FromArray(pos=(pos + center).tolist(), vel=np.zeros_like(pos).tolist())
+vv_sol = mir.Integrators.VelocityVerlet('vv')
+u.registerParticleVector(pv_sol, ic_sol)
+u.registerIntegrator(vv_sol)
+u.setIntegrator(vv_sol, pv_sol)
+
+com_q = [[center[0], center[1], center[2],   1., 0, 0, 0]]
+pv_rig = mir.ParticleVectors.RigidEllipsoidVector('ellipsoid', mass=1, object_size=len(coords), semi_axes=axes)
+ic_rig = mir.InitialConditions.Rigid(com_q=com_q, coords=coords.tolist())
+vv_rig = mir.Integrators.RigidVelocityVerlet("ellvv")
+u.registerParticleVector(pv_rig, ic_rig)
+u.registerIntegrator(vv_rig)
+u.setIntegrator(vv_rig, pv_rig)
+
+u.registerPlugins(mir.Plugins.createPinObject("pin", pv_rig, dump_every=1000, path="pin/",
+                                              velocity=[0, 0, 0], angular_velocity=[0, 0, omega]))
+
+bb = mir.Bouncers.Ellipsoid("bouncer", "bounce_back")
+u.registerBouncer(bb)
+u.setBouncer(bb, pv_rig, pv_sol)
+
+u.run(1)
+
+if pv_sol is not None:
+    rig = np.array(pv_rig.getCoordinates())
+    com = np.mean(rig, axis=0)
+    # main axis of the ellipsoid from the largest principal direction of its particles
+    w, v = np.linalg.eigh(np.cov((rig - com).T))
+    e = v[:, np.argmax(w)]
+
+    r = np.array(pv_sol.getCoordinates()) - com
+    vel = np.array(pv_sol.getVelocities())
+    moved = np.linalg.norm(vel, axis=1) > 0
+    Lz = np.sum(r[:,0] * vel[:,1] - r[:,1] * vel[:,0])
+
+    no_inside = np.all(ellipsoid_value(r, e) > 0.98)
+    all_swept = np.sum(moved) >= num_swept
+
+    np.savetxt("spin.txt", [no_inside, all_swept, Lz > 0], fmt="%d")
+
+del u
+
+# nTEST: bounce.rigid.fast_spin
+# set -eu
+# cd bounce/rigid
+# rm -rf pin spin.txt spin.out.txt
+# mir.run --runargs "-n 2" ./fast_spin.py
+# mv spin.txt spin.out.txt
@@ -5,6 +5,7 @@ import mirheo as mir
 
 parser = argparse.ArgumentParser()
 parser.add_argument("--non_primary", action='store_true', default=False)
+parser.add_argument("--reset_forces", action='store_true', default=False)
 args = parser.parse_args()
 
 dt = 0.001
@@ -30,7 +31,7 @@ dpd = mir.Interactions.Pairwise('dpd', rc, kind="DPD", a=10.0, gamma=10.0, kBT=1
 u.registerInteraction(dpd)
 u.setInteraction(dpd, pv, pv)
 
-vv = mir.Integrators.VelocityVerlet('vv')
+vv = mir.Integrators.VelocityVerlet('vv', reset_forces=args.reset_forces)
 u.registerIntegrator(vv)
 u.setIntegrator(vv, pv)
 
@@ -51,3 +52,15 @@ u.run(501)
 # rm -rf stats.csv
 # mir.run --runargs "-n 2" ./rest.py --non_primary > /dev/null
 # mir.post ../tools/dump_csv.py stats.csv time kBT vx vy vz --header > stats.out.txt
+
+# nTEST: clist.primary.reset_forces
+# cd clist
+# rm -rf stats.csv
+# mir.run --runargs "-n 2" ./rest.py --reset_forces > /dev/null
+# mir.post ../tools/dump_csv.py stats.csv time kBT vx vy vz --header > stats.out.txt
+
+# nTEST: clist.nonPrimary.reset_forces
+# cd clist
+# rm -rf stats.csv
+# mir.run --runargs "-n 2" ./rest.py --non_primary --reset_forces > /dev/null
+# mir.post ../tools/dump_csv.py stats.csv time kBT vx vy vz --header > stats.out.txt
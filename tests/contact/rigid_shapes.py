@@ -0,0 +1,77 @@
+#!/usr/bin/env python
+
+import numpy as np
+import mirheo as mir
+
+ranks  = (1, 1, 1)
+domain = (12., 8., 8.)
+
+dt = 1e-3
+R  = 1.0
+
+k_contact = 100.0
+contact_distance = 0.1
+overlap = 0.05
+
+u = mir.Mirheo(ranks, domain, dt, debug_level=3, log_filename='log', no_splash=True)
+
+# frozen particles of a sphere; they only carry the motion of the objects
+g = np.arange(-R, R + 0.01, 0.25)
+x, y, z = np.meshgrid(g, g, g, indexing='ij')
+coords = np.stack([x.flatten(), y.flatten(), z.flatten()], axis=1)
+coords = coords[np.sum(coords**2, axis=1) < R**2]
+coords -= np.mean(coords, axis=0)
+num_per_obj = len(coords)
+
+d = 2 * R - overlap
+com_q = [[ 3.0,           2.0, 4.0,   1., 0, 0, 0], # overlapping pair
+         [ 3.0 + d,       2.0, 4.0,   1., 0, 0, 0],
+         [11.5,           6.0, 4.0,   1., 0, 0, 0], # overlapping pair across the periodic boundary
+         [11.5 + d - 12., 6.0, 4.0,   1., 0, 0, 0],
+         [ 6.0,           6.0, 4.0,   1., 0, 0, 0], # pair further apart than the contact distance
+         [ 6.0 + 2.5,     6.0, 4.0,   1., 0, 0, 0]]
+
+pv = mir.ParticleVectors.RigidEllipsoidVector('spheres', mass=1, object_size=num_per_obj, semi_axes=(R, R, R))
+ic = mir.InitialConditions.Rigid(com_q=com_q, coords=coords.tolist())
+vv = mir.Integrators.RigidVelocityVerlet("vv")
+u.registerParticleVector(pv, ic)
+u.registerIntegrator(vv)
+u.setIntegrator(vv, pv)
+
+contact = mir.Interactions.RigidContact("contact", k_contact=k_contact, contact_distance=contact_distance)
+u.registerInteraction(contact)
+u.setInteraction(contact, pv, pv)
+
+u.run(1)
+
+if pv is not None:
+    pos = np.array(pv.getCoordinates()).reshape(-1, num_per_obj, 3)
+    vel = np.array(pv.getVelocities()).reshape(-1, num_per_obj, 3)
+
+    com = np.mean(pos, axis=1) % np.array(domain)
+    v = np.mean(vel, axis=1)
+
+    # repulsion k (h_c - h) along the line of centers, integrated over one step
+    dv = k_contact * (contact_distance + overlap) * dt / num_per_obj
+
+    def velocity_of(x, y):
+        i = np.argmin(np.abs(com[:,0] - x) + np.abs(com[:,1] - y))
+        return v[i]
+
+    def pushed(x, y, sign):
+        vi = velocity_of(x, y)
+        return abs(vi[0] - sign * dv) < 1e-2 * dv and np.max(np.abs(vi[1:])) < 1e-2 * dv
+
+    checks = [pushed(3.0, 2.0, -1) and pushed(3.0 + d, 2.0, +1),
+              pushed(11.5, 6.0, -1) and pushed(11.5 + d - 12., 6.0, +1),
+              np.all(velocity_of(6.0, 6.0) == 0) and np.all(velocity_of(8.5, 6.0) == 0)]
+
+    np.savetxt("contact.txt", checks, fmt="%d")
+
+del u
+
+# nTEST: contact.rigid.shapes
+# cd contact
+# rm -rf contact.txt contact.out.txt
+# mir.run --runargs "-n 2" ./rigid_shapes.py
+# mv contact.txt contact.out.txt
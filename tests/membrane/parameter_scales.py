@@ -0,0 +1,58 @@
+#!/usr/bin/env python
+
+import numpy as np
+import mirheo as mir
+import sys
+
+sys.path.append("..")
+from common.membrane_params import lina_parameters
+
+dt = 0.001
+
+ranks  = (1, 1, 1)
+domain = (12, 8, 10)
+
+u = mir.Mirheo(ranks, domain, dt, debug_level=3, log_filename='log', no_splash=True)
+
+mesh_rbc = mir.ParticleVectors.MembraneMesh("rbc_mesh.off")
+
+# identical membranes with different force scales (shear, bending, constraints, viscosity)
+com_q = [[2.0,  4.0, 5.0,   1.0, 0.0, 0.0, 0.0],
+         [6.0,  4.0, 5.0,   1.0, 0.0, 0.0, 0.0],
+         [10.0, 4.0, 5.0,   1.0, 0.0, 0.0, 0.0]]
+scales = [[1.0, 1.0, 1.0, 1.0],
+          [2.0, 2.0, 2.0, 2.0],
+          [0.0, 0.0, 0.0, 0.0]]
+
+pv_rbc = mir.ParticleVectors.MembraneVector("rbc", mass=1.0, mesh=mesh_rbc)
+ic_rbc = mir.InitialConditions.MembraneWithParameterScales(com_q, scales)
+u.registerParticleVector(pv_rbc, ic_rbc)
+
+prm_rbc = lina_parameters(1.0)
+int_rbc = mir.Interactions.MembraneForces("int_rbc", "wlc", "Kantor", **prm_rbc, stress_free=False)
+u.registerInteraction(int_rbc)
+u.setInteraction(int_rbc, pv_rbc, pv_rbc)
+
+# no integrator: the forces are computed on the initial shapes
+u.run(1)
+
+if pv_rbc is not None:
+    nv = len(mesh_rbc.getVertices())
+    pos = np.array(pv_rbc.getCoordinates()).reshape(-1, nv, 3)
+    frc = np.array(pv_rbc.getForces()).reshape(-1, nv, 3)
+
+    order = np.argsort(pos[:,:,0].mean(axis=1))
+    f1, f2, f0 = frc[order]
+
+    fmax = np.max(np.abs(f1))
+    err_double = np.max(np.abs(f2 - 2 * f1)) / fmax
+    err_zero   = np.max(np.abs(f0)) / fmax
+
+    np.savetxt("scales.txt", [fmax > 0, err_double < 1e-4, err_zero < 1e-4], fmt="%d")
+
+
+# nTEST: membrane.parameter_scales
+# cd membrane
+# cp ../../data/rbc_mesh.off .
+# mir.run --runargs "-n 2" ./parameter_scales.py
+# mv scales.txt scales.out.txt
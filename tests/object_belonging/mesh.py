@@ -1,8 +1,13 @@
 #!/usr/bin/env python
 
+import argparse
 import mirheo as mir
 import numpy as np
 
+parser = argparse.ArgumentParser()
+parser.add_argument("--checker", choices=["rays", "grid", "winding_number"], default="rays")
+args = parser.parse_args()
+
 density = 4
 ranks  = (1, 1, 1)
 domain = (12, 8, 10)
@@ -19,7 +24,12 @@ pv_outer = mir.ParticleVectors.ParticleVector('pv_outer', mass = 1.0)
 ic_outer = mir.InitialConditions.Uniform(density)
 u.registerParticleVector(pv_outer, ic_outer)
 
-inner_checker = mir.BelongingCheckers.Mesh("inner_solvent_checker")
+if args.checker == "grid":
+    inner_checker = mir.BelongingCheckers.MeshGrid("inner_solvent_checker", grid_size=16)
+elif args.checker == "winding_number":
+    inner_checker = mir.BelongingCheckers.MeshWindingNumber("inner_solvent_checker")
+else:
+    inner_checker = mir.BelongingCheckers.Mesh("inner_solvent_checker")
 u.registerObjectBelongingChecker(inner_checker, pv_rbc)
 
 pv_inner = u.applyObjectBelongingChecker(inner_checker, pv_outer, correct_every = 0, inside = "pv_inner")
@@ -36,3 +46,26 @@ if u.isMasterTask():
 # cp ../../data/rbc_mesh.off .
 # mir.run --runargs "-n 1" ./mesh.py
 # cat pos.inner.txt | LC_ALL=en_US.utf8 sort > belonging.out.txt
+
+# the grid and winding number checkers are compared to the ray checker on the same particles;
+# a few particles within the tolerance of the surface may be classified differently
+
+# TEST: object_belonging.mesh_grid
+# cd object_belonging
+# rm -rf pos.inner.txt pos.rays.txt pos.grid.txt belonging.out.txt
+# cp ../../data/rbc_mesh.off .
+# mir.run --runargs "-n 1" ./mesh.py
+# cat pos.inner.txt | LC_ALL=en_US.utf8 sort > pos.rays.txt
+# mir.run --runargs "-n 1" ./mesh.py --checker grid
+# cat pos.inner.txt | LC_ALL=en_US.utf8 sort > pos.grid.txt
+# n=`LC_ALL=en_US.utf8 comm -3 pos.rays.txt pos.grid.txt | wc -l`; [ -s pos.rays.txt ] && [ $n -le 5 ] && echo 1 > belonging.out.txt || echo 0 > belonging.out.txt
+
+# TEST: object_belonging.mesh_winding_number
+# cd object_belonging
+# rm -rf pos.inner.txt pos.rays.txt pos.winding.txt belonging.out.txt
+# cp ../../data/rbc_mesh.off .
+# mir.run --runargs "-n 1" ./mesh.py
+# cat pos.inner.txt | LC_ALL=en_US.utf8 sort > pos.rays.txt
+# mir.run --runargs "-n 1" ./mesh.py --checker winding_number
+# cat pos.inner.txt | LC_ALL=en_US.utf8 sort > pos.winding.txt
+# n=`LC_ALL=en_US.utf8 comm -3 pos.rays.txt pos.winding.txt | wc -l`; [ -s pos.rays.txt ] && [ $n -le 1 ] && echo 1 > belonging.out.txt || echo 0 > belonging.out.txt
@@ -5,6 +5,7 @@ import argparse
 
 parser = argparse.ArgumentParser()
 parser.add_argument("--max_density", type=float, required=True)
+parser.add_argument("--vectorized", action='store_true', default=False)
 args = parser.parse_args()
 
 dt  = 0.001
@@ -27,7 +28,13 @@ resolution = (h, h, h)
 def outlet_region(r):
     return -r[0] + (domain[0] - 1.0)
 
-u.registerPlugins(mir.Plugins.createDensityOutlet('outlet', [pv], args.max_density, outlet_region, resolution))
+def outlet_region_vectorized(r):
+    return -r[:,0] + (domain[0] - 1.0)
+
+if args.vectorized:
+    u.registerPlugins(mir.Plugins.createDensityOutlet('outlet', [pv], args.max_density, outlet_region_vectorized, resolution, vectorized=True))
+else:
+    u.registerPlugins(mir.Plugins.createDensityOutlet('outlet', [pv], args.max_density, outlet_region, resolution))
 
 dump_every   = 100
 sample_every = 10
@@ -44,3 +51,9 @@ del (u)
 # rm -rf h5
 # mir.run --runargs "-n 2" ./density_outlet.py --max_density 0.0
 # mir.avgh5 yz number_densities h5/solvent-00009.h5 > profile.out.txt
+
+# nTEST: plugins.density_outlet.killAll.vectorized
+# cd plugins
+# rm -rf h5
+# mir.run --runargs "-n 2" ./density_outlet.py --max_density 0.0 --vectorized
+# mir.avgh5 yz number_densities h5/solvent-00009.h5 > profile.out.txt
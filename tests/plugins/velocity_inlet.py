@@ -6,6 +6,7 @@ import argparse
 
 parser = argparse.ArgumentParser()
 parser.add_argument("--geometry", choices=["sphere", 'cylinder', 'plane'])
+parser.add_argument("--vectorized", action='store_true', default=False)
 args = parser.parse_args()
 
 dt  = 0.001
@@ -41,6 +42,9 @@ if args.geometry == "sphere":
                     (r[2] - center[2])**2)
         return R - radius
 
+    def inlet_surface_vectorized(r):
+        return np.linalg.norm(r - np.array(center), axis=1) - radius
+
     def inlet_velocity(r):
         factor = vel / radius
         return (factor * (r[0] - center[0]),
@@ -78,7 +82,11 @@ elif args.geometry == "plane":
 else:
     exit(1)
     
-u.registerPlugins(mir.Plugins.createVelocityInlet('inlet', pv, inlet_surface, inlet_velocity, resolution, inlet_density, kBT))
+if args.vectorized:
+    u.registerPlugins(mir.Plugins.createVelocityInlet('inlet', pv, inlet_surface_vectorized, inlet_velocity, resolution, inlet_density, kBT,
+                                                      vectorized=True))
+else:
+    u.registerPlugins(mir.Plugins.createVelocityInlet('inlet', pv, inlet_surface, inlet_velocity, resolution, inlet_density, kBT))
 
 sample_every = 10
 dump_every = 1000
@@ -95,6 +103,12 @@ del (u)
 # mir.run --runargs "-n 2" ./velocity_inlet.py --geometry sphere  > /dev/null
 # mir.avgh5 yz number_densities h5/solvent-0000*.h5 > profile.out.txt
 
+# nTEST: plugins.velocity_inlet.sphere.vectorized
+# cd plugins
+# rm -rf h5
+# mir.run --runargs "-n 2" ./velocity_inlet.py --geometry sphere --vectorized > /dev/null
+# mir.avgh5 yz number_densities h5/solvent-0000*.h5 > profile.out.txt
+
 # nTEST: plugins.velocity_inlet.cylinder
 # cd plugins
 # rm -rf h5
@@ -0,0 +1,81 @@
+#!/usr/bin/env python
+
+import numpy as np
+import mirheo as mir
+
+ranks  = (1, 1, 1)
+domain = (12, 8, 8)
+
+dt = 1e-3
+L = 5.0
+num_segments = 40
+
+u = mir.Mirheo(ranks, domain, dt, debug_level=3, log_filename='log', no_splash=True)
+
+# identical rods with different force scales (bounds, bending, twist)
+com_q = [[ 2.0, 4.0, 4.0,    1.0, 0.0, 0.0, 0.0],
+         [ 6.0, 4.0, 4.0,    1.0, 0.0, 0.0, 0.0],
+         [10.0, 4.0, 4.0,    1.0, 0.0, 0.0, 0.0]]
+scales = [[1.0, 1.0, 1.0],
+          [2.0, 2.0, 2.0],
+          [0.0, 0.0, 0.0]]
+
+a0     = 0.05
+tau0   = [0.2, 0.0]
+kappa0 = [(0.0, 0.0), (0.0, 0.1)]
+E0     = [0.0, 0.0]
+
+def center_line(s):
+    # slightly curved so that bending and smoothing forces do not vanish
+    return (0.2 * np.sin(np.pi * s), 0, (s-0.5) * L)
+
+def torsion(s):
+    return tau0[0] if s < 0.4 else tau0[1]
+
+h = 1.0 / num_segments
+l0 = np.linalg.norm(np.array(center_line(h)) - np.array(center_line(0)))
+
+rv = mir.ParticleVectors.RodVector('rod', mass=1, num_segments = num_segments)
+ic = mir.InitialConditions.RodWithParameterScales(com_q, scales, center_line, torsion, a0)
+u.registerParticleVector(rv, ic)
+
+prms = {
+    "a0" : a0,
+    "l0" : 0.9 * l0,
+    "k_s_center" : 1000.0,
+    "k_s_frame"  : 1000.0,
+    "k_bending"  : (30.0, 0.0, 30.0),
+    "k_twist"    : 30.0,
+    "k_smoothing": 10.0,
+    "tau0"       : tau0,
+    "kappa0"     : kappa0,
+    "E0"         : E0
+}
+
+int_rod = mir.Interactions.RodForces("rod_forces", "smoothing", **prms);
+u.registerInteraction(int_rod)
+u.setInteraction(int_rod, rv, rv)
+
+# no integrator: the forces are computed on the initial shapes
+u.run(1)
+
+if rv is not None:
+    nper = 5 * num_segments + 1
+    pos = np.array(rv.getCoordinates()).reshape(-1, nper, 3)
+    frc = np.array(rv.getForces()).reshape(-1, nper, 3)
+
+    order = np.argsort(pos[:,:,0].mean(axis=1))
+    f1, f2, f0 = frc[order]
+
+    fmax = np.max(np.abs(f1))
+    err_double = np.max(np.abs(f2 - 2 * f1)) / fmax
+    err_zero   = np.max(np.abs(f0)) / fmax
+
+    np.savetxt("scales.txt", [fmax > 0, err_double < 1e-4, err_zero < 1e-4], fmt="%d")
+
+del u
+
+# nTEST: rod.parameter_scales
+# cd rod
+# mir.run --runargs "-n 2" ./parameter_scales.py
+# mv scales.txt scales.out.txt
@@ -0,0 +1,88 @@
+#!/usr/bin/env python
+
+import argparse
+import numpy as np
+import mirheo as mir
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--no_cache", action="store_true", default=False)
+args = parser.parse_args()
+
+dt = 0.001
+
+ranks  = (1, 1, 1)
+domain = (8, 8, 8)
+force  = (2.0, 0, 0)
+
+density = 4
+z_lo, z_hi = 1.0, domain[2] - 1.0
+
+u = mir.Mirheo(ranks, domain, dt, debug_level=3, log_filename='log', no_splash=True)
+
+pv = mir.ParticleVectors.ParticleVector('pv', mass = 1)
+ic = mir.InitialConditions.Uniform(number_density=density)
+u.registerParticleVector(pv=pv, ic=ic)
+
+dpd = mir.Interactions.Pairwise('dpd', rc=1.0, kind="DPD", a=10.0, gamma=20.0, kBT=1.0, power=0.5)
+u.registerInteraction(dpd)
+
+# the walls are checked regularly: the check reuses the SDF values cached by the wall
+plate_lo = mir.Walls.Plane("plate_lo", (0, 0, -1), (0, 0, z_lo))
+plate_hi = mir.Walls.Plane("plate_hi", (0, 0,  1), (0, 0, z_hi))
+u.registerWall(plate_lo, 100)
+u.registerWall(plate_hi, 100)
+
+# the reference run evaluates the SDF of all the particles of the boundary cells in the bounce
+if args.no_cache:
+    plate_lo.useSdfCacheInBounce(False)
+    plate_hi.useSdfCacheInBounce(False)
+
+vv = mir.Integrators.VelocityVerlet("vv")
+frozen = u.makeFrozenWallParticles(pvName="plates", walls=[plate_lo, plate_hi], interactions=[dpd], integrator=vv,
+                                   number_density=density, nsteps=500)
+
+u.setWall(plate_lo, pv)
+u.setWall(plate_hi, pv)
+
+for p in (pv, frozen):
+    u.setInteraction(dpd, p, pv)
+
+vv_dp = mir.Integrators.VelocityVerlet_withConstForce("vv_dp", force)
+u.registerIntegrator(vv_dp)
+u.setIntegrator(vv_dp, pv)
+
+# the plugins fill the SDF values cached by the walls before the integration; the bounce reuses them
+u.registerPlugins(mir.Plugins.createWallRepulsion("repulsion_lo", pv, plate_lo, C=10, h=0.25, max_force=100))
+u.registerPlugins(mir.Plugins.createWallRepulsion("repulsion_hi", pv, plate_hi, C=10, h=0.25, max_force=100))
+
+u.registerPlugins(mir.Plugins.createDumpAverage('field', [pv], 2, 1000, (1., 1., 0.5), ["velocities"], 'h5/solvent-'))
+
+u.run(3000)
+
+if pv is not None:
+    pos = np.array(pv.getCoordinates())
+    vel = np.array(pv.getVelocities())
+    z = pos[:,2]
+
+    tolerance = 1e-4
+    no_leak = np.all(z > z_lo - tolerance) and np.all(z < z_hi + tolerance)
+
+    # the bounced solvent develops a Poiseuille-like profile
+    center = np.abs(z - 0.5 * (z_lo + z_hi)) < 1.0
+    near_walls = (z < z_lo + 0.5) | (z > z_hi - 0.5)
+    profile = np.mean(vel[center,0]) > 2 * np.mean(vel[near_walls,0]) > 0
+
+    np.savetxt("bounce_cache.nocache.txt" if args.no_cache else "bounce_cache.txt", [no_leak, profile], fmt="%d")
+
+del u
+
+# nTEST: walls.analytic.bounce_cache
+# cd walls/analytic
+# rm -rf h5 bounce_cache.txt bounce_cache.nocache.txt bounce_cache.out.txt profile.cache.txt profile.nocache.txt
+# mir.run --runargs "-n 2" ./bounce_cache.py
+# mir.avgh5 xy velocities h5/solvent-0000[1-2].h5 | awk '{print $1}' > profile.cache.txt
+# rm -rf h5
+# mir.run --runargs "-n 2" ./bounce_cache.py --no_cache
+# mir.avgh5 xy velocities h5/solvent-0000[1-2].h5 | awk '{print $1}' > profile.nocache.txt
+# cat bounce_cache.txt bounce_cache.nocache.txt > bounce_cache.out.txt
+# paste profile.cache.txt profile.nocache.txt | awk '{d = $1 - $2; if (d < 0) d = -d; if (d > dmax) dmax = d; if ($1 > umax) umax = $1} END {print (NR == 16 && umax > 0 && dmax < 0.05 * umax)}' >> bounce_cache.out.txt
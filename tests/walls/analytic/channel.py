@@ -5,7 +5,7 @@ import mirheo as mir
 import argparse
 
 parser = argparse.ArgumentParser()
-parser.add_argument("--type", choices=["squarePipe", 'cylinderPipe'])
+parser.add_argument("--type", choices=["squarePipe", 'cylinderPipe', 'compositeSquarePipe'])
 args = parser.parse_args()
 
 dt = 0.001
@@ -35,6 +35,15 @@ elif args.type == "squarePipe":
     hi = (2*domain[0], domain[1]-rc, domain[2]-rc)
     wall = mir.Walls.Box("squarePipe", low=lo, high=hi, inside=True)
 
+elif args.type == "compositeSquarePipe":
+    # same geometry as squarePipe, carved out of a block; the far sphere is skipped by its bounding box
+    lo = ( -domain[0],           rc,           rc)
+    hi = (2*domain[0], domain[1]-rc, domain[2]-rc)
+    channel = mir.Walls.Box("channel", low=lo, high=hi, inside=False)
+    block   = mir.Walls.Box("block", low=(-100, -100, -100), high=(100, 100, 100), inside=False)
+    sphere  = mir.Walls.Sphere("sphere", center=(50, 50, 50), radius=1.0, inside=False)
+    wall = mir.Walls.Composite("squarePipe", ("difference", ("union", block, sphere), channel))
+
 u.registerWall(wall, 0)
 
 vv = mir.Integrators.VelocityVerlet("vv")
@@ -75,3 +84,9 @@ u.run(7002)
 # rm -rf h5
 # mir.run --runargs "-n 2" ./channel.py --type squarePipe
 # mir.avgh5 xy velocities h5/solvent-0000[4-7].h5 | awk '{print $1}' > profile.out.txt
+
+# nTEST: walls.analytic.channel.composite
+# cd walls/analytic
+# rm -rf h5
+# mir.run --runargs "-n 2" ./channel.py --type compositeSquarePipe
+# mir.avgh5 xy velocities h5/solvent-0000[4-7].h5 | awk '{print $1}' > profile.out.txt
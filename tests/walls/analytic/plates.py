@@ -1,10 +1,16 @@
 #!/usr/bin/env python
 
+import argparse
 import mirheo as mir
 
+parser = argparse.ArgumentParser()
+parser.add_argument("--cache_folder", type=str, default="")
+parser.add_argument("--ranks", type=int, nargs=3, default=(1,1,1))
+args = parser.parse_args()
+
 dt = 0.001
 
-ranks  = (1, 1, 1)
+ranks  = args.ranks
 domain = (8, 16, 8)
 force = (1.0, 0, 0)
 
@@ -25,7 +31,8 @@ u.registerWall(plate_lo, 0)
 u.registerWall(plate_hi, 0)
 
 vv = mir.Integrators.VelocityVerlet("vv")
-frozen = u.makeFrozenWallParticles(pvName="plates", walls=[plate_lo, plate_hi], interactions=[dpd], integrator=vv, number_density=density)
+frozen = u.makeFrozenWallParticles(pvName="plates", walls=[plate_lo, plate_hi], interactions=[dpd], integrator=vv, number_density=density,
+                                   cache_folder=args.cache_folder)
 
 u.setWall(plate_lo, pv)
 u.setWall(plate_hi, pv)
@@ -52,3 +59,21 @@ u.run(7002)
 # rm -rf h5
 # mir.run --runargs "-n 2" ./plates.py
 # mir.avgh5 xy velocities h5/solvent-0000[4-7].h5 | awk '{print $1}' > profile.out.txt
+
+# nTEST: walls.analytic.plates.cached
+# cd walls/analytic
+# rm -rf h5 frozen_cache
+# mir.run --runargs "-n 2" ./plates.py --cache_folder frozen_cache
+# rm -rf h5
+# mir.run --runargs "-n 2" ./plates.py --cache_folder frozen_cache
+# mir.avgh5 xy velocities h5/solvent-0000[4-7].h5 | awk '{print $1}' > profile.out.txt
+
+# nTEST: walls.analytic.plates.mpi
+# cd walls/analytic
+# rm -rf h5 profile.single.txt profile.mpi.txt
+# mir.run --runargs "-n 2" ./plates.py
+# mir.avgh5 xy velocities h5/solvent-0000[4-7].h5 | awk '{print $1}' > profile.single.txt
+# rm -rf h5
+# mir.run --runargs "-n 4" ./plates.py --ranks 2 1 1
+# mir.avgh5 xy velocities h5/solvent-0000[4-7].h5 | awk '{print $1}' > profile.mpi.txt
+# paste profile.single.txt profile.mpi.txt | awk '{d = $1 - $2; if (d < 0) d = -d; if (d > dmax) dmax = d; if ($1 > umax) umax = $1} END {print (NR == 16 && umax > 0 && dmax < 0.05 * umax)}' > profile.out.txt
@@ -8,6 +8,8 @@ parser.add_argument("--sdf_file", type=str)
 parser.add_argument("--domain", type=float, nargs=3)
 parser.add_argument("--vtarget", type=int, default=0.1)
 parser.add_argument("--niters", type=int, default=7002)
+parser.add_argument("--narrow_band_width", type=float, default=0.0)
+parser.add_argument("--interpolation", type=str, default="linear")
 
 args = parser.parse_args()
 
@@ -27,7 +29,7 @@ u.registerParticleVector(pv, ic)
 dpd = mir.Interactions.Pairwise('dpd', rc=1.0, kind="DPD", a=10.0, gamma=50.0, kBT=0.01, power=0.5)
 u.registerInteraction(dpd)
 
-wall = mir.Walls.SDF("sdf", args.sdf_file)
+wall = mir.Walls.SDF("sdf", args.sdf_file, narrow_band_width=args.narrow_band_width, interpolation=args.interpolation)
 u.registerWall(wall, 100)
 u.dumpWalls2XDMF([wall], (0.5, 0.5, 0.5), filename='h5/wall')
 
@@ -82,3 +84,41 @@ u.run(args.niters)
 # domain=`head -n 1 $f`
 # mir.run --runargs "-n 2" ./from_file.py --sdf_file $f --domain $domain --niters=5002 --vtarget=5
 # grep "inside the wall" log_00000.log | awk '{print $6 / 100.0;}' > particles.out.txt
+
+# nTEST: walls.sdf.from_file.narrow_band.profile
+# cd walls/sdf
+# rm -rf h5
+# f=../../../data/pachinko_one_post_sdf.dat
+# domain=`head -n 1 $f`
+# mir.run --runargs "-n 2" ./from_file.py --sdf_file $f --domain $domain --narrow_band_width 4.0
+# mir.avgh5 z velocities h5/solvent-0000[4-7].h5 > profile.out.txt
+
+# nTEST: walls.sdf.from_file.cubic.particles
+# cd walls/sdf
+# rm -rf h5
+# f=../../../data/pachinko_one_post_sdf.dat
+# domain=`head -n 1 $f`
+# mir.run --runargs "-n 2" ./from_file.py --sdf_file $f --domain $domain --niters=5002 --vtarget=5 --interpolation cubic
+# grep "inside the wall" log_00000.log | awk 'BEGIN {n = 0} {if ($6 > n) n = $6;} END {print (NR > 0 && n <= 1)}' > particles.out.txt
+
+# nTEST: walls.sdf.from_file.tiled.sdf
+# cd walls/sdf
+# rm -rf h5 sdf.plain.txt sdf.tiled.txt
+# f=../../../data/pachinko_one_post_sdf.dat
+# domain=`head -n 1 $f`
+# mir.run --runargs "-n 2" ./from_file.py --sdf_file $f --domain $domain --niters=0
+# mir.avgh5 z sdf h5/wall.h5 > sdf.plain.txt
+# rm -rf h5
+# mir.sdf2tiles $f sdf.tiled --tile_size 16
+# mir.run --runargs "-n 2" ./from_file.py --sdf_file sdf.tiled --domain $domain --niters=0
+# mir.avgh5 z sdf h5/wall.h5 > sdf.tiled.txt
+# cmp -s sdf.plain.txt sdf.tiled.txt && echo 1 > sdf.out.txt || echo 0 > sdf.out.txt
+
+# nTEST: walls.sdf.from_file.tiled.zlib.sdf
+# cd walls/sdf
+# rm -rf h5 sdf.plain.txt sdf.tiled.txt
+# f=../../../data/pachinko_one_post_sdf.dat
+# domain=`head -n 1 $f`
+# zlib=`python -m mirheo compile_opt useZlib`
+# if [ "$zlib" = "1" ]; then mir.run --runargs "-n 2" ./from_file.py --sdf_file $f --domain $domain --niters=0; mir.avgh5 z sdf h5/wall.h5 > sdf.plain.txt; rm -rf h5; mir.sdf2tiles $f sdf.tiled --tile_size 16 --compress; mir.run --runargs "-n 2" ./from_file.py --sdf_file sdf.tiled --domain $domain --niters=0; mir.avgh5 z sdf h5/wall.h5 > sdf.tiled.txt; fi
+# if [ "$zlib" = "1" ]; then cmp -s sdf.plain.txt sdf.tiled.txt && echo 1 > sdf.out.txt || echo 0 > sdf.out.txt; else echo "Mirheo compiled without zlib, skipping walls.sdf.from_file.tiled.zlib.sdf" >&2; echo 1 > sdf.out.txt; fi
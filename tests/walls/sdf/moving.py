@@ -0,0 +1,102 @@
+#!/usr/bin/env python
+
+import numpy as np
+import mirheo as mir
+from mpi4py import MPI
+
+dt = 0.001
+
+ranks  = (1, 1, 1)
+domain = (16, 8, 8)
+
+density = 8
+radius = 1.5
+center = np.array([4.0, 4.0, 4.0])
+velocity = (2.0, 0.0, 0.0)
+niters = 3000
+
+sdf_file = "sphere.sdf"
+
+# the sphere is solid: the SDF is positive inside
+if MPI.COMM_WORLD.rank == 0:
+    n = (64, 32, 32)
+    x, y, z = [np.arange(ni) * L / ni for ni, L in zip(n, domain)]
+    Z, Y, X = np.meshgrid(z, y, x, indexing='ij')
+    sdf = radius - np.sqrt((X - center[0])**2 + (Y - center[1])**2 + (Z - center[2])**2)
+    with open(sdf_file, "wb") as f:
+        f.write("{} {} {}\n{} {} {}\n".format(*domain, *n).encode())
+        f.write(sdf.astype(np.float32).tobytes())
+MPI.COMM_WORLD.Barrier()
+
+u = mir.Mirheo(ranks, domain, dt, debug_level=3, log_filename='log', no_splash=True)
+
+pv = mir.ParticleVectors.ParticleVector('pv', mass = 1)
+ic = mir.InitialConditions.Uniform(number_density=density)
+u.registerParticleVector(pv=pv, ic=ic)
+
+dpd = mir.Interactions.Pairwise('dpd', rc=1.0, kind="DPD", a=10.0, gamma=20.0, kBT=0.1, power=0.5)
+u.registerInteraction(dpd)
+
+wall = mir.Walls.MovingSDF("sphere", sdf_file, velocity=velocity, omega=(0, 0, 0), center=center)
+u.registerWall(wall, 100)
+
+vv = mir.Integrators.VelocityVerlet("vv")
+frozen = u.makeFrozenWallParticles(pvName="sphere", walls=[wall], interactions=[dpd], integrator=vv,
+                                   number_density=density, nsteps=500)
+
+# the frozen particles follow the wall; this also clears their static flag
+motion = mir.Integrators.RigidMotion("motion", velocity=velocity, omega=(0, 0, 0), center=center)
+u.registerIntegrator(motion)
+u.setIntegrator(motion, frozen)
+
+u.setWall(wall, pv)
+
+for p in (pv, frozen):
+    u.setInteraction(dpd, p, pv)
+
+u.registerIntegrator(vv)
+u.setIntegrator(vv, pv)
+
+u.run(niters)
+
+def distance_to_center(pos):
+    # the sphere travels several times its radius: the cell lists of the wall must have been refreshed
+    c = center + np.array(velocity) * niters * dt
+    dr = pos - c
+    L = np.array(domain)
+    dr -= L * np.round(dr / L)
+    return np.linalg.norm(dr, axis=1)
+
+ok = []
+
+if pv is not None:
+    pos = np.array(pv.getCoordinates())
+    vel = np.array(pv.getVelocities())
+    r = distance_to_center(pos)
+
+    # the solvent is bounced off the moved sphere
+    ok.append(np.all(r > radius - 0.02))
+
+    # the solvent close to the surface is dragged along with the sphere
+    near = r < radius + 0.3
+    ok.append(np.sum(near) > 0 and np.mean(vel[near,0]) > 0.5 * velocity[0])
+
+if frozen is not None:
+    pos = np.array(frozen.getCoordinates())
+    vel = np.array(frozen.getVelocities())
+    r = distance_to_center(pos)
+
+    # the frozen particles moved with the wall and carry its velocity
+    ok.append(len(r) > 0 and np.all(r < radius + 0.01))
+    ok.append(np.allclose(vel, velocity, atol=1e-4))
+
+if len(ok) > 0:
+    np.savetxt("moving.txt", ok, fmt="%d")
+
+del u
+
+# nTEST: walls.sdf.moving
+# cd walls/sdf
+# rm -rf moving.txt moving.out.txt sphere.sdf
+# mir.run --runargs "-n 2" ./moving.py
+# mv moving.txt moving.out.txt
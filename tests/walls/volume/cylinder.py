@@ -1,8 +1,13 @@
 #!/usr/bin/env python
 
+import argparse
 import numpy as np
 import mirheo as mir
 
+parser = argparse.ArgumentParser()
+parser.add_argument("--h", type = float, default = 0.0)
+args = parser.parse_args()
+
 ranks  = (1, 1, 1)
 domain = (16, 16, 8)
 
@@ -13,7 +18,7 @@ wall = mir.Walls.Cylinder("cylinder", center=center, radius=domain[1]*0.4, axis=
 
 u.registerWall(wall, 1000)
 
-volume = u.computeVolumeInsideWalls([wall], 100000)
+volume = u.computeVolumeInsideWalls([wall], 100000, h=args.h)
 
 np.savetxt("volume.txt", [volume]);
 
@@ -22,3 +27,9 @@ np.savetxt("volume.txt", [volume]);
 # rm -rf volume*txt
 # mir.run --runargs "-n 1" ./cylinder.py
 # cp volume.txt volume.out.txt
+
+# nTEST: walls.volume.cylinder.grid
+# cd walls/volume
+# rm -rf volume*txt
+# mir.run --runargs "-n 1" ./cylinder.py --h 0.25
+# cp volume.txt volume.out.txt
@@ -0,0 +1,82 @@
+#! /usr/bin/env python
+
+import argparse, sys
+import numpy as np
+
+magic = "MIRHEO_TILED_SDF"
+
+def err(s): sys.stderr.write(s)
+
+def read_sdf(fname):
+    try:
+        f = open(fname, "rb")
+    except IOError:
+        err("sdf2tiles: fails to open <%s>\n" % fname)
+        sys.exit(2)
+
+    with f:
+        extents    = f.readline().decode().strip()
+        resolution = f.readline().decode().strip()
+        (nx, ny, nz) = [int(n) for n in resolution.split()]
+        data = np.fromfile(f, dtype=np.float32, count=nx*ny*nz)
+
+    if data.size != nx*ny*nz:
+        err("sdf2tiles: <%s> contains %d values instead of %d\n" % (fname, data.size, nx*ny*nz))
+        sys.exit(1)
+
+    return extents, resolution, data.reshape((nz, ny, nx))
+
+def write_tiles(fname, extents, resolution, data, tile_size, compress):
+    if compress:
+        try:
+            import zlib
+        except ImportError:
+            err("sdf2tiles: --compress needs the python zlib module\n")
+            sys.exit(1)
+
+    (nz, ny, nx) = data.shape
+    (tx, ty, tz) = tile_size
+    ntiles = [(n + t - 1) // t for n, t in zip((nx, ny, nz), (tx, ty, tz))]
+
+    tiles = []
+    for kz in range(ntiles[2]):
+        for ky in range(ntiles[1]):
+            for kx in range(ntiles[0]):
+                tile = data[kz*tz:(kz+1)*tz, ky*ty:(ky+1)*ty, kx*tx:(kx+1)*tx]
+                raw = np.ascontiguousarray(tile, dtype=np.float32).tobytes()
+                tiles.append(zlib.compress(raw) if compress else raw)
+
+    header = "%s\n%s\n%s\n%d %d %d %s\n" % (magic, extents, resolution, tx, ty, tz,
+                                          "zlib" if compress else "none")
+    header = header.encode()
+
+    # index: absolute offset and size in bytes of each tile, x is the fast index
+    index = np.zeros((len(tiles), 2), dtype=np.int64)
+    offset = len(header) + index.nbytes
+    for i, tile in enumerate(tiles):
+        index[i] = (offset, len(tile))
+        offset += len(tile)
+
+    with open(fname, "wb") as f:
+        f.write(header)
+        f.write(index.tobytes())
+        for tile in tiles:
+            f.write(tile)
+
+
+parser = argparse.ArgumentParser(description='Convert a .sdf file to the tiled SDF format, from which each rank reads only the tiles it needs.')
+parser.add_argument('input',  type=str, help='input .sdf file')
+parser.add_argument('output', type=str, help='output tiled SDF file')
+parser.add_argument('--tile_size', type=int, nargs='+', default=[32], help='number of grid nodes of a tile along each direction (one or three values)')
+parser.add_argument('--compress', action='store_true', default=False, help='compress the tiles with zlib')
+args = parser.parse_args()
+
+tile_size = args.tile_size
+if len(tile_size) == 1:
+    tile_size = tile_size * 3
+if len(tile_size) != 3 or min(tile_size) <= 0:
+    err("sdf2tiles: expected one or three positive tile sizes\n")
+    sys.exit(1)
+
+extents, resolution, data = read_sdf(args.input)
+write_tiles(args.output, extents, resolution, data, tile_size, args.compress)
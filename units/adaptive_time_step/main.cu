@@ -0,0 +1,150 @@
+#include <mirheo/core/adaptive_time_step.h>
+#include <mirheo/core/datatypes.h>
+#include <mirheo/core/logger.h>
+#include <mirheo/core/pvs/particle_vector.h>
+#include <mirheo/core/utils/cuda_common.h>
+
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace mirheo;
+
+static const AdaptiveTimeStepParams params {1e-4_r, 1e-2_r, 0.05_r, 1.1_r, 1};
+
+struct TestSystem
+{
+    TestSystem(int n, real mass) :
+        domain{make_real3(8.0_r), make_real3(0.0_r), make_real3(8.0_r)},
+        state(domain, params.dtMin, UnitConversion{}),
+        pv(&state, "pv", mass, n)
+    {
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<real> u(-0.5_r, 0.5_r);
+
+        auto& pos = pv.local()->positions();
+        auto& vel = pv.local()->velocities();
+
+        for (int i = 0; i < n; ++i)
+        {
+            pos[i] = make_real4(u(gen), u(gen), u(gen), 0.0_r);
+            vel[i] = make_real4(u(gen), u(gen), u(gen), 0.0_r);
+        }
+        pos.uploadToDevice(defaultStream);
+        vel.uploadToDevice(defaultStream);
+
+        setForce(-1, make_real3(0.0_r));
+    }
+
+    /// set the force of particle i (all other forces are zero); no force is set if i < 0
+    void setForce(int i, real3 f)
+    {
+        auto& forces = pv.local()->forces();
+        for (auto& frc : forces)
+            frc = Force(make_real3(0.0_r), 0);
+        if (i >= 0)
+            forces[i] = Force(f, 0);
+        forces.uploadToDevice(defaultStream);
+    }
+
+    real maxVelocity()
+    {
+        real vmax = 0.0_r;
+        for (auto v : pv.local()->velocities())
+            vmax = math::max(vmax, length(make_real3(v)));
+        return vmax;
+    }
+
+    real update(AdaptiveTimeStep& controller, real dt)
+    {
+        controller.reduceLocal({&pv}, defaultStream);
+        CUDA_Check( cudaStreamSynchronize(defaultStream) );
+        return controller.computeTimeStep(dt, MPI_COMM_WORLD);
+    }
+
+    DomainInfo domain;
+    MirState state;
+    ParticleVector pv;
+};
+
+static void checkBounds(real dt)
+{
+    ASSERT_GE(dt, params.dtMin);
+    ASSERT_LE(dt, params.dtMax);
+}
+
+/// v dt + a dt^2 = dx when the time step is not limited
+static real expectedDisplacement(real v, real a, real dt)
+{
+    return v * dt + a * dt * dt;
+}
+
+TEST (ADAPTIVE_TIME_STEP, reacts_to_a_force_spike_within_the_bounds)
+{
+    const real mass = 2.0_r;
+    TestSystem sys(1000, mass);
+    AdaptiveTimeStep controller(params);
+
+    const real vmax = sys.maxVelocity();
+    const real dtFree = params.maxDisplacement / vmax;
+    ASSERT_GT(dtFree, params.dtMax); // the free motion alone would allow more than dtMax
+
+    // no force: the time step grows by at most max_growth per update, up to dtMax
+    real dt = params.dtMin;
+    for (int step = 0; step < 200; ++step)
+    {
+        const real newDt = sys.update(controller, dt);
+        checkBounds(newDt);
+        ASSERT_LE(newDt, params.maxGrowth * dt * (1.0_r + 1e-6_r));
+        dt = newDt;
+    }
+    ASSERT_EQ(dt, params.dtMax);
+
+    // moderate force spike: the time step drops immediately to the one that limits the displacement
+    const real a = 2000.0_r;
+    sys.setForce(123, make_real3(0.0_r, a * mass, 0.0_r));
+    dt = sys.update(controller, dt);
+    checkBounds(dt);
+    ASSERT_LT(dt, params.dtMax);
+    ASSERT_NEAR(expectedDisplacement(vmax, a, dt), params.maxDisplacement, 1e-4_r * params.maxDisplacement);
+
+    // huge force spike: the time step is clamped to dtMin
+    sys.setForce(456, make_real3(-1e9_r * mass, 0.0_r, 0.0_r));
+    dt = sys.update(controller, dt);
+    ASSERT_EQ(dt, params.dtMin);
+
+    // the spike is gone: the time step recovers progressively
+    sys.setForce(-1, make_real3(0.0_r));
+    const real recovered = sys.update(controller, dt);
+    checkBounds(recovered);
+    ASSERT_NEAR(recovered, params.maxGrowth * params.dtMin, 1e-6_r * params.dtMin);
+}
+
+TEST (ADAPTIVE_TIME_STEP, reduces_over_all_particle_vectors)
+{
+    const real mass = 1.0_r;
+    TestSystem sys1(100, mass), sys2(100, mass);
+    AdaptiveTimeStep controller(params);
+
+    const real a = 5000.0_r;
+    sys2.setForce(7, make_real3(0.0_r, 0.0_r, a * mass));
+
+    controller.reduceLocal({&sys1.pv, &sys2.pv}, defaultStream);
+    CUDA_Check( cudaStreamSynchronize(defaultStream) );
+    const real dt = controller.computeTimeStep(params.dtMax, MPI_COMM_WORLD);
+
+    const real vmax = math::max(sys1.maxVelocity(), sys2.maxVelocity());
+    ASSERT_NEAR(expectedDisplacement(vmax, a, dt), params.maxDisplacement, 1e-4_r * params.maxDisplacement);
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+
+    logger.init(MPI_COMM_WORLD, "adaptive_time_step.log", 9);
+
+    testing::InitGoogleTest(&argc, argv);
+    const int result = RUN_ALL_TESTS();
+
+    MPI_Finalize();
+    return result;
+}
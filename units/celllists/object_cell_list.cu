@@ -0,0 +1,113 @@
+#include <mirheo/core/object_cell_list.h>
+#include <mirheo/core/pvs/object_vector.h>
+#include <mirheo/core/pvs/views/ov.h>
+#include <mirheo/core/utils/cuda_common.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace mirheo;
+
+/// the cells along one direction that overlap the interval [lo, hi]; the boundary cells extend to infinity
+static std::vector<int> overlappedCells(real lo, real hi, real origin, real h, int n)
+{
+    std::vector<int> cells;
+    for (int c = 0; c < n; ++c)
+    {
+        const real cellLo = origin + c * h;
+        const real cellHi = origin + (c + 1) * h;
+
+        const bool aboveLow  = (c == n - 1) || lo < cellHi;
+        const bool belowHigh = (c == 0)     || hi >= cellLo;
+
+        if (aboveLow && belowHigh)
+            cells.push_back(c);
+    }
+    return cells;
+}
+
+static void testBinning(real3 localDomainSize, real h, real margin, int nObjects, long seed)
+{
+    DomainInfo domain{localDomainSize, {0,0,0}, localDomainSize};
+    MirState state(domain, 0.0_r, UnitConversion{});
+
+    ObjectVector ov(&state, "ov", 1.0_r, 1, nObjects);
+    auto& extents = *ov.local()->dataPerObject.getData<COMandExtent>(channel_names::comExtents);
+
+    // objects anywhere in the local domain and its halo, of various sizes
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<real> uPos(-0.5_r - 0.2_r, 0.5_r + 0.2_r);
+    std::uniform_real_distribution<real> uSize(0.05_r, 2.0_r);
+
+    for (auto& e : extents)
+    {
+        e.com  = make_real3(uPos(gen), uPos(gen), uPos(gen)) * localDomainSize;
+        e.low  = e.com - make_real3(uSize(gen), uSize(gen), uSize(gen));
+        e.high = e.com + make_real3(uSize(gen), uSize(gen), uSize(gen));
+    }
+    extents.uploadToDevice(defaultStream);
+
+    ObjectCellList cells;
+    cells.build(OVview(&ov, ov.local()), h, margin, localDomainSize, defaultStream);
+    const ObjectCellListView view = cells.getView();
+
+    const int nEntries = cells.getNumEntries();
+    std::vector<int> cellStarts(view.totcells + 1), cellObjects(nEntries);
+
+    CUDA_Check( cudaMemcpy(cellStarts.data(), view.cellStarts, cellStarts.size() * sizeof(int), cudaMemcpyDeviceToHost) );
+    CUDA_Check( cudaMemcpy(cellObjects.data(), view.cellObjects, cellObjects.size() * sizeof(int), cudaMemcpyDeviceToHost) );
+
+    ASSERT_EQ(cellStarts[view.totcells], nEntries);
+
+    // cells listing each object, as found in the cell list
+    std::vector<std::vector<int>> binned(nObjects);
+    for (int cid = 0; cid < view.totcells; ++cid)
+        for (int i = cellStarts[cid]; i < cellStarts[cid+1]; ++i)
+            binned[cellObjects[i]].push_back(cid);
+
+    const real3 cellSize = 1.0_r / view.invh;
+    int nExpected = 0;
+
+    for (int objId = 0; objId < nObjects; ++objId)
+    {
+        const auto& e = extents[objId];
+        const real3 lo = e.low  - margin;
+        const real3 hi = e.high + margin;
+
+        const auto cx = overlappedCells(lo.x, hi.x, view.origin.x, cellSize.x, view.ncells.x);
+        const auto cy = overlappedCells(lo.y, hi.y, view.origin.y, cellSize.y, view.ncells.y);
+        const auto cz = overlappedCells(lo.z, hi.z, view.origin.z, cellSize.z, view.ncells.z);
+
+        std::vector<int> expected;
+        for (int z : cz)
+            for (int y : cy)
+                for (int x : cx)
+                    expected.push_back((z * view.ncells.y + y) * view.ncells.x + x);
+
+        // the cells are visited in increasing order: the lists are sorted and must be identical, without duplicates
+        std::sort(expected.begin(), expected.end());
+        ASSERT_EQ(binned[objId], expected) << "object " << objId;
+
+        nExpected += static_cast<int>(expected.size());
+    }
+
+    ASSERT_EQ(nEntries, nExpected);
+}
+
+TEST (OBJECT_CELL_LIST, bins_objects_in_overlapped_cells)
+{
+    testBinning(make_real3(10, 8, 6), 1.3_r, 0.4_r, 200, 42);
+}
+
+TEST (OBJECT_CELL_LIST, bins_objects_without_margin)
+{
+    testBinning(make_real3(10, 8, 6), 1.3_r, 0.0_r, 200, 1234);
+}
+
+TEST (OBJECT_CELL_LIST, bins_objects_in_large_cells)
+{
+    testBinning(make_real3(16, 16, 16), 5.0_r, 1.5_r, 500, 7);
+}
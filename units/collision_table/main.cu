@@ -0,0 +1,131 @@
+#include <mirheo/core/bouncers/collision_table.h>
+#include <mirheo/core/bouncers/drivers/common.h>
+#include <mirheo/core/logger.h>
+#include <mirheo/core/utils/cuda_common.h>
+#include <mirheo/core/utils/kernel_launch.h>
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace mirheo;
+
+using Table = AdaptiveCollisionTable<int2>;
+
+__global__ void pushEntries(int n, CollisionTable<int2> table)
+{
+    const int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i >= n) return;
+    table.push_back({i, 7 * i});
+}
+
+// same launch pattern as the bouncers: clear, launch, and launch again while the table overflows
+static int fill(Table& table, int n)
+{
+    const int nthreads = 128;
+    int nLaunches = 0;
+
+    do {
+        table.clear(defaultStream);
+
+        SAFE_KERNEL_LAUNCH(
+            pushEntries,
+            getNblocks(n, nthreads), nthreads, 0, defaultStream,
+            n, CollisionTable<int2>{table.capacity(), table.devCounter(), table.devPtr()} );
+
+        ++nLaunches;
+    } while (!table.downloadAndCheck(defaultStream));
+
+    return nLaunches;
+}
+
+static void checkEntries(Table& table, int n)
+{
+    ASSERT_EQ(table.size(), n);
+
+    std::vector<int2> entries(static_cast<size_t>(n));
+    CUDA_Check( cudaMemcpyAsync(entries.data(), table.devPtr(), n * sizeof(int2),
+                                cudaMemcpyDeviceToHost, defaultStream) );
+    CUDA_Check( cudaStreamSynchronize(defaultStream) );
+
+    std::sort(entries.begin(), entries.end(), [](int2 a, int2 b) {return a.x < b.x;});
+
+    for (int i = 0; i < n; ++i)
+    {
+        ASSERT_EQ(entries[i].x, i);
+        ASSERT_EQ(entries[i].y, 7 * i);
+    }
+}
+
+TEST (COLLISION_TABLE, grows_on_overflow_and_keeps_all_entries)
+{
+    const int initialCapacity = 256;
+    Table table("test", initialCapacity);
+    ASSERT_EQ(table.capacity(), initialCapacity);
+
+    // fits: a single launch
+    ASSERT_EQ(fill(table, 200), 1);
+    ASSERT_EQ(table.capacity(), initialCapacity);
+    checkEntries(table, 200);
+
+    // overflows: the table grows and the retry stores every entry
+    const int n = 10000;
+    ASSERT_EQ(fill(table, n), 2);
+    ASSERT_GE(table.capacity(), n);
+    checkEntries(table, n);
+
+    // the grown capacity is kept
+    ASSERT_EQ(fill(table, n), 1);
+    checkEntries(table, n);
+}
+
+TEST (COLLISION_TABLE, shrinks_only_after_the_hysteresis_window)
+{
+    const int nStepsBeforeShrink = Table::nStepsBeforeShrink;
+    const int minCapacity = Table::minCapacity;
+    const int nLarge = 10000;
+    const int nSmall = 100;
+
+    Table table("test", minCapacity);
+    fill(table, nLarge);
+    const int largeCapacity = table.capacity();
+    ASSERT_GE(largeCapacity, nLarge);
+
+    // underused, but not for long enough
+    for (int i = 0; i < nStepsBeforeShrink - 1; ++i)
+        ASSERT_EQ(fill(table, nSmall), 1);
+    ASSERT_EQ(table.capacity(), largeCapacity);
+
+    // a launch that uses the table restarts the window
+    ASSERT_EQ(fill(table, nLarge), 1);
+    for (int i = 0; i < nStepsBeforeShrink - 1; ++i)
+        fill(table, nSmall);
+    ASSERT_EQ(table.capacity(), largeCapacity);
+
+    // end of the window: the capacity shrinks, the current entries are still valid
+    ASSERT_EQ(fill(table, nSmall), 1);
+    ASSERT_LT(table.capacity(), largeCapacity);
+    ASSERT_GE(table.capacity(), nSmall);
+    ASSERT_GE(table.capacity(), minCapacity);
+    checkEntries(table, nSmall);
+
+    // the shrunk table still works and grows again if needed
+    ASSERT_EQ(fill(table, nSmall), 1);
+    checkEntries(table, nSmall);
+
+    ASSERT_EQ(fill(table, nLarge), 2);
+    checkEntries(table, nLarge);
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+
+    logger.init(MPI_COMM_WORLD, "collision_table.log", 9);
+
+    testing::InitGoogleTest(&argc, argv);
+    const int result = RUN_ALL_TESTS();
+
+    MPI_Finalize();
+    return result;
+}
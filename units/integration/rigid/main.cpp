@@ -2,12 +2,17 @@
 #include <mirheo/core/integrators/rigid_vv.h>
 #include <mirheo/core/logger.h>
 #include <mirheo/core/pvs/rigid_object_vector.h>
+#include <mirheo/core/pvs/views/rov.h>
+#include <mirheo/core/rigid/operations.h>
 #include <mirheo/core/rigid/utils.h>
 #include <mirheo/core/utils/common.h>
 #include <mirheo/core/utils/cuda_common.h>
 
+#include "../../timer.h"
+
 #include <cstdio>
 #include <gtest/gtest.h>
+#include <random>
 
 using namespace mirheo;
 
@@ -322,6 +327,144 @@ TEST (Integration_Rigid, constantTorquePrincipalAxis)
     check({0.0_r, 0.0_r, -2.0_r});
 }
 
+static std::unique_ptr<RigidObjectVector> makeManyRigidObjects(const MirState *state, int nObjects, int objSize, cudaStream_t stream)
+{
+    std::mt19937 gen(4242);
+    std::uniform_real_distribution<real> U(-1.0_r, 1.0_r);
+
+    std::vector<real3> posTemplate(objSize);
+    for (auto& r : posTemplate)
+        r = {U(gen), U(gen), U(gen)};
+
+    const real partMass = 1.0_r;
+    const real3 J {1.0_r, 1.0_r, 1.0_r};
+    auto rov = std::make_unique<RigidObjectVector>(state, "rigid_bodies", partMass, J, objSize, std::make_shared<Mesh>(), nObjects);
+
+    auto lrov = rov->local();
+    auto& motions = *lrov->dataPerObject.getData<RigidMotion>(channel_names::motions);
+
+    const real L = state->domain.localSize.x;
+    for (auto& m : motions)
+    {
+        m = initMotion({0.0_r, 0.0_r, 0.0_r});
+        m.r = make_rigidReal3(0.5_r * L * make_real3(U(gen), U(gen), U(gen)));
+    }
+    motions.uploadToDevice(stream);
+
+    rov->initialPositions = getInitialPositions(posTemplate, stream);
+    setParticlesFromMotions(rov.get(), stream);
+
+    auto& forces = lrov->forces();
+    for (auto& f : forces)
+        f.f = {U(gen), U(gen), U(gen)};
+    forces.uploadToDevice(stream);
+
+    return rov;
+}
+
+// reference values on the host
+static std::vector<RigidMotion> collectForcesCPU(RigidObjectVector *rov, cudaStream_t stream)
+{
+    auto lrov = rov->local();
+    auto& motions = *lrov->dataPerObject.getData<RigidMotion>(channel_names::motions);
+    auto& positions = lrov->positions();
+    auto& forces = lrov->forces();
+    motions.downloadFromDevice(stream);
+    positions.downloadFromDevice(stream);
+    forces.downloadFromDevice(stream);
+
+    const int objSize = rov->getObjectSize();
+    std::vector<RigidMotion> ref(motions.begin(), motions.end());
+
+    for (size_t objId = 0; objId < ref.size(); ++objId)
+    {
+        auto& m = ref[objId];
+        m.force = m.torque = {0, 0, 0};
+        for (int i = 0; i < objSize; ++i)
+        {
+            const size_t pid = objId * objSize + i;
+            const RigidReal3 f = make_rigidReal3(forces[pid].f);
+            const RigidReal3 r = make_rigidReal3(make_real3(positions[pid])) - m.r;
+            m.force  += f;
+            m.torque += cross(r, f);
+        }
+    }
+    return ref;
+}
+
+static void collectForcesGPU(RigidObjectVector *rov, rigid_operations::CollectForcesMode mode, cudaStream_t stream)
+{
+    ROVview view(rov, rov->local());
+    rigid_operations::clearRigidForcesFromMotions(view, stream);
+    rigid_operations::collectRigidForces(view, stream, mode);
+}
+
+TEST (Integration_Rigid, collectForces_segmented_vs_block)
+{
+    using Mode = rigid_operations::CollectForcesMode;
+    constexpr real L = 32.0_r;
+    DomainInfo domain {{L, L, L}, {0._r, 0._r, 0._r}, {L, L, L}};
+    MirState state(domain, 0.0_r, UnitConversion{});
+
+    for (int objSize : {1, 6, 20, 33, 100, 300})
+    {
+        const int nObjects = 1000;
+        auto rov = makeManyRigidObjects(&state, nObjects, objSize, defaultStream);
+        const auto ref = collectForcesCPU(rov.get(), defaultStream);
+
+        for (auto mode : {Mode::OneBlockPerObject, Mode::Segmented, Mode::Auto})
+        {
+            collectForcesGPU(rov.get(), mode, defaultStream);
+
+            auto& motions = *rov->local()->dataPerObject.getData<RigidMotion>(channel_names::motions);
+            motions.downloadFromDevice(defaultStream);
+
+            constexpr real tol = 1e-3_r;
+            for (int i = 0; i < nObjects; ++i)
+            {
+                ASSERT_NEAR(motions[i].force.x,  ref[i].force.x,  tol);
+                ASSERT_NEAR(motions[i].force.y,  ref[i].force.y,  tol);
+                ASSERT_NEAR(motions[i].force.z,  ref[i].force.z,  tol);
+                ASSERT_NEAR(motions[i].torque.x, ref[i].torque.x, tol);
+                ASSERT_NEAR(motions[i].torque.y, ref[i].torque.y, tol);
+                ASSERT_NEAR(motions[i].torque.z, ref[i].torque.z, tol);
+            }
+        }
+    }
+}
+
+TEST (Integration_Rigid, collectForces_benchmark)
+{
+    using Mode = rigid_operations::CollectForcesMode;
+    constexpr real L = 64.0_r;
+    DomainInfo domain {{L, L, L}, {0._r, 0._r, 0._r}, {L, L, L}};
+    MirState state(domain, 0.0_r, UnitConversion{});
+
+    constexpr int nrepeat = 20;
+    const int nObjects = 100000;
+
+    for (int objSize : {6, 20, 64, 200})
+    {
+        auto rov = makeManyRigidObjects(&state, nObjects, objSize, defaultStream);
+
+        for (auto mode : {Mode::OneBlockPerObject, Mode::Segmented})
+        {
+            collectForcesGPU(rov.get(), mode, defaultStream); // warm up
+            CUDA_Check( cudaDeviceSynchronize() );
+
+            Timer timer;
+            timer.start();
+            for (int i = 0; i < nrepeat; ++i)
+                collectForcesGPU(rov.get(), mode, defaultStream);
+            CUDA_Check( cudaDeviceSynchronize() );
+            const double tms = timer.elapsed() * 1e-6 / nrepeat;
+
+            printf("%d objects of %3d particles, %s: %g ms\n", nObjects, objSize,
+                   mode == Mode::Segmented ? "segmented" : "one block per object", tms);
+        }
+    }
+}
+
 int main(int argc, char **argv)
 {
     testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,372 @@
+#include "../../timer.h"
+
+#include <mirheo/core/initial_conditions/rod.h>
+#include <mirheo/core/integrators/factory.h>
+#include <mirheo/core/interactions/rod/base_rod.h>
+#include <mirheo/core/interactions/rod/factory.h>
+#include <mirheo/core/logger.h>
+#include <mirheo/core/pvs/rod_vector.h>
+#include <mirheo/core/utils/cuda_common.h>
+#include <mirheo/core/utils/helper_math.h>
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace mirheo;
+
+constexpr real a = 0.05_r;
+constexpr real L = 16.0_r;
+constexpr int nSegments = 100;
+
+// helix parameters; the chord between two consecutive center line particles is l0
+constexpr real radius = 0.5_r;
+constexpr real height = 4.0_r;
+constexpr real nTurns = 4.0_r;
+
+static real helixSegmentLength()
+{
+    const real dt = 2.0_r * static_cast<real>(M_PI) * nTurns / nSegments;
+    const real dz = height / nSegments;
+    return math::sqrt(2.0_r * radius * radius * (1.0_r - math::cos(dt)) + dz * dz);
+}
+
+static void initializeHelices(const MPI_Comm& comm, RodVector& rv, int nRods)
+{
+    RodIC::MappingFunc3D centerLine = [&](real s)
+    {
+        const real t = 2.0_r * static_cast<real>(M_PI) * nTurns * s;
+        return real3({radius * math::cos(t), radius * math::sin(t), (s - 0.5_r) * height});
+    };
+
+    RodIC::MappingFunc1D torsion = [&](__UNUSED real s)
+    {
+        return 0.0_r;
+    };
+
+    std::vector<ComQ> comqs;
+    for (int i = 0; i < nRods; ++i)
+    {
+        const real x = L * (i + 0.5_r) / nRods;
+        comqs.push_back({{x, 0.5_r * L, 0.5_r * L}, {1.0_r, 0.0_r, 0.0_r, 0.0_r}});
+    }
+
+    RodIC ic(comqs, centerLine, torsion, a);
+    ic.exec(comm, &rv, defaultStream);
+}
+
+// the helix is not the equilibrium shape (straight rod), so the bending forces set it in motion
+static RodParameters rodParameters(real ks)
+{
+    RodParameters params;
+    params.kBending = {1.0_r, 0.0_r, 1.0_r};
+    params.kappaEq  = {{0.0_r, 0.0_r}};
+    params.kTwist   = 1.0_r;
+    params.tauEq    = {0.0_r};
+    params.groundE  = {0.0_r};
+    params.a0       = a;
+    params.l0       = helixSegmentLength();
+    params.ksCenter = ks;
+    params.ksFrame  = ks;
+    return params;
+}
+
+static void setRandomVelocities(RodVector& rv, real sigma, long seed)
+{
+    std::mt19937 gen(seed);
+    std::normal_distribution<real> distr(0.0_r, sigma);
+
+    auto& vel = rv.local()->velocities();
+    for (auto& v : vel)
+    {
+        v.x = distr(gen);
+        v.y = distr(gen);
+        v.z = distr(gen);
+    }
+    vel.uploadToDevice(defaultStream);
+}
+
+/// largest relative deviation of the 15 constrained lengths of all segments from their equilibrium values
+static real maxRelativeLengthError(RodVector& rv, real a0, real l0)
+{
+    auto& pos = rv.local()->positions();
+    pos.downloadFromDevice(defaultStream, ContainersSynch::Synch);
+
+    const int objSize = rv.getObjectSize();
+    const int nRods = rv.local()->getNumObjects();
+
+    const real lcenter = l0;
+    const real lcross  = a0;
+    const real lring   = 0.5_r * math::sqrt(2.0_r) * a0;
+    const real ldiag   = 0.5_r * math::sqrt(a0*a0 + l0*l0);
+
+    real err = 0.0_r;
+
+    for (int rod = 0; rod < nRods; ++rod)
+    {
+        for (int seg = 0; seg < nSegments; ++seg)
+        {
+            const int start = rod * objSize + 5 * seg;
+            auto r = [&](int id) {return make_real3(pos[start + id]);};
+
+            auto check = [&](int i, int j, real l)
+            {
+                err = std::max(err, math::abs(length(r(i) - r(j)) - l) / l);
+            };
+
+            for (int frame : {1, 2, 3, 4})
+            {
+                check(0, frame, ldiag);
+                check(5, frame, ldiag);
+            }
+            check(1, 3, lring);
+            check(3, 2, lring);
+            check(2, 4, lring);
+            check(4, 1, lring);
+
+            check(1, 2, lcross);
+            check(3, 4, lcross);
+
+            check(0, 5, lcenter);
+        }
+    }
+    return err;
+}
+
+struct Invariants
+{
+    double energy;
+    double3 momentum;
+};
+
+/// total energy (kinetic, bound and elastic) and momentum of the rods; the forces must be computed with energies
+static Invariants computeInvariants(RodVector& rv, const RodParameters& params)
+{
+    auto lrv = rv.local();
+    auto& pos = lrv->positions();
+    auto& vel = lrv->velocities();
+    auto& energies = *lrv->dataPerBisegment.getData<real>(channel_names::energies);
+
+    pos.downloadFromDevice(defaultStream, ContainersSynch::Asynch);
+    vel.downloadFromDevice(defaultStream, ContainersSynch::Asynch);
+    energies.downloadFromDevice(defaultStream, ContainersSynch::Synch);
+
+    Invariants inv {0.0, {0.0, 0.0, 0.0}};
+
+    for (auto v : vel)
+    {
+        inv.energy += 0.5 * rv.getMassPerParticle() * (v.x*v.x + v.y*v.y + v.z*v.z);
+        inv.momentum.x += rv.getMassPerParticle() * v.x;
+        inv.momentum.y += rv.getMassPerParticle() * v.y;
+        inv.momentum.z += rv.getMassPerParticle() * v.z;
+    }
+
+    for (auto e : energies)
+        inv.energy += e;
+
+    // bound energy, 0.5 ks l (l - l0)^2 for each bound (see rod_forces_kernels::fbound)
+    if (params.ksCenter > 0 || params.ksFrame > 0)
+    {
+        const int objSize = rv.getObjectSize();
+        const int nRods = lrv->getNumObjects();
+        const real lring = 0.5_r * math::sqrt(2.0_r) * params.a0;
+        const real ldiag = 0.5_r * math::sqrt(params.a0*params.a0 + params.l0*params.l0);
+
+        for (int rod = 0; rod < nRods; ++rod)
+        {
+            for (int seg = 0; seg < nSegments; ++seg)
+            {
+                const int start = rod * objSize + 5 * seg;
+                auto r = [&](int id) {return make_real3(pos[start + id]);};
+                auto bound = [&](int i, int j, real ks, real l0)
+                {
+                    const double l = length(r(i) - r(j));
+                    inv.energy += 0.5 * ks * l * (l - l0) * (l - l0);
+                };
+
+                for (int frame : {1, 2, 3, 4})
+                {
+                    bound(0, frame, params.ksFrame, ldiag);
+                    bound(5, frame, params.ksFrame, ldiag);
+                }
+                bound(1, 3, params.ksFrame, lring);
+                bound(3, 2, params.ksFrame, lring);
+                bound(2, 4, params.ksFrame, lring);
+                bound(4, 1, params.ksFrame, lring);
+                bound(1, 2, params.ksFrame, params.a0);
+                bound(3, 4, params.ksFrame, params.a0);
+                bound(0, 5, params.ksCenter, params.l0);
+            }
+        }
+    }
+    return inv;
+}
+
+struct RunStatistics
+{
+    double maxEnergyDrift;   ///< largest deviation of the total energy, relative to the initial elastic energy
+    double maxMomentumDrift; ///< largest deviation of the total momentum
+    double msPerTimeUnit;    ///< wall time needed to advance the rods by one time unit
+};
+
+/// advance the rods released from a helix at rest for the time tend and measure the invariants
+static RunStatistics runHelices(Integrator *integrator, BaseRodInteraction *interaction, const RodParameters& params,
+                                MirState& state, int nRods, real tend, bool measure)
+{
+    RodVector rv(&state, "rod", 1.0_r, nSegments);
+    initializeHelices(MPI_COMM_WORLD, rv, nRods);
+
+    interaction->setPrerequisites(&rv, &rv, nullptr, nullptr);
+    integrator->setPrerequisites(&rv);
+
+    auto computeForces = [&]()
+    {
+        rv.local()->forces().clear(defaultStream);
+        interaction->local(&rv, &rv, nullptr, nullptr, defaultStream);
+    };
+
+    const int nsteps = static_cast<int>(tend / state.dt);
+
+    computeForces();
+    const Invariants inv0 = computeInvariants(rv, params);
+
+    RunStatistics stats {0.0, 0.0, 0.0};
+
+    Timer timer;
+    timer.start();
+
+    for (int step = 0; step < nsteps; ++step)
+    {
+        state.currentStep = step;
+        state.currentTime = step * state.dt;
+
+        integrator->execute(&rv, defaultStream);
+        computeForces();
+
+        if (measure)
+        {
+            const auto inv = computeInvariants(rv, params);
+            const double3 dp {inv.momentum.x - inv0.momentum.x,
+                              inv.momentum.y - inv0.momentum.y,
+                              inv.momentum.z - inv0.momentum.z};
+            stats.maxEnergyDrift   = std::max(stats.maxEnergyDrift, std::abs(inv.energy - inv0.energy) / inv0.energy);
+            stats.maxMomentumDrift = std::max(stats.maxMomentumDrift, std::sqrt(dp.x*dp.x + dp.y*dp.y + dp.z*dp.z));
+        }
+    }
+    CUDA_Check( cudaDeviceSynchronize() );
+    stats.msPerTimeUnit = timer.elapsed() * 1e-6 / tend;
+
+    return stats;
+}
+
+TEST (Integration_rods, constraints_restore_segment_lengths)
+{
+    const real dt = 1e-3_r;
+    DomainInfo domain {{L, L, L}, {0._r, 0._r, 0._r}, {L, L, L}};
+    MirState state(domain, dt, UnitConversion{});
+
+    const real l0 = helixSegmentLength();
+    auto interaction = createInteractionRod(&state, "rod_forces", rodParameters(0.0_r), StatesParametersNone{}, false);
+    auto constraints = integrator_factory::createRodConstraints(&state, "constraints", interaction.get(), 50, 1, {});
+    auto vv = integrator_factory::createVV(&state, "vv", false);
+
+    auto run = [&](Integrator *integrator)
+    {
+        RodVector rv(&state, "rod", 1.0_r, nSegments);
+        initializeHelices(MPI_COMM_WORLD, rv, 4);
+        const real err0 = maxRelativeLengthError(rv, a, l0);
+        EXPECT_LE(err0, 1e-3_r);
+
+        // random velocities break the bounds if they are not constrained
+        setRandomVelocities(rv, 0.1_r, 42);
+        integrator->setPrerequisites(&rv);
+
+        for (int step = 0; step < 100; ++step)
+        {
+            rv.local()->forces().clear(defaultStream);
+            integrator->execute(&rv, defaultStream);
+        }
+        return maxRelativeLengthError(rv, a, l0);
+    };
+
+    const real errFree        = run(vv.get());
+    const real errConstrained = run(constraints.get());
+
+    printf("max relative length error: free %g, constrained %g\n", errFree, errConstrained);
+
+    ASSERT_GT(errFree, 1e-2_r);
+    ASSERT_LE(errConstrained, 1e-3_r);
+}
+
+// compare the constrained integrator with the velocity-Verlet integrator and stiff bound forces:
+// energy and momentum drift, and wall time needed to simulate the same physical time
+TEST (Integration_rods, constraints_energy_drift_against_stiff_bounds)
+{
+    DomainInfo domain {{L, L, L}, {0._r, 0._r, 0._r}, {L, L, L}};
+
+    const real tend = 0.5_r;
+    const int nRods = 4;
+
+    // stiff bounds need a small time step
+    MirState stateVV(domain, 2e-4_r, UnitConversion{});
+    const auto paramsVV = rodParameters(10000.0_r);
+    auto forcesVV = createInteractionRod(&stateVV, "rod_forces", paramsVV, StatesParametersNone{}, true);
+    auto vv = integrator_factory::createVV(&stateVV, "vv", false);
+
+    MirState stateC(domain, 2e-3_r, UnitConversion{});
+    const auto paramsC = rodParameters(0.0_r);
+    auto forcesC = createInteractionRod(&stateC, "rod_forces", paramsC, StatesParametersNone{}, true);
+    auto constraints = integrator_factory::createRodConstraints(&stateC, "constraints", forcesC.get(), 20, 1, {});
+
+    const auto statsVV = runHelices(vv.get(),          forcesVV.get(), paramsVV, stateVV, nRods, tend, true);
+    const auto statsC  = runHelices(constraints.get(), forcesC.get(),  paramsC,  stateC,  nRods, tend, true);
+
+    printf("stiff bounds, dt = %g: energy drift %g, momentum drift %g\n",
+           stateVV.dt, statsVV.maxEnergyDrift, statsVV.maxMomentumDrift);
+    printf("constraints,  dt = %g: energy drift %g, momentum drift %g\n",
+           stateC.dt, statsC.maxEnergyDrift, statsC.maxMomentumDrift);
+
+    // the SHAKE corrections are symmetric: the momentum is conserved as with the pairwise bound forces
+    ASSERT_LE(statsC.maxMomentumDrift, 1e-3);
+    ASSERT_LE(statsC.maxEnergyDrift, 0.05);
+    ASSERT_LE(statsC.maxEnergyDrift, std::max(0.02, 5.0 * statsVV.maxEnergyDrift));
+}
+
+TEST (Integration_rods, constraints_benchmark_against_stiff_bounds)
+{
+    DomainInfo domain {{L, L, L}, {0._r, 0._r, 0._r}, {L, L, L}};
+    const real tend = 1.0_r;
+
+    for (int nRods : {16, 256, 2048})
+    {
+        MirState stateVV(domain, 2e-4_r, UnitConversion{});
+        const auto paramsVV = rodParameters(10000.0_r);
+        auto forcesVV = createInteractionRod(&stateVV, "rod_forces", paramsVV, StatesParametersNone{}, false);
+        auto vv = integrator_factory::createVV(&stateVV, "vv", false);
+
+        MirState stateC(domain, 2e-3_r, UnitConversion{});
+        const auto paramsC = rodParameters(0.0_r);
+        auto forcesC = createInteractionRod(&stateC, "rod_forces", paramsC, StatesParametersNone{}, false);
+        auto constraints = integrator_factory::createRodConstraints(&stateC, "constraints", forcesC.get(), 20, 1, {});
+
+        const auto statsVV = runHelices(vv.get(),          forcesVV.get(), paramsVV, stateVV, nRods, tend, false);
+        const auto statsC  = runHelices(constraints.get(), forcesC.get(),  paramsC,  stateC,  nRods, tend, false);
+
+        printf("%4d rods: stiff bounds (dt = %g) %9.3f ms, constraints (dt = %g) %9.3f ms per time unit\n",
+               nRods, stateVV.dt, statsVV.msPerTimeUnit, stateC.dt, statsC.msPerTimeUnit);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    logger.init(MPI_COMM_WORLD, "integration_rods.log", 3);
+
+    testing::InitGoogleTest(&argc, argv);
+    auto ret = RUN_ALL_TESTS();
+
+    MPI_Finalize();
+    return ret;
+}
@@ -1,8 +1,13 @@
+#include "../timer.h"
+#include "serial_reference.h"
+
 #include <mirheo/core/logger.h>
 #include <mirheo/core/marching_cubes.h>
 
 #include <cstdio>
 #include <cmath>
+#include <map>
+#include <utility>
 #include <gtest/gtest.h>
 
 using namespace mirheo;
@@ -78,6 +83,185 @@ TEST (MARCHING_CUBES, Sphere)
     ASSERT_LE(maxVal, 0.01);
 }
 
+static DomainInfo makeCubicDomain(real L)
+{
+    DomainInfo domain;
+    domain.globalStart = make_real3(0, 0, 0);
+    domain.localSize   = make_real3(L, L, L);
+    domain.globalSize  = domain.localSize;
+    return domain;
+}
+
+TEST (MARCHING_CUBES, IndexedMeshIsClosed)
+{
+    const real R = 1.0;
+    const auto domain = makeCubicDomain(2.5 * R);
+    const real3 center = domain.globalStart + 0.5 * domain.globalSize;
+
+    auto sphereSurface = [&] (real3 r)
+    {
+        r -= center;
+        return math::sqrt(dot(r, r)) - R;
+    };
+
+    long nEvaluations = 0;
+    auto batchSurface = [&] (int n, const real3 *positions, real *values)
+    {
+        nEvaluations += n;
+        for (int i = 0; i < n; ++i)
+            values[i] = sphereSurface(positions[i]);
+    };
+
+    const real h = 0.1_r;
+    const real3 resolution {h, h, h};
+
+    marching_cubes::IndexedMesh mesh;
+    marching_cubes::computeIndexedMesh(domain, resolution, batchSurface, mesh);
+
+    // every grid node is sampled once
+    const long nNodes = static_cast<long>(domain.localSize.x / h + 1) *
+        static_cast<long>(domain.localSize.y / h + 1) *
+        static_cast<long>(domain.localSize.z / h + 1);
+    ASSERT_EQ(nEvaluations, nNodes);
+
+    const int nVertices = static_cast<int>(mesh.vertices.size());
+    const int nFaces    = static_cast<int>(mesh.triangles.size());
+    ASSERT_GT(nFaces, 0);
+
+    for (auto r : mesh.vertices)
+        ASSERT_LE(std::abs(sphereSurface(domain.local2global(r))), 0.01);
+
+    // the surface is closed: every edge is shared by exactly two triangles
+    std::map<std::pair<int,int>, int> edges;
+    auto addEdge = [&](int a, int b)
+    {
+        ASSERT_GE(a, 0);
+        ASSERT_LT(a, nVertices);
+        ++edges[{std::min(a, b), std::max(a, b)}];
+    };
+
+    for (auto t : mesh.triangles)
+    {
+        addEdge(t.x, t.y);
+        addEdge(t.y, t.z);
+        addEdge(t.z, t.x);
+    }
+
+    for (const auto& edge : edges)
+        ASSERT_EQ(edge.second, 2);
+
+    // and has the topology of a sphere
+    const int nEdges = static_cast<int>(edges.size());
+    ASSERT_EQ(nVertices - nEdges + nFaces, 2);
+
+    // same triangles as the unshared version
+    std::vector<marching_cubes::Triangle> triangles;
+    marching_cubes::computeTriangles(domain, resolution, sphereSurface, triangles);
+    ASSERT_EQ(triangles.size(), mesh.triangles.size());
+
+    for (size_t i = 0; i < triangles.size(); ++i)
+    {
+        const int3 t = mesh.triangles[i];
+        ASSERT_LE(length(triangles[i].a - mesh.vertices[t.x]), 1e-6);
+        ASSERT_LE(length(triangles[i].b - mesh.vertices[t.y]), 1e-6);
+        ASSERT_LE(length(triangles[i].c - mesh.vertices[t.z]), 1e-6);
+    }
+}
+
+TEST (MARCHING_CUBES, MatchesSerialReference)
+{
+    const real R = 1.0;
+    const auto domain = makeCubicDomain(2.5 * R);
+    const real3 center = domain.globalStart + 0.5 * domain.globalSize;
+
+    // perturbed sphere, so that most of the cube configurations are met
+    auto surface = [&] (real3 r)
+    {
+        r -= center;
+        return math::sqrt(dot(r, r)) - R + 0.1_r * math::sin(5 * r.x) * math::cos(3 * r.y) * math::sin(4 * r.z);
+    };
+
+    auto batchSurface = [&] (int n, const real3 *positions, real *values)
+    {
+        for (int i = 0; i < n; ++i)
+            values[i] = surface(positions[i]);
+    };
+
+    const real h = 0.05_r;
+    const real3 resolution {h, h, h};
+
+    std::vector<marching_cubes::Triangle> reference;
+    serial_reference::computeTriangles(domain, resolution, surface, reference);
+
+    marching_cubes::IndexedMesh mesh;
+    marching_cubes::computeIndexedMesh(domain, resolution, batchSurface, mesh);
+
+    ASSERT_GT(reference.size(), 0);
+    ASSERT_EQ(reference.size(), mesh.triangles.size());
+
+    for (size_t i = 0; i < reference.size(); ++i)
+    {
+        const int3 t = mesh.triangles[i];
+        ASSERT_LE(length(reference[i].a - mesh.vertices[t.x]), 1e-5);
+        ASSERT_LE(length(reference[i].b - mesh.vertices[t.y]), 1e-5);
+        ASSERT_LE(length(reference[i].c - mesh.vertices[t.z]), 1e-5);
+    }
+
+    ASSERT_LT(mesh.vertices.size(), 3 * reference.size());
+}
+
+TEST (MARCHING_CUBES, timings)
+{
+    const real R = 1.0;
+    const auto domain = makeCubicDomain(2.5 * R);
+    const real3 center = domain.globalStart + 0.5 * domain.globalSize;
+
+    // perturbed sphere: a few transcendental calls per evaluation, as in typical user shapes
+    long nEvaluations = 0;
+    auto surface = [&] (real3 r)
+    {
+        ++nEvaluations;
+        r -= center;
+        return math::sqrt(dot(r, r)) - R + 0.1_r * math::sin(5 * r.x) * math::cos(3 * r.y) * math::sin(4 * r.z);
+    };
+
+    auto batchSurface = [&] (int n, const real3 *positions, real *values)
+    {
+        for (int i = 0; i < n; ++i)
+            values[i] = surface(positions[i]);
+    };
+
+    for (real h : {0.1_r, 0.05_r, 0.02_r})
+    {
+        const real3 resolution {h, h, h};
+        std::vector<marching_cubes::Triangle> triangles;
+        marching_cubes::IndexedMesh mesh;
+        Timer timer;
+
+        nEvaluations = 0;
+        timer.start();
+        serial_reference::computeTriangles(domain, resolution, surface, triangles);
+        const double tReference = static_cast<double>(timer.elapsedAndReset()) * 1e-6;
+        const long nEvaluationsReference = nEvaluations;
+
+        nEvaluations = 0;
+        timer.start();
+        marching_cubes::computeIndexedMesh(domain, resolution, batchSurface, mesh);
+        const double tIndexed = static_cast<double>(timer.elapsedAndReset()) * 1e-6;
+
+        printf("h = %g: %d triangles; serial reference: %g ms, %d vertices, %ld evaluations; "
+               "computeIndexedMesh: %g ms, %d vertices, %ld evaluations (speedup %.2f)\n",
+               h, static_cast<int>(triangles.size()),
+               tReference, static_cast<int>(3 * triangles.size()), nEvaluationsReference,
+               tIndexed, static_cast<int>(mesh.vertices.size()), nEvaluations,
+               tReference / tIndexed);
+
+        // the reference samples each node once per adjacent cell
+        ASSERT_EQ(triangles.size(), mesh.triangles.size());
+        ASSERT_LT(4 * nEvaluations, nEvaluationsReference);
+    }
+}
+
 int main(int argc, char **argv)
 {
     testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,403 @@
+#include "../timer.h"
+
+#include <mirheo/core/bouncers/drivers/mesh_host.h>
+#include <mirheo/core/bouncers/from_mesh.h>
+#include <mirheo/core/celllist.h>
+#include <mirheo/core/logger.h>
+#include <mirheo/core/mesh/membrane.h>
+#include <mirheo/core/pvs/membrane_vector.h>
+#include <mirheo/core/pvs/particle_vector.h>
+#include <mirheo/core/pvs/views/ov.h>
+#include <mirheo/core/pvs/views/pv.h>
+#include <mirheo/core/utils/cuda_common.h>
+#include <mirheo/core/utils/helper_math.h>
+#include <mirheo/core/utils/kernel_launch.h>
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace mirheo;
+
+// sphere obtained by recursive subdivision of an icosahedron
+static void makeIcosphere(int nSubdivisions, real radius, std::vector<real3>& vertices, std::vector<int3>& faces)
+{
+    const real t = 0.5_r * (1.0_r + math::sqrt(5.0_r));
+
+    vertices = {{-1,  t,  0}, { 1,  t,  0}, {-1, -t,  0}, { 1, -t,  0},
+                { 0, -1,  t}, { 0,  1,  t}, { 0, -1, -t}, { 0,  1, -t},
+                { t,  0, -1}, { t,  0,  1}, {-t,  0, -1}, {-t,  0,  1}};
+
+    faces = {{0, 11,  5}, {0,  5,  1}, { 0,  1,  7}, { 0,  7, 10}, {0, 10, 11},
+             {1,  5,  9}, {5, 11,  4}, {11, 10,  2}, {10,  7,  6}, {7,  1,  8},
+             {3,  9,  4}, {3,  4,  2}, { 3,  2,  6}, { 3,  6,  8}, {3,  8,  9},
+             {4,  9,  5}, {2,  4, 11}, { 6,  2, 10}, { 8,  6,  7}, {9,  8,  1}};
+
+    for (int s = 0; s < nSubdivisions; ++s)
+    {
+        std::map<std::pair<int,int>, int> midPoints;
+        auto getMidPoint = [&](int a, int b)
+        {
+            const auto key = std::make_pair(std::min(a, b), std::max(a, b));
+            auto it = midPoints.find(key);
+            if (it != midPoints.end())
+                return it->second;
+            const int id = static_cast<int>(vertices.size());
+            vertices.push_back(0.5_r * (vertices[a] + vertices[b]));
+            midPoints[key] = id;
+            return id;
+        };
+
+        std::vector<int3> newFaces;
+        for (auto f : faces)
+        {
+            const int a = getMidPoint(f.x, f.y);
+            const int b = getMidPoint(f.y, f.z);
+            const int c = getMidPoint(f.z, f.x);
+            newFaces.push_back({f.x, a, c});
+            newFaces.push_back({f.y, b, a});
+            newFaces.push_back({f.z, c, b});
+            newFaces.push_back({a, b, c});
+        }
+        faces = std::move(newFaces);
+    }
+
+    for (auto& v : vertices)
+        v = radius * normalize(v);
+}
+
+// spheres on a lattice that translate by a small random displacement, surrounded by particles
+struct Scene
+{
+    real3 L;
+    std::vector<int3> faces;
+    int nvertices;
+    std::vector<real3> vertices, oldVertices;
+    std::vector<real3> positions, oldPositions;
+};
+
+static Scene createScene(real3 L, int nSpheresPerDim, int nSubdivisions, real numberDensity, long seed)
+{
+    Scene s;
+    s.L = L;
+
+    std::vector<real3> sphere;
+    makeIcosphere(nSubdivisions, 0.35_r * L.x / nSpheresPerDim, sphere, s.faces);
+    s.nvertices = static_cast<int>(sphere.size());
+
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<real> u01(0.0_r, 1.0_r);
+    std::uniform_real_distribution<real> disp(-0.05_r, 0.05_r);
+
+    for (int iz = 0; iz < nSpheresPerDim; ++iz)
+    for (int iy = 0; iy < nSpheresPerDim; ++iy)
+    for (int ix = 0; ix < nSpheresPerDim; ++ix)
+    {
+        const real3 center {(ix + 0.5_r) * L.x / nSpheresPerDim - 0.5_r * L.x,
+                            (iy + 0.5_r) * L.y / nSpheresPerDim - 0.5_r * L.y,
+                            (iz + 0.5_r) * L.z / nSpheresPerDim - 0.5_r * L.z};
+        const real3 d {disp(gen), disp(gen), disp(gen)};
+
+        for (auto v : sphere)
+        {
+            s.vertices   .push_back(center + v);
+            s.oldVertices.push_back(center + v - d);
+        }
+    }
+
+    const long n = static_cast<long>(numberDensity * L.x * L.y * L.z);
+    for (long i = 0; i < n; ++i)
+    {
+        const real3 r {(u01(gen) - 0.5_r) * L.x, (u01(gen) - 0.5_r) * L.y, (u01(gen) - 0.5_r) * L.z};
+        const real3 d {2 * disp(gen), 2 * disp(gen), 2 * disp(gen)};
+        s.positions   .push_back(r);
+        s.oldPositions.push_back(r - d);
+    }
+
+    return s;
+}
+
+// all pairs passing the swept box and quick check tests, sorted by particle index
+static std::vector<int2> bruteForceCandidates(const Scene& s)
+{
+    using namespace mesh_bounce_kernels;
+
+    const int ntriangles = static_cast<int>(s.faces.size());
+    const int nObjects = static_cast<int>(s.vertices.size()) / s.nvertices;
+
+    std::vector<Triangle> tr, trOld;
+    std::vector<real3> lo, hi;
+    for (int objId = 0; objId < nObjects; ++objId)
+        for (auto f : s.faces)
+        {
+            const int o = objId * s.nvertices;
+            tr   .push_back({s.vertices   [o+f.x], s.vertices   [o+f.y], s.vertices   [o+f.z]});
+            trOld.push_back({s.oldVertices[o+f.x], s.oldVertices[o+f.y], s.oldVertices[o+f.z]});
+            real3 l, h;
+            sweptTriangleBox(tr.back(), trOld.back(), l, h);
+            lo.push_back(l);
+            hi.push_back(h);
+        }
+
+    std::vector<int2> candidates;
+    for (size_t pid = 0; pid < s.positions.size(); ++pid)
+    {
+        const real3 r = s.positions[pid], rOld = s.oldPositions[pid];
+        const real3 plo = math::min(r, rOld) - sweptBoxMargin;
+        const real3 phi = math::max(r, rOld) + sweptBoxMargin;
+
+        for (int i = 0; i < nObjects * ntriangles; ++i)
+            if (boxesOverlap(plo, phi, lo[i], hi[i]) && segmentTriangleQuickCheck(tr[i], trOld[i], r, rOld))
+                candidates.push_back({static_cast<int>(pid), i});
+    }
+    return candidates;
+}
+
+// number of (particle, triangle) pairs visited by the former broad phase:
+// every particle in the cells overlapped by the swept triangle box inflated by the maximum displacement
+static long countPerTriangleScanPairs(const Scene& s, const CellListInfo& cinfo)
+{
+    using namespace mesh_bounce_kernels;
+
+    std::vector<int> particlesPerCell(cinfo.totcells, 0);
+    for (auto r : s.oldPositions)
+        particlesPerCell[cinfo.getCellId(r)]++;
+
+    const int nObjects = static_cast<int>(s.vertices.size()) / s.nvertices;
+    long n = 0;
+    for (int objId = 0; objId < nObjects; ++objId)
+        for (auto f : s.faces)
+        {
+            const int o = objId * s.nvertices;
+            const Triangle tr    {s.vertices   [o+f.x], s.vertices   [o+f.y], s.vertices   [o+f.z]};
+            const Triangle trOld {s.oldVertices[o+f.x], s.oldVertices[o+f.y], s.oldVertices[o+f.z]};
+            real3 lo, hi;
+            sweptTriangleBox(tr, trOld, lo, hi);
+            forEachTriangleCell(cinfo, lo, hi, [&](int cid) {n += particlesPerCell[cid];});
+        }
+    return n;
+}
+
+static bool operator<(int2 a, int2 b)
+{
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+TEST (MESH_BOUNCE, broad_phase_finds_all_candidates)
+{
+    const real3 L {8.0_r, 8.0_r, 8.0_r};
+    const auto s = createScene(L, 2, 2, 4.0_r, 4242);
+    const CellListInfo cinfo(1.0_r, L);
+
+    auto candidates = mesh_bounce_host::findBounceCandidates(cinfo, s.faces, s.nvertices,
+                                                             s.vertices, s.oldVertices,
+                                                             s.positions, s.oldPositions);
+    auto reference = bruteForceCandidates(s);
+
+    std::sort(candidates.begin(), candidates.end());
+    std::sort(reference.begin(), reference.end());
+
+    ASSERT_GT(reference.size(), 0);
+    ASSERT_EQ(candidates.size(), reference.size());
+
+    for (size_t i = 0; i < reference.size(); ++i)
+    {
+        ASSERT_EQ(candidates[i].x, reference[i].x);
+        ASSERT_EQ(candidates[i].y, reference[i].y);
+    }
+}
+
+static void uploadPositions(const std::vector<real3>& src, PinnedBuffer<real4>& dst)
+{
+    for (size_t i = 0; i < src.size(); ++i)
+        dst[i] = make_real4(src[i].x, src[i].y, src[i].z, 0.0_r);
+    dst.uploadToDevice(defaultStream);
+}
+
+// run the device broad phase (triangle cells + findBouncesInTriangleCells) and return the candidates sorted
+static std::vector<int2> findBounceCandidatesGPU(const Scene& s, const CellListInfo& cinfo)
+{
+    using namespace mesh_bounce_kernels;
+
+    DomainInfo domain {s.L, {0.0_r, 0.0_r, 0.0_r}, s.L};
+    MirState state(domain, 0.0_r, UnitConversion{});
+
+    const int nObjects = static_cast<int>(s.vertices.size()) / s.nvertices;
+    auto mesh = std::make_shared<MembraneMesh>(std::vector<real3>(s.vertices.begin(), s.vertices.begin() + s.nvertices), s.faces);
+    MembraneVector mv(&state, "mv", 1.0_r, mesh, nObjects);
+    ParticleVector pv(&state, "pv", 1.0_r, static_cast<int>(s.positions.size()));
+
+    // the mesh vertices are the particles of the membranes
+    uploadPositions(s.vertices,     mv.local()->positions());
+    uploadPositions(s.oldVertices,  *mv.local()->dataPerParticle.getData<real4>(channel_names::oldPositions));
+    uploadPositions(s.positions,    pv.local()->positions());
+    uploadPositions(s.oldPositions, *pv.local()->dataPerParticle.getData<real4>(channel_names::oldPositions));
+
+    OVviewWithNewOldVertices vertexView(&mv, mv.local(), defaultStream);
+    PVviewWithOldParticles pvView(&pv, pv.local());
+    const MeshView meshView(mesh.get());
+
+    const int nthreads = 128;
+    const int totalTriangles = nObjects * mesh->getNtriangles();
+
+    PinnedBuffer<int> counts(cinfo.totcells), starts(cinfo.totcells + 1);
+    counts.clear(defaultStream);
+
+    SAFE_KERNEL_LAUNCH(
+            countTrianglesPerCell,
+            getNblocks(totalTriangles, nthreads), nthreads, 0, defaultStream,
+            vertexView, meshView, cinfo, counts.devPtr() );
+
+    counts.downloadFromDevice(defaultStream, ContainersSynch::Synch);
+    starts[0] = 0;
+    for (int i = 0; i < cinfo.totcells; ++i)
+        starts[i+1] = starts[i] + counts[i];
+    starts.uploadToDevice(defaultStream);
+
+    DeviceBuffer<int> triangleCells(starts[cinfo.totcells]);
+    counts.clear(defaultStream);
+
+    SAFE_KERNEL_LAUNCH(
+            fillTriangleCells,
+            getNblocks(totalTriangles, nthreads), nthreads, 0, defaultStream,
+            vertexView, meshView, cinfo, starts.devPtr(), counts.devPtr(), triangleCells.devPtr() );
+
+    const int capacity = static_cast<int>(s.positions.size()) * 16;
+    PinnedBuffer<int> nCandidates(1);
+    PinnedBuffer<int2> table(capacity);
+    nCandidates.clear(defaultStream);
+
+    SAFE_KERNEL_LAUNCH(
+            findBouncesInTriangleCells,
+            getNblocks(pvView.size, nthreads), nthreads, 0, defaultStream,
+            vertexView, pvView, meshView, cinfo, starts.devPtr(), triangleCells.devPtr(),
+            TriangleTable {capacity, nCandidates.devPtr(), table.devPtr()} );
+
+    nCandidates.downloadFromDevice(defaultStream, ContainersSynch::Synch);
+    table.downloadFromDevice(defaultStream, ContainersSynch::Synch);
+
+    EXPECT_LE(nCandidates[0], capacity);
+
+    std::vector<int2> candidates(table.begin(), table.begin() + std::min(nCandidates[0], capacity));
+    std::sort(candidates.begin(), candidates.end());
+    return candidates;
+}
+
+TEST (MESH_BOUNCE, gpu_broad_phase_matches_host)
+{
+    const real3 L {8.0_r, 8.0_r, 8.0_r};
+    const auto s = createScene(L, 2, 2, 4.0_r, 4242);
+    const CellListInfo cinfo(1.0_r, L);
+
+    auto reference = bruteForceCandidates(s);
+    auto hostCandidates = mesh_bounce_host::findBounceCandidates(cinfo, s.faces, s.nvertices,
+                                                                 s.vertices, s.oldVertices,
+                                                                 s.positions, s.oldPositions);
+    const auto gpuCandidates = findBounceCandidatesGPU(s, cinfo);
+
+    std::sort(reference.begin(), reference.end());
+    std::sort(hostCandidates.begin(), hostCandidates.end());
+
+    ASSERT_GT(reference.size(), 0);
+    ASSERT_EQ(gpuCandidates.size(), reference.size());
+    ASSERT_EQ(gpuCandidates.size(), hostCandidates.size());
+
+    for (size_t i = 0; i < reference.size(); ++i)
+    {
+        ASSERT_EQ(gpuCandidates[i].x, reference[i].x) << "candidate " << i;
+        ASSERT_EQ(gpuCandidates[i].y, reference[i].y) << "candidate " << i;
+        ASSERT_EQ(gpuCandidates[i].x, hostCandidates[i].x) << "candidate " << i;
+        ASSERT_EQ(gpuCandidates[i].y, hostCandidates[i].y) << "candidate " << i;
+    }
+}
+
+TEST (MESH_BOUNCE, broad_phase_host_benchmark)
+{
+    const real3 L {24.0_r, 24.0_r, 24.0_r};
+    const CellListInfo cinfo(1.0_r, L);
+
+    for (int nSubdivisions : {2, 3, 4})
+    {
+        const auto s = createScene(L, 4, nSubdivisions, 10.0_r, 1234);
+
+        Timer timer;
+        timer.start();
+        const auto candidates = mesh_bounce_host::findBounceCandidates(cinfo, s.faces, s.nvertices,
+                                                                       s.vertices, s.oldVertices,
+                                                                       s.positions, s.oldPositions);
+        const double tms = timer.elapsed() * 1e-6;
+
+        const long scannedPairs = countPerTriangleScanPairs(s, cinfo);
+
+        printf("%6zu triangles per object: %8ld pairs scanned by the per-triangle scan, %6zu candidates, %8.2f ms on host\n",
+               s.faces.size(), scannedPairs, candidates.size(), tms);
+    }
+}
+
+TEST (MESH_BOUNCE, gpu_benchmark)
+{
+    const real3 L {24.0_r, 24.0_r, 24.0_r};
+    const real rc = 1.0_r;
+    const real dt = 0.01_r;
+    DomainInfo domain {L, {0.0_r, 0.0_r, 0.0_r}, L};
+    MirState state(domain, dt, UnitConversion{});
+
+    for (int nSubdivisions : {2, 3, 4})
+    {
+        const int nSpheresPerDim = 4;
+        const auto s = createScene(L, nSpheresPerDim, nSubdivisions, 10.0_r, 1234);
+        const int nObjects = nSpheresPerDim * nSpheresPerDim * nSpheresPerDim;
+
+        auto mesh = std::make_shared<MembraneMesh>(std::vector<real3>(s.vertices.begin(), s.vertices.begin() + s.nvertices), s.faces);
+        MembraneVector mv(&state, "mv", 1.0_r, mesh, nObjects);
+        ParticleVector pv(&state, "pv", 1.0_r, static_cast<int>(s.positions.size()));
+        CellList cl(&pv, rc, L);
+
+        BounceFromMesh bouncer(&state, "bouncer", BounceBack{});
+        bouncer.setup(&mv);
+        bouncer.setPrerequisites(&pv);
+
+        auto resetParticles = [&]()
+        {
+            uploadPositions(s.positions,    pv.local()->positions());
+            uploadPositions(s.oldPositions, *pv.local()->dataPerParticle.getData<real4>(channel_names::oldPositions));
+            pv.local()->velocities().clear(defaultStream);
+        };
+
+        uploadPositions(s.vertices,    mv.local()->positions());
+        uploadPositions(s.oldVertices, *mv.local()->dataPerParticle.getData<real4>(channel_names::oldPositions));
+
+        const int nrepeat = 10;
+        int64_t elapsed = 0;
+        for (int i = 0; i < nrepeat; ++i)
+        {
+            resetParticles();
+            CUDA_Check( cudaDeviceSynchronize() );
+
+            Timer timer;
+            timer.start();
+            bouncer.bounceLocal(&pv, &cl, defaultStream);
+            CUDA_Check( cudaDeviceSynchronize() );
+            elapsed += timer.elapsed();
+        }
+
+        printf("%3d objects of %6zu triangles, %8zu particles: %8.3f ms per bounce\n",
+               nObjects, s.faces.size(), s.positions.size(), elapsed * 1e-6 / nrepeat);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+
+    logger.init(MPI_COMM_WORLD, "mesh_bounce.log", 0);
+
+    testing::InitGoogleTest(&argc, argv);
+    auto ret = RUN_ALL_TESTS();
+
+    MPI_Finalize();
+    return ret;
+}
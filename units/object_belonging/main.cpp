@@ -0,0 +1,218 @@
+#include "../timer.h"
+
+#include <mirheo/core/logger.h>
+#include <mirheo/core/mesh/off.h>
+#include <mirheo/core/object_belonging/winding_number.h>
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace mirheo;
+
+struct TestMesh
+{
+    std::vector<real3> vertices;
+    std::vector<int3> triangles;
+};
+
+static TestMesh readTestMesh(const std::string& name)
+{
+    TestMesh m;
+    std::tie(m.vertices, m.triangles) = readOff(std::string(MIRHEO_DATA_PATH) + name);
+    return m;
+}
+
+static real exactWindingNumber(const TestMesh& m, real3 r)
+{
+    real omega = 0.0_r;
+    for (auto t : m.triangles)
+        omega += winding_number::triangleSolidAngle(m.vertices[t.x] - r, m.vertices[t.y] - r, m.vertices[t.z] - r);
+    return omega / (4.0_r * static_cast<real>(M_PI));
+}
+
+// same test as the device version in mesh_belonging.cu: majority vote over the parity of 3 rays
+static bool insideRayTest(const TestMesh& m, real3 r)
+{
+    constexpr real tolerance = 1e-6_r;
+    const real3 rays[3] = {{0, 1, 0}, {0, 1, 0}, {0, 1, 0}};
+
+    auto intersects = [&](real3 dir, real3 v0, real3 v1, real3 v2)
+    {
+        const real3 e1 = v1 - v0;
+        const real3 e2 = v2 - v0;
+        const real3 h = cross(dir, e2);
+        const real a = dot(e1, h);
+        if (math::abs(a) < tolerance) return false;
+        const real f = 1.0_r / a;
+        const real3 s = r - v0;
+        const real u = f * dot(s, h);
+        if (u < 0.0_r || u > 1.0_r) return false;
+        const real3 q = cross(s, e1);
+        const real v = f * dot(dir, q);
+        if (v < 0.0_r || u + v > 1.0_r) return false;
+        return f * dot(e2, q) > tolerance;
+    };
+
+    int nOdd = 0;
+    for (auto dir : rays)
+    {
+        int n = 0;
+        for (auto t : m.triangles)
+            if (intersects(dir, m.vertices[t.x], m.vertices[t.y], m.vertices[t.z]))
+                ++n;
+        nOdd += n % 2;
+    }
+    return nOdd > 1;
+}
+
+// hierarchy of a mesh with its far field data, as used by the belonging checker
+struct Hierarchy
+{
+    Hierarchy(const TestMesh& m, real farFieldRatio, int leafSize) :
+        vertices(m.vertices),
+        triangles(m.triangles)
+    {
+        nodes = winding_number::buildTree(vertices, triangles, leafSize);
+        centers.resize(nodes.size());
+        normals.resize(nodes.size());
+
+        auto getVertex = [&](int i) { return vertices[i]; };
+        for (size_t i = 0; i < nodes.size(); ++i)
+            winding_number::computeNodeGeometry(nodes[i], triangles.data(), getVertex, centers[i], normals[i]);
+
+        tree = {static_cast<int>(nodes.size()), nodes.data(), triangles.data(), farFieldRatio};
+    }
+
+    real evaluate(real3 r) const
+    {
+        auto getVertex = [&](int i) { return vertices[i]; };
+        return winding_number::evaluate(r, tree, centers.data(), normals.data(), getVertex);
+    }
+
+    std::vector<real3> vertices;
+    std::vector<int3> triangles;
+    std::vector<winding_number::TreeNode> nodes;
+    std::vector<real4> centers, normals;
+    winding_number::TreeView tree;
+};
+
+// uniform points in the bounding box of the mesh, inflated by a margin
+static std::vector<real3> samplePoints(const TestMesh& m, int n, long seed)
+{
+    real3 lo = m.vertices[0], hi = m.vertices[0];
+    for (auto v : m.vertices)
+    {
+        lo = math::min(lo, v);
+        hi = math::max(hi, v);
+    }
+    lo = lo - 0.5_r;
+    hi = hi + 0.5_r;
+
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<real> u01(0.0_r, 1.0_r);
+
+    std::vector<real3> points(n);
+    for (auto& p : points)
+        p = lo + (hi - lo) * real3{u01(gen), u01(gen), u01(gen)};
+    return points;
+}
+
+static const std::vector<std::string> testMeshes {"rbc_mesh.off", "sphere_mesh.off"};
+
+TEST (WINDING_NUMBER, hierarchical_matches_exact)
+{
+    for (const auto& name : testMeshes)
+    {
+        const auto m = readTestMesh(name);
+        const Hierarchy h(m, 2.0_r, 8);
+
+        real maxError = 0.0_r;
+        for (auto r : samplePoints(m, 2000, 42))
+        {
+            const real we = exactWindingNumber(m, r);
+            const real wh = h.evaluate(r);
+            maxError = math::max(maxError, math::abs(we - wh));
+
+            ASSERT_EQ(we > 0.5_r, wh > 0.5_r) << name << " at " << r.x << " " << r.y << " " << r.z;
+        }
+        ASSERT_LE(maxError, 0.1_r) << name;
+    }
+}
+
+TEST (WINDING_NUMBER, agrees_with_ray_test_on_closed_mesh)
+{
+    for (const auto& name : testMeshes)
+    {
+        const auto m = readTestMesh(name);
+        const Hierarchy h(m, 2.0_r, 8);
+
+        int nDisagree = 0, nInside = 0;
+        for (auto r : samplePoints(m, 2000, 4242))
+        {
+            const bool inside = h.evaluate(r) > 0.5_r;
+            nInside += inside;
+            if (inside != insideRayTest(m, r))
+                ++nDisagree;
+        }
+
+        ASSERT_GT(nInside, 0) << name;
+        ASSERT_LE(nDisagree, 2) << name; // only possible for points within round-off of the surface
+    }
+}
+
+TEST (WINDING_NUMBER, robust_to_holes)
+{
+    for (const auto& name : testMeshes)
+    {
+        auto m = readTestMesh(name);
+
+        real3 com {0.0_r, 0.0_r, 0.0_r};
+        for (auto v : m.vertices)
+            com = com + v;
+        com = com / static_cast<real>(m.vertices.size());
+
+        // open the mesh
+        m.triangles.erase(m.triangles.begin(), m.triangles.begin() + 4);
+        const Hierarchy h(m, 2.0_r, 8);
+
+        ASSERT_GT(h.evaluate(com), 0.5_r) << name;
+        ASSERT_LT(h.evaluate(com + real3{100.0_r, 0.0_r, 0.0_r}), 0.5_r) << name;
+    }
+}
+
+TEST (WINDING_NUMBER, timings)
+{
+    for (const auto& name : testMeshes)
+    {
+        const auto m = readTestMesh(name);
+        const Hierarchy h(m, 2.0_r, 8);
+        const auto points = samplePoints(m, 2000, 1234);
+
+        Timer timer;
+        int n = 0;
+
+        timer.start();
+        for (auto r : points) n += insideRayTest(m, r);
+        const double tRays = timer.elapsedAndReset() * 1e-6;
+
+        for (auto r : points) n += exactWindingNumber(m, r) > 0.5_r;
+        const double tExact = timer.elapsedAndReset() * 1e-6;
+
+        for (auto r : points) n += h.evaluate(r) > 0.5_r;
+        const double tHierarchical = timer.elapsedAndReset() * 1e-6;
+
+        printf("%s (%d triangles), %d points: rays %g ms, exact winding number %g ms, hierarchical winding number %g ms (%d inside)\n",
+               name.c_str(), static_cast<int>(m.triangles.size()), static_cast<int>(points.size()),
+               tRays, tExact, tHierarchical, n / 3);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
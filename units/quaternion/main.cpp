@@ -86,6 +86,46 @@ TEST (QUATERNION, construction_opposite )
     }
 }
 
+TEST (QUATERNION, slerp )
+{
+    const real angle = 0.8_r * M_PI;
+    const auto q0 = Quaternion<real>::createFromRotation(0.0_r, ez);
+    const auto q1 = Quaternion<real>::createFromRotation(angle, ez);
+
+    for (real t : {0.0_r, 0.25_r, 0.5_r, 1.0_r})
+    {
+        const auto q = Quaternion<real>::slerp(q0, q1, t);
+        const auto ref = Quaternion<real>::createFromRotation(t * angle, ez);
+        assertEquals(ref.rotate(ex), q.rotate(ex));
+        ASSERT_NEAR(q.norm(), 1.0_r, 1e-6_r);
+    }
+
+    // q and -q represent the same rotation; slerp must follow the shortest arc
+    const auto q = Quaternion<real>::slerp(q0, -1.0_r * q1, 0.5_r);
+    const auto ref = Quaternion<real>::createFromRotation(0.5_r * angle, ez);
+    assertEquals(ref.rotate(ex), q.rotate(ex));
+}
+
+TEST (QUATERNION, rotationAngle )
+{
+    const unsigned long seed = 4242;
+    const int numTries = 50;
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<real> U(0.0_r, M_PI);
+
+    for (int i = 0; i < numTries; ++i)
+    {
+        const auto axis0 = makeRandomUnitVector(gen);
+        const auto axis1 = makeRandomUnitVector(gen);
+        const real angle = U(gen);
+
+        const auto q0 = Quaternion<real>::createFromRotation(U(gen), axis0);
+        const auto q1 = Quaternion<real>::createFromRotation(angle, axis1) * q0;
+
+        ASSERT_NEAR(Quaternion<real>::rotationAngle(q0, q1), angle, 1e-3_r);
+    }
+}
+
 int main(int argc, char **argv)
 {
     testing::InitGoogleTest(&argc, argv);
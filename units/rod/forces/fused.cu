@@ -0,0 +1,254 @@
+#include "../../timer.h"
+
+#include <mirheo/core/initial_conditions/rod.h>
+#include <mirheo/core/initial_conditions/rod_with_parameter_scales.h>
+#include <mirheo/core/interactions/rod/drivers_forces.h>
+#include <mirheo/core/interactions/rod/rod.h>
+#include <mirheo/core/logger.h>
+#include <mirheo/core/pvs/rod_vector.h>
+#include <mirheo/core/pvs/views/rv.h>
+#include <mirheo/core/utils/cuda_common.h>
+#include <mirheo/core/utils/helper_math.h>
+#include <mirheo/core/utils/kernel_launch.h>
+
+#include <cmath>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace mirheo;
+
+constexpr real a = 0.05_r;
+
+static RodParameters helixParameters()
+{
+    RodParameters params;
+    params.kBending = {1.0_r, 0.1_r, 2.0_r};
+    params.kappaEq  = {{0.5_r, 0.1_r}};
+    params.kTwist   = 1.0_r;
+    params.tauEq    = {0.2_r};
+    params.groundE  = {0.0_r};
+    params.a0       = a;
+    params.l0       = 0.1_r;
+    params.ksCenter = 10.0_r;
+    params.ksFrame  = 10.0_r;
+    return params;
+}
+
+static void initializeHelices(const MPI_Comm& comm, RodVector& rv, int nRods, real L,
+                              const std::vector<real3>& scales = {})
+{
+    const real pitch  = 1.0_r;
+    const real radius = 0.5_r;
+    const real height = 0.5_r * L;
+    const real nTurns = height / pitch;
+
+    RodIC::MappingFunc3D centerLine = [&](real s)
+    {
+        const real t = 2.0_r * static_cast<real>(M_PI) * nTurns * s;
+        return real3({radius * math::cos(t), radius * math::sin(t), (s - 0.5_r) * height});
+    };
+
+    RodIC::MappingFunc1D torsion = [&](real s)
+    {
+        return 0.3_r * math::sin(4.0_r * static_cast<real>(M_PI) * s);
+    };
+
+    std::vector<ComQ> comqs;
+    for (int i = 0; i < nRods; ++i)
+    {
+        const real x = L * (i + 0.5_r) / nRods;
+        comqs.push_back({{x, 0.5_r * L, 0.5_r * L}, {1.0_r, 0.0_r, 0.0_r, 0.0_r}});
+    }
+
+    if (scales.empty())
+    {
+        RodIC ic(comqs, centerLine, torsion, a);
+        ic.exec(comm, &rv, defaultStream);
+    }
+    else
+    {
+        RodWithParameterScalesIC ic(comqs, scales, centerLine, torsion, a);
+        ic.exec(comm, &rv, defaultStream);
+    }
+}
+
+// launch the separate bound and bisegment kernels, as done with polymorphic states
+static void computeForcesSeparate(RodVector& rv, const RodParameters& params, RodObjectScales scales,
+                                  bool saveEnergies = false)
+{
+    RVview view(&rv, rv.local());
+    const int nthreads = 128;
+
+    SAFE_KERNEL_LAUNCH(rod_forces_kernels::computeRodBoundForces,
+                       getNblocks(view.nObjects * view.nSegments, nthreads), nthreads, 0, defaultStream,
+                       view, getBoundParams(params), scales);
+
+    SAFE_KERNEL_LAUNCH(rod_forces_kernels::computeRodBiSegmentForces<1>,
+                       getNblocks(view.nObjects * (view.nSegments-1), nthreads), nthreads, 0, defaultStream,
+                       view, getBiSegmentParams<1>(params), scales, saveEnergies);
+}
+
+static void computeForcesFused(RodVector& rv, const RodParameters& params, RodObjectScales scales,
+                               bool saveEnergies = false)
+{
+    RVview view(&rv, rv.local());
+    const int nthreads = 128;
+
+    SAFE_KERNEL_LAUNCH(rod_forces_kernels::computeRodForcesFused<1>,
+                       getNblocks(view.nObjects * view.nSegments, nthreads), nthreads, 0, defaultStream,
+                       view, getBoundParams(params), getBiSegmentParams<1>(params), scales, saveEnergies);
+}
+
+template <class ComputeForces>
+static std::vector<real3> getForces(RodVector& rv, ComputeForces computeForces)
+{
+    auto& forces = rv.local()->forces();
+    forces.clear(defaultStream);
+    computeForces();
+    forces.downloadFromDevice(defaultStream, ContainersSynch::Synch);
+
+    std::vector<real3> f;
+    f.reserve(forces.size());
+    for (const auto& force : forces)
+        f.push_back(force.f);
+    return f;
+}
+
+TEST (ROD_FUSED, same_forces_as_separate_kernels)
+{
+    const real L = 32.0_r;
+    DomainInfo domain {{L, L, L}, {0._r, 0._r, 0._r}, {L, L, L}};
+    MirState state(domain, 0.0_r, UnitConversion{});
+
+    const auto params = helixParameters();
+    RodVector rv(&state, "rod", 1.0_r, 200);
+    initializeHelices(MPI_COMM_WORLD, rv, 8, L);
+
+    RodObjectScales scales;
+    scales.setup(&rv);
+
+    const auto ref = getForces(rv, [&]() {computeForcesSeparate(rv, params, scales);});
+    const auto fused = getForces(rv, [&]() {computeForcesFused(rv, params, scales);});
+
+    ASSERT_EQ(ref.size(), fused.size());
+
+    real maxForce = 0.0_r;
+    for (auto f : ref)
+        maxForce = std::max(maxForce, length(f));
+
+    for (size_t i = 0; i < ref.size(); ++i)
+        ASSERT_LE(length(ref[i] - fused[i]), 1e-4_r * maxForce) << "particle " << i;
+}
+
+template <class ComputeForces>
+static std::vector<real> getEnergies(RodVector& rv, ComputeForces computeForces)
+{
+    auto& energies = *rv.local()->dataPerBisegment.getData<real>(channel_names::energies);
+    energies.clear(defaultStream);
+    computeForces();
+    energies.downloadFromDevice(defaultStream, ContainersSynch::Synch);
+    return {energies.begin(), energies.end()};
+}
+
+TEST (ROD_FUSED, same_forces_and_energies_with_parameter_scales)
+{
+    const real L = 32.0_r;
+    DomainInfo domain {{L, L, L}, {0._r, 0._r, 0._r}, {L, L, L}};
+    MirState state(domain, 0.0_r, UnitConversion{});
+
+    const auto params = helixParameters();
+    const int nRods = 8;
+    RodVector rv(&state, "rod", 1.0_r, 200);
+
+    // different (bounds, bending, twist) scales for each rod, none equal to 1
+    std::vector<real3> rodScales;
+    for (int i = 0; i < nRods; ++i)
+        rodScales.push_back({0.5_r + 0.25_r * static_cast<real>(i),
+                             2.0_r - 0.2_r * static_cast<real>(i),
+                             0.3_r + 0.4_r * static_cast<real>(i % 3)});
+
+    // required before the initial conditions so that the channel is sized with the bisegments
+    rv.requireDataPerBisegment<real>(channel_names::energies, DataManager::PersistenceMode::None);
+    initializeHelices(MPI_COMM_WORLD, rv, nRods, L, rodScales);
+
+    RodObjectScales scales;
+    scales.setup(&rv);
+
+    auto computeSeparate = [&]() {computeForcesSeparate(rv, params, scales, true);};
+    auto computeFused    = [&]() {computeForcesFused   (rv, params, scales, true);};
+
+    const auto ref   = getForces(rv, computeSeparate);
+    const auto fused = getForces(rv, computeFused);
+
+    // the scales must have an effect on the forces
+    RodObjectScales unitScales;
+    const auto unscaled = getForces(rv, [&]() {computeForcesSeparate(rv, params, unitScales);});
+
+    ASSERT_EQ(ref.size(), fused.size());
+
+    real maxForce = 0.0_r, maxScalingEffect = 0.0_r;
+    for (size_t i = 0; i < ref.size(); ++i)
+    {
+        maxForce = std::max(maxForce, length(ref[i]));
+        maxScalingEffect = std::max(maxScalingEffect, length(ref[i] - unscaled[i]));
+    }
+    ASSERT_GT(maxScalingEffect, 0.1_r * maxForce);
+
+    for (size_t i = 0; i < ref.size(); ++i)
+        ASSERT_LE(length(ref[i] - fused[i]), 1e-4_r * maxForce) << "particle " << i;
+
+    const auto refEnergies   = getEnergies(rv, computeSeparate);
+    const auto fusedEnergies = getEnergies(rv, computeFused);
+
+    ASSERT_EQ(refEnergies.size(), fusedEnergies.size());
+
+    real maxEnergy = 0.0_r;
+    for (auto e : refEnergies)
+        maxEnergy = std::max(maxEnergy, std::abs(e));
+    ASSERT_GT(maxEnergy, 0.0_r);
+
+    for (size_t i = 0; i < refEnergies.size(); ++i)
+        ASSERT_LE(std::abs(refEnergies[i] - fusedEnergies[i]), 1e-4_r * maxEnergy) << "bisegment " << i;
+}
+
+TEST (ROD_FUSED, benchmark)
+{
+    const real L = 32.0_r;
+    DomainInfo domain {{L, L, L}, {0._r, 0._r, 0._r}, {L, L, L}};
+    MirState state(domain, 0.0_r, UnitConversion{});
+
+    const auto params = helixParameters();
+    const int nSegments = 100;
+    const int nrepeat = 50;
+
+    for (int nRods : {64, 512, 4096})
+    {
+        RodVector rv(&state, "rod", 1.0_r, nSegments);
+        initializeHelices(MPI_COMM_WORLD, rv, nRods, L);
+
+        RodObjectScales scales;
+        scales.setup(&rv);
+
+        auto measure = [&](auto computeForces)
+        {
+            computeForces(); // warm up
+            CUDA_Check( cudaDeviceSynchronize() );
+
+            Timer timer;
+            timer.start();
+            for (int i = 0; i < nrepeat; ++i)
+                computeForces();
+            CUDA_Check( cudaDeviceSynchronize() );
+            return timer.elapsed() * 1e-6 / nrepeat;
+        };
+
+        const double tSeparate = measure([&]() {computeForcesSeparate(rv, params, scales);});
+        const double tFused    = measure([&]() {computeForcesFused   (rv, params, scales);});
+
+        const double nSeg = static_cast<double>(nRods) * nSegments;
+        printf("%5d rods of %d segments: separate %8.3f ms (%7.2f Mseg/s), fused %8.3f ms (%7.2f Mseg/s)\n",
+               nRods, nSegments,
+               tSeparate, nSeg / (tSeparate * 1e3),
+               tFused,    nSeg / (tFused    * 1e3));
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <mirheo/core/initial_conditions/rod.h>
+#include <mirheo/core/interactions/rod/kernels/parameters.h>
+#include <mirheo/core/pvs/rod_vector.h>
+#include <mirheo/core/utils/cuda_common.h>
+
+#include <vector>
+
+using namespace mirheo;
+
+constexpr real a = 0.05_r;
+
+// straight rods without torsion: curvature and torsion vanish, the energy of each state is its ground energy
+static void initializeStraightRods(const MPI_Comm& comm, RodVector& rv, int nRods, real L)
+{
+    RodIC::MappingFunc3D centerLine = [&](real s)
+    {
+        return real3({0.0_r, 0.0_r, (s - 0.5_r) * 0.5_r * L});
+    };
+
+    RodIC::MappingFunc1D torsion = [&](__UNUSED real s)
+    {
+        return 0.0_r;
+    };
+
+    std::vector<ComQ> comqs;
+    for (int i = 0; i < nRods; ++i)
+    {
+        const real x = L * (i + 0.5_r) / nRods;
+        comqs.push_back({{x, 0.5_r * L, 0.5_r * L}, {1.0_r, 0.0_r, 0.0_r, 0.0_r}});
+    }
+
+    RodIC ic(comqs, centerLine, torsion, a);
+    ic.exec(comm, &rv, defaultStream);
+}
+
+static RodParameters twoStatesParameters(real dE)
+{
+    RodParameters params;
+    params.kBending = {1.0_r, 0.0_r, 1.0_r};
+    params.kappaEq  = {{0.0_r, 0.0_r}, {0.0_r, 0.0_r}};
+    params.kTwist   = 1.0_r;
+    params.tauEq    = {0.0_r, 0.0_r};
+    params.groundE  = {0.0_r, dE};
+    params.a0       = a;
+    params.l0       = 0.0_r;
+    params.ksCenter = 0.0_r;
+    params.ksFrame  = 0.0_r;
+    return params;
+}
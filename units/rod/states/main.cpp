@@ -0,0 +1,118 @@
+#include "common.h"
+
+#include <mirheo/core/interactions/rod/base_rod.h>
+#include <mirheo/core/interactions/rod/factory.h>
+#include <mirheo/core/logger.h>
+#include <mirheo/core/pvs/rod_vector.h>
+#include <mirheo/core/utils/cuda_common.h>
+#include <mirheo/core/utils/helper_math.h>
+
+#include <cmath>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace mirheo;
+
+constexpr real dt = 0._r;
+
+// fraction of bisegments in state 1 in an infinite Ising chain with coupling J and energy difference dE between the two states
+static double referenceFractionState1(double kBT, double J, double dE)
+{
+    const double beta = 1.0 / kBT;
+    // symmetric transfer matrix [[1, c], [c, b]]
+    const double b = std::exp(-beta * dE);
+    const double c = std::exp(-beta * (J + 0.5 * dE));
+
+    const double lambda = 0.5 * (1.0 + b) + std::sqrt(0.25 * (1.0 - b) * (1.0 - b) + c * c);
+    // leading eigenvector (c, lambda - 1)
+    const double v0 = c;
+    const double v1 = lambda - 1.0;
+    return v1 * v1 / (v0 * v0 + v1 * v1);
+}
+
+static double measureFractionState1(const MPI_Comm& comm, int nRods, int nSegments,
+                                    real kBT, real J, real dE, int nsteps, int nsamples)
+{
+    DomainInfo domain;
+    const real L = 32.0_r;
+    domain.globalSize  = {L, L, L};
+    domain.globalStart = {0._r, 0._r, 0._r};
+    domain.localSize   = {L, L, L};
+    MirState state(domain, dt, UnitConversion{});
+
+    RodVector rv(&state, "rod", 1.0_r, nSegments);
+    initializeStraightRods(comm, rv, nRods, L);
+
+    StatesSpinParameters spinParams;
+    spinParams.nsteps = nsteps;
+    spinParams.kBT    = kBT;
+    spinParams.J      = J;
+
+    auto interaction = createInteractionRod(&state, "rod_interaction", twoStatesParameters(dE), spinParams, false);
+    interaction->setPrerequisites(&rv, &rv, nullptr, nullptr);
+
+    auto& states = *rv.local()->dataPerBisegment.getData<int>(channel_names::polyStates);
+
+    long nState1 = 0;
+    long nTotal  = 0;
+
+    for (int sample = 0; sample < nsamples; ++sample)
+    {
+        rv.local()->forces().clear(defaultStream);
+        interaction->local(&rv, &rv, nullptr, nullptr, defaultStream);
+        states.downloadFromDevice(defaultStream, ContainersSynch::Synch);
+
+        for (auto s : states)
+            nState1 += (s == 1);
+        nTotal += states.size();
+    }
+
+    return static_cast<double>(nState1) / static_cast<double>(nTotal);
+}
+
+// one block per rod
+TEST (ROD_STATES, detailed_balance_short_rods_no_coupling)
+{
+    const real kBT = 1.0_r, J = 0.0_r, dE = 0.5_r;
+    const double ref = referenceFractionState1(kBT, J, dE);
+    const double sim = measureFractionState1(MPI_COMM_WORLD, 64, 101, kBT, J, dE, 20, 5);
+    ASSERT_NEAR(sim, ref, 0.02);
+}
+
+// checkerboard update over all bisegments
+TEST (ROD_STATES, detailed_balance_long_rods_no_coupling)
+{
+    const real kBT = 1.0_r, J = 0.0_r, dE = 0.5_r;
+    const double ref = referenceFractionState1(kBT, J, dE);
+    const double sim = measureFractionState1(MPI_COMM_WORLD, 4, 2001, kBT, J, dE, 20, 5);
+    ASSERT_NEAR(sim, ref, 0.02);
+}
+
+TEST (ROD_STATES, detailed_balance_short_rods_coupling)
+{
+    const real kBT = 1.0_r, J = 0.5_r, dE = 0.5_r;
+    const double ref = referenceFractionState1(kBT, J, dE);
+    const double sim = measureFractionState1(MPI_COMM_WORLD, 16, 501, kBT, J, dE, 500, 5);
+    ASSERT_NEAR(sim, ref, 0.02);
+}
+
+TEST (ROD_STATES, detailed_balance_long_rods_coupling)
+{
+    const real kBT = 1.0_r, J = 0.5_r, dE = 0.5_r;
+    const double ref = referenceFractionState1(kBT, J, dE);
+    const double sim = measureFractionState1(MPI_COMM_WORLD, 4, 2001, kBT, J, dE, 500, 5);
+    ASSERT_NEAR(sim, ref, 0.02);
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+
+    logger.init(MPI_COMM_WORLD, "rod_states.log", 0);
+
+    testing::InitGoogleTest(&argc, argv);
+    auto ret = RUN_ALL_TESTS();
+
+    MPI_Finalize();
+    return ret;
+}
@@ -0,0 +1,73 @@
+#include "common.h"
+#include "../../timer.h"
+
+#include <mirheo/core/interactions/rod/base_rod.h>
+#include <mirheo/core/interactions/rod/factory.h>
+#include <mirheo/core/interactions/rod/polymorphic_states.h>
+#include <mirheo/core/logger.h>
+#include <mirheo/core/pvs/rod_vector.h>
+#include <mirheo/core/pvs/views/rv.h>
+#include <mirheo/core/utils/cuda_common.h>
+
+#include <cstdio>
+#include <gtest/gtest.h>
+
+// throughput of the MC sweeps only; the state energies and the elastic forces are not part of the timing.
+// Should scale with the number of bisegments, not be latency bound.
+TEST (ROD_STATES, benchmark_mc_sweeps)
+{
+    DomainInfo domain;
+    const real L = 32.0_r;
+    domain.globalSize  = {L, L, L};
+    domain.globalStart = {0._r, 0._r, 0._r};
+    domain.localSize   = {L, L, L};
+    MirState state(domain, 0.0_r, UnitConversion{});
+
+    constexpr int Nstates = 2;
+    const real dE = 0.5_r;
+    const int nRods = 16;
+
+    StatesSpinParameters spinParams;
+    spinParams.nsteps = 100;
+    spinParams.kBT    = 1.0_r;
+    spinParams.J      = 0.5_r;
+
+    for (int nSegments : {256, 1024, 4096, 16384})
+    {
+        RodVector rv(&state, "rod", 1.0_r, nSegments);
+        initializeStraightRods(MPI_COMM_WORLD, rv, nRods, L);
+
+        // only used to create the states channel
+        auto interaction = createInteractionRod(&state, "rod_interaction", twoStatesParameters(dE), spinParams, false);
+        interaction->setPrerequisites(&rv, &rv, nullptr, nullptr);
+
+        RVview view(&rv, rv.local());
+        const int nBiSegmentsTot = view.nObjects * (nSegments - 1);
+
+        // straight rods: the energy of each state is its ground energy
+        PinnedBuffer<real> stateEnergies(nBiSegmentsTot * Nstates);
+        for (int i = 0; i < nBiSegmentsTot; ++i)
+        {
+            stateEnergies[Nstates * i + 0] = 0.0_r;
+            stateEnergies[Nstates * i + 1] = dE;
+        }
+        stateEnergies.uploadToDevice(defaultStream);
+        rv.local()->dataPerBisegment.getData<int>(channel_names::polyStates)->clear(defaultStream);
+
+        // warm up
+        runSpinMonteCarloSweeps<Nstates>(view, spinParams, stateEnergies.devPtr(), defaultStream);
+        CUDA_Check( cudaDeviceSynchronize() );
+
+        const int nrepeat = 10;
+        Timer timer;
+        timer.start();
+        for (int i = 0; i < nrepeat; ++i)
+            runSpinMonteCarloSweeps<Nstates>(view, spinParams, stateEnergies.devPtr(), defaultStream);
+        CUDA_Check( cudaDeviceSynchronize() );
+
+        const double tms = timer.elapsed() * 1e-6 / nrepeat;
+        const double nUpdates = static_cast<double>(spinParams.nsteps) * nRods * (nSegments - 1);
+        printf("%d rods of %6d segments: %8.3f ms per %d sweeps, %8.3f bisegment updates per ns\n",
+               nRods, nSegments, tms, spinParams.nsteps, nUpdates / (tms * 1e6));
+    }
+}
@@ -57,6 +57,20 @@ TEST (ROOTS, LinearSearch_sqrt)
     testSolver(sqrtSolverLinearSearch);
 }
 
+TEST (ROOTS, FirstRootSampled)
+{
+    // two roots in [0, 1]: 0.2 and 0.6; the first one must be found
+    auto f = [](float x) {return (x - 0.2f) * (x - 0.6f);};
+    const root_finder::Bounds limits{0.f, 1.f};
+
+    const auto root = root_finder::firstRootSampled(f, limits, 8);
+    ASSERT_LE(math::abs(root.x - 0.2f), 1e-5f);
+
+    // too few samples to see the sign changes
+    const auto noRoot = root_finder::firstRootSampled(f, limits, 1);
+    ASSERT_TRUE(noRoot == root_finder::invalidRoot);
+}
+
 int main(int argc, char **argv)
 {
     testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,350 @@
+#include <mirheo/core/logger.h>
+#include <mirheo/core/utils/cuda_common.h>
+#include <mirheo/core/utils/kernel_launch.h>
+#include <mirheo/core/walls/factory.h>
+#include <mirheo/core/walls/stationary_walls/composite.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <gtest/gtest.h>
+#include <functional>
+#include <random>
+#include <vector>
+
+using namespace mirheo;
+
+using Operation = CompositeWallExpression::Operation;
+
+static const real3 domainSize {16.0_r, 16.0_r, 16.0_r};
+
+template <class Checker>
+__global__ void evaluateSdf(Checker checker, int n, const real3 *positions, real *values)
+{
+    const int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i >= n) return;
+    values[i] = checker(positions[i]);
+}
+
+template <class Checker>
+static std::vector<real> evaluate(const Checker& checker, const std::vector<real3>& positions)
+{
+    const int n = static_cast<int>(positions.size());
+    PinnedBuffer<real3> pos(n);
+    PinnedBuffer<real> values(n);
+
+    std::copy(positions.begin(), positions.end(), pos.begin());
+    pos.uploadToDevice(defaultStream);
+
+    const int nthreads = 128;
+    SAFE_KERNEL_LAUNCH(
+        evaluateSdf,
+        getNblocks(n, nthreads), nthreads, 0, defaultStream,
+        checker, n, pos.devPtr(), values.devPtr() );
+
+    values.downloadFromDevice(defaultStream);
+    return {values.begin(), values.end()};
+}
+
+static CompositeWallExpression leaf(std::shared_ptr<Wall> wall)
+{
+    return {Operation::Wall, std::move(wall), {}};
+}
+
+static CompositeWallExpression node(Operation operation, std::vector<CompositeWallExpression> children)
+{
+    return {operation, nullptr, std::move(children)};
+}
+
+/// positions in local coordinates, spread over the domain and a bit outside of it
+static std::vector<real3> randomPositions(int n, long seed)
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<real> u(-0.6_r, 0.6_r);
+
+    std::vector<real3> positions(n);
+    for (auto& r : positions)
+        r = make_real3(u(gen), u(gen), u(gen)) * domainSize;
+    return positions;
+}
+
+struct WallTest : public ::testing::Test
+{
+    WallTest() :
+        domain{domainSize, make_real3(0.0_r), domainSize},
+        state(domain, 0.0_r, UnitConversion{}),
+        comm(MPI_COMM_WORLD)
+    {}
+
+    DomainInfo domain;
+    MirState state;
+    MPI_Comm comm;
+};
+
+struct CompositeWallTest : public WallTest
+{
+    /// the composite SDF, where far operands may be skipped
+    std::vector<real> evaluateComposite(const CompositeWallExpression& expression, const std::vector<real3>& positions)
+    {
+        StationaryWallComposite composite(expression);
+        composite.setup(comm, domain);
+        return evaluate(composite.handler(), positions);
+    }
+
+    template <class Checker>
+    std::vector<real> evaluateWall(const std::shared_ptr<SimpleStationaryWall<Checker>>& wall, const std::vector<real3>& positions)
+    {
+        wall->getChecker().setup(comm, domain);
+        return evaluate(wall->getChecker().handler(), positions);
+    }
+};
+
+using Combine = std::function<real(real, real)>;
+
+static const Combine unite     = [](real a, real b) {return std::max(a,  b);};
+static const Combine intersect = [](real a, real b) {return std::min(a,  b);};
+static const Combine subtract  = [](real a, real b) {return std::min(a, -b);};
+
+/// combine the SDFs of each operand evaluated separately: no operand is skipped
+static std::vector<real> combine(const Combine& op, const std::vector<real>& a, const std::vector<real>& b)
+{
+    std::vector<real> result(a.size());
+    for (size_t i = 0; i < a.size(); ++i)
+        result[i] = op(a[i], b[i]);
+    return result;
+}
+
+static void checkSame(const std::vector<real>& skip, const std::vector<real>& noSkip)
+{
+    ASSERT_EQ(skip.size(), noSkip.size());
+    for (size_t i = 0; i < skip.size(); ++i)
+        ASSERT_NEAR(skip[i], noSkip[i], 1e-5_r) << "at point " << i;
+}
+
+TEST_F (CompositeWallTest, box_operands_carved_out_of_a_block)
+{
+    // the channel of the walls.analytic.channel.composite test, with a sphere far away
+    const real rc = 1.0_r;
+    auto channel = wall_factory::createBoxWall(&state, "channel", {-domainSize.x, rc, rc},
+                                               {2*domainSize.x, domainSize.y - rc, domainSize.z - rc}, false);
+    auto block  = wall_factory::createBoxWall(&state, "block", make_real3(-100.0_r), make_real3(100.0_r), false);
+    auto sphere = wall_factory::createSphereWall(&state, "sphere", make_real3(50.0_r), 1.0_r, false);
+
+    const auto positions = randomPositions(100000, 42);
+
+    const auto skip = evaluateComposite(node(Operation::Difference, {node(Operation::Union, {leaf(block), leaf(sphere)}),
+                                                                     leaf(channel)}),
+                                        positions);
+
+    const auto noSkip = combine(subtract,
+                                combine(unite, evaluateWall(block, positions), evaluateWall(sphere, positions)),
+                                evaluateWall(channel, positions));
+    checkSame(skip, noSkip);
+}
+
+TEST_F (CompositeWallTest, union_of_a_box_with_bounded_operands)
+{
+    // the box SDF is the distance to its closest face plane: it is close to zero far from the box
+    // next to the extension of its faces, where a bounds-based skip would be wrong
+    auto box      = wall_factory::createBoxWall(&state, "box", {6, 6, 6}, {10, 10, 10}, false);
+    auto sphere   = wall_factory::createSphereWall(&state, "sphere", {3, 3, 12}, 2.0_r, false);
+    auto cylinder = wall_factory::createCylinderWall(&state, "cylinder", {12, 4}, 1.5_r, "z", false);
+    auto plane    = wall_factory::createPlaneWall(&state, "plane", {0, 0, -1}, {0, 0, 1});
+
+    const auto positions = randomPositions(100000, 4242);
+
+    const auto skip = evaluateComposite(node(Operation::Union, {leaf(plane), leaf(sphere), leaf(box), leaf(cylinder)}),
+                                        positions);
+
+    auto noSkip = combine(unite, evaluateWall(plane, positions), evaluateWall(sphere, positions));
+    noSkip = combine(unite, noSkip, evaluateWall(box, positions));
+    noSkip = combine(unite, noSkip, evaluateWall(cylinder, positions));
+    checkSame(skip, noSkip);
+}
+
+TEST_F (CompositeWallTest, nested_differences_and_intersections)
+{
+    auto pipe     = wall_factory::createCylinderWall(&state, "pipe", {8, 8}, 6.0_r, "x", true);
+    auto cavity   = wall_factory::createSphereWall(&state, "cavity", {8, 8, 8}, 4.0_r, false);
+    auto post     = wall_factory::createCylinderWall(&state, "post", {8, 8}, 1.0_r, "y", false);
+    auto obstacle = wall_factory::createBoxWall(&state, "obstacle", {2, 7, 7}, {4, 9, 9}, false);
+
+    const auto positions = randomPositions(100000, 424242);
+
+    const auto skip = evaluateComposite(node(Operation::Difference,
+                                             {leaf(pipe),
+                                              node(Operation::Intersection, {leaf(cavity), leaf(post)}),
+                                              leaf(obstacle)}),
+                                        positions);
+
+    const auto postInCavity = combine(intersect, evaluateWall(cavity, positions), evaluateWall(post, positions));
+    auto noSkip = combine(subtract, evaluateWall(pipe, positions), postInCavity);
+    noSkip = combine(subtract, noSkip, evaluateWall(obstacle, positions));
+    checkSame(skip, noSkip);
+}
+
+/// sphere of the moving SDF tests, inside the wall (positive SDF) at time 0
+static const real3 movingSphereCenter {11.0_r, 8.0_r, 8.0_r};
+static const real movingSphereRadius = 1.5_r;
+
+static real movingSphereSdf(real3 gr)
+{
+    return movingSphereRadius - length(gr - movingSphereCenter);
+}
+
+/// write a plain SDF file of the sphere at time 0 over the whole domain
+static void writeSphereSdfFile(const std::string& fileName, int3 resolution)
+{
+    FILE *f = fopen(fileName.c_str(), "wb");
+    ASSERT_NE(f, nullptr);
+
+    fprintf(f, "%g %g %g\n%d %d %d\n", domainSize.x, domainSize.y, domainSize.z,
+            resolution.x, resolution.y, resolution.z);
+
+    const real3 h = domainSize / make_real3(resolution);
+    std::vector<float> data;
+    for (int k = 0; k < resolution.z; ++k)
+        for (int j = 0; j < resolution.y; ++j)
+            for (int i = 0; i < resolution.x; ++i)
+                data.push_back(static_cast<float>(movingSphereSdf(make_real3(i, j, k) * h)));
+
+    fwrite(data.data(), sizeof(float), data.size(), f);
+    fclose(f);
+}
+
+__global__ void evaluateRigidVelocity(VelocityFieldRigidMotion motion, int n, const real3 *positions, real3 *velocities)
+{
+    const int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i >= n) return;
+    velocities[i] = motion(positions[i]);
+}
+
+struct MovingSDFWallTest : public WallTest
+{
+    MovingSDFWallTest() :
+        velocity {1.0_r, 0.5_r, 0.0_r},
+        omega    {0.0_r, 0.0_r, 0.5_r},
+        center   {8.0_r, 8.0_r, 8.0_r}
+    {}
+
+    /// exact position at time t (global coordinates) of the body point that was at gr0 at time 0
+    real3 movedPoint(real3 gr0, real t) const
+    {
+        const real omegaNorm = length(omega);
+        const auto q = Quaternion<real>::createFromRotation(omegaNorm * t, omega / omegaNorm);
+        return q.rotate(gr0 - center) + center + velocity * t;
+    }
+
+    real3 velocity, omega, center;
+};
+
+TEST_F (MovingSDFWallTest, sdf_follows_the_rigid_motion)
+{
+    const std::string fileName = "moving_sphere.sdf";
+    writeSphereSdfFile(fileName, {64, 64, 64});
+
+    VelocityFieldRigidMotion motion(velocity, omega, center, 0.0_r);
+    MovingWallSDF sdf(&state, fileName, make_real3(0.25_r), 0.0_r, FieldInterpolation::Linear, motion);
+    sdf.setup(comm, domain);
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<real> u(-1.0_r, 1.0_r);
+
+    for (real t : {0.0_r, 0.7_r, 2.3_r})
+    {
+        state.currentTime = t;
+        const real3 sphereCenter = movedPoint(movingSphereCenter, t);
+
+        // around the current position of the sphere, in local coordinates
+        std::vector<real3> positions(10000);
+        for (auto& r : positions)
+            r = domain.global2local(sphereCenter + 2 * movingSphereRadius * make_real3(u(gen), u(gen), u(gen)));
+
+        const auto values = evaluate(sdf.handler(), positions);
+
+        for (size_t i = 0; i < positions.size(); ++i)
+        {
+            real3 dr = domain.local2global(positions[i]) - sphereCenter;
+            dr -= domainSize * math::floor(dr / domainSize + 0.5_r);
+
+            // the SDF has a kink at the center of the sphere, which the interpolation smoothes out
+            if (length(dr) < 0.5_r)
+                continue;
+
+            const real expected = movingSphereRadius - length(dr);
+            ASSERT_NEAR(values[i], expected, 0.05_r) << "at point " << i << " and time " << t;
+        }
+    }
+}
+
+TEST_F (MovingSDFWallTest, wall_velocity_is_the_rigid_body_velocity)
+{
+    std::mt19937 gen(4242);
+    std::uniform_real_distribution<real> u(-0.25_r, 0.25_r);
+
+    for (real t : {0.0_r, 1.3_r})
+    {
+        VelocityFieldRigidMotion motion(velocity, omega, center, 0.0_r);
+        motion.setup(t, domain);
+
+        const real3 c = center + velocity * t;
+
+        const int n = 1000;
+        PinnedBuffer<real3> positions(n), velocities(n);
+        for (auto& r : positions)
+            r = domain.global2local(c + make_real3(u(gen), u(gen), u(gen)) * domainSize);
+        positions.uploadToDevice(defaultStream);
+
+        const int nthreads = 128;
+        SAFE_KERNEL_LAUNCH(
+            evaluateRigidVelocity,
+            getNblocks(n, nthreads), nthreads, 0, defaultStream,
+            motion.handler(), n, positions.devPtr(), velocities.devPtr() );
+        velocities.downloadFromDevice(defaultStream);
+
+        for (int i = 0; i < n; ++i)
+        {
+            const real3 expected = velocity + cross(omega, domain.local2global(positions[i]) - c);
+            ASSERT_NEAR(velocities[i].x, expected.x, 1e-4_r) << "at point " << i;
+            ASSERT_NEAR(velocities[i].y, expected.y, 1e-4_r) << "at point " << i;
+            ASSERT_NEAR(velocities[i].z, expected.z, 1e-4_r) << "at point " << i;
+        }
+    }
+}
+
+TEST_F (MovingSDFWallTest, rigid_displacements_do_not_drift)
+{
+    // the displacements of the RigidMotion integrator, applied over many steps
+    const real dt = 1e-3_r;
+    const int nsteps = 2000;
+
+    const real3 gr0 = movingSphereCenter + make_real3(0.5_r, -1.0_r, 0.25_r);
+    real3 gr = gr0;
+
+    for (int step = 0; step < nsteps; ++step)
+    {
+        VelocityFieldRigidMotion now (velocity, omega, center, 0.0_r);
+        VelocityFieldRigidMotion next(velocity, omega, center, 0.0_r);
+        now .setup( step      * dt, domain);
+        next.setup((step + 1) * dt, domain);
+
+        gr += now.displacementTo(next, gr);
+    }
+
+    const real3 expected = movedPoint(gr0, nsteps * dt);
+    ASSERT_NEAR(gr.x, expected.x, 1e-3_r);
+    ASSERT_NEAR(gr.y, expected.y, 1e-3_r);
+    ASSERT_NEAR(gr.z, expected.z, 1e-3_r);
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+
+    logger.init(MPI_COMM_WORLD, "walls.log", 9);
+
+    testing::InitGoogleTest(&argc, argv);
+    const int result = RUN_ALL_TESTS();
+
+    MPI_Finalize();
+    return result;
+}